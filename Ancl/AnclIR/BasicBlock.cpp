@@ -170,12 +170,16 @@ size_t BasicBlock::GetPredecessorsNumber() const {
 }
 
 void BasicBlock::handleNewTerminator(TerminatorInstruction* terminator) {
-    // TODO: switch
     if (auto* branch = dynamic_cast<ir::BranchInstruction*>(terminator)) {
         branch->GetTrueBasicBlock()->AddPredecessor(this);
         if (branch->IsConditional()) {
             branch->GetFalseBasicBlock()->AddPredecessor(this);
         }
+    } else if (auto* switchInstr = dynamic_cast<ir::SwitchInstruction*>(terminator)) {
+        switchInstr->GetDefaultBasicBlock()->AddPredecessor(this);
+        for (const auto& switchCase : switchInstr->GetCases()) {
+            switchCase.CaseBasicBlock->AddPredecessor(this);
+        }
     }
 }
 
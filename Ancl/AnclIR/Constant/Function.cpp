@@ -40,6 +40,10 @@ void Function::AddBasicBlock(BasicBlock* basicBlock) {
     m_BasicBlocks.push_back(basicBlock);
 }
 
+void Function::InsertBasicBlock(size_t index, BasicBlock* basicBlock) {
+    m_BasicBlocks.insert(m_BasicBlocks.begin() + index, basicBlock);
+}
+
 void Function::SetEntryBlock(BasicBlock* basicBlock) {
     basicBlock->SetName(GetName());
     m_BasicBlocks.at(0) = basicBlock;
@@ -71,6 +75,11 @@ std::vector<BasicBlock*> Function::GetBasicBlocks() const {
     return m_BasicBlocks;
 }
 
+void Function::ClearBody() {
+    m_BasicBlocks.clear();
+    m_ReturnValue = nullptr;
+}
+
 void Function::SetReturnValue(Value* value) {
     m_ReturnValue = value;
 }
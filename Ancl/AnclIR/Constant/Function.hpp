@@ -26,6 +26,7 @@ public:
     std::vector<Parameter*> GetParameters() const;
 
     void AddBasicBlock(BasicBlock* basicBlock);
+    void InsertBasicBlock(size_t index, BasicBlock* basicBlock);
 
     void SetEntryBlock(BasicBlock* basicBlock);
     BasicBlock* GetEntryBlock() const;
@@ -35,6 +36,7 @@ public:
 
     void SetBasicBlocks(const std::vector<BasicBlock*>& blocks);
     std::vector<BasicBlock*> GetBasicBlocks() const;
+    void ClearBody();
 
     void SetReturnValue(Value* value);
     bool HasReturnValue() const;
@@ -36,6 +36,7 @@
 #include <Ancl/AnclIR/Instruction/MemoryCopyInstruction.hpp>
 #include <Ancl/AnclIR/Instruction/MemorySetInstruction.hpp>
 #include <Ancl/AnclIR/Instruction/ReturnInstruction.hpp>
+#include <Ancl/AnclIR/Instruction/SelectInstruction.hpp>
 #include <Ancl/AnclIR/Instruction/StoreInstruction.hpp>
 #include <Ancl/AnclIR/Instruction/SwitchInstruction.hpp>
 #include <Ancl/AnclIR/Instruction/TerminatorInstruction.hpp>
@@ -1,5 +1,9 @@
 #include <Ancl/AnclIR/IRProgram.hpp>
 
+#include <format>
+
+#include <Ancl/AnclIR/Instruction/Instruction.hpp>
+
 
 namespace ir {
 
@@ -42,6 +46,24 @@ Function* IRProgram::GetFunction(const std::string& name) const {
     return m_FunctionMap.at(name);
 }
 
+std::string IRProgram::CreateStringLabel() {
+    std::string label = ".L.str";
+    if (m_StringLabelsNumber > 0) {
+        label = std::format(".L.str.{}", m_StringLabelsNumber);
+    }
+    ++m_StringLabelsNumber;
+    return label;
+}
+
+void IRProgram::ReleaseFunctionBody(Function* function, size_t valuesMark) {
+    function->ClearBody();
+    function->SetDeclaration();
+
+    m_ValueTracker.DeallocateSince(valuesMark, [](Value* value) {
+        return dynamic_cast<Instruction*>(value) || dynamic_cast<BasicBlock*>(value);
+    });
+}
+
 void IRProgram::init(const std::vector<GlobalVariable*>& globalVars,
                      const std::vector<Function*>& functions) {
     for (auto* globalVar : globalVars) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,6 +13,30 @@
 namespace ir {
 
 class IRProgram {
+public:
+    // Function bodies generated in parallel allocate from per-thread pools,
+    // the pools belong to the program and live as long as it
+    struct AllocationPool {
+        Tracker<Value> ValueTracker;
+        Tracker<Type> TypeTracker;
+    };
+
+    // Routes allocations of the current thread to the pool while alive
+    class ThreadAllocationScope {
+    public:
+        ThreadAllocationScope(AllocationPool* pool)
+            : m_PreviousPool(s_ThreadPool) {
+            s_ThreadPool = pool;
+        }
+
+        ~ThreadAllocationScope() {
+            s_ThreadPool = m_PreviousPool;
+        }
+
+    private:
+        AllocationPool* m_PreviousPool;
+    };
+
 public:
     IRProgram() = default;
 
@@ -32,11 +57,41 @@ public:
 
     template <typename T, typename... Args>
     T* CreateValue(Args&&... args) {
+        if (s_ThreadPool) {
+            return s_ThreadPool->ValueTracker.Allocate<T>(std::forward<Args>(args)...);
+        }
         return m_ValueTracker.Allocate<T>(std::forward<Args>(args)...);
     }
 
+    size_t GetValuesNumber() const {
+        return m_ValueTracker.GetAllocatedNumber();
+    }
+
+    size_t GetAllocatedBytes() const {
+        size_t bytes = m_ValueTracker.GetAllocatedBytes() + m_TypeTracker.GetAllocatedBytes();
+        for (const AllocationPool& pool : m_Pools) {
+            bytes += pool.ValueTracker.GetAllocatedBytes() + pool.TypeTracker.GetAllocatedBytes();
+        }
+        return bytes;
+    }
+
+    // Must be called before the workers start
+    AllocationPool* CreateAllocationPool() {
+        return &m_Pools.emplace_back();
+    }
+
+    // Labels of string literals: .L.str, .L.str.1, ...
+    std::string CreateStringLabel();
+
+    // Streaming compilation: releases instructions and basic blocks
+    // created after `valuesMark`, constants and parameters are kept
+    void ReleaseFunctionBody(Function* function, size_t valuesMark);
+
     template <typename T, typename... Args>
     T* CreateType(Args&&... args) {
+        if (s_ThreadPool) {
+            return s_ThreadPool->TypeTracker.Allocate<T>(std::forward<Args>(args)...);
+        }
         return m_TypeTracker.Allocate<T>(std::forward<Args>(args)...);
     }
 
@@ -53,6 +108,12 @@ private:
 
     Tracker<Value> m_ValueTracker;
     Tracker<Type> m_TypeTracker;
+
+    std::deque<AllocationPool> m_Pools;
+
+    size_t m_StringLabelsNumber = 0;
+
+    inline static thread_local AllocationPool* s_ThreadPool = nullptr;
 };
 
 }  // namespace ir
@@ -31,4 +31,12 @@ size_t CallInstruction::GetArgumentsNumber() const {
     return GetOperandsNumber();
 }
 
+void CallInstruction::SetTailCall() {
+    m_IsTailCall = true;
+}
+
+bool CallInstruction::IsTailCall() const {
+    return m_IsTailCall;
+}
+
 }  // namespace ir
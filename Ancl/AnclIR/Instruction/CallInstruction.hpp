@@ -23,8 +23,14 @@ public:
 
     size_t GetArgumentsNumber() const;
 
+    // The caller frame is released before the jump to the callee
+    void SetTailCall();
+    bool IsTailCall() const;
+
 private:
     Function* m_Callee;
+
+    bool m_IsTailCall = false;
 };
 
 }  // namespace ir
@@ -0,0 +1,27 @@
+#include <Ancl/AnclIR/Instruction/SelectInstruction.hpp>
+
+
+namespace ir {
+
+SelectInstruction::SelectInstruction(Value* condition, Value* trueValue, Value* falseValue,
+                                     const std::string& name, BasicBlock* basicBlock)
+        : Instruction(trueValue->GetType(), basicBlock) {
+    SetName(name);
+    AddOperand(condition);
+    AddOperand(trueValue);
+    AddOperand(falseValue);
+}
+
+Value* SelectInstruction::GetCondition() const {
+    return GetOperand(0);
+}
+
+Value* SelectInstruction::GetTrueValue() const {
+    return GetOperand(1);
+}
+
+Value* SelectInstruction::GetFalseValue() const {
+    return GetOperand(2);
+}
+
+}  // namespace ir
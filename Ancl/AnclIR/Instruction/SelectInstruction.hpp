@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include <Ancl/AnclIR/BasicBlock.hpp>
+#include <Ancl/AnclIR/Instruction/Instruction.hpp>
+#include <Ancl/AnclIR/Value.hpp>
+
+
+namespace ir {
+
+// Chooses one of two values without branching
+class SelectInstruction: public Instruction {
+public:
+    SelectInstruction(Value* condition, Value* trueValue, Value* falseValue,
+                      const std::string& name, BasicBlock* basicBlock);
+
+    Value* GetCondition() const;
+
+    Value* GetTrueValue() const;
+    Value* GetFalseValue() const;
+};
+
+}  // namespace ir
@@ -8,16 +8,12 @@ namespace ir {
 SwitchInstruction::SwitchInstruction(Value* value, BasicBlock* defaultBlock,
                                      BasicBlock* basicBlock)
         : TerminatorInstruction(VoidType::Create(value->GetProgram()), basicBlock),
-          m_Value(value), m_DefaultBB(defaultBlock) {
-    // TODO: Cases uses?
+          m_DefaultBB(defaultBlock) {
     AddOperand(value);
-    AddOperand(defaultBlock);
-
-    // TODO: Link Basic Blocks
 }
 
 Value* SwitchInstruction::GetValue() const {
-    return m_Value;
+    return GetOperand(0);
 }
 
 bool SwitchInstruction::HasDefaultBasicBlock() const {
@@ -28,7 +24,18 @@ BasicBlock* SwitchInstruction::GetDefaultBasicBlock() const {
     return m_DefaultBB;
 }
 
+void SwitchInstruction::SetDefaultBasicBlock(BasicBlock* defaultBlock) {
+    if (isLinked()) {
+        m_DefaultBB->RemovePredecessor(GetBasicBlock());
+        defaultBlock->AddPredecessor(GetBasicBlock());
+    }
+    m_DefaultBB = defaultBlock;
+}
+
 void SwitchInstruction::AddCase(SwitchCase switchCase) {
+    if (isLinked()) {
+        switchCase.CaseBasicBlock->AddPredecessor(GetBasicBlock());
+    }
     m_SwitchCases.push_back(switchCase);
 }
 
@@ -40,4 +47,9 @@ size_t SwitchInstruction::GetCasesNumber() const {
     return m_SwitchCases.size();
 }
 
+bool SwitchInstruction::isLinked() const {
+    BasicBlock* basicBlock = GetBasicBlock();
+    return basicBlock && basicBlock->GetTerminator() == this;
+}
+
 }  // namespace ir
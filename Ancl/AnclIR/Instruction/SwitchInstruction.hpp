@@ -3,16 +3,22 @@
 #include <vector>
 
 #include <Ancl/AnclIR/BasicBlock.hpp>
+#include <Ancl/AnclIR/Constant/IntConstant.hpp>
 #include <Ancl/AnclIR/Instruction/TerminatorInstruction.hpp>
 #include <Ancl/AnclIR/Value.hpp>
 
 
 namespace ir {
 
+/*
+    switch %value, label %default [%case0, label %bb0], ...
+
+    Every case has its own block, so there are no duplicate edges
+*/
 class SwitchInstruction: public TerminatorInstruction {
 public:
     struct SwitchCase {
-        Value* CaseValue;
+        IntConstant* CaseValue;
         BasicBlock* CaseBasicBlock;
     };
 
@@ -23,6 +29,7 @@ public:
 
     bool HasDefaultBasicBlock() const;
     BasicBlock* GetDefaultBasicBlock() const;
+    void SetDefaultBasicBlock(BasicBlock* defaultBlock);
 
     void AddCase(SwitchCase switchCase);
 
@@ -31,8 +38,10 @@ public:
     size_t GetCasesNumber() const;
 
 private:
-    Value* m_Value;
+    // Cases may be added after the switch terminates its block
+    bool isLinked() const;
 
+private:
     BasicBlock* m_DefaultBB = nullptr;
     std::vector<SwitchCase> m_SwitchCases;
 };
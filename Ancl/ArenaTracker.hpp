@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+
+// Tracker that places objects one after another in large chunks
+// instead of allocating each of them separately
+template <typename T>
+class ArenaTracker {
+public:
+    ArenaTracker() = default;
+
+    ArenaTracker(const ArenaTracker&) = delete;
+    ArenaTracker(ArenaTracker&&) = delete;
+
+    ArenaTracker& operator=(const ArenaTracker&) = delete;
+    ArenaTracker& operator=(ArenaTracker&&) = delete;
+
+    ~ArenaTracker() {
+        DeallocateAll();
+    }
+
+    template<typename U, typename... Args>
+    U* Allocate(Args&&... args) {
+        static_assert(std::is_base_of_v<T, U>);
+        static_assert(alignof(U) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        void* memory = allocateBytes(sizeof(U), alignof(U));
+        U* result = new (memory) U(args...);
+        m_Allocated.push_back(result);
+        return result;
+    }
+
+    size_t GetAllocatedNumber() const {
+        return m_Allocated.size();
+    }
+
+    size_t GetAllocatedBytes() const {
+        return m_AllocatedBytes;
+    }
+
+    void DeallocateAll() {
+        for (T* entry : m_Allocated) {
+            entry->~T();
+        }
+        m_Allocated.clear();
+        m_Chunks.clear();
+        m_ChunkOffset = 0;
+        m_AllocatedBytes = 0;
+    }
+
+private:
+    static constexpr size_t kChunkSize = 64 * 1024;
+
+    struct Chunk {
+        std::unique_ptr<std::byte[]> Data;
+        size_t Size = 0;
+    };
+
+    void* allocateBytes(size_t size, size_t alignment) {
+        size_t offset = (m_ChunkOffset + alignment - 1) & ~(alignment - 1);
+        if (m_Chunks.empty() || offset + size > m_Chunks.back().Size) {
+            size_t chunkSize = std::max(kChunkSize, size);
+            m_Chunks.push_back(Chunk{std::unique_ptr<std::byte[]>(new std::byte[chunkSize]), chunkSize});
+            offset = 0;
+        }
+
+        m_ChunkOffset = offset + size;
+        m_AllocatedBytes += size;
+        return m_Chunks.back().Data.get() + offset;
+    }
+
+private:
+    std::vector<Chunk> m_Chunks;
+    size_t m_ChunkOffset = 0;
+    size_t m_AllocatedBytes = 0;
+
+    std::vector<T*> m_Allocated;
+};
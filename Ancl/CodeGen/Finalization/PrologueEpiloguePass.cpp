@@ -123,15 +123,13 @@ void PrologueEpiloguePass::generatePrologue(MFunction* function) {
 }
 
 void PrologueEpiloguePass::generateEpilogue(MFunction* function) {
-    MBasicBlock* endBlock = function->GetLastBasicBlock();
-
-    MBasicBlock::TInstructionIt returnInstructionIt = --endBlock->GetInstrEnd();
-    assert(returnInstructionIt->IsReturn());
-
-    MBasicBlock::TInstructionIt instrIt = returnInstructionIt;
-    for (const MInstruction& instruction : m_EpilogueInstructions | std::views::reverse) {
-        instrIt = endBlock->InsertBefore(instruction, instrIt);
-    } 
+    // Tail calls leave the function too, the frame is released before the jump
+    for (MBasicBlock* exitBlock : function->GetExitBasicBlocks()) {
+        MBasicBlock::TInstructionIt instrIt = exitBlock->GetLastInstruction();
+        for (const MInstruction& instruction : m_EpilogueInstructions | std::views::reverse) {
+            instrIt = exitBlock->InsertBefore(instruction, instrIt);
+        }
+    }
 }
 
 }  // namespace gen
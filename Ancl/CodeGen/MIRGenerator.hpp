@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <list>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <Ancl/AnclIR/IRProgram.hpp>
 #include <Ancl/DataLayout/Alignment.hpp>
@@ -23,12 +29,20 @@ public:
 
     void Generate() {
         for (ir::Function* irFunction : m_IRProgram.GetFunctions()) {
-            TScopePtr<MFunction> mirFunction = genMFromIRFunction(irFunction);
-            if (mirFunction) {
-                m_MIRProgram.AddFunction(std::move(mirFunction));
-            }
+            GenerateFunction(irFunction);
+        }
+
+        GenerateGlobalData();
+    }
+
+    void GenerateFunction(ir::Function* irFunction) {
+        TScopePtr<MFunction> mirFunction = genMFromIRFunction(irFunction);
+        if (mirFunction) {
+            m_MIRProgram.AddFunction(std::move(mirFunction));
         }
+    }
 
+    void GenerateGlobalData() {
         for (ir::GlobalVariable* globalVar : m_IRProgram.GetGlobalVars()) {
             gen::GlobalDataArea globalData = genGlobalDataArea(globalVar);
             if (globalVar->GetLinkage() == ir::GlobalValue::LinkageType::kStatic) {
@@ -41,6 +55,47 @@ public:
         }
     }
 
+private:
+    struct SwitchCluster {
+        uint64_t Low = 0;
+        uint64_t High = 0;
+        bool IsTable = false;
+
+        // Indexed by value - Low, holes are nullptr
+        std::vector<MBasicBlock*> Targets;
+    };
+
+    struct SwitchLowering {
+        MOperand Value;
+        uint64_t ValueSize = 0;
+
+        MBasicBlock* SwitchBlock = nullptr;
+        MBasicBlock* Fallback = nullptr;
+        MBasicBlock* LastBlock = nullptr;
+        size_t BlocksNumber = 0;
+
+        std::unordered_set<MBasicBlock*> LinkedTargets;
+    };
+
+    struct JumpTable {
+        std::string Label;
+        std::vector<MBasicBlock*> Targets;
+    };
+
+    static constexpr size_t kMaxSwitchChainLength = 3;
+    static constexpr size_t kMinJumpTableCases = 4;
+    static constexpr uint64_t kMinJumpTableDensity = 40;  // percent
+    static constexpr uint64_t kMaxJumpTableSize = 4096;
+    static constexpr uint64_t kJumpTableEntrySize = 4;
+
+    // Constant memsets up to the first size are unrolled stores, up to the second
+    // are rep stos, larger ones call libc
+    static constexpr uint64_t kMaxInlineMemSetSize = 128;
+    static constexpr uint64_t kMaxRepStoreMemSetSize = 2048;
+
+    // Constant memcpys up to the size are unrolled load and store pairs
+    static constexpr uint64_t kMaxInlineMemCopySize = 128;
+
 private:
     void linkIRValueWithVReg(ir::Value* value, uint64_t vreg) {
         // NB: Unnamed values must be assigned numbers in the AnclIR
@@ -311,6 +366,22 @@ private:
         basicBlock->AddInstruction(mirInstr);
     }
 
+    void genMFromIRSelectInstr(ir::SelectInstruction* selectInstr, MBasicBlock* basicBlock) {
+        MInstruction mirInstr{MInstruction::OpType::kSelect};
+
+        MOperand definition = genMVRegisterFromIRValue(selectInstr, basicBlock);
+        MOperand condition = genMVRegisterFromIRValue(selectInstr->GetCondition(), basicBlock);
+        MOperand trueValue = genMVRegisterFromIRValue(selectInstr->GetTrueValue(), basicBlock);
+        MOperand falseValue = genMVRegisterFromIRValue(selectInstr->GetFalseValue(), basicBlock);
+
+        mirInstr.AddOperand(definition);
+        mirInstr.AddOperand(condition);
+        mirInstr.AddOperand(trueValue);
+        mirInstr.AddOperand(falseValue);
+
+        basicBlock->AddInstruction(mirInstr);
+    }
+
     void genMFromIRCastInstr(ir::CastInstruction* castInstr, MBasicBlock* basicBlock) {
         auto irOpType = castInstr->GetOpType();
 
@@ -493,11 +564,20 @@ private:
     }
 
     void genMFromIRMemCopyInstr(ir::MemoryCopyInstruction* memCopyInstr, MBasicBlock* basicBlock) {
+        uint64_t size = memCopyInstr->GetSizeConstant()->GetValue().GetUnsignedValue();
+        if (size <= kMaxInlineMemCopySize) {
+            MOperand destOperand = genMVRegisterFromIRValue(memCopyInstr->GetDestinationOperand(),
+                                                            basicBlock);
+            MOperand sourceOperand = genMVRegisterFromIRValue(memCopyInstr->GetSourceOperand(),
+                                                              basicBlock);
+            genMInlineMemCopy(destOperand, sourceOperand, size, basicBlock);
+            return;
+        }
+
         MFunction* function = basicBlock->GetFunction();
         function->SetCaller();
 
         target::TargetABI* targetABI = m_TargetMachine->GetABI();
-        target::RegisterSet* targetRegSet = m_TargetMachine->GetRegisterSet();
         std::vector<target::Register> argumentRegisters = targetABI->GetIntArgumentRegisters();
 
         target::Register destReg = argumentRegisters.at(0);
@@ -532,6 +612,178 @@ private:
         basicBlock->AddInstruction(callInstr);
     }
 
+    // Load and store pairs of 8 bytes, odd sizes end with a pair overlapping the previous one
+    void genMInlineMemCopy(const MOperand& destOperand, const MOperand& sourceOperand, uint64_t size,
+                           MBasicBlock* basicBlock) {
+        if (size == 0) {
+            return;
+        }
+
+        uint64_t pieceSize = 8;
+        while (pieceSize > size) {
+            pieceSize /= 2;
+        }
+
+        uint64_t offset = 0;
+        for (; offset + pieceSize <= size; offset += pieceSize) {
+            genMCopyPiece(destOperand, sourceOperand, offset, pieceSize, basicBlock);
+        }
+        if (offset < size) {
+            genMCopyPiece(destOperand, sourceOperand, size - pieceSize, pieceSize, basicBlock);
+        }
+    }
+
+    void genMCopyPiece(const MOperand& destOperand, const MOperand& sourceOperand, uint64_t offset,
+                       uint64_t pieceSize, MBasicBlock* basicBlock) {
+        MFunction* mirFunction = basicBlock->GetFunction();
+
+        MInstruction mirLoad{MInstruction::OpType::kLoad};
+        mirLoad.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(pieceSize));
+        mirLoad.AddOperand(genMAddressWithOffset(sourceOperand, offset, basicBlock));
+        basicBlock->AddInstruction(mirLoad);
+
+        MInstruction mirStore{MInstruction::OpType::kStore};
+        mirStore.AddOperand(genMAddressWithOffset(destOperand, offset, basicBlock));
+        mirStore.AddOperand(*mirLoad.GetDefinition());
+        basicBlock->AddInstruction(mirStore);
+    }
+
+    void genMFromIRMemSetInstr(ir::MemorySetInstruction* memSetInstr, MBasicBlock* basicBlock) {
+        uint64_t size = memSetInstr->GetBytesNumber()->GetValue().GetUnsignedValue();
+        uint64_t fillByte = memSetInstr->GetFillByte()->GetValue().GetUnsignedValue() & 0xFF;
+        MOperand destOperand = genMVRegisterFromIRValue(memSetInstr->GetDestinationOperand(), basicBlock);
+
+        if (size <= kMaxInlineMemSetSize) {
+            genMInlineMemSet(destOperand, fillByte, size, basicBlock);
+        } else if (size <= kMaxRepStoreMemSetSize) {
+            genMRepStoreMemSet(destOperand, fillByte, size, basicBlock);
+        } else {
+            genMMemSetCall(destOperand, fillByte, size, basicBlock);
+        }
+    }
+
+    // 8-byte stores of the splatted byte, odd sizes end with a store overlapping the previous one
+    void genMInlineMemSet(const MOperand& destOperand, uint64_t fillByte, uint64_t size,
+                          MBasicBlock* basicBlock) {
+        if (size == 0) {
+            return;
+        }
+
+        uint64_t pieceSize = 8;
+        while (pieceSize > size) {
+            pieceSize /= 2;
+        }
+
+        uint64_t pattern = fillByte * 0x0101010101010101;
+        MOperand valueOperand = genMSplatOperand(pattern, pieceSize, basicBlock);
+
+        uint64_t offset = 0;
+        for (; offset + pieceSize <= size; offset += pieceSize) {
+            genMStoreWithOffset(destOperand, offset, valueOperand, basicBlock);
+        }
+        if (offset < size) {
+            genMStoreWithOffset(destOperand, size - pieceSize, valueOperand, basicBlock);
+        }
+    }
+
+    void genMRepStoreMemSet(const MOperand& destOperand, uint64_t fillByte, uint64_t size,
+                            MBasicBlock* basicBlock) {
+        // Quad words when the size allows it, bytes otherwise
+        uint64_t elementSize = (size % 8 == 0) ? 8 : 1;
+        uint64_t pattern = fillByte * 0x0101010101010101;
+
+        MInstruction memSetInstr{MInstruction::OpType::kMemSet};
+        memSetInstr.Undefine();
+        memSetInstr.AddOperand(destOperand);
+        memSetInstr.AddOperand(MOperand::CreateImmInteger(truncateToSigned(pattern, elementSize), elementSize));
+        memSetInstr.AddImmInteger(size / elementSize);
+        basicBlock->AddInstruction(memSetInstr);
+    }
+
+    void genMMemSetCall(const MOperand& destOperand, uint64_t fillByte, uint64_t size,
+                        MBasicBlock* basicBlock) {
+        MFunction* function = basicBlock->GetFunction();
+        function->SetCaller();
+
+        target::TargetABI* targetABI = m_TargetMachine->GetABI();
+        target::RegisterSet* targetRegSet = m_TargetMachine->GetRegisterSet();
+        std::vector<target::Register> argumentRegisters = targetABI->GetIntArgumentRegisters();
+
+        MInstruction movDestInstr{MInstruction::OpType::kMov};
+        movDestInstr.AddPhysicalRegister(argumentRegisters.at(0));
+        movDestInstr.AddOperand(destOperand);
+        basicBlock->AddInstruction(movDestInstr);
+
+        // The fill value is an int
+        target::Register fillReg = argumentRegisters.at(1);
+        fillReg = targetRegSet->GetRegister(fillReg.GetSubRegNumbers().at(0));
+
+        MInstruction movFillInstr{MInstruction::OpType::kMov};
+        movFillInstr.AddPhysicalRegister(fillReg);
+        movFillInstr.AddImmInteger(fillByte, fillReg.GetBytes());
+        basicBlock->AddInstruction(movFillInstr);
+
+        MInstruction movSizeInstr{MInstruction::OpType::kMov};
+        movSizeInstr.AddPhysicalRegister(argumentRegisters.at(2));
+        movSizeInstr.AddImmInteger(size);
+        basicBlock->AddInstruction(movSizeInstr);
+
+        MInstruction callInstr{MInstruction::OpType::kCall};
+        callInstr.AddFunction("memset");
+        basicBlock->AddInstruction(callInstr);
+    }
+
+    // Stores take sign extended imm32, wider patterns are moved to a register once
+    MOperand genMSplatOperand(uint64_t pattern, uint64_t bytes, MBasicBlock* basicBlock) {
+        int64_t value = truncateToSigned(pattern, bytes);
+        MOperand immOperand = MOperand::CreateImmInteger(value, bytes);
+        if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+            return immOperand;
+        }
+
+        MFunction* mirFunction = basicBlock->GetFunction();
+
+        MInstruction movInstr{MInstruction::OpType::kMov};
+        movInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(bytes));
+        movInstr.AddOperand(immOperand);
+        basicBlock->AddInstruction(movInstr);
+        return *movInstr.GetDefinition();
+    }
+
+    void genMStoreWithOffset(const MOperand& addressOperand, uint64_t offset,
+                             const MOperand& valueOperand, MBasicBlock* basicBlock) {
+        MInstruction mirStore{MInstruction::OpType::kStore};
+        mirStore.AddOperand(genMAddressWithOffset(addressOperand, offset, basicBlock));
+        mirStore.AddOperand(valueOperand);
+        basicBlock->AddInstruction(mirStore);
+    }
+
+    // The member address has a single use, the selection folds it into the memory operand
+    MOperand genMAddressWithOffset(const MOperand& addressOperand, uint64_t offset, MBasicBlock* basicBlock) {
+        if (offset == 0) {
+            return addressOperand;
+        }
+
+        MFunction* mirFunction = basicBlock->GetFunction();
+        uint64_t pointerSize = m_TargetMachine->GetPointerByteSize();
+
+        // BaseReg + DispImm
+        MInstruction memberAddress{MInstruction::OpType::kMemberAddress};
+        memberAddress.AddVirtualRegister(mirFunction->NextVReg(), MType::CreatePointer(pointerSize));
+        memberAddress.AddOperand(addressOperand);
+        memberAddress.AddImmInteger(0);
+        memberAddress.AddVirtualRegister(0, MType::CreateScalar(pointerSize));
+        memberAddress.AddImmInteger(offset, pointerSize);
+        basicBlock->AddInstruction(memberAddress);
+
+        return *memberAddress.GetDefinition();
+    }
+
+    static int64_t truncateToSigned(uint64_t value, uint64_t bytes) {
+        uint64_t shift = 64 - bytes * 8;
+        return static_cast<int64_t>(value << shift) >> shift;
+    }
+
     void genMFromIRPhiInstr(ir::PhiInstruction* phiInstr, MBasicBlock* basicBlock) {
         MInstruction mirPhi{MInstruction::OpType::kPhi};
 
@@ -634,9 +886,288 @@ private:
         basicBlock->AddInstruction(mirBranch);
     }
 
+    void genMFromIRSwitchInstr(ir::SwitchInstruction* switchInstr, MBasicBlock* basicBlock) {
+        ir::Value* irValue = switchInstr->GetValue();
+        uint64_t valueSize = ir::Alignment::GetTypeSize(irValue->GetType());
+
+        SwitchLowering lowering{
+            .Value = genMVRegisterFromIRValue(irValue, basicBlock),
+            .ValueSize = valueSize,
+            .SwitchBlock = basicBlock,
+            .LastBlock = basicBlock,
+        };
+        if (lowering.Value.IsImmediate()) {
+            lowering.Value = genMSwitchRegister(lowering.Value, valueSize, basicBlock);
+        }
+
+        // Cases are ordered as unsigned values, the compare tree and the tables use unsigned compares
+        uint64_t mask = valueSize >= 8 ? ~uint64_t{0} : (uint64_t{1} << (valueSize * 8)) - 1;
+        std::vector<std::pair<uint64_t, MBasicBlock*>> cases;
+        for (const ir::SwitchInstruction::SwitchCase& irCase : switchInstr->GetCases()) {
+            uint64_t caseValue = irCase.CaseValue->GetValue().GetUnsignedValue() & mask;
+            cases.emplace_back(caseValue, m_MBBMap[irCase.CaseBasicBlock->GetName()]);
+        }
+        std::sort(cases.begin(), cases.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+
+        basicBlock->ClearSuccessors();
+
+        // Copies of the phis are inserted at the end of the predecessor, so the default block
+        // with phis must have a single predecessor, misses of the compares jump to it through a trampoline
+        ir::BasicBlock* irDefaultBB = switchInstr->GetDefaultBasicBlock();
+        MBasicBlock* defaultBlock = m_MBBMap[irDefaultBB->GetName()];
+        lowering.Fallback = defaultBlock;
+        if (irDefaultBB->HasPhiFunctions() && !cases.empty()) {
+            lowering.Fallback = createSwitchBlock(lowering);
+
+            MInstruction mirJump{MInstruction::OpType::kJump};
+            mirJump.AddBasicBlock(defaultBlock);
+            lowering.Fallback->AddInstruction(mirJump);
+            linkSwitchEdge(lowering, lowering.Fallback, defaultBlock);
+        }
+
+        if (cases.empty()) {
+            MInstruction mirJump{MInstruction::OpType::kJump};
+            mirJump.AddBasicBlock(defaultBlock);
+            basicBlock->AddInstruction(mirJump);
+            linkSwitchEdge(lowering, basicBlock, defaultBlock);
+            return;
+        }
+
+        std::vector<SwitchCluster> clusters = genSwitchClusters(cases);
+        genMSwitchClusters(lowering, clusters, 0, clusters.size(), basicBlock);
+    }
+
+    // Dense runs of cases become jump tables, the rest of them are compared one by one
+    std::vector<SwitchCluster> genSwitchClusters(const std::vector<std::pair<uint64_t, MBasicBlock*>>& cases) {
+        std::vector<SwitchCluster> clusters;
+
+        size_t first = 0;
+        while (first < cases.size()) {
+            size_t last = first;
+            for (size_t i = first + 1; i < cases.size(); ++i) {
+                uint64_t range = cases[i].first - cases[first].first;
+                if (range >= kMaxJumpTableSize) {
+                    break;
+                }
+                uint64_t casesNumber = i - first + 1;
+                if (casesNumber * 100 >= (range + 1) * kMinJumpTableDensity) {
+                    last = i;
+                }
+            }
+
+            SwitchCluster cluster;
+            cluster.Low = cases[first].first;
+            if (last - first + 1 < kMinJumpTableCases) {
+                cluster.High = cluster.Low;
+                cluster.Targets.push_back(cases[first].second);
+                clusters.push_back(std::move(cluster));
+                ++first;
+                continue;
+            }
+
+            cluster.High = cases[last].first;
+            cluster.IsTable = true;
+            cluster.Targets.resize(cluster.High - cluster.Low + 1, nullptr);
+            for (size_t i = first; i <= last; ++i) {
+                cluster.Targets[cases[i].first - cluster.Low] = cases[i].second;
+            }
+            clusters.push_back(std::move(cluster));
+            first = last + 1;
+        }
+
+        return clusters;
+    }
+
+    void genMSwitchClusters(SwitchLowering& lowering, const std::vector<SwitchCluster>& clusters,
+                            size_t begin, size_t end, MBasicBlock* block) {
+        if (end - begin <= kMaxSwitchChainLength) {
+            for (size_t i = begin; i < end; ++i) {
+                MBasicBlock* missBlock = lowering.Fallback;
+                if (i + 1 < end) {
+                    missBlock = createSwitchBlock(lowering);
+                }
+                genMSwitchCluster(lowering, clusters[i], block, missBlock);
+                block = missBlock;
+            }
+            return;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+
+        MBasicBlock* leftBlock = createSwitchBlock(lowering);
+        MBasicBlock* rightBlock = createSwitchBlock(lowering);
+        genMSwitchBranch(lowering, block, MInstruction::CompareKind::kLess, lowering.Value,
+                         clusters[middle].Low, leftBlock, rightBlock);
+
+        genMSwitchClusters(lowering, clusters, begin, middle, leftBlock);
+        genMSwitchClusters(lowering, clusters, middle, end, rightBlock);
+    }
+
+    // Case blocks may have phis, they are reached only by the false edge
+    void genMSwitchCluster(SwitchLowering& lowering, const SwitchCluster& cluster,
+                           MBasicBlock* block, MBasicBlock* missBlock) {
+        MFunction* mirFunction = block->GetFunction();
+
+        if (!cluster.IsTable) {
+            genMSwitchBranch(lowering, block, MInstruction::CompareKind::kNEqual, lowering.Value,
+                             cluster.Low, missBlock, cluster.Targets[0]);
+            return;
+        }
+
+        MOperand indexOperand = lowering.Value;
+        if (cluster.Low != 0) {
+            indexOperand = MOperand::CreateRegister(mirFunction->NextVReg(),
+                                                    MType::CreateScalar(lowering.ValueSize));
+            MInstruction subInstr{MInstruction::OpType::kSub};
+            subInstr.AddOperand(indexOperand);
+            subInstr.AddOperand(lowering.Value);
+            subInstr.AddOperand(genMSwitchImmediate(lowering, cluster.Low, block));
+            block->AddInstruction(subInstr);
+        }
+
+        MBasicBlock* tableBlock = createSwitchBlock(lowering);
+        genMSwitchBranch(lowering, block, MInstruction::CompareKind::kLessEq, indexOperand,
+                         cluster.High - cluster.Low, tableBlock, missBlock);
+
+        uint64_t pointerSize = m_TargetMachine->GetPointerByteSize();
+        if (lowering.ValueSize < pointerSize) {
+            MOperand extIndexOperand = MOperand::CreateRegister(mirFunction->NextVReg(),
+                                                                MType::CreateScalar(pointerSize));
+            MInstruction extInstr{MInstruction::OpType::kZExt};
+            extInstr.AddOperand(extIndexOperand);
+            extInstr.AddOperand(indexOperand);
+            tableBlock->AddInstruction(extInstr);
+            indexOperand = extIndexOperand;
+        }
+
+        // Entries are offsets from the table, so it stays position independent
+        std::string tableLabel = std::format(".L.{}.switch.{}", mirFunction->GetName(), m_JumpTables.size());
+        JumpTable jumpTable{tableLabel, {}};
+
+        MInstruction tableAddressInstr{MInstruction::OpType::kGlobalAddress};
+        tableAddressInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreatePointer(pointerSize));
+        tableAddressInstr.AddGlobalSymbol(tableLabel);
+        tableBlock->AddInstruction(tableAddressInstr);
+        MOperand tableOperand = *tableAddressInstr.GetDefinition();
+
+        MInstruction entryAddressInstr{MInstruction::OpType::kMemberAddress};
+        entryAddressInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreatePointer(pointerSize));
+        entryAddressInstr.AddOperand(tableOperand);
+        entryAddressInstr.AddImmInteger(kJumpTableEntrySize, pointerSize);
+        entryAddressInstr.AddOperand(indexOperand);
+        entryAddressInstr.AddImmInteger(0);
+        tableBlock->AddInstruction(entryAddressInstr);
+
+        MInstruction loadInstr{MInstruction::OpType::kLoad};
+        loadInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(kJumpTableEntrySize));
+        loadInstr.AddOperand(*entryAddressInstr.GetDefinition());
+        tableBlock->AddInstruction(loadInstr);
+
+        MInstruction extInstr{MInstruction::OpType::kSExt};
+        extInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(pointerSize));
+        extInstr.AddOperand(*loadInstr.GetDefinition());
+        tableBlock->AddInstruction(extInstr);
+
+        MInstruction targetInstr{MInstruction::OpType::kAdd};
+        targetInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreatePointer(pointerSize));
+        targetInstr.AddOperand(tableOperand);
+        targetInstr.AddOperand(*extInstr.GetDefinition());
+        tableBlock->AddInstruction(targetInstr);
+
+        MInstruction jumpInstr{MInstruction::OpType::kJump};
+        jumpInstr.AddOperand(*targetInstr.GetDefinition());
+        tableBlock->AddInstruction(jumpInstr);
+
+        std::unordered_set<MBasicBlock*> successors;
+        for (MBasicBlock* target : cluster.Targets) {
+            if (!target) {
+                target = lowering.Fallback;
+            }
+            jumpTable.Targets.push_back(target);
+            if (successors.insert(target).second) {
+                linkSwitchEdge(lowering, tableBlock, target);
+            }
+        }
+
+        m_JumpTables.push_back(std::move(jumpTable));
+    }
+
+    void genMSwitchBranch(SwitchLowering& lowering, MBasicBlock* block,
+                          MInstruction::CompareKind compareKind, const MOperand& operand,
+                          uint64_t value, MBasicBlock* trueBlock, MBasicBlock* falseBlock) {
+        MFunction* mirFunction = block->GetFunction();
+
+        MInstruction cmpInstr{MInstruction::OpType::kUCmp, compareKind};
+        cmpInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(1));
+        cmpInstr.AddOperand(operand);
+        cmpInstr.AddOperand(genMSwitchImmediate(lowering, value, block));
+        block->AddInstruction(cmpInstr);
+
+        MInstruction mirBranch{MInstruction::OpType::kBranch};
+        mirBranch.AddOperand(*cmpInstr.GetDefinition());
+        mirBranch.AddBasicBlock(trueBlock);
+        mirBranch.AddBasicBlock(falseBlock);
+        block->AddInstruction(mirBranch);
+
+        linkSwitchEdge(lowering, block, trueBlock);
+        linkSwitchEdge(lowering, block, falseBlock);
+    }
+
+    // Immediates are sign extended by the target, values out of imm32 go through a register
+    MOperand genMSwitchImmediate(SwitchLowering& lowering, uint64_t value, MBasicBlock* block) {
+        int64_t signedValue = truncateToSigned(value, lowering.ValueSize);
+
+        MOperand immOperand = MOperand::CreateImmInteger(signedValue, lowering.ValueSize);
+        if (signedValue < std::numeric_limits<int32_t>::min() ||
+                signedValue > std::numeric_limits<int32_t>::max()) {
+            return genMSwitchRegister(immOperand, lowering.ValueSize, block);
+        }
+        return immOperand;
+    }
+
+    MOperand genMSwitchRegister(const MOperand& immOperand, uint64_t size, MBasicBlock* block) {
+        MFunction* mirFunction = block->GetFunction();
+
+        MInstruction movInstr{MInstruction::OpType::kMov};
+        movInstr.AddVirtualRegister(mirFunction->NextVReg(), MType::CreateScalar(size));
+        movInstr.AddOperand(immOperand);
+        block->AddInstruction(movInstr);
+        return *movInstr.GetDefinition();
+    }
+
+    // Blocks of the lowering follow the switch block, the allocator relies on the textual order
+    MBasicBlock* createSwitchBlock(SwitchLowering& lowering) {
+        MFunction* mirFunction = lowering.SwitchBlock->GetFunction();
+        std::string name = std::format("{}.switch.{}", lowering.SwitchBlock->GetName(),
+                                       lowering.BlocksNumber++);
+        auto MBB = CreateScope<MBasicBlock>(name, mirFunction);
+        lowering.LastBlock = mirFunction->InsertBasicBlockAfter(lowering.LastBlock, std::move(MBB));
+        return lowering.LastBlock;
+    }
+
+    // The first edge to a target takes the place of the switch block among its predecessors
+    void linkSwitchEdge(SwitchLowering& lowering, MBasicBlock* from, MBasicBlock* to) {
+        from->AddSuccessor(to);
+
+        std::vector<MBasicBlock*> predecessors = to->GetPredecessors();
+        bool isSwitchTarget = std::find(predecessors.begin(), predecessors.end(),
+                                        lowering.SwitchBlock) != predecessors.end();
+        if (isSwitchTarget && lowering.LinkedTargets.insert(to).second) {
+            to->ReplacePredecessor(lowering.SwitchBlock, from);
+        } else {
+            to->AddPredecessor(from);
+        }
+    }
+
     void genMFromIRCallInstr(ir::CallInstruction* callInstr, MBasicBlock* basicBlock) {
-        MFunction* function = basicBlock->GetFunction();
-        function->SetCaller();
+        // The callee of a tail call returns to our caller, the result is already in place
+        bool isTailCall = callInstr->IsTailCall();
+        if (!isTailCall) {
+            MFunction* function = basicBlock->GetFunction();
+            function->SetCaller();
+        }
 
         target::TargetABI* targetABI = m_TargetMachine->GetABI();
         target::RegisterSet* targetRegSet = m_TargetMachine->GetRegisterSet();
@@ -683,12 +1214,12 @@ private:
             basicBlock->AddInstruction(vectorInfoMovInstr);
         }
 
-        MInstruction mirCall{MInstruction::OpType::kCall};
+        MInstruction mirCall{isTailCall ? MInstruction::OpType::kTailCall : MInstruction::OpType::kCall};
         mirCall.AddFunction(calleeValue->GetName());
         basicBlock->AddInstruction(mirCall);
 
         ir::Type* callResultIRType = callInstr->GetType();
-        if (dynamic_cast<ir::VoidType*>(callResultIRType)) {
+        if (isTailCall || dynamic_cast<ir::VoidType*>(callResultIRType)) {
             return;
         }
 
@@ -722,6 +1253,12 @@ private:
     }
 
     void genMFromIRReturnInstr(ir::ReturnInstruction* returnInstr, MBasicBlock* basicBlock) {
+        // The tail call has already left the function
+        std::list<MInstruction>& instructions = basicBlock->GetInstructions();
+        if (!instructions.empty() && instructions.back().IsTailCall()) {
+            return;
+        }
+
         MInstruction mirReturn{MInstruction::OpType::kRet};
         if (!returnInstr->HasReturnValue()) {
             basicBlock->AddInstruction(mirReturn);
@@ -770,6 +1307,8 @@ private:
             genMFromIRCompareInstr(compareInstr, basicBlock);
         } else if (auto* castInstr = dynamic_cast<ir::CastInstruction*>(instruction)) {
             genMFromIRCastInstr(castInstr, basicBlock);
+        } else if (auto* selectInstr = dynamic_cast<ir::SelectInstruction*>(instruction)) {
+            genMFromIRSelectInstr(selectInstr, basicBlock);
         } else if (auto* storeInstr = dynamic_cast<ir::StoreInstruction*>(instruction)) {
             genMFromIRStoreInstr(storeInstr, basicBlock);
         }else if (auto* loadInstr = dynamic_cast<ir::LoadInstruction*>(instruction)) {
@@ -779,13 +1318,13 @@ private:
         } else if (auto* memCopyInstr = dynamic_cast<ir::MemoryCopyInstruction*>(instruction)) {
             genMFromIRMemCopyInstr(memCopyInstr, basicBlock);
         } else if (auto* memSetInstr = dynamic_cast<ir::MemorySetInstruction*>(instruction)) {
-            ANCL_CRITICAL("MachineIR: Memset is not implemented :(");
+            genMFromIRMemSetInstr(memSetInstr, basicBlock);
         } else if (auto* phiInstr = dynamic_cast<ir::PhiInstruction*>(instruction)) {
             genMFromIRPhiInstr(phiInstr, basicBlock);
         } else if (auto* branchInstr = dynamic_cast<ir::BranchInstruction*>(instruction)) {
             genMFromIRBranchInstr(branchInstr, basicBlock);
         } else if (auto* switchInstr = dynamic_cast<ir::SwitchInstruction*>(instruction)) {
-            // genMFromIRSwitchInstr(switchInstr, basicBlock);
+            genMFromIRSwitchInstr(switchInstr, basicBlock);
         } else if (auto* callInstr = dynamic_cast<ir::CallInstruction*>(instruction)) {
             genMFromIRCallInstr(callInstr, basicBlock);
         } else if (auto* returnInstr = dynamic_cast<ir::ReturnInstruction*>(instruction)) {
@@ -915,6 +1454,7 @@ private:
 
         m_MBBMap.clear();
         m_IRValueToVReg.clear();
+        m_JumpTables.clear();
 
         auto mirFunctionScope = CreateScope<MFunction>(irFunction->GetName());
         MFunction* mirFunction = mirFunctionScope.get();
@@ -928,6 +1468,7 @@ private:
 
         updateMIRFunctionParameters(irFunction, mirFunction);
 
+        // Switch lowering rewires the edges of its targets, so all of them are linked first
         for (ir::BasicBlock* basicBlock : irFunction->GetBasicBlocks()) {
             MBasicBlock* mirBasicBlock = m_MBBMap[basicBlock->GetName()];
 
@@ -937,6 +1478,10 @@ private:
             for (ir::BasicBlock* successor : basicBlock->GetSuccessors()) {
                 mirBasicBlock->AddSuccessor(m_MBBMap[successor->GetName()]);
             }
+        }
+
+        for (ir::BasicBlock* basicBlock : irFunction->GetBasicBlocks()) {
+            MBasicBlock* mirBasicBlock = m_MBBMap[basicBlock->GetName()];
 
             for (ir::Instruction* instruction : basicBlock->GetInstructions()) {
                 genMFromIRInstruction(instruction, mirBasicBlock);
@@ -952,6 +1497,18 @@ private:
             mirBlock->SetName(std::format("{}.{}", mirFunction->GetName(), mirBlock->GetName()));
         }
 
+        // Entries need the final names of the blocks
+        for (const JumpTable& jumpTable : m_JumpTables) {
+            GlobalDataArea globalDataArea{jumpTable.Label};
+            globalDataArea.SetConst();
+            globalDataArea.SetLocal();
+            for (MBasicBlock* target : jumpTable.Targets) {
+                globalDataArea.AddLabelSlot(kJumpTableEntrySize,
+                                            std::format(".{} - {}", target->GetName(), jumpTable.Label));
+            }
+            m_MIRProgram.AddGlobalDataArea(globalDataArea);
+        }
+
         return mirFunctionScope;
     }
 
@@ -1076,6 +1633,8 @@ private:
     std::unordered_map<std::string, std::string> m_FloatLabelNumbers;
 
     std::unordered_map<std::string, MBasicBlock*> m_MBBMap;
+
+    std::vector<JumpTable> m_JumpTables;
 };
 
 }  // namespace gen
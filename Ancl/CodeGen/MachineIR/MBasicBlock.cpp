@@ -32,6 +32,10 @@ std::vector<MBasicBlock*> MBasicBlock::GetSuccessors() const {
     return m_Successors;
 }
 
+void MBasicBlock::ClearSuccessors() {
+    m_Successors.clear();
+}
+
 void MBasicBlock::AddPredecessor(MBasicBlock* block) {
     m_Predecessors.push_back(block);
 }
@@ -40,6 +44,15 @@ std::vector<MBasicBlock*> MBasicBlock::GetPredecessors() const {
     return m_Predecessors;
 }
 
+void MBasicBlock::ReplacePredecessor(MBasicBlock* fromBlock, MBasicBlock* toBlock) {
+    for (MBasicBlock*& predecessor : m_Predecessors) {
+        if (predecessor == fromBlock) {
+            predecessor = toBlock;
+            return;
+        }
+    }
+}
+
 size_t MBasicBlock::GetPredecessorsNumber() const {
     return m_Predecessors.size();
 }
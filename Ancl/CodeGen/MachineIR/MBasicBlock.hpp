@@ -24,10 +24,14 @@ public:
 
     void AddSuccessor(MBasicBlock* block);
     std::vector<MBasicBlock*> GetSuccessors() const;
+    void ClearSuccessors();
 
     void AddPredecessor(MBasicBlock* block);
     std::vector<MBasicBlock*> GetPredecessors() const;
 
+    // Keeps the index of the predecessor, the phi operands stay in order
+    void ReplacePredecessor(MBasicBlock* fromBlock, MBasicBlock* toBlock);
+
     size_t GetPredecessorsNumber() const;
     MBasicBlock* GetPredecessor(size_t index) const;
 
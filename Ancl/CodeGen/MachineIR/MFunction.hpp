@@ -1,5 +1,7 @@
 #pragma once
 
+#include <iterator>
+#include <list>
 #include <string>
 #include <vector>
 
@@ -36,6 +38,14 @@ public:
         m_BasicBlocks.push_back(std::move(MBB));
     }
 
+    MBasicBlock* InsertBasicBlockAfter(MBasicBlock* afterBlock, TScopePtr<MBasicBlock> MBB) {
+        auto it = m_BasicBlocks.begin();
+        while (it->get() != afterBlock) {
+            ++it;
+        }
+        return m_BasicBlocks.insert(std::next(it), std::move(MBB))->get();
+    }
+
     MBasicBlock* GetBasicBlock(size_t idx) {
         return m_BasicBlocks[idx].get();
     }
@@ -52,6 +62,19 @@ public:
         return m_BasicBlocks.back().get();
     }
 
+    // Blocks that leave the function with a return or a tail call
+    std::vector<MBasicBlock*> GetExitBasicBlocks() {
+        std::vector<MBasicBlock*> exitBlocks;
+        for (auto& basicBlock : m_BasicBlocks) {
+            std::list<MInstruction>& instructions = basicBlock->GetInstructions();
+            if (!instructions.empty() &&
+                    (instructions.back().IsReturn() || instructions.back().IsTailCall())) {
+                exitBlocks.push_back(basicBlock.get());
+            }
+        }
+        return exitBlocks;
+    }
+
     LocalDataArea& GetLocalDataArea() {
         return m_LocalDataArea;
     }
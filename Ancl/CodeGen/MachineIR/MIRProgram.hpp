@@ -29,6 +29,10 @@ public:
         return m_Functions;
     }
 
+    void ClearFunctions() {
+        m_Functions.clear();
+    }
+
     MFunction* GetLastFunction() {
         auto& function = m_Functions.back();
         return function.get();
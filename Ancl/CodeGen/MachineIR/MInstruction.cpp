@@ -79,6 +79,8 @@ std::string MInstruction::GetOpTypeString() const {
             return "XOR";
         case OpType::kOr:
             return "OR";
+        case OpType::kSelect:
+            return "SELECT";
         case OpType::kITrunc:
             return "ITRUNC";
         case OpType::kFTrunc:
@@ -99,6 +101,8 @@ std::string MInstruction::GetOpTypeString() const {
             return "SITOF";
         case OpType::kCall:
             return "CALL";
+        case OpType::kTailCall:
+            return "TAILCALL";
         case OpType::kJump:
             return "JUMP";
         case OpType::kBranch:
@@ -113,6 +117,8 @@ std::string MInstruction::GetOpTypeString() const {
             return "LOAD";
         case OpType::kStore:
             return "STORE";
+        case OpType::kMemSet:
+            return "MEMSET";
         case OpType::kStackAddress:
             return "STACKADDR";
         case OpType::kGlobalAddress:
@@ -138,6 +144,10 @@ bool MInstruction::IsCall() const {
     return m_OpType == OpType::kCall;
 }
 
+bool MInstruction::IsTailCall() const {
+    return m_OpType == OpType::kTailCall;
+}
+
 bool MInstruction::IsReturn() const {
     return m_OpType == OpType::kRet;
 }
@@ -151,7 +161,7 @@ bool MInstruction::IsBranch() const {
 }
 
 bool MInstruction::IsTerminator() const {
-    return IsJump() || IsBranch() || IsReturn();
+    return IsJump() || IsBranch() || IsReturn() || IsTailCall();
 }
 
 bool MInstruction::IsStore() const {
@@ -175,7 +185,7 @@ bool MInstruction::IsMemberAddress() const {
 }
 
 bool MInstruction::IsCmp() const {
-    return m_OpType == OpType::kCmp;
+    return m_OpType == OpType::kCmp || m_OpType == OpType::kUCmp;
 }
 
 bool MInstruction::IsMov() const {
@@ -316,7 +326,7 @@ void MInstruction::Undefine() {
 }
 
 bool MInstruction::IsDefinition() const {
-    return !IsReturn() && !IsJump() && !IsBranch() && !IsStore() &&
+    return !IsReturn() && !IsTailCall() && !IsJump() && !IsBranch() && !IsStore() &&
             !IsPush() && !IsPop() && m_IsDefinition; 
 }
 
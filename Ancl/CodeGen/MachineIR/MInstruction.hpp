@@ -23,17 +23,19 @@ public:
         kAnd, kXor, kOr,
 
         kCmp, kUCmp, kFCmp,
+        kSelect,
 
         kITrunc, kFTrunc,
         kZExt, kSExt, kFExt,
         kFToUI, kFToSI,
         kUIToF, kSIToF,
 
-        kCall, kJump, kBranch, kRet,
+        kCall, kTailCall, kJump, kBranch, kRet,
 
         kMov, kFMov,
 
         kLoad, kStore,
+        kMemSet,
         kStackAddress, kGlobalAddress,
         kMemberAddress,
 
@@ -62,6 +64,7 @@ public:
     std::string GetOpTypeString() const;
 
     bool IsCall() const;
+    bool IsTailCall() const;
     bool IsReturn() const;
     bool IsJump() const;
     bool IsBranch() const;
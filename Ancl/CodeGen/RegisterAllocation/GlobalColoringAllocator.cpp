@@ -406,7 +406,6 @@ bool GlobalColoringAllocator::RenameAndSpill() {
         }
 
         MBasicBlock* firstBlock = m_Function.GetFirstBasicBlock();
-        MBasicBlock* lastBlock = m_Function.GetLastBasicBlock();
         if (m_CalleeSavedSpillSet.contains(calleeSavedReg.GetNumber())) {
             LocalDataArea& localData = m_Function.GetLocalDataArea();
             localData.HandleNewSpilledCalleeSaved();
@@ -419,7 +418,9 @@ bool GlobalColoringAllocator::RenameAndSpill() {
             MInstruction popReg(MInstruction::OpType::kPop);
             popReg.AddPhysicalRegister(calleeSavedReg);
             MInstruction targetPopReg = InstructionSelector::SelectInstruction(popReg, m_TargetMachine);
-            lastBlock->InsertBeforeLastInstruction(targetPopReg);
+            for (MBasicBlock* exitBlock : m_Function.GetExitBasicBlocks()) {
+                exitBlock->InsertBeforeLastInstruction(targetPopReg);
+            }
         }
     }
 
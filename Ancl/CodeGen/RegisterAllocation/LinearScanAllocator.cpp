@@ -370,8 +370,7 @@ void LinearScanAllocator::spillPhysicalRegisters() {
     // For now we rely on the fact that the callee saved LRs are spilled before the virtual LRs
     // TODO: Handle spilling of other physical Live Ranges
     MBasicBlock* firstBlock = m_Function.GetFirstBasicBlock();
-    MBasicBlock* lastBlock = m_Function.GetLastBasicBlock();
-    assert(lastBlock->GetLastInstruction()->IsReturn());
+    std::vector<MBasicBlock*> exitBlocks = m_Function.GetExitBasicBlocks();
 
     for (target::Register& reg : m_PRegisterSpills) {
         uint64_t regNumber = reg.GetNumber();
@@ -390,7 +389,9 @@ void LinearScanAllocator::spillPhysicalRegisters() {
         // MInstruction loadInstr{MInstruction::OpType::kLoad};
         // loadInstr.AddPhysicalRegister(reg);
         // loadInstr.AddStackIndex(regNumber);
-        lastBlock->InsertBeforeLastInstruction(targetPopReg);
+        for (MBasicBlock* exitBlock : exitBlocks) {
+            exitBlock->InsertBeforeLastInstruction(targetPopReg);
+        }
     }
 }
 
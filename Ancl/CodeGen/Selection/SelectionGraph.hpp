@@ -117,7 +117,7 @@ private:
             TContext currentContext;
             for (MInstruction& instruction : basicBlock->GetInstructions()) {
                 // Separate call and PR copies
-                if (instruction.IsCall() || instruction.IsMov()) {
+                if (instruction.IsCall() || instruction.IsTailCall() || instruction.IsMov()) {
                     contexts.push_back(currentContext);
                     contexts.push_back({instruction});
                     currentContext.clear();
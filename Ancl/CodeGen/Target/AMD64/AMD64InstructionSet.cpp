@@ -28,6 +28,7 @@ void AMD64InstructionSet::initInstructionsMap() {
 
         {IMUL_RR,  {grOp, grOp}, "imul"}, {IMUL_RM, {grOp, memOp}, "imul"},
         {IMUL_RRI, {grOp, grOp, immOp}, "imul"}, {IMUL_RMI, {grOp, memOp, immOp}, "imul"},
+        {IMUL_R,   {grOp}, "imul"}, {MUL_R, {grOp}, "mul"},
 
         {MULSS_RR,  {frOp, frOp},  "mulss"}, {MULSS_RM,  {frOp, memOp}, "mulss"},
         {MULSD_RR,  {frOp, frOp},  "mulsd"}, {MULSD_RM,  {frOp, memOp}, "mulsd"},
@@ -82,6 +83,12 @@ void AMD64InstructionSet::initInstructionsMap() {
         {SETB,  {grOp}, "setb"}, {SETBE, {grOp}, "setbe"},
         {SETA,  {grOp}, "seta"}, {SETAE, {grOp}, "setae"},
 
+        {CMOVE,  {grOp, grOp}, "cmove"},  {CMOVNE, {grOp, grOp}, "cmovne"},
+        {CMOVL,  {grOp, grOp}, "cmovl"},  {CMOVLE, {grOp, grOp}, "cmovle"},
+        {CMOVG,  {grOp, grOp}, "cmovg"},  {CMOVGE, {grOp, grOp}, "cmovge"},
+        {CMOVB,  {grOp, grOp}, "cmovb"},  {CMOVBE, {grOp, grOp}, "cmovbe"},
+        {CMOVA,  {grOp, grOp}, "cmova"},  {CMOVAE, {grOp, grOp}, "cmovae"},
+
         {MOVZX_RR, {grOp, grOp},  "movz"}, {MOVZX_RM, {grOp, memOp}, "movz"},
 
         {CDQ, {}, "cdq"}, {CQO, {}, "cqo"},
@@ -121,6 +128,8 @@ void AMD64InstructionSet::initInstructionsMap() {
 
         {LEA, {grOp, memOp}, "lea"},
 
+        {REP_STOSB, {}, "rep stosb"}, {REP_STOSQ, {}, "rep stosq"},
+
         {PUSH_R, {grOp}, "push"}, {PUSH_M, {memOp}, "push"}, {PUSH_I, {immOp}, "push"},
 
         {POP_R, {grOp}, "pop"}, {POP_M, {memOp}, "pop"}
@@ -155,6 +164,10 @@ void AMD64InstructionSet::initInstructionsMap() {
         XOR_RR, XOR_RM, XOR_RI,
 
         OR_RR, OR_RM, OR_RI,
+
+        CMOVE, CMOVNE,
+        CMOVL, CMOVLE, CMOVG, CMOVGE,
+        CMOVB, CMOVBE, CMOVA, CMOVAE,
     };
 
     for (TargetInstruction& instr : instructions) {
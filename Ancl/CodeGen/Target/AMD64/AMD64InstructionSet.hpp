@@ -26,8 +26,9 @@ public:
         INVALID = 0,
 
         // felixcloutier.com/x86/imul
-        // TODO: IMUL R/M with implicit AX register?
+        // felixcloutier.com/x86/mul
         IMUL_RR, IMUL_RM, IMUL_RRI, IMUL_RMI,
+        IMUL_R, MUL_R,  // DX:AX = AX * reg
 
         // felixcloutier.com/x86/mulss
         // felixcloutier.com/x86/mulsd
@@ -83,6 +84,11 @@ public:
         SETL, SETLE, SETG, SETGE,  // signed integer
         SETB, SETBE, SETA, SETAE,  // unsigned integer or float
 
+        // felixcloutier.com/x86/cmovcc
+        CMOVE, CMOVNE,
+        CMOVL, CMOVLE, CMOVG, CMOVGE,  // signed integer
+        CMOVB, CMOVBE, CMOVA, CMOVAE,  // unsigned integer
+
         // felixcloutier.com/x86/movzx
         // TODO: from 8->64 to 8->32 
         MOVZX_RR, MOVZX_RM,
@@ -134,6 +140,10 @@ public:
         // felixcloutier.com/x86/lea
         LEA,
 
+        // felixcloutier.com/x86/rep:repe:repz:repne:repnz
+        // felixcloutier.com/x86/stos:stosb:stosw:stosd:stosq
+        REP_STOSB, REP_STOSQ,
+
         // felixcloutier.com/x86/push
         PUSH_R, PUSH_M, PUSH_I,
 
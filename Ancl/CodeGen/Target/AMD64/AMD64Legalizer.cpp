@@ -30,7 +30,9 @@ bool AMD64Legalizer::IsLegalizationRequired(SelectionNode* node) {
         case MInstruction::OpType::kOr:
         case MInstruction::OpType::kCmp:
         case MInstruction::OpType::kUCmp:
+        case MInstruction::OpType::kSelect:
         case MInstruction::OpType::kZExt:
+        case MInstruction::OpType::kMemSet:
             return true;
 
         default:
@@ -113,6 +115,26 @@ void AMD64Legalizer::LegalizeCmp(SelectionNode* node) {
     materializeLeftImmediate(node);
 }
 
+void AMD64Legalizer::LegalizeSelect(SelectionNode* node) {
+    // CMOV moves only from a register, the false value is copied to the result first
+    MInstruction instruction = node->GetInstruction();
+
+    MInstruction newInstruction{instruction.GetOpType()};
+    newInstruction.SetBasicBlock(instruction.GetBasicBlock());
+    newInstruction.AddOperand(*instruction.GetDefinition());
+
+    for (size_t i = 0; i < instruction.GetUsesNumber(); ++i) {
+        MInstruction::TOperandIt use = instruction.GetUse(i);
+        if (use->IsImmediate()) {
+            newInstruction.AddOperand(materializeImmediate(*use, node));
+        } else {
+            newInstruction.AddOperand(*use);
+        }
+    }
+
+    node->SetInstruction(newInstruction);
+}
+
 void AMD64Legalizer::LegalizeZExt(SelectionNode* node) {
     MInstruction& instruction = node->GetInstructionRef();
     MInstruction::TOperandIt fromOperand = instruction.GetUse(0);
@@ -151,8 +173,58 @@ void AMD64Legalizer::LegalizeZExt(SelectionNode* node) {
     *toOperand = tempRegister;
 }
 
+void AMD64Legalizer::LegalizeMemSet(SelectionNode* node) {
+    /*
+        MemSet address value count
+        --------------------------
+        MOV RDI address
+        MOV AL/RAX value
+        MOV RCX count
+        REP STOSB/STOSQ
+    */
+
+    MInstruction& instruction = node->GetInstructionRef();
+    MInstruction::TOperandIt addressOperand = instruction.GetUse(0);
+    MInstruction::TOperandIt valueOperand = instruction.GetUse(1);
+    MInstruction::TOperandIt countOperand = instruction.GetUse(2);
+
+    auto axRegNumber = AMD64RegisterSet::AL;
+    if (valueOperand->GetType().GetBytes() == 8) {
+        axRegNumber = AMD64RegisterSet::RAX;
+    }
+
+    target::RegisterSet* registers = m_TargetMachine->GetRegisterSet();
+    target::Register diReg = registers->GetRegister(AMD64RegisterSet::RDI);
+    target::Register axReg = registers->GetRegister(axRegNumber);
+    target::Register cxReg = registers->GetRegister(AMD64RegisterSet::RCX);
+
+    MBasicBlock* basicBlock = instruction.GetBasicBlock();
+    node->AddPrologueInstruction(createMovToRegister(diReg, *addressOperand, basicBlock));
+    node->AddPrologueInstruction(createMovToRegister(axReg, *valueOperand, basicBlock));
+    node->AddPrologueInstruction(createMovToRegister(cxReg, *countOperand, basicBlock));
+
+    MInstruction newInstruction{instruction.GetOpType()};
+    newInstruction.SetBasicBlock(basicBlock);
+
+    // The width of the stored value selects the instruction
+    newInstruction.AddPhysicalRegister(axReg);
+    newInstruction.Undefine();
+
+    newInstruction.AddImplicitRegDefinition(diReg);
+    newInstruction.AddImplicitRegDefinition(cxReg);
+    newInstruction.AddImplicitRegUse(diReg);
+    newInstruction.AddImplicitRegUse(cxReg);
+    newInstruction.AddImplicitRegUse(registers->GetRegister(AMD64RegisterSet::RAX));
+
+    node->SetInstruction(newInstruction);
+}
+
 void AMD64Legalizer::legalizeDivRem(SelectionNode* node, bool isRem) {
     MInstruction& instruction = node->GetInstructionRef();
+    if (isDivisionByConstant(instruction)) {
+        return;
+    }
+
     MInstruction::TOperandIt resOperand = instruction.GetDefinition();
     MInstruction::TOperandIt dividendOperand = instruction.GetUse(0);
     MInstruction::TOperandIt divisorOperand = instruction.GetUse(1);
@@ -221,6 +293,30 @@ void AMD64Legalizer::legalizeDivRem(SelectionNode* node, bool isRem) {
     node->SetInstruction(newInstruction);
 }
 
+// These are selected as multiplications by the reciprocal without DIV,
+// the division by zero is left to trap at runtime
+bool AMD64Legalizer::isDivisionByConstant(MInstruction& instruction) {
+    MInstruction::TOperandIt dividendOperand = instruction.GetUse(0);
+    MInstruction::TOperandIt divisorOperand = instruction.GetUse(1);
+    if (dividendOperand->IsImmediate() || !divisorOperand->IsImmInteger()) {
+        return false;
+    }
+
+    uint64_t bytes = instruction.GetDefinition()->GetType().GetBytes();
+    if (bytes != 4 && bytes != 8) {
+        return false;
+    }
+
+    MInstruction::OpType opType = instruction.GetOpType();
+    bool isSigned = (opType == MInstruction::OpType::kSDiv || opType == MInstruction::OpType::kSRem);
+
+    int64_t divisor = divisorOperand->GetImmInteger();
+    if (bytes == 4) {
+        divisor = isSigned ? static_cast<int32_t>(divisor) : static_cast<uint32_t>(divisor);
+    }
+    return divisor != 0 && divisor != 1 && !(isSigned && divisor == -1);
+}
+
 void AMD64Legalizer::moveImmediateToEnd(SelectionNode* node) {
     MInstruction instruction = node->GetInstruction();
 
@@ -279,4 +375,24 @@ MOperand AMD64Legalizer::materializeImmediate(const MOperand& operand, Selection
     return vreg;
 }
 
+MInstruction AMD64Legalizer::createMovToRegister(target::Register reg, const MOperand& operand,
+                                                 MBasicBlock* basicBlock) {
+    target::RegisterSet* registers = m_TargetMachine->GetRegisterSet();
+
+    MInstruction movInstruction{MInstruction::OpType::kMov};
+    movInstruction.SetBasicBlock(basicBlock);
+    movInstruction.SetInstructionClass(registers->GetRegisterClass(reg));
+
+    movInstruction.AddPhysicalRegister(reg);
+    movInstruction.AddOperand(operand);
+
+    if (operand.IsImmediate()) {
+        movInstruction.SetTargetInstructionCode(AMD64InstructionSet::MOV_RI);
+    } else {
+        movInstruction.SetTargetInstructionCode(AMD64InstructionSet::MOV_RR);
+    }
+
+    return movInstruction;
+}
+
 }  // namespace gen::target::amd64
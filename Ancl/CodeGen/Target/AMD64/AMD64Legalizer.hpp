@@ -22,15 +22,20 @@ public:
     void LegalizeXor(SelectionNode* node) override;
     void LegalizeOr(SelectionNode* node) override;
     void LegalizeCmp(SelectionNode* node) override;
+    void LegalizeSelect(SelectionNode* node) override;
     void LegalizeZExt(SelectionNode* node) override;
+    void LegalizeMemSet(SelectionNode* node) override;
 
 private:
     void legalizeDivRem(SelectionNode* node, bool isRem = false);
+    bool isDivisionByConstant(MInstruction& instruction);
 
     void moveImmediateToEnd(SelectionNode* node);
     void materializeLeftImmediate(SelectionNode* node);
 
     MOperand materializeImmediate(const MOperand& operand, SelectionNode* node);
+
+    MInstruction createMovToRegister(target::Register reg, const MOperand& operand, MBasicBlock* basicBlock);
 };
 
 }  // namespace gen::target::amd64
@@ -1,5 +1,118 @@
 #include <Ancl/CodeGen/Target/AMD64/AMD64Machine.hpp>
 
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#include <Ancl/CodeGen/MachineIR/MFunction.hpp>
+
+
+namespace {
+
+struct SignedMagic {
+    int64_t Multiplier;
+    uint64_t Shift;
+};
+
+struct UnsignedMagic {
+    uint64_t Multiplier;
+    uint64_t Shift;
+    bool IsAdd;
+};
+
+// Hacker's Delight 10-1: x / d = (mulhs(x, M) +- x) >> s, the sign of M differs from
+// the sign of d when M does not fit, one is added to the negative quotients
+template <typename TUnsigned>
+SignedMagic getSignedMagic(int64_t divisor) {
+    constexpr uint64_t bitsNumber = sizeof(TUnsigned) * 8;
+    constexpr TUnsigned signBit = TUnsigned(1) << (bitsNumber - 1);
+
+    auto d = static_cast<TUnsigned>(divisor);
+    TUnsigned absD = divisor < 0 ? TUnsigned(0) - d : d;
+    TUnsigned t = signBit + (d >> (bitsNumber - 1));
+    TUnsigned absNc = t - 1 - t % absD;
+
+    uint64_t p = bitsNumber - 1;
+    TUnsigned q1 = signBit / absNc;
+    TUnsigned r1 = signBit - q1 * absNc;
+    TUnsigned q2 = signBit / absD;
+    TUnsigned r2 = signBit - q2 * absD;
+    TUnsigned delta = 0;
+    do {
+        ++p;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= absNc) {
+            ++q1;
+            r1 -= absNc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= absD) {
+            ++q2;
+            r2 -= absD;
+        }
+        delta = absD - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    TUnsigned multiplier = q2 + 1;
+    if (divisor < 0) {
+        multiplier = TUnsigned(0) - multiplier;
+    }
+    return {static_cast<std::make_signed_t<TUnsigned>>(multiplier), p - bitsNumber};
+}
+
+// Hacker's Delight 10-8: x / d = mulhu(x, M) >> s, when M needs one more bit
+// than the type, x / d = (((x - hi) >> 1) + hi) >> (s - 1) with hi = mulhu(x, M - 2^N)
+template <typename TUnsigned>
+UnsignedMagic getUnsignedMagic(TUnsigned d) {
+    constexpr uint64_t bitsNumber = sizeof(TUnsigned) * 8;
+    constexpr TUnsigned signBit = TUnsigned(1) << (bitsNumber - 1);
+    constexpr TUnsigned maxSigned = signBit - 1;
+
+    bool isAdd = false;
+    bool isGreater = false;
+    TUnsigned nc = TUnsigned(~TUnsigned(0)) - TUnsigned(TUnsigned(0) - d) % d;
+
+    uint64_t p = bitsNumber - 1;
+    TUnsigned q1 = signBit / nc;
+    TUnsigned r1 = signBit - q1 * nc;
+    TUnsigned q2 = maxSigned / d;
+    TUnsigned r2 = maxSigned - q2 * d;
+    TUnsigned delta = 0;
+    do {
+        ++p;
+        if (q1 >= signBit) {
+            isGreater = true;
+        }
+        if (r1 >= nc - r1) {
+            q1 = 2 * q1 + 1;
+            r1 = 2 * r1 - nc;
+        } else {
+            q1 = 2 * q1;
+            r1 = 2 * r1;
+        }
+        if (r2 + 1 >= d - r2) {
+            if (q2 >= maxSigned) {
+                isAdd = true;
+            }
+            q2 = 2 * q2 + 1;
+            r2 = 2 * r2 + 1 - d;
+        } else {
+            if (q2 >= signBit) {
+                isAdd = true;
+            }
+            q2 = 2 * q2;
+            r2 = 2 * r2 + 1;
+        }
+        delta = d - 1 - r2;
+    } while (!isGreater && p < 2 * bitsNumber && (q1 < delta || (q1 == delta && r1 == 0)));
+
+    return {static_cast<uint64_t>(TUnsigned(q2 + 1)), p - bitsNumber, isAdd};
+}
+
+}  // namespace
+
 
 namespace gen::target::amd64 {
 
@@ -72,6 +185,9 @@ void AMD64TargetMachine::selectNode(SelectionNode* node) {
         case MInstruction::OpType::kFCmp:
             return selectCmp(node);
 
+        case MInstruction::OpType::kSelect:
+            return selectSelect(node);
+
         case MInstruction::OpType::kITrunc:
             return selectITrunc(node);
         case MInstruction::OpType::kFTrunc:
@@ -93,6 +209,8 @@ void AMD64TargetMachine::selectNode(SelectionNode* node) {
 
         case MInstruction::OpType::kCall:
             return selectCall(node);
+        case MInstruction::OpType::kTailCall:
+            return selectTailCall(node);
         case MInstruction::OpType::kJump:
             return selectJump(node);
         case MInstruction::OpType::kBranch:
@@ -109,6 +227,8 @@ void AMD64TargetMachine::selectNode(SelectionNode* node) {
             return selectLoad(node);
         case MInstruction::OpType::kStore:
             return selectStore(node);
+        case MInstruction::OpType::kMemSet:
+            return selectMemSet(node);
 
         case MInstruction::OpType::kStackAddress:
             return selectStackAddress(node);
@@ -258,6 +378,11 @@ void AMD64TargetMachine::finalizeSelect(SelectionNode* node,
 }
 
 void AMD64TargetMachine::selectMul(SelectionNode* node) {
+    std::vector<MInstruction> reducedInstructions;
+    if (selectMulByConstant(node, reducedInstructions)) {
+        return finalizeSelect(node, reducedInstructions);
+    }
+
     MInstruction instruction = node->GetInstruction();
     MInstruction::TOperandIt defOperand = instruction.GetDefinition();
 
@@ -377,6 +502,10 @@ void AMD64TargetMachine::selectSDivImpl(SelectionNode* node) {
     // NB: There are still two nodes here. Operand corresponds to the second node
 
     MInstruction instruction = node->GetInstruction();
+    if (instruction.IsDefinition()) {  // The legalizer keeps the constant divisors
+        return selectDivRemByConstant(node);
+    }
+
     MInstruction::TOperandIt divOperand = instruction.GetOperand(0);
 
     std::vector<MInstruction> targetInstructions;
@@ -427,6 +556,10 @@ void AMD64TargetMachine::selectUDivImpl(SelectionNode* node) {
     // NB: There are still two nodes here. Operand corresponds to the second node
 
     MInstruction instruction = node->GetInstruction();
+    if (instruction.IsDefinition()) {  // The legalizer keeps the constant divisors
+        return selectDivRemByConstant(node);
+    }
+
     MInstruction::TOperandIt divOperand = instruction.GetOperand(0);
 
     std::vector<MInstruction> targetInstructions;
@@ -474,6 +607,329 @@ void AMD64TargetMachine::selectUDiv(SelectionNode* node) {
     selectUDivImpl(node);
 }
 
+// IMUL takes 3 cycles, LEA and the shifts take one
+bool AMD64TargetMachine::selectMulByConstant(SelectionNode* node,
+                                             std::vector<MInstruction>& targetInstructions) {
+    MInstruction instruction = node->GetInstruction();
+    MOperand result = *instruction.GetDefinition();
+    MOperand multiplicand = *instruction.GetUse(0);
+    MOperand factorOperand = *instruction.GetUse(1);
+
+    // The loaded multiplicand is folded into IMUL
+    SelectionNode* child = node->GetChild(0);
+    unsigned int instrClass = result.GetRegisterClass();
+    if (!factorOperand.IsImmInteger() || multiplicand.IsImmediate() || (child && child->GetInstruction().IsLoad()) ||
+            (instrClass != GR32 && instrClass != GR64)) {
+        return false;
+    }
+
+    int64_t factor = factorOperand.GetImmInteger();
+    if (factor < 3) {
+        return false;
+    }
+
+    uint64_t bitsNumber = result.GetType().GetBytes() * 8;
+    MBasicBlock* basicBlock = instruction.GetBasicBlock();
+
+    auto getLeaScale = [](int64_t factor) -> int64_t {
+        return (factor == 3 || factor == 5 || factor == 9) ? factor - 1 : 0;
+    };
+    auto createLea = [this, basicBlock](const MOperand& definition, const MOperand& operand, int64_t scale) {
+        return createTargetInstruction(MInstruction::OpType::kMul, AMD64InstructionSet::LEA, basicBlock,
+                                       {definition, operand, MOperand::CreateImmInteger(scale),
+                                        operand, MOperand::CreateImmInteger(0)});
+    };
+
+    // x * 3 = [x + x * 2]
+    if (int64_t scale = getLeaScale(factor)) {
+        targetInstructions.push_back(createLea(result, multiplicand, scale));
+        return true;
+    }
+
+    // x * 12 = [x + x * 2] << 2, x * 45 = [y + y * 4], y = [x + x * 8]
+    for (int64_t leaFactor : {3, 5, 9}) {
+        if (factor % leaFactor != 0) {
+            continue;
+        }
+
+        int64_t restFactor = factor / leaFactor;
+        int64_t restScale = getLeaScale(restFactor);
+        bool isShift = std::has_single_bit(static_cast<uint64_t>(restFactor));
+        if (!restScale && !isShift) {
+            continue;
+        }
+
+        MOperand scaled = createVirtualRegister(node, result);
+        targetInstructions.push_back(createLea(scaled, multiplicand, leaFactor - 1));
+        if (restScale) {
+            targetInstructions.push_back(createLea(result, scaled, restScale));
+        } else {
+            auto shift = MOperand::CreateImmInteger(std::countr_zero(static_cast<uint64_t>(restFactor)));
+            targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kShiftL,
+                                         AMD64InstructionSet::SHL_RI, basicBlock, {result, scaled, shift}));
+        }
+        return true;
+    }
+
+    // x * (2^k + 1) = (x << k) + x, x * (2^k - 1) = (x << k) - x
+    auto unsignedFactor = static_cast<uint64_t>(factor);
+    bool isAdd = std::has_single_bit(unsignedFactor - 1);
+    if (!isAdd && !std::has_single_bit(unsignedFactor + 1)) {
+        return false;
+    }
+
+    uint64_t shift = std::countr_zero(isAdd ? unsignedFactor - 1 : unsignedFactor + 1);
+    if (shift >= bitsNumber) {
+        return false;
+    }
+
+    MOperand shifted = createVirtualRegister(node, result);
+    targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kShiftL, AMD64InstructionSet::SHL_RI,
+                                 basicBlock, {shifted, multiplicand, MOperand::CreateImmInteger(shift)}));
+    if (isAdd) {
+        targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR,
+                                     basicBlock, {result, shifted, multiplicand}));
+    } else {
+        targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kSub, AMD64InstructionSet::SUB_RR,
+                                     basicBlock, {result, shifted, multiplicand}));
+    }
+    return true;
+}
+
+void AMD64TargetMachine::selectDivRemByConstant(SelectionNode* node) {
+    /*
+        SDiv/UDiv res x imm
+        -------------------
+        MOV AX magic
+        IMUL/MUL x
+        MOV hi DX
+        fixups and shifts of hi
+
+        SRem/URem res x imm: res = x - (x / imm) * imm
+    */
+
+    MInstruction instruction = node->GetInstruction();
+    MOperand result = *instruction.GetDefinition();
+    MOperand dividend = *instruction.GetUse(0);
+    int64_t divisor = instruction.GetUse(1)->GetImmInteger();
+    MBasicBlock* basicBlock = instruction.GetBasicBlock();
+
+    MInstruction::OpType opType = instruction.GetOpType();
+    bool isSigned = (opType == MInstruction::OpType::kSDiv || opType == MInstruction::OpType::kSRem);
+    bool isRem = (opType == MInstruction::OpType::kSRem || opType == MInstruction::OpType::kURem);
+
+    bool isDoubleWord = result.GetType().GetBytes() == 4;
+    if (isDoubleWord) {
+        divisor = isSigned ? static_cast<int32_t>(divisor) : static_cast<uint32_t>(divisor);
+    }
+
+    std::vector<MInstruction> targetInstructions;
+
+    MOperand quotient = isRem ? createVirtualRegister(node, result) : result;
+    if (isSigned) {
+        selectSignedDivByConstant(node, dividend, divisor, quotient, targetInstructions);
+    } else {
+        selectUnsignedDivByConstant(node, dividend, divisor, quotient, targetInstructions);
+    }
+
+    if (isRem) {
+        MOperand product = createVirtualRegister(node, result);
+
+        auto unsignedDivisor = static_cast<uint64_t>(divisor);
+        if (std::has_single_bit(unsignedDivisor) && (!isSigned || divisor > 0)) {
+            auto shift = MOperand::CreateImmInteger(std::countr_zero(unsignedDivisor));
+            targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kShiftL,
+                                         AMD64InstructionSet::SHL_RI, basicBlock, {product, quotient, shift}));
+        } else if (isDoubleWord || divisor == static_cast<int32_t>(divisor)) {
+            // The low half of the product does not depend on the signedness
+            auto factor = MOperand::CreateImmInteger(static_cast<int32_t>(divisor));
+            targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kMul,
+                                         AMD64InstructionSet::IMUL_RRI, basicBlock, {product, quotient, factor}));
+        } else {
+            MOperand factor = createVirtualRegister(node, result);
+            targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kMov,
+                                         AMD64InstructionSet::MOV_RI, basicBlock,
+                                         {factor, MOperand::CreateImmInteger(divisor)}));
+            targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kMul,
+                                         AMD64InstructionSet::IMUL_RR, basicBlock, {product, quotient, factor}));
+        }
+
+        targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kSub, AMD64InstructionSet::SUB_RR,
+                                     basicBlock, {result, dividend, product}));
+    }
+
+    finalizeSelect(node, targetInstructions);
+}
+
+void AMD64TargetMachine::selectSignedDivByConstant(SelectionNode* node, const MOperand& dividend,
+                                                   int64_t divisor, const MOperand& quotient,
+                                                   std::vector<MInstruction>& targetInstructions) {
+    uint64_t bitsNumber = quotient.GetType().GetBytes() * 8;
+    MBasicBlock* basicBlock = node->GetBasicBlock();
+
+    auto append = [&](MInstruction::OpType opType, TInstrCode code, const MOperand& definition,
+                      const MOperand& first, const MOperand& second) {
+        targetInstructions.push_back(createTargetInstruction(opType, code, basicBlock, {definition, first, second}));
+    };
+    auto immediate = [](uint64_t value) {
+        return MOperand::CreateImmInteger(value);
+    };
+
+    // The negative dividends are rounded toward zero by adding 2^k - 1
+    if (divisor > 0 && std::has_single_bit(static_cast<uint64_t>(divisor))) {
+        uint64_t shift = std::countr_zero(static_cast<uint64_t>(divisor));
+
+        MOperand sign = createVirtualRegister(node, quotient);
+        MOperand bias = createVirtualRegister(node, quotient);
+        MOperand biased = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kAShiftR, AMD64InstructionSet::SAR_RI, sign, dividend, immediate(bitsNumber - 1));
+        append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, bias, sign, immediate(bitsNumber - shift));
+        append(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR, biased, dividend, bias);
+        append(MInstruction::OpType::kAShiftR, AMD64InstructionSet::SAR_RI, quotient, biased, immediate(shift));
+        return;
+    }
+
+    SignedMagic magic = bitsNumber == 32 ? getSignedMagic<uint32_t>(divisor) : getSignedMagic<uint64_t>(divisor);
+    MOperand high = selectMultiplyHigh(node, dividend, magic.Multiplier, /*isSigned=*/true, targetInstructions);
+
+    if (divisor > 0 && magic.Multiplier < 0) {
+        MOperand corrected = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR, corrected, high, dividend);
+        high = corrected;
+    } else if (divisor < 0 && magic.Multiplier > 0) {
+        MOperand corrected = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kSub, AMD64InstructionSet::SUB_RR, corrected, high, dividend);
+        high = corrected;
+    }
+
+    if (magic.Shift > 0) {
+        MOperand shifted = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kAShiftR, AMD64InstructionSet::SAR_RI, shifted, high, immediate(magic.Shift));
+        high = shifted;
+    }
+
+    MOperand sign = createVirtualRegister(node, quotient);
+    append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, sign, high, immediate(bitsNumber - 1));
+    append(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR, quotient, high, sign);
+}
+
+void AMD64TargetMachine::selectUnsignedDivByConstant(SelectionNode* node, const MOperand& dividend,
+                                                     uint64_t divisor, const MOperand& quotient,
+                                                     std::vector<MInstruction>& targetInstructions) {
+    uint64_t bitsNumber = quotient.GetType().GetBytes() * 8;
+    MBasicBlock* basicBlock = node->GetBasicBlock();
+
+    auto append = [&](MInstruction::OpType opType, TInstrCode code, const MOperand& definition,
+                      const MOperand& first, const MOperand& second) {
+        targetInstructions.push_back(createTargetInstruction(opType, code, basicBlock, {definition, first, second}));
+    };
+    auto immediate = [](uint64_t value) {
+        return MOperand::CreateImmInteger(value);
+    };
+
+    if (std::has_single_bit(divisor)) {
+        uint64_t shift = std::countr_zero(divisor);
+        append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, quotient, dividend, immediate(shift));
+        return;
+    }
+
+    UnsignedMagic magic = bitsNumber == 32 ? getUnsignedMagic<uint32_t>(divisor) : getUnsignedMagic<uint64_t>(divisor);
+    MOperand high = selectMultiplyHigh(node, dividend, magic.Multiplier, /*isSigned=*/false, targetInstructions);
+
+    if (magic.IsAdd) {
+        MOperand difference = createVirtualRegister(node, quotient);
+        MOperand halved = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kSub, AMD64InstructionSet::SUB_RR, difference, dividend, high);
+        append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, halved, difference, immediate(1));
+
+        if (magic.Shift == 1) {
+            append(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR, quotient, halved, high);
+            return;
+        }
+
+        MOperand sum = createVirtualRegister(node, quotient);
+        append(MInstruction::OpType::kAdd, AMD64InstructionSet::ADD_RR, sum, halved, high);
+        append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, quotient, sum, immediate(magic.Shift - 1));
+        return;
+    }
+
+    if (magic.Shift == 0) {
+        targetInstructions.push_back(createTargetInstruction(MInstruction::OpType::kMov, AMD64InstructionSet::MOV_RR,
+                                     basicBlock, {quotient, high}));
+        return;
+    }
+    append(MInstruction::OpType::kLShiftR, AMD64InstructionSet::SHR_RI, quotient, high, immediate(magic.Shift));
+}
+
+// The high half of the product goes to DX
+MOperand AMD64TargetMachine::selectMultiplyHigh(SelectionNode* node, const MOperand& operand, int64_t multiplier,
+                                                bool isSigned, std::vector<MInstruction>& targetInstructions) {
+    MBasicBlock* basicBlock = node->GetBasicBlock();
+
+    uint64_t bytes = operand.GetType().GetBytes();
+    auto axRegNumber = AMD64RegisterSet::EAX;
+    auto dxRegNumber = AMD64RegisterSet::EDX;
+    if (bytes == 8) {
+        axRegNumber = AMD64RegisterSet::RAX;
+        dxRegNumber = AMD64RegisterSet::RDX;
+    }
+
+    target::Register axReg = m_RegisterSet->GetRegister(axRegNumber);
+    target::Register dxReg = m_RegisterSet->GetRegister(dxRegNumber);
+
+    MInstruction movToAX{MInstruction::OpType::kMov};
+    movToAX.SetBasicBlock(basicBlock);
+    movToAX.SetTargetInstructionCode(AMD64InstructionSet::MOV_RI);
+    movToAX.SetInstructionClass(m_RegisterSet->GetRegisterClass(axReg));
+    movToAX.AddPhysicalRegister(axReg);
+    movToAX.AddOperand(MOperand::CreateImmInteger(multiplier, bytes));
+    targetInstructions.push_back(movToAX);
+
+    MInstruction mulInstr{MInstruction::OpType::kMul};
+    mulInstr.SetBasicBlock(basicBlock);
+    mulInstr.SetTargetInstructionCode(isSigned ? AMD64InstructionSet::IMUL_R : AMD64InstructionSet::MUL_R);
+    mulInstr.SetInstructionClass(operand.GetRegisterClass());
+    mulInstr.AddOperand(operand);
+    mulInstr.Undefine();
+
+    mulInstr.AddImplicitRegDefinition(axReg);
+    mulInstr.AddImplicitRegDefinition(dxReg);
+    mulInstr.AddImplicitRegUse(axReg);
+    targetInstructions.push_back(mulInstr);
+
+    MOperand high = createVirtualRegister(node, operand);
+
+    MInstruction movFromDX{MInstruction::OpType::kMov};
+    movFromDX.SetBasicBlock(basicBlock);
+    movFromDX.SetTargetInstructionCode(AMD64InstructionSet::MOV_RR);
+    movFromDX.SetInstructionClass(high.GetRegisterClass());
+    movFromDX.AddOperand(high);
+    movFromDX.AddPhysicalRegister(dxReg);
+    targetInstructions.push_back(movFromDX);
+
+    return high;
+}
+
+MOperand AMD64TargetMachine::createVirtualRegister(SelectionNode* node, const MOperand& sample) {
+    MFunction* function = node->GetBasicBlock()->GetFunction();
+    auto vreg = MOperand::CreateRegister(function->NextVReg(), sample.GetType(), /*isVirtual=*/true);
+    vreg.SetRegisterClass(sample.GetRegisterClass());
+    return vreg;
+}
+
+MInstruction AMD64TargetMachine::createTargetInstruction(MInstruction::OpType opType, TInstrCode code,
+                                                         MBasicBlock* basicBlock,
+                                                         std::initializer_list<MOperand> operands) {
+    MInstruction instruction{opType};
+    instruction.SetBasicBlock(basicBlock);
+    instruction.SetTargetInstructionCode(code);
+    instruction.SetInstructionClass(operands.begin()->GetRegisterClass());
+    for (const MOperand& operand : operands) {
+        instruction.AddOperand(operand);
+    }
+    return instruction;
+}
+
 void AMD64TargetMachine::selectFDiv(SelectionNode* node) {
     MInstruction resultInstruction = selectRMImpl(node);
     MInstruction::TOperandIt definition = resultInstruction.GetDefinition();
@@ -859,6 +1315,85 @@ void AMD64TargetMachine::selectCmp(SelectionNode* node) {
     finalizeSelect(node, targetInstructions);
 }
 
+void AMD64TargetMachine::selectSelect(SelectionNode* node) {
+    /*
+        Select res cond trueVR falseVR
+        ------------------------------
+        CMP mem/reg imm/reg  (folded compare)  or  CMP cond 0
+        CMOVcc res(falseVR) trueVR
+    */
+
+    MInstruction instruction = node->GetInstruction();
+    MInstruction::TOperandIt defOperand = instruction.GetDefinition();
+
+    std::vector<MInstruction> targetInstructions;
+
+    MInstruction targetCmov{MInstruction::OpType::kNone};
+    targetCmov.SetBasicBlock(instruction.GetBasicBlock());
+    targetCmov.SetInstructionClass(defOperand->GetRegisterClass());
+    targetCmov.AddOperand(*defOperand);
+    targetCmov.AddOperand(*instruction.GetUse(2));
+    targetCmov.AddOperand(*instruction.GetUse(1));
+
+    // The left immediate of a compare is materialized only by its own selection
+    SelectionNode* conditionNode = node->GetChild(0);
+    if (conditionNode && (!conditionNode->GetInstruction().IsCmp() ||
+                              conditionNode->GetInstruction().GetUse(0)->IsImmediate())) {
+        conditionNode = nullptr;
+    }
+
+    if (conditionNode) {
+        MInstruction conditionInstr = conditionNode->GetInstruction();
+        conditionNode->MarkAsSelected();
+        targetInstructions.push_back(selectFoldedCmp(conditionNode));
+
+        bool isSignedCmp = (conditionInstr.GetOpType() == MInstruction::OpType::kCmp);
+        switch (conditionInstr.GetCompareKind()) {
+        case MInstruction::CompareKind::kEqual:
+            targetCmov.SetTargetInstructionCode(AMD64InstructionSet::CMOVE);
+            break;
+        case MInstruction::CompareKind::kNEqual:
+            targetCmov.SetTargetInstructionCode(AMD64InstructionSet::CMOVNE);
+            break;
+        case MInstruction::CompareKind::kGreater:
+            targetCmov.SetTargetInstructionCode(isSignedCmp ? AMD64InstructionSet::CMOVG :
+                                                              AMD64InstructionSet::CMOVA);
+            break;
+        case MInstruction::CompareKind::kLess:
+            targetCmov.SetTargetInstructionCode(isSignedCmp ? AMD64InstructionSet::CMOVL :
+                                                              AMD64InstructionSet::CMOVB);
+            break;
+        case MInstruction::CompareKind::kGreaterEq:
+            targetCmov.SetTargetInstructionCode(isSignedCmp ? AMD64InstructionSet::CMOVGE :
+                                                              AMD64InstructionSet::CMOVAE);
+            break;
+        case MInstruction::CompareKind::kLessEq:
+            targetCmov.SetTargetInstructionCode(isSignedCmp ? AMD64InstructionSet::CMOVLE :
+                                                              AMD64InstructionSet::CMOVBE);
+            break;
+        default:
+            ANCL_CRITICAL("AMD64 Selection: unknown compare kind of select");
+            break;
+        }
+    } else {
+        MInstruction::TOperandIt condOperand = instruction.GetUse(0);
+
+        MInstruction targetCmp{MInstruction::OpType::kCmp};
+        targetCmp.Undefine();
+        targetCmp.SetBasicBlock(instruction.GetBasicBlock());
+        targetCmp.SetInstructionClass(condOperand->GetRegisterClass());
+        targetCmp.AddOperand(*condOperand);
+        targetCmp.AddOperand(MOperand::CreateImmInteger(0, condOperand->GetType().GetBytes()));
+        targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_RI);
+        targetInstructions.push_back(targetCmp);
+
+        targetCmov.SetTargetInstructionCode(AMD64InstructionSet::CMOVNE);
+    }
+    targetInstructions.push_back(targetCmov);
+
+    finalizeSelect(node, targetInstructions);
+}
+
 void AMD64TargetMachine::selectITrunc(SelectionNode* node) {
     MInstruction instruction = node->GetInstruction();
 
@@ -1131,13 +1666,23 @@ void AMD64TargetMachine::selectCall(SelectionNode* node) {
     finalizeSelect(node, instruction);
 }
 
-void AMD64TargetMachine::selectJump(SelectionNode* node) {
-    // TODO: Handle reg Jump
+// The frame is already released by the epilogue, so the callee returns to our caller
+void AMD64TargetMachine::selectTailCall(SelectionNode* node) {
     MInstruction instruction = node->GetInstruction();
     instruction.SetTargetInstructionCode(AMD64InstructionSet::JMP);
     finalizeSelect(node, instruction);
 }
 
+void AMD64TargetMachine::selectJump(SelectionNode* node) {
+    MInstruction instruction = node->GetInstruction();
+    if (instruction.GetUse(0)->IsRegister()) {  // Jump table
+        instruction.SetTargetInstructionCode(AMD64InstructionSet::JMP_R);
+    } else {
+        instruction.SetTargetInstructionCode(AMD64InstructionSet::JMP);
+    }
+    finalizeSelect(node, instruction);
+}
+
 void AMD64TargetMachine::selectBranch(SelectionNode* node) {
     /*
         Branch condVR labelTrue labelFalse
@@ -1161,44 +1706,7 @@ void AMD64TargetMachine::selectBranch(SelectionNode* node) {
         assert(conditionInstr.IsCmp());
 
         conditionNode->MarkAsSelected();
-
-        bool isMemory = false;
-
-        MInstruction targetCmp{MInstruction::OpType::kCmp};
-        targetCmp.Undefine();
-        targetCmp.SetBasicBlock(conditionInstr.GetBasicBlock());
-
-        MInstruction::TOperandIt firstUse = conditionInstr.GetUse(0);
-        MInstruction::TOperandIt secondUse = conditionInstr.GetUse(1);
-
-        targetCmp.SetInstructionClass(firstUse->GetRegisterClass());
-
-        if (SelectionNode* child = conditionNode->GetChild(0)) {
-            std::vector<MOperand> operands = trySelectMemory(child);
-            if (operands.size() > 1) {
-                isMemory = true;
-            }
-            for (const MOperand& operand : operands) {
-                targetCmp.AddOperand(operand);
-            }
-        } else {
-            targetCmp.AddOperand(*firstUse);
-        }
-
-        targetCmp.AddOperand(*secondUse);
-
-        if (secondUse->IsImmediate()) {
-            targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_RI);
-            if (isMemory) {
-                targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_MI);
-            }
-        } else {
-            targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_RR);
-            if (isMemory) {
-                targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_MR);
-            }
-        }
-        targetInstructions.push_back(targetCmp);
+        targetInstructions.push_back(selectFoldedCmp(conditionNode));
     } else {
         MBasicBlock* block = instruction.GetBasicBlock();
         MBasicBlock::TInstructionIt terminatorIt = block->GetLastInstruction();
@@ -1269,6 +1777,50 @@ void AMD64TargetMachine::selectBranch(SelectionNode* node) {
     finalizeSelect(node, targetInstructions);
 }
 
+// The compare is emitted right before the instruction that reads the flags
+MInstruction AMD64TargetMachine::selectFoldedCmp(SelectionNode* conditionNode) {
+    MInstruction conditionInstr = conditionNode->GetInstruction();
+
+    bool isMemory = false;
+
+    MInstruction targetCmp{MInstruction::OpType::kCmp};
+    targetCmp.Undefine();
+    targetCmp.SetBasicBlock(conditionInstr.GetBasicBlock());
+
+    MInstruction::TOperandIt firstUse = conditionInstr.GetUse(0);
+    MInstruction::TOperandIt secondUse = conditionInstr.GetUse(1);
+
+    targetCmp.SetInstructionClass(firstUse->GetRegisterClass());
+
+    if (SelectionNode* child = conditionNode->GetChild(0)) {
+        std::vector<MOperand> operands = trySelectMemory(child);
+        if (operands.size() > 1) {
+            isMemory = true;
+        }
+        for (const MOperand& operand : operands) {
+            targetCmp.AddOperand(operand);
+        }
+    } else {
+        targetCmp.AddOperand(*firstUse);
+    }
+
+    targetCmp.AddOperand(*secondUse);
+
+    if (secondUse->IsImmediate()) {
+        targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_RI);
+        if (isMemory) {
+            targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_MI);
+        }
+    } else {
+        targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_RR);
+        if (isMemory) {
+            targetCmp.SetTargetInstructionCode(AMD64InstructionSet::CMP_MR);
+        }
+    }
+
+    return targetCmp;
+}
+
 void AMD64TargetMachine::selectRet(SelectionNode* node) {
     MInstruction instruction = node->GetInstruction();
     instruction.SetTargetInstructionCode(AMD64InstructionSet::RET);
@@ -1412,6 +1964,17 @@ void AMD64TargetMachine::selectStore(SelectionNode* node) {
     finalizeSelect(node, resultInstruction);
 }
 
+void AMD64TargetMachine::selectMemSet(SelectionNode* node) {
+    // Operands are already in RDI, AL/RAX and RCX after legalization
+    MInstruction instruction = node->GetInstruction();
+    if (instruction.GetOperand(0)->GetType().GetBytes() == 8) {
+        instruction.SetTargetInstructionCode(AMD64InstructionSet::REP_STOSQ);
+    } else {
+        instruction.SetTargetInstructionCode(AMD64InstructionSet::REP_STOSB);
+    }
+    finalizeSelect(node, instruction);
+}
+
 void AMD64TargetMachine::selectStackAddress(SelectionNode* node) {
     MInstruction instruction = node->GetInstruction();
 
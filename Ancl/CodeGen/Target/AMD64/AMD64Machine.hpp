@@ -1,5 +1,6 @@
 #pragma once
 
+#include <initializer_list>
 #include <vector>
 
 #include <Ancl/CodeGen/MachineIR/MOperand.hpp>
@@ -57,6 +58,7 @@ private:
     void selectOr(SelectionNode* node);
 
     void selectCmp(SelectionNode* node);
+    void selectSelect(SelectionNode* node);
 
     void selectITrunc(SelectionNode* node);
     void selectFTrunc(SelectionNode* node);
@@ -69,6 +71,7 @@ private:
     void selectSIToF(SelectionNode* node);
 
     void selectCall(SelectionNode* node);
+    void selectTailCall(SelectionNode* node);
     void selectJump(SelectionNode* node);
     void selectBranch(SelectionNode* node);
     void selectRet(SelectionNode* node);
@@ -78,6 +81,7 @@ private:
 
     void selectLoad(SelectionNode* node);
     void selectStore(SelectionNode* node);
+    void selectMemSet(SelectionNode* node);
     void selectStackAddress(SelectionNode* node);
     void selectGlobalAddress(SelectionNode* node);
 
@@ -92,7 +96,21 @@ private:
     void selectSDivImpl(SelectionNode* node);
     void selectUDivImpl(SelectionNode* node);
 
+    bool selectMulByConstant(SelectionNode* node, std::vector<MInstruction>& targetInstructions);
+    void selectDivRemByConstant(SelectionNode* node);
+    void selectSignedDivByConstant(SelectionNode* node, const MOperand& dividend, int64_t divisor,
+                                   const MOperand& quotient, std::vector<MInstruction>& targetInstructions);
+    void selectUnsignedDivByConstant(SelectionNode* node, const MOperand& dividend, uint64_t divisor,
+                                     const MOperand& quotient, std::vector<MInstruction>& targetInstructions);
+    MOperand selectMultiplyHigh(SelectionNode* node, const MOperand& operand, int64_t multiplier,
+                                bool isSigned, std::vector<MInstruction>& targetInstructions);
+
+    MOperand createVirtualRegister(SelectionNode* node, const MOperand& sample);
+    MInstruction createTargetInstruction(MInstruction::OpType opType, TInstrCode code, MBasicBlock* basicBlock,
+                                         std::initializer_list<MOperand> operands);
+
     MInstruction selectRMImpl(SelectionNode* node);
+    MInstruction selectFoldedCmp(SelectionNode* conditionNode);
 
     std::vector<MOperand> mergeMemberAddress(SelectionNode* node);
     void legalizeAddressScale(SelectionNode* node,
@@ -27,7 +27,9 @@ public:
     virtual void LegalizeXor(SelectionNode* instruction) = 0;
     virtual void LegalizeOr(SelectionNode* instruction) = 0;
     virtual void LegalizeCmp(SelectionNode* instruction) = 0;
+    virtual void LegalizeSelect(SelectionNode* instruction) = 0;
     virtual void LegalizeZExt(SelectionNode* instruction) = 0;
+    virtual void LegalizeMemSet(SelectionNode* instruction) = 0;
 
     void Legalize(SelectionNode* node) {
         if (!IsLegalizationRequired(node)) {
@@ -70,9 +72,15 @@ public:
             case MInstruction::OpType::kCmp:
                 return LegalizeCmp(node);
 
+            case MInstruction::OpType::kSelect:
+                return LegalizeSelect(node);
+
             case MInstruction::OpType::kZExt:
                 return LegalizeZExt(node);
 
+            case MInstruction::OpType::kMemSet:
+                return LegalizeMemSet(node);
+
             default:
                 ANCL_CRITICAL("It is impossible to legalize instruction");
                 break;
@@ -1,9 +1,17 @@
 #include <Ancl/Driver/Driver.hpp>
 
+#include <format>
+#include <stdexcept>
+
 #include "CLexer.h"
 
 #include <Ancl/Logger/Logger.hpp>
 
+#include <Ancl/Grammar/Lexer/DeclarationTokenSource.hpp>
+#include <Ancl/Grammar/Lexer/FastLexer.hpp>
+#include <Ancl/Grammar/Lexer/FastTokenSource.hpp>
+#include <Ancl/Grammar/Lexer/LocationTokenSource.hpp>
+
 #include <Ancl/Preprocessor/Preprocessor.hpp>
 
 #include <Ancl/Visitor/AstDotVisitor.hpp>
@@ -13,10 +21,20 @@
 
 #include <Ancl/SymbolTable/DotConverter.hpp>
 
+#include <Ancl/Optimization/InlinePass.hpp>
+#include <Ancl/Optimization/SROAPass.hpp>
 #include <Ancl/Optimization/SSAPass.hpp>
+#include <Ancl/Optimization/SCCPPass.hpp>
+#include <Ancl/Optimization/InstCombinePass.hpp>
 #include <Ancl/Optimization/DVNTPass.hpp>
+#include <Ancl/Optimization/RLEPass.hpp>
+#include <Ancl/Optimization/LICMPass.hpp>
+#include <Ancl/Optimization/LSRPass.hpp>
+#include <Ancl/Optimization/DSEPass.hpp>
+#include <Ancl/Optimization/IfConversionPass.hpp>
 #include <Ancl/Optimization/DCEPass.hpp>
 #include <Ancl/Optimization/CleanPass.hpp>
+#include <Ancl/Optimization/TailCallPass.hpp>
 
 #include <Ancl/CodeGen/Target/AMD64/AMD64Machine.hpp>
 
@@ -57,38 +75,66 @@ void Driver::PreprocessToFile(const std::string& sourceFilename, const std::stri
 }
 
 Driver::ParseResult Driver::Parse(std::istream& inputStream) {
-    antlr4::ANTLRInputStream inputAntlrStream{inputStream};
+    return lexInput(inputStream, [this](antlr4::TokenSource* tokenSource) {
+        return parseTokens(tokenSource);
+    });
+}
 
-    anclgrammar::CLexer lexer{&inputAntlrStream};
-    antlr4::CommonTokenStream tokens{&lexer};
+Driver::ParseResult Driver::DumpTokens(std::istream& inputStream, const std::string& filename) {
+    std::ofstream outputStream{filename};
 
-    std::vector<antlr4::Token*> lineTokens;
-    tokens.fill();
-    for (antlr4::Token* token : tokens.getTokens()) {
-        if (token->getChannel() == anclgrammar::CLexer::LINE) {
-            lineTokens.push_back(token);
+    // Both lexers skip the bad characters, so the streams are compared past them
+    ParseResult result = lexInput(inputStream, [this, &outputStream](antlr4::TokenSource* tokenSource) {
+        // Every line is registered before the first position is looked up
+        std::vector<std::unique_ptr<antlr4::Token>> tokens;
+        for (auto token = tokenSource->nextToken(); token->getType() != antlr4::Token::EOF;
+                token = tokenSource->nextToken()) {
+            tokens.push_back(std::move(token));
         }
-    }
 
-    ANCL_INFO("Parsing...");
-    anclgrammar::CParser parser{&tokens};
-    auto* syntaxTreeEntry = parser.translationUnit();
+        const SourceManager& sourceManager = m_ASTProgram->GetSourceManager();
+        for (const std::unique_ptr<antlr4::Token>& token : tokens) {
+            if (token->getChannel() == anclgrammar::CLexer::LINE) {
+                outputStream << std::format("#line \"{}\"\n", token->getText());
+            } else if (token->getChannel() == antlr4::Token::DEFAULT_CHANNEL) {
+                Position position = sourceManager.GetPosition(token->getStartIndex());
+                outputStream << std::format("{}:{}.{} {}:{} {} {}\n",
+                                            position.GetFileName(), position.GetLine(),
+                                            position.GetColumn(), token->getLine(),
+                                            token->getCharPositionInLine(), token->getType(),
+                                            token->getText());
+            }
+        }
+        return ParseResult::kOK;
+    }, /*stopOnLexicalErrors=*/false);
 
-    if (parser.getNumberOfSyntaxErrors()) {
-        ANCL_CRITICAL("Syntax errors were found. The program is completed.");
-        return ParseResult::kError;
-    }
+    ANCL_INFO("Tokens are saved in \"{}\"", filename);
+    return result;
+}
 
-    ANCL_INFO("Creating AST...");
-    buildAST(syntaxTreeEntry, lineTokens);
+Driver::ParseResult Driver::CompileStreaming(std::istream& inputStream) {
+    if (!m_SemanticDotInfoPath.empty() || !m_ASTDotInfoPath.empty() ||
+            !m_IREmitterPath.empty() || !m_MIREmitterPath.empty()) {
+        ANCL_WARN("Intermediate dumps are not supported in streaming mode");
+        m_SemanticDotInfoPath.clear();
+        m_ASTDotInfoPath.clear();
+        m_IREmitterPath.clear();
+        m_MIREmitterPath.clear();
+    }
 
-    return ParseResult::kOK;
+    return lexInput(inputStream, [this](antlr4::TokenSource* tokenSource) {
+        return compileTokens(tokenSource);
+    });
 }
 
 void Driver::RunSemanticPass() {
     ANCL_INFO("Analyzing semantics...");
-    ast::SemanticAstVisitor semanticVisitor{m_ASTProgram};
-    semanticVisitor.Run();
+    ast::SemanticAstVisitor semanticVisitor{*m_ASTProgram};
+    if (m_ThreadPool) {
+        runSemanticPassParallel(semanticVisitor);
+    } else {
+        semanticVisitor.Run();
+    }
 
     if (!m_SemanticDotInfoPath.empty()) {
         semanticVisitor.PrintScopeInfoDot(m_SemanticDotInfoPath.string());
@@ -96,23 +142,30 @@ void Driver::RunSemanticPass() {
     }
 
     if (!m_ASTDotInfoPath.empty()) {
-        ast::AstDotVisitor dotVisitor{m_ASTDotInfoPath.string()};
-        dotVisitor.Visit(*m_ASTProgram.GetTranslationUnit());
+        ast::AstDotVisitor dotVisitor{m_ASTDotInfoPath.string(), m_ASTProgram->GetSourceManager()};
+        dotVisitor.Visit(*m_ASTProgram->GetTranslationUnit());
         ANCL_INFO("AST in DOT format: \"{}\"", m_ASTDotInfoPath.string());
     }
 }
 
 void Driver::GenerateAnclIR() {
     ANCL_INFO("Generating Ancl IR...");
-    ast::IRGenAstVisitor irGenVisitor{m_IRProgram};
-    irGenVisitor.Run(m_ASTProgram);
+    ast::IRGenAstVisitor irGenVisitor{*m_IRProgram};
+    irGenVisitor.SetBuildSSA(m_UseOptimizations);
+    if (m_ThreadPool) {
+        generateAnclIRParallel(irGenVisitor);
+    } else {
+        irGenVisitor.Run(*m_ASTProgram);
+    }
 
     if (!m_IREmitterPath.empty()) {
         const auto irPath = m_IREmitterPath / "AnclIR.txt";
         ir::IREmitter irEmitter(irPath.string());
-        irEmitter.Emit(m_IRProgram);
+        irEmitter.Emit(*m_IRProgram);
         ANCL_INFO("Ancl IR is saved in \"{}\"", irPath.string());
     }
+
+    releaseAST();
 }
 
 void Driver::OptimizeIR() {
@@ -120,45 +173,21 @@ void Driver::OptimizeIR() {
         return;
     }
 
-    ANCL_INFO("SSA Pass...");
-    for (ir::Function* function : m_IRProgram.GetFunctions()) {
-        if (function->IsDeclaration()) {
-            continue;
-        }
-        ir::SSAPass ssaPass(function);
-        ssaPass.Run();
-    }
-    emitAnclIR("AnclIR_SSA.txt");
-
-    ANCL_INFO("DVNT Pass...");
-    for (ir::Function* function : m_IRProgram.GetFunctions()) {
-        if (function->IsDeclaration()) {
-            continue;
-        }
-        ir::DVNTPass dvntPass(function);
-        dvntPass.Run();
-    }
-    emitAnclIR("AnclIR_DVNT.txt");
-
-    ANCL_INFO("DCE Pass...");
-    for (ir::Function* function : m_IRProgram.GetFunctions()) {
-        if (function->IsDeclaration()) {
-            continue;
-        }
-        ir::DCEPass dcePass(function);
-        dcePass.Run();
-    }
-    emitAnclIR("AnclIR_DCE.txt");
-
-    ANCL_INFO("CleanCFG Pass...");
-    for (ir::Function* function : m_IRProgram.GetFunctions()) {
-        if (function->IsDeclaration()) {
-            continue;
+    ANCL_INFO("Inline Pass...");
+    ir::InlinePass inlinePass(*m_IRProgram);
+    inlinePass.Run();
+    emitAnclIR("AnclIR_Inline.txt");
+
+    for (const OptimizationStage& stage : getOptimizationStages()) {
+        ANCL_INFO("{} Pass...", stage.Name);
+        for (ir::Function* function : m_IRProgram->GetFunctions()) {
+            if (function->IsDeclaration()) {
+                continue;
+            }
+            stage.Run(function);
         }
-        ir::CleanPass cleanPass(function);
-        cleanPass.Run();
+        emitAnclIR(std::format("AnclIR_{}.txt", stage.Name));
     }
-    emitAnclIR("AnclIR_CleanCFG.txt");
 
     ANCL_INFO("Optimization results are saved in \"{}\" directory", m_IREmitterPath.string());
 }
@@ -166,12 +195,14 @@ void Driver::OptimizeIR() {
 void Driver::GenerateMachineIR() {
     ANCL_INFO("Generating Machine IR...");
     m_TargetMachine = CreateScope<gen::target::amd64::AMD64TargetMachine>();
-    gen::MIRGenerator machineIRGenerator(m_MIRProgram, m_IRProgram, m_TargetMachine.get());
+    gen::MIRGenerator machineIRGenerator(m_MIRProgram, *m_IRProgram, m_TargetMachine.get());
     machineIRGenerator.Generate();
     emitMachineIR("MachineIR.txt");
     if (!m_MIREmitterPath.empty()) {
         ANCL_INFO("Machine IR is saved in \"{}\" directory", m_MIREmitterPath.string());
     }
+
+    releaseIR();
 }
 
 void Driver::RunInstructionSelection() {
@@ -277,6 +308,21 @@ void Driver::SetUseOptimizations(bool useOptimizations) {
     m_UseOptimizations = useOptimizations;
 }
 
+void Driver::SetUseFastLexer(bool useFastLexer) {
+    m_UseFastLexer = useFastLexer;
+}
+
+void Driver::SetThreadsNumber(size_t threadsNumber) {
+    m_ThreadPool.reset();
+    if (threadsNumber > 1) {
+        m_ThreadPool = CreateScope<ThreadPool>(threadsNumber);
+    }
+}
+
+void Driver::SetVerifyDominators(bool verifyDominators) {
+    m_VerifyDominators = verifyDominators;
+}
+
 void Driver::SetMIREmitterPath(const std::string& path) {
     m_MIREmitterPath = path;
 }
@@ -289,18 +335,317 @@ void Driver::SetGASEmitterPath(const std::string& path) {
     m_GASEmitterPath = path;
 }
 
-void Driver::buildAST(anclgrammar::CParser::TranslationUnitContext* syntaxTreeEntry,
-                const std::vector<antlr4::Token*> lineTokens) {
-    anclgrammar::BuildAstVisitor buildVisitor{m_ASTProgram};
-    buildVisitor.setLineTokens(lineTokens);
+Driver::ParseResult Driver::lexInput(std::istream& inputStream, const TokenSourceHandler& handler,
+                                     bool stopOnLexicalErrors) {
+    if (m_UseFastLexer) {
+        ANCL_INFO("Lexing with the fast lexer...");
+        std::string buffer{std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>()};
+        anclgrammar::FastLexer lexer{std::move(buffer)};
+        lexer.Tokenize();
+        if (lexer.GetErrorsNumber() && stopOnLexicalErrors) {
+            ANCL_CRITICAL("Lexical errors were found. The program is completed.");
+            return ParseResult::kError;
+        }
+
+        addSourceLines(lexer);
+
+        anclgrammar::FastTokenSource tokenSource{lexer};
+        return handler(&tokenSource);
+    }
+
+    antlr4::ANTLRInputStream inputAntlrStream{inputStream};
+    anclgrammar::CLexer lexer{&inputAntlrStream};
+    anclgrammar::LocationTokenSource tokenSource{lexer, m_ASTProgram->GetSourceManager()};
+    return handler(&tokenSource);
+}
+
+Driver::ParseResult Driver::parseTokens(antlr4::TokenSource* tokenSource) {
+    // The parser pulls the tokens from the lexer as it goes
+    antlr4::CommonTokenStream tokens{tokenSource};
+
+    ANCL_INFO("Parsing...");
+    anclgrammar::CParser parser{&tokens};
+    auto* syntaxTreeEntry = parser.translationUnit();
+
+    if (parser.getNumberOfSyntaxErrors()) {
+        ANCL_CRITICAL("Syntax errors were found. The program is completed.");
+        return ParseResult::kError;
+    }
+
+    ANCL_INFO("Creating AST...");
+    buildAST(syntaxTreeEntry);
+
+    // The parse tree and the token stream are released with the parser on return
+
+    return ParseResult::kOK;
+}
+
+Driver::ParseResult Driver::compileTokens(antlr4::TokenSource* tokenSource) {
+    anclgrammar::DeclarationTokenSource declarationTokenSource{*tokenSource};
+
+    anclgrammar::BuildAstVisitor buildVisitor{*m_ASTProgram};
+    ast::SemanticAstVisitor semanticVisitor{*m_ASTProgram};
+    ast::IRGenAstVisitor irGenVisitor{*m_IRProgram};
+    irGenVisitor.SetBuildSSA(m_UseOptimizations);
+
+    m_TargetMachine = CreateScope<gen::target::amd64::AMD64TargetMachine>();
+    gen::MIRGenerator machineIRGenerator(m_MIRProgram, *m_IRProgram, m_TargetMachine.get());
+
+    std::vector<TScopePtr<gen::target::AssemblyEmitter>> emitters;
+    if (!m_IntelEmitterPath.empty()) {
+        emitters.push_back(CreateScope<gen::target::amd64::IntelEmitter>(m_IntelEmitterPath));
+    }
+    if (!m_GASEmitterPath.empty()) {
+        emitters.push_back(CreateScope<gen::target::amd64::GASEmitter>(m_GASEmitterPath));
+    }
+    for (auto& emitter : emitters) {
+        emitter->EmitBegin(m_TargetMachine.get());
+    }
+
+    ANCL_INFO("Compiling declarations one by one...");
+    while (true) {
+        std::vector<ast::Declaration*> decls;
+        {
+            // The tokens and the parse tree of a declaration live until its AST is built
+            antlr4::CommonTokenStream tokens{&declarationTokenSource};
+            if (tokens.LA(1) == antlr4::Token::EOF) {
+                break;
+            }
+
+            anclgrammar::CParser parser{&tokens};
+            auto* declCtx = parser.externalDeclaration();
+
+            if (parser.getNumberOfSyntaxErrors()) {
+                ANCL_CRITICAL("Syntax errors were found. The program is completed.");
+                return ParseResult::kError;
+            }
+
+            decls = buildVisitor.BuildExternalDeclaration(declCtx);
+            declarationTokenSource.ReturnLookahead(tokens);
+        }
+
+        for (ast::Declaration* decl : decls) {
+            if (semanticVisitor.Run(*decl) == ast::SemanticAstVisitor::Status::kError) {
+                ANCL_CRITICAL("Semantic errors were found. The program is completed.");
+                return ParseResult::kError;
+            }
+
+            size_t valuesMark = m_IRProgram->GetValuesNumber();
+            irGenVisitor.Run(*decl);
+
+            auto* funcDecl = dynamic_cast<ast::FunctionDeclaration*>(decl);
+            if (!funcDecl) {
+                continue;
+            }
+            semanticVisitor.ReleaseFunctionScopes();
+
+            if (!funcDecl->GetBody()) {
+                continue;
+            }
+            funcDecl->ReleaseBody();
+            m_ASTProgram->ReleaseFunctionBodies();
+
+            ir::Function* irFunction = m_IRProgram->GetFunction(funcDecl->GetName());
+            optimizeFunction(irFunction);
+
+            machineIRGenerator.GenerateFunction(irFunction);
+
+            // Small bodies stay to be inlined into the later functions
+            if (!m_UseOptimizations || !ir::InlinePass::IsInlineCandidate(irFunction)) {
+                m_IRProgram->ReleaseFunctionBody(irFunction, valuesMark);
+            }
+
+            RunInstructionSelection();
+            AllocateRegisters();
+            Finalize();
+
+            for (auto& emitter : emitters) {
+                emitter->EmitFunction(m_MIRProgram.GetLastFunction());
+            }
+            m_MIRProgram.ClearFunctions();
+            m_FunctionsLiveOUT.clear();
+        }
+    }
+
+    machineIRGenerator.GenerateGlobalData();
+    for (auto& emitter : emitters) {
+        emitter->EmitEnd(m_MIRProgram.GetGlobalData());
+    }
+
+    if (!m_IntelEmitterPath.empty()) {
+        ANCL_INFO("Intel assembler is saved in \"{}\"", m_IntelEmitterPath.string());
+    }
+    if (!m_GASEmitterPath.empty()) {
+        ANCL_INFO("GAS assembler is saved in \"{}\"", m_GASEmitterPath.string());
+    }
+
+    return ParseResult::kOK;
+}
+
+void Driver::buildAST(anclgrammar::CParser::TranslationUnitContext* syntaxTreeEntry) {
+    anclgrammar::BuildAstVisitor buildVisitor{*m_ASTProgram};
     buildVisitor.visitTranslationUnit(syntaxTreeEntry);
 }
 
+// The fast lexer keeps all the tokens, so their lines are registered before parsing
+void Driver::addSourceLines(const anclgrammar::FastLexer& lexer) {
+    SourceManager& sourceManager = m_ASTProgram->GetSourceManager();
+    for (const anclgrammar::FastToken& token : lexer.GetTokens()) {
+        if (token.Kind == anclgrammar::FastTokenKind::kLineDirective) {
+            sourceManager.AddFileMarker(std::string(lexer.GetText(token)));
+        } else {
+            sourceManager.AddToken(token.Offset, token.Line, token.Column + 1);
+        }
+    }
+}
+
+void Driver::runSemanticPassParallel(ast::SemanticAstVisitor& semanticVisitor) {
+    std::vector<ast::FunctionDeclaration*> definitions;
+    semanticVisitor.RunDeclarations(definitions);
+
+    std::vector<ast::ASTProgram::AllocationPool*> pools;
+    for (size_t i = 0; i < m_ThreadPool->GetThreadsNumber(); ++i) {
+        pools.push_back(m_ASTProgram->CreateAllocationPool());
+    }
+
+    ANCL_INFO("Analyzing {} function bodies on {} threads...", definitions.size(), pools.size());
+    m_ThreadPool->Run(definitions.size(), [&](size_t index, size_t threadIndex) {
+        ast::ASTProgram::ThreadAllocationScope allocationScope(pools[threadIndex]);
+        ast::SemanticAstVisitor bodyVisitor{*m_ASTProgram, semanticVisitor};
+        bodyVisitor.RunFunctionBody(*definitions[index]);
+    });
+}
+
+void Driver::generateAnclIRParallel(ast::IRGenAstVisitor& irGenVisitor) {
+    std::vector<ast::IRGenAstVisitor::FunctionDefinition> definitions;
+    irGenVisitor.RunDeclarations(*m_ASTProgram, definitions);
+
+    std::vector<ir::IRProgram::AllocationPool*> pools;
+    for (size_t i = 0; i < m_ThreadPool->GetThreadsNumber(); ++i) {
+        pools.push_back(m_IRProgram->CreateAllocationPool());
+    }
+
+    ANCL_INFO("Generating {} function bodies on {} threads...", definitions.size(), pools.size());
+    std::vector<TScopePtr<ast::IRGenAstVisitor>> bodyVisitors(definitions.size());
+    m_ThreadPool->Run(definitions.size(), [&](size_t index, size_t threadIndex) {
+        ir::IRProgram::ThreadAllocationScope allocationScope(pools[threadIndex]);
+        bodyVisitors[index] = CreateScope<ast::IRGenAstVisitor>(*m_IRProgram, irGenVisitor);
+        bodyVisitors[index]->RunFunctionBody(definitions[index]);
+    });
+
+    // Source order keeps the program lists and string labels deterministic
+    for (TScopePtr<ast::IRGenAstVisitor>& bodyVisitor : bodyVisitors) {
+        bodyVisitor->MergeFunctionBody();
+    }
+}
+
+// The later stages work on their own representation, so every program
+// is released as soon as the next one is built
+void Driver::releaseAST() {
+    ANCL_INFO("Releasing AST ({} bytes)...", m_ASTProgram->GetAllocatedBytes());
+    m_ASTProgram.reset();
+}
+
+void Driver::releaseIR() {
+    ANCL_INFO("Releasing Ancl IR ({} bytes)...", m_IRProgram->GetAllocatedBytes());
+    m_IRProgram.reset();
+}
+
+std::vector<Driver::OptimizationStage> Driver::getOptimizationStages() const {
+    return {
+        {"SROA", [](ir::Function* function) {
+            ir::SROAPass sroaPass(function);
+            sroaPass.Run();
+        }},
+        {"SSA", [](ir::Function* function) {
+            // Scalar locals are already in SSA form after IRGen
+            if (!ir::SSAPass::HasAllocas(function)) {
+                return;
+            }
+            ir::SSAPass ssaPass(function, /*isPruned=*/true);
+            ssaPass.Run();
+        }},
+        {"SCCP", [](ir::Function* function) {
+            ir::SCCPPass sccpPass(function);
+            sccpPass.Run();
+        }},
+        {"InstCombine", [](ir::Function* function) {
+            ir::InstCombinePass instCombinePass(function);
+            instCombinePass.Run();
+        }},
+        {"DVNT", [](ir::Function* function) {
+            ir::DVNTPass dvntPass(function);
+            dvntPass.Run();
+        }},
+        {"InstCombineAfterDVNT", [](ir::Function* function) {
+            ir::InstCombinePass instCombinePass(function);
+            instCombinePass.Run();
+        }},
+        {"RLE", [](ir::Function* function) {
+            ir::RLEPass rlePass(function);
+            rlePass.Run();
+        }},
+        {"LICM", [](ir::Function* function) {
+            ir::LICMPass licmPass(function);
+            licmPass.Run();
+        }},
+        {"LSR", [](ir::Function* function) {
+            ir::LSRPass lsrPass(function);
+            lsrPass.Run();
+        }},
+        {"DSE", [](ir::Function* function) {
+            ir::DSEPass dsePass(function);
+            dsePass.Run();
+        }},
+        {"IfConversion", [](ir::Function* function) {
+            ir::IfConversionPass ifConversionPass(function);
+            ifConversionPass.Run();
+        }},
+        {"DCE", [](ir::Function* function) {
+            ir::DCEPass dcePass(function);
+            dcePass.Run();
+        }},
+        {"CleanCFG", [this](ir::Function* function) {
+            if (!m_VerifyDominators) {
+                ir::CleanPass cleanPass(function);
+                cleanPass.Run();
+                return;
+            }
+
+            // The tree is updated with every change of the CFG instead of being rebuilt
+            DominatorTree domTree(function);
+            ir::CleanPass cleanPass(function, &domTree);
+            cleanPass.Run();
+            if (!domTree.Verify()) {
+                throw std::runtime_error("Dominator tree verification error");
+            }
+        }},
+        {"TailCall", [](ir::Function* function) {
+            ir::TailCallPass tailCallPass(function);
+            tailCallPass.Run();
+        }},
+    };
+}
+
+void Driver::optimizeFunction(ir::Function* function) {
+    if (!m_UseOptimizations || function->IsDeclaration()) {
+        return;
+    }
+
+    // Only the callees defined earlier can be inlined
+    ir::InlinePass inlinePass(*m_IRProgram);
+    inlinePass.RunOnFunction(function);
+
+    for (const OptimizationStage& stage : getOptimizationStages()) {
+        stage.Run(function);
+    }
+}
+
 void Driver::emitAnclIR(const std::string& filename) {
     if (!m_IREmitterPath.empty()) {
         const auto irPath = m_IREmitterPath / filename;
         ir::IREmitter irEmitter(irPath.string());
-        irEmitter.Emit(m_IRProgram);
+        irEmitter.Emit(*m_IRProgram);
     }   
 }
 
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <unordered_map>
 
 #include "antlr4-runtime.h"
 #include "CParser.h"
 
 #include <Ancl/Base.hpp>
+#include <Ancl/Driver/ThreadPool.hpp>
 
 #include <Ancl/CodeGen/RegisterAllocation/LiveOutPass.hpp>
 #include <Ancl/CodeGen/Target/Base/Machine.hpp>
@@ -16,6 +18,16 @@
 #include <Ancl/Grammar/AST/ASTProgram.hpp>
 
 
+namespace ast {
+class SemanticAstVisitor;
+class IRGenAstVisitor;
+}  // namespace ast
+
+namespace anclgrammar {
+class FastLexer;
+}  // namespace anclgrammar
+
+
 class Driver {
 public:
     enum class ParseResult {
@@ -33,6 +45,16 @@ public:
 
     ParseResult Parse(std::istream& inputStream);
 
+    // Writes the position, type and text of every token, one per line,
+    // lexical errors are reported but do not stop the output
+    ParseResult DumpTokens(std::istream& inputStream, const std::string& filename);
+
+    // Parses, checks and generates code one external declaration at a time,
+    // function bodies are released as soon as their assembler is emitted.
+    // With optimizations the bodies small enough to inline stay, and calls
+    // are inlined only into the functions defined after the callee
+    ParseResult CompileStreaming(std::istream& inputStream);
+
     void RunSemanticPass();
 
     void GenerateAnclIR();
@@ -52,26 +74,57 @@ public:
     void SetSemanticDotInfoPath(const std::string& path);
     void SetIREmitterPath(const std::string& path);
     void SetUseOptimizations(bool useOptimizations);
+    void SetUseFastLexer(bool useFastLexer);
+    void SetThreadsNumber(size_t threadsNumber);
+    void SetVerifyDominators(bool verifyDominators);
     void SetMIREmitterPath(const std::string& path);
     void SetIntelEmitterPath(const std::string& path);
     void SetGASEmitterPath(const std::string& path);
 
 private:
-    void buildAST(anclgrammar::CParser::TranslationUnitContext* syntaxTreeEntry,
-                  const std::vector<antlr4::Token*> lineTokens);
+    struct OptimizationStage {
+        std::string Name;
+        std::function<void(ir::Function*)> Run;
+    };
+
+private:
+    using TokenSourceHandler = std::function<ParseResult(antlr4::TokenSource*)>;
+
+    ParseResult lexInput(std::istream& inputStream, const TokenSourceHandler& handler,
+                         bool stopOnLexicalErrors = true);
+    ParseResult parseTokens(antlr4::TokenSource* tokenSource);
+    ParseResult compileTokens(antlr4::TokenSource* tokenSource);
+
+    // Function bodies are checked and lowered by the thread pool
+    // after the file-scope declarations
+    void runSemanticPassParallel(ast::SemanticAstVisitor& semanticVisitor);
+    void generateAnclIRParallel(ast::IRGenAstVisitor& irGenVisitor);
+
+    void releaseAST();
+    void releaseIR();
+
+    std::vector<OptimizationStage> getOptimizationStages() const;
+    void optimizeFunction(ir::Function* function);
+
+    void buildAST(anclgrammar::CParser::TranslationUnitContext* syntaxTreeEntry);
+    void addSourceLines(const anclgrammar::FastLexer& lexer);
 
     void emitAnclIR(const std::string& filename);
     void emitMachineIR(const std::string& filename);
 
 private:
-    ast::ASTProgram m_ASTProgram;
-    ir::IRProgram m_IRProgram;
+    TScopePtr<ast::ASTProgram> m_ASTProgram = CreateScope<ast::ASTProgram>();
+    TScopePtr<ir::IRProgram> m_IRProgram = CreateScope<ir::IRProgram>();
     gen::MIRProgram m_MIRProgram;
 
     std::unordered_map<std::string, gen::LiveOUTPass> m_FunctionsLiveOUT;
     bool m_UseGraphColorAllocator = true;
 
     bool m_UseOptimizations = false;
+    bool m_UseFastLexer = false;
+    bool m_VerifyDominators = false;
+
+    TScopePtr<ThreadPool> m_ThreadPool;
 
     TScopePtr<gen::target::TargetMachine> m_TargetMachine;
 
@@ -0,0 +1,84 @@
+#include <Ancl/Driver/ThreadPool.hpp>
+
+
+ThreadPool::ThreadPool(size_t threadsNumber) {
+    m_Threads.reserve(threadsNumber);
+    for (size_t i = 0; i < threadsNumber; ++i) {
+        m_Threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_IsStopping = true;
+    }
+    m_StartCondition.notify_all();
+
+    for (std::thread& thread : m_Threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Run(size_t jobsNumber, const TJob& job) {
+    if (jobsNumber == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Job = &job;
+        m_JobsNumber = jobsNumber;
+        m_NextJob = 0;
+        m_Exceptions.assign(jobsNumber, nullptr);
+        m_BusyThreadsNumber = m_Threads.size();
+        ++m_Generation;
+    }
+    m_StartCondition.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_DoneCondition.wait(lock, [this]() {
+            return m_BusyThreadsNumber == 0;
+        });
+        m_Job = nullptr;
+    }
+
+    for (const std::exception_ptr& exception : m_Exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+void ThreadPool::workerLoop(size_t threadIndex) {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_StartCondition.wait(lock, [this, generation]() {
+                return m_IsStopping || m_Generation != generation;
+            });
+            if (m_IsStopping) {
+                return;
+            }
+            generation = m_Generation;
+        }
+
+        // Jobs are taken one by one, so long functions do not stall a whole batch
+        for (size_t jobIndex = m_NextJob++; jobIndex < m_JobsNumber; jobIndex = m_NextJob++) {
+            try {
+                (*m_Job)(jobIndex, threadIndex);
+            } catch (...) {
+                m_Exceptions[jobIndex] = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--m_BusyThreadsNumber == 0) {
+                m_DoneCondition.notify_one();
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Fixed set of worker threads that run batches of indexed jobs
+class ThreadPool {
+public:
+    using TJob = std::function<void(size_t jobIndex, size_t threadIndex)>;
+
+public:
+    ThreadPool(size_t threadsNumber);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t GetThreadsNumber() const {
+        return m_Threads.size();
+    }
+
+    // Runs jobs [0, jobsNumber) and waits for all of them,
+    // the exception of the first failed job in index order is rethrown
+    void Run(size_t jobsNumber, const TJob& job);
+
+private:
+    void workerLoop(size_t threadIndex);
+
+private:
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_StartCondition;
+    std::condition_variable m_DoneCondition;
+
+    const TJob* m_Job = nullptr;
+    size_t m_JobsNumber = 0;
+    std::atomic<size_t> m_NextJob = 0;
+    std::vector<std::exception_ptr> m_Exceptions;
+
+    uint64_t m_Generation = 0;
+    size_t m_BusyThreadsNumber = 0;
+    bool m_IsStopping = false;
+};
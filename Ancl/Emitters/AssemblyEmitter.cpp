@@ -13,15 +13,23 @@ AssemblyEmitter::AssemblyEmitter(const std::string& filename)
     : m_OutputStream(filename) {}
 
 void AssemblyEmitter::Emit(MIRProgram& program, target::TargetMachine* targetMachine) {
-    m_TargetMachine = targetMachine;
-
-    EmitHeader();
+    EmitBegin(targetMachine);
 
     for (TScopePtr<MFunction>& function : program.GetFunctions()) {
         EmitFunction(function.get());
     }
 
-    EmitGlobalData(program.GetGlobalData());
+    EmitEnd(program.GetGlobalData());
+}
+
+void AssemblyEmitter::EmitBegin(target::TargetMachine* targetMachine) {
+    m_TargetMachine = targetMachine;
+
+    EmitHeader();
+}
+
+void AssemblyEmitter::EmitEnd(const std::vector<GlobalDataArea>& globalData) {
+    EmitGlobalData(globalData);
 
     // Only for Linux
     m_OutputStream << "\n.section\t\".note.GNU-stack\",\"\",@progbits\n";
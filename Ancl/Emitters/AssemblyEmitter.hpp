@@ -16,6 +16,10 @@ public:
 
     void Emit(MIRProgram& program, target::TargetMachine* targetMachine);
 
+    // Streaming compilation: functions are emitted one by one between these calls
+    void EmitBegin(target::TargetMachine* targetMachine);
+    void EmitEnd(const std::vector<GlobalDataArea>& globalData);
+
     void EmitDataAreas(const std::vector<GlobalDataArea>& dataAreas);
     void EmitGlobalData(const std::vector<GlobalDataArea>& globalData);
 
@@ -116,6 +116,11 @@ void GASEmitter::EmitInstruction(MInstruction& instruction) {
     std::string sizeSuffix = getInstructionSuffix(instruction, targetInstrCode);
     m_OutputStream << getInstructionName(targetInstr) + sizeSuffix << "\t";
 
+    // Indirect jump
+    if (targetInstrCode == AMD64InstructionSet::JMP_R) {
+        m_OutputStream << "*";
+    }
+
     // TODO: string stream
     std::string operandsString;
     MInstruction::TOperandIt operandIt = --instruction.GetOpEnd();
@@ -147,6 +152,17 @@ std::string GASEmitter::getInstructionSuffix(MInstruction& instruction, uint64_t
         case AMD64InstructionSet::CVTSI2SS_RM:
         case AMD64InstructionSet::CVTSI2SD_RR:
         case AMD64InstructionSet::CVTSI2SD_RM:
+        // The condition suffix is ambiguous with the size one (cmovl)
+        case AMD64InstructionSet::CMOVE:
+        case AMD64InstructionSet::CMOVNE:
+        case AMD64InstructionSet::CMOVL:
+        case AMD64InstructionSet::CMOVLE:
+        case AMD64InstructionSet::CMOVG:
+        case AMD64InstructionSet::CMOVGE:
+        case AMD64InstructionSet::CMOVB:
+        case AMD64InstructionSet::CMOVBE:
+        case AMD64InstructionSet::CMOVA:
+        case AMD64InstructionSet::CMOVAE:
             return "";
 
         default:
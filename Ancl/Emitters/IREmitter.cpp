@@ -93,6 +93,40 @@ void IREmitter::emitInstruction(const Instruction* instruction) {
             m_OutputStream << std::format("branch {} '{}': {}, {}",
                                             condName, typeString, trueName, falseName);
         }
+    } else if (const auto* switchInstr = dynamic_cast<const SwitchInstruction*>(instruction)) {
+        Value* value = switchInstr->GetValue();
+        std::string valueName = getValueString(value);
+        std::string typeString = getTypeString(value->GetType());
+
+        std::string defaultName = getValueString(switchInstr->GetDefaultBasicBlock());
+
+        std::string casesString;
+        for (const auto& switchCase : switchInstr->GetCases()) {
+            std::string caseName = getValueString(switchCase.CaseValue);
+            std::string blockName = getValueString(switchCase.CaseBasicBlock);
+            casesString += std::format("[{}, {}], ", caseName, blockName);
+        }
+        if (switchInstr->GetCasesNumber()) {
+            casesString.pop_back();
+            casesString.pop_back();
+        }
+
+        m_OutputStream << std::format("switch {} '{}', {} {}",
+                                        valueName, typeString, defaultName, casesString);
+    } else if (const auto* select = dynamic_cast<const SelectInstruction*>(instruction)) {
+        std::string resultName = getValueString(select);
+        std::string typeString = getTypeString(select->GetType());
+
+        Value* condition = select->GetCondition();
+        std::string condName = getValueString(condition);
+        std::string condTypeString = getTypeString(condition->GetType());
+
+        std::string trueName = getValueString(select->GetTrueValue());
+        std::string falseName = getValueString(select->GetFalseValue());
+
+        m_OutputStream << std::format("select {}, {} '{}', {}, {} '{}'",
+                                        resultName, condName, condTypeString,
+                                        trueName, falseName, typeString);
     } else if (const auto* call = dynamic_cast<const CallInstruction*>(instruction)) {
         std::string callName = getValueString(call);
 
@@ -113,8 +147,13 @@ void IREmitter::emitInstruction(const Instruction* instruction) {
             argsString.pop_back();
         }
 
-        m_OutputStream << std::format("call {} '{}' {}({})",
-                                        callName, retTypeString, calleeName, argsString);
+        std::string instrName = "call";
+        if (call->IsTailCall()) {
+            instrName += " <tail>";
+        }
+
+        m_OutputStream << std::format("{} {} '{}' {}({})",
+                                        instrName, callName, retTypeString, calleeName, argsString);
     } else if (const auto* compare = dynamic_cast<const CompareInstruction*>(instruction)) {
         std::string instrName = compare->GetOpTypeStr();
 
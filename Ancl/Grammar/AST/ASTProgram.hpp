@@ -1,17 +1,44 @@
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include <Ancl/Grammar/AST/Base/ASTNode.hpp>
+#include <Ancl/Grammar/AST/Base/Identifier.hpp>
+#include <Ancl/Grammar/AST/Base/SourceManager.hpp>
 #include <Ancl/Grammar/AST/Type/TypeNode.hpp>
 #include <Ancl/Grammar/AST/Declaration/TranslationUnit.hpp>
 
-#include <Ancl/Tracker.hpp>
+#include <Ancl/ArenaTracker.hpp>
 
 
 namespace ast {
 
 class ASTProgram {
+public:
+    // Function bodies checked in parallel allocate from per-thread pools,
+    // the pools belong to the program and live as long as it
+    struct AllocationPool {
+        ArenaTracker<ASTNode> BodyTracker;
+        ArenaTracker<TypeNode> TypeTracker;
+    };
+
+    // Routes allocations of the current thread to the pool while alive
+    class ThreadAllocationScope {
+    public:
+        ThreadAllocationScope(AllocationPool* pool)
+            : m_PreviousPool(s_ThreadPool) {
+            s_ThreadPool = pool;
+        }
+
+        ~ThreadAllocationScope() {
+            s_ThreadPool = m_PreviousPool;
+        }
+
+    private:
+        AllocationPool* m_PreviousPool;
+    };
+
 public:
     ASTProgram() = default;
     ~ASTProgram() = default;
@@ -24,21 +51,90 @@ public:
         return m_TranslationUnit;
     }
 
+    Identifier GetIdentifier(std::string_view name) {
+        return m_Identifiers.Get(name);
+    }
+
+    SourceManager& GetSourceManager() {
+        return m_SourceManager;
+    }
+
+    const SourceManager& GetSourceManager() const {
+        return m_SourceManager;
+    }
+
     template<typename T, typename... Args>
     T* CreateAstNode(Args&&... args) {
+        if (s_ThreadPool) {
+            return s_ThreadPool->BodyTracker.Allocate<T>(std::forward<Args>(args)...);
+        }
+        if (m_IsFunctionBody) {
+            return m_BodyTracker.Allocate<T>(std::forward<Args>(args)...);
+        }
         return m_AstTracker.Allocate<T>(std::forward<Args>(args)...);
     }
 
+    // Nodes created between BeginFunctionBody() and EndFunctionBody()
+    // belong to function bodies and are released by ReleaseFunctionBodies()
+    // Pool allocations always belong to bodies, so workers leave the flag alone
+    void BeginFunctionBody() {
+        if (!s_ThreadPool) {
+            m_IsFunctionBody = true;
+        }
+    }
+
+    void EndFunctionBody() {
+        if (!s_ThreadPool) {
+            m_IsFunctionBody = false;
+        }
+    }
+
+    void ReleaseFunctionBodies() {
+        m_BodyTracker.DeallocateAll();
+        for (AllocationPool& pool : m_Pools) {
+            pool.BodyTracker.DeallocateAll();
+        }
+    }
+
+    // Must be called before the workers start
+    AllocationPool* CreateAllocationPool() {
+        return &m_Pools.emplace_back();
+    }
+
+    size_t GetAllocatedBytes() const {
+        size_t bytes = m_AstTracker.GetAllocatedBytes() + m_BodyTracker.GetAllocatedBytes() +
+                       m_TypeTracker.GetAllocatedBytes();
+        for (const AllocationPool& pool : m_Pools) {
+            bytes += pool.BodyTracker.GetAllocatedBytes() + pool.TypeTracker.GetAllocatedBytes();
+        }
+        return bytes;
+    }
+
     template<typename T, typename... Args>
     T* CreateType(Args&&... args) {
+        if (s_ThreadPool) {
+            return s_ThreadPool->TypeTracker.Allocate<T>(std::forward<Args>(args)...);
+        }
         return m_TypeTracker.Allocate<T>(std::forward<Args>(args)...);
     }
 
 private:
-    Tracker<ASTNode> m_AstTracker;
-    Tracker<TypeNode> m_TypeTracker;
+    // Declared first: names outlive the nodes that refer to them
+    IdentifierTable m_Identifiers;
+
+    ArenaTracker<ASTNode> m_AstTracker;
+    ArenaTracker<ASTNode> m_BodyTracker;
+    ArenaTracker<TypeNode> m_TypeTracker;
+
+    std::deque<AllocationPool> m_Pools;
+
+    SourceManager m_SourceManager;
+
+    bool m_IsFunctionBody = false;
+
+    TranslationUnit* m_TranslationUnit = nullptr;
 
-    TranslationUnit* m_TranslationUnit;
+    inline static thread_local AllocationPool* s_ThreadPool = nullptr;
 };
 
 }  // namespace ast
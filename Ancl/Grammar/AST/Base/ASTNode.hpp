@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility>
+
 #include <Ancl/Visitor/AstVisitor.hpp>
 #include <Ancl/Grammar/AST/Base/Location.hpp>
 
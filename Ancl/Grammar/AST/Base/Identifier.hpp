@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+
+namespace ast {
+
+// Interned name: equal names share one string owned by IdentifierTable,
+// so identifiers are compared and hashed by pointer
+class Identifier {
+public:
+    Identifier() = default;
+
+    explicit Identifier(const std::string* name)
+        : m_Name(name) {}
+
+    bool IsEmpty() const {
+        return !m_Name || m_Name->empty();
+    }
+
+    const std::string& GetString() const {
+        static const std::string kEmptyName;
+        return m_Name ? *m_Name : kEmptyName;
+    }
+
+    bool operator==(const Identifier& other) const = default;
+
+private:
+    friend struct std::hash<Identifier>;
+
+    const std::string* m_Name = nullptr;
+};
+
+class IdentifierTable {
+public:
+    IdentifierTable() = default;
+
+    IdentifierTable(const IdentifierTable&) = delete;
+    IdentifierTable& operator=(const IdentifierTable&) = delete;
+
+    Identifier Get(std::string_view name) {
+        auto it = m_Names.find(name);
+        if (it == m_Names.end()) {
+            it = m_Names.emplace(name).first;
+        }
+        return Identifier(&*it);
+    }
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    // Node-based set: interned strings never move
+    std::unordered_set<std::string, NameHash, std::equal_to<>> m_Names;
+};
+
+}  // namespace ast
+
+
+template <>
+struct std::hash<ast::Identifier> {
+    size_t operator()(const ast::Identifier& identifier) const {
+        return std::hash<const std::string*>{}(identifier.m_Name);
+    }
+};
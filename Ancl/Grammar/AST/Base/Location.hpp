@@ -1,34 +1,26 @@
 #pragma once
 
-#include <format>
-
-#include <Ancl/Grammar/AST/Base/Position.hpp>
+#include <cstdint>
 
 
+// Offsets of the first and the last token of a node in the parsed buffer,
+// file, line and column are resolved by SourceManager when they are needed
 class Location {
 public:
     Location() = default;
 
-    Location(Position begin, Position end)
-        : m_Begin(std::move(begin)), m_End(std::move(end)) {}
+    Location(uint32_t begin, uint32_t end)
+        : m_Begin(begin), m_End(end) {}
 
-    Position GetBegin() const {
+    uint32_t GetBegin() const {
         return m_Begin;
     }
 
-    Position GetEnd() const {
+    uint32_t GetEnd() const {
         return m_End;
     }
 
-    std::string ToString() const {
-        std::string filename = m_Begin.GetFileName();
-        return std::format("{}:{}.{}-{}.{}",
-                           std::move(filename),
-                           m_Begin.GetLine(), m_Begin.GetColumn(),
-                           m_End.GetLine(), m_End.GetColumn());
-    }
-
 private:
-    Position m_Begin;
-    Position m_End;
+    uint32_t m_Begin = 0;
+    uint32_t m_End = 0;
 };
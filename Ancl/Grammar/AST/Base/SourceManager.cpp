@@ -0,0 +1,64 @@
+#include <Ancl/Grammar/AST/Base/SourceManager.hpp>
+
+#include <algorithm>
+#include <format>
+
+
+void SourceManager::AddFileMarker(const std::string& filename) {
+    if (m_FileNames.empty() || m_FileNames.back() != filename) {
+        m_FileNames.push_back(filename);
+    }
+    m_IsNewFile = true;
+}
+
+void SourceManager::AddToken(uint32_t offset, uint32_t line, uint32_t column) {
+    if (!m_Lines.empty() && !m_IsNewFile) {
+        // The entry covers the token while its columns advance with the offsets
+        const LineEntry& entry = m_Lines.back();
+        if (entry.Line == line && column - entry.Column == offset - entry.Offset) {
+            return;
+        }
+    }
+
+    uint32_t fileIndex = m_FileNames.empty() ? 0 : m_FileNames.size() - 1;
+    m_Lines.push_back({offset, line, column, fileIndex});
+    m_IsNewFile = false;
+}
+
+Position SourceManager::GetPosition(uint32_t offset) const {
+    const LineEntry* entry = findLine(offset);
+    if (!entry) {
+        return Position("unknown");
+    }
+
+    // Offsets are counted from the entry, it ends before the next multibyte character
+    return Position(getFileName(entry), entry->Line, entry->Column + (offset - entry->Offset));
+}
+
+std::string SourceManager::ToString(const Location& location) const {
+    Position begin = GetPosition(location.GetBegin());
+    Position end = GetPosition(location.GetEnd());
+    return std::format("{}:{}.{}-{}.{}",
+                       begin.GetFileName(),
+                       begin.GetLine(), begin.GetColumn(),
+                       end.GetLine(), end.GetColumn());
+}
+
+const SourceManager::LineEntry* SourceManager::findLine(uint32_t offset) const {
+    auto it = std::upper_bound(m_Lines.begin(), m_Lines.end(), offset,
+                               [](uint32_t offset, const LineEntry& entry) {
+        return offset < entry.Offset;
+    });
+    if (it == m_Lines.begin()) {
+        return nullptr;
+    }
+    return &*std::prev(it);
+}
+
+const std::string& SourceManager::getFileName(const LineEntry* entry) const {
+    static const std::string kUnknownFile = "unknown";
+    if (m_FileNames.empty()) {
+        return kUnknownFile;
+    }
+    return m_FileNames[entry->FileIndex];
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <Ancl/Grammar/AST/Base/Location.hpp>
+#include <Ancl/Grammar/AST/Base/Position.hpp>
+
+
+// Maps buffer offsets to file positions.
+// Stores one entry per source line that has tokens and one name per #line file.
+// Offsets may count bytes while columns count code points, so a line gets
+// another entry after every multibyte character.
+class SourceManager {
+public:
+    SourceManager() = default;
+
+    // Subsequent lines belong to the file, called for every #line marker
+    void AddFileMarker(const std::string& filename);
+
+    // Registers a token, tokens must be added in the buffer order
+    void AddToken(uint32_t offset, uint32_t line, uint32_t column);
+
+    Position GetPosition(uint32_t offset) const;
+
+    std::string ToString(const Location& location) const;
+
+private:
+    struct LineEntry {
+        uint32_t Offset;
+        uint32_t Line;
+        uint32_t Column;
+        uint32_t FileIndex;
+    };
+
+    const LineEntry* findLine(uint32_t offset) const;
+    const std::string& getFileName(const LineEntry* entry) const;
+
+private:
+    std::vector<std::string> m_FileNames;
+    std::vector<LineEntry> m_Lines;
+
+    bool m_IsNewFile = false;
+};
@@ -3,6 +3,7 @@
 #include <string>
 
 #include <Ancl/Grammar/AST/Base/ASTNode.hpp>
+#include <Ancl/Grammar/AST/Base/Identifier.hpp>
 
 
 namespace ast {
@@ -11,8 +12,8 @@ class Declaration: public ASTNode {
 public:
     Declaration() = default;
 
-    Declaration(std::string name)
-        : m_Name(std::move(name)) {}
+    Declaration(Identifier name)
+        : m_Name(name) {}
 
     virtual ~Declaration() = default;
 
@@ -20,15 +21,19 @@ public:
         visitor.Visit(*this);
     }
 
-    void SetName(const std::string& name) {
+    void SetName(Identifier name) {
         m_Name = name;
     }
 
     bool HasName() const {
-        return !m_Name.empty();
+        return !m_Name.IsEmpty();
     }
 
-    std::string GetName() const {
+    const std::string& GetName() const {
+        return m_Name.GetString();
+    }
+
+    Identifier GetIdentifier() const {
         return m_Name;
     }
 
@@ -39,7 +44,7 @@ public:
     virtual bool IsValueDecl() const = 0;
 
 private:
-    std::string m_Name;
+    Identifier m_Name;
 };
 
 }  // namespace ast
@@ -9,7 +9,7 @@ class FieldDeclaration: public ValueDeclaration {
 public:
     FieldDeclaration() = default;
 
-    FieldDeclaration(const std::string& name, QualType type = nullptr)
+    FieldDeclaration(Identifier name, QualType type = nullptr)
         : ValueDeclaration(name, type) {}
 
     void Accept(AstVisitor& visitor) override {
@@ -19,15 +19,21 @@ public:
     }
 
     bool IsDefinition() const {
-        return m_Body;
+        return m_Body || m_IsBodyReleased;
     }
 
     void SetBody(Statement* body) {
         m_Body = body;
     }
 
+    // The function stays a definition, but its statements are gone
+    void ReleaseBody() {
+        m_Body = nullptr;
+        m_IsBodyReleased = true;
+    }
+
     bool HasBody() const {
-        return m_Body;
+        return m_Body || m_IsBodyReleased;
     }
 
     Statement* GetBody() const {
@@ -67,7 +73,8 @@ public:
     }
 
 private:
-    Statement* m_Body;
+    Statement* m_Body = nullptr;
+    bool m_IsBodyReleased = false;
     std::vector<ParameterDeclaration*> m_Params;
 
     StorageClass m_StorageClass = StorageClass::kNone;
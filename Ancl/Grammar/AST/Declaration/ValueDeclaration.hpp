@@ -10,7 +10,7 @@ class ValueDeclaration: public Declaration {
 public:
     ValueDeclaration() = default;
 
-    ValueDeclaration(const std::string& name, QualType type = nullptr)
+    ValueDeclaration(Identifier name, QualType type = nullptr)
         : Declaration(name), m_Type(type) {}
 
     virtual ~ValueDeclaration() = default;
@@ -27,6 +27,15 @@ public:
         return m_Type;
     }
 
+    // Set by the semantic pass for '&decl', such values must live in memory
+    void SetAddressTaken() {
+        m_IsAddressTaken = true;
+    }
+
+    bool IsAddressTaken() const {
+        return m_IsAddressTaken;
+    }
+
     bool IsLabelDecl() const override {
         return false;
     }
@@ -41,6 +50,8 @@ public:
 
 private:
     QualType m_Type;
+
+    bool m_IsAddressTaken = false;
 };
 
 }  // namespace ast
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <Ancl/Grammar/AST/Statement/Expression/Expression.hpp>
 
 
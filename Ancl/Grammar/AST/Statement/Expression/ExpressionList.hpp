@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include <Ancl/Grammar/AST/Statement/Expression/Expression.hpp>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 #include <Ancl/Grammar/AST/Statement/Expression/Expression.hpp>
@@ -20,6 +21,10 @@ public:
         m_Inits.push_back(init);
     }
 
+    void SetInit(size_t index, Expression* init) {
+        m_Inits[index] = init;
+    }
+
     std::vector<Expression*> GetInits() const {
         return m_Inits;
     }
@@ -0,0 +1,33 @@
+#include <Ancl/Grammar/Lexer/DeclarationTokenSource.hpp>
+
+#include <iterator>
+
+
+namespace anclgrammar {
+
+DeclarationTokenSource::DeclarationTokenSource(antlr4::TokenSource& source)
+    : m_Source(source) {}
+
+std::unique_ptr<antlr4::Token> DeclarationTokenSource::nextToken() {
+    if (m_Lookahead.empty()) {
+        return m_Source.nextToken();
+    }
+
+    std::unique_ptr<antlr4::Token> token = std::move(m_Lookahead.front());
+    m_Lookahead.pop_front();
+    return token;
+}
+
+void DeclarationTokenSource::ReturnLookahead(antlr4::BufferedTokenStream& tokens) {
+    // The stream releases its tokens, so the unconsumed ones are copied
+    std::deque<std::unique_ptr<antlr4::Token>> lookahead;
+    for (size_t i = tokens.index(); i < tokens.size(); ++i) {
+        lookahead.push_back(std::make_unique<antlr4::CommonToken>(tokens.get(i)));
+    }
+
+    // Followed by the replayed tokens the stream has not fetched
+    std::move(m_Lookahead.begin(), m_Lookahead.end(), std::back_inserter(lookahead));
+    m_Lookahead = std::move(lookahead);
+}
+
+}  // namespace anclgrammar
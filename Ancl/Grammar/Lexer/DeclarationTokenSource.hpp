@@ -0,0 +1,48 @@
+#pragma once
+
+#include <deque>
+
+#include "antlr4-runtime.h"
+
+
+namespace anclgrammar {
+
+// Lets every external declaration be parsed from its own token stream.
+// The tokens a stream fetched past its declaration are replayed to the next one,
+// so only the tokens of one declaration are alive at a time.
+class DeclarationTokenSource: public antlr4::TokenSource {
+public:
+    DeclarationTokenSource(antlr4::TokenSource& source);
+
+    std::unique_ptr<antlr4::Token> nextToken() override;
+
+    // Takes the tokens after the parsed declaration before the stream is released
+    void ReturnLookahead(antlr4::BufferedTokenStream& tokens);
+
+    size_t getLine() const override {
+        return m_Source.getLine();
+    }
+
+    size_t getCharPositionInLine() override {
+        return m_Source.getCharPositionInLine();
+    }
+
+    antlr4::CharStream* getInputStream() override {
+        return m_Source.getInputStream();
+    }
+
+    std::string getSourceName() override {
+        return m_Source.getSourceName();
+    }
+
+    antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() override {
+        return m_Source.getTokenFactory();
+    }
+
+private:
+    antlr4::TokenSource& m_Source;
+
+    std::deque<std::unique_ptr<antlr4::Token>> m_Lookahead;
+};
+
+}  // namespace anclgrammar
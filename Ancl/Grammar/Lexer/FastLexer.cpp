@@ -0,0 +1,845 @@
+#include <Ancl/Grammar/Lexer/FastLexer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <Ancl/Logger/Logger.hpp>
+
+
+namespace anclgrammar {
+
+namespace {
+
+// Every scan loop reads whole blocks, so the buffer is padded
+// with one block of zero bytes that no character class accepts
+constexpr size_t kBlockSize = 16;
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isHexDigit(char c) {
+    return isDigit(c) || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f');
+}
+
+bool isOctalDigit(char c) {
+    return c >= '0' && c <= '7';
+}
+
+bool isNondigit(char c) {
+    return ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '_';
+}
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+#if defined(__SSE2__)
+
+__m128i loadBlock(const char* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+__m128i inRange(__m128i block, char low, char high) {
+    __m128i notLess = _mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(low - 1)));
+    __m128i notGreater = _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(high + 1)));
+    return _mm_and_si128(notLess, notGreater);
+}
+
+uint32_t identifierMask(const char* data) {
+    __m128i block = loadBlock(data);
+    __m128i lower = _mm_or_si128(block, _mm_set1_epi8(0x20));
+    __m128i mask = _mm_or_si128(inRange(lower, 'a', 'z'), inRange(block, '0', '9'));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8('_')));
+    return _mm_movemask_epi8(mask);
+}
+
+uint32_t whitespaceMask(const char* data) {
+    __m128i block = loadBlock(data);
+    __m128i mask = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                                _mm_cmpeq_epi8(block, _mm_set1_epi8('\t')));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8('\n')));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8('\r')));
+    return _mm_movemask_epi8(mask);
+}
+
+uint32_t anyOfMask(const char* data, char a, char b, char c, char d) {
+    __m128i block = loadBlock(data);
+    __m128i mask = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(a)),
+                                _mm_cmpeq_epi8(block, _mm_set1_epi8(b)));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi8(block, _mm_set1_epi8(d)));
+    return _mm_movemask_epi8(mask);
+}
+
+uint32_t nonASCIIMask(const char* data) {
+    return _mm_movemask_epi8(loadBlock(data));
+}
+
+#else
+
+template <typename TPredicate>
+uint32_t scalarMask(const char* data, TPredicate predicate) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        if (predicate(data[i])) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+uint32_t identifierMask(const char* data) {
+    return scalarMask(data, [](char c) { return isNondigit(c) || isDigit(c); });
+}
+
+uint32_t whitespaceMask(const char* data) {
+    return scalarMask(data, isWhitespace);
+}
+
+uint32_t anyOfMask(const char* data, char a, char b, char c, char d) {
+    return scalarMask(data, [=](char x) { return x == a || x == b || x == c || x == d; });
+}
+
+uint32_t nonASCIIMask(const char* data) {
+    return scalarMask(data, [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+}
+
+#endif
+
+// Position of the first byte at or after pos that is not in the class
+template <typename TMaskFn>
+size_t skipMatching(const char* data, size_t pos, TMaskFn maskFn) {
+    while (true) {
+        uint32_t mask = ~maskFn(data + pos) & 0xFFFF;
+        if (mask) {
+            return pos + std::countr_zero(mask);
+        }
+        pos += kBlockSize;
+    }
+}
+
+// Position of the first byte in [pos, end) that is in the class, or end
+template <typename TMaskFn>
+size_t findMatching(const char* data, size_t pos, size_t end, TMaskFn maskFn) {
+    while (pos < end) {
+        uint32_t mask = maskFn(data + pos);
+        if (mask) {
+            return std::min(pos + std::countr_zero(mask), end);
+        }
+        pos += kBlockSize;
+    }
+    return end;
+}
+
+size_t findByte(const char* data, size_t pos, size_t end, char c) {
+    return findMatching(data, pos, end, [c](const char* block) {
+        return anyOfMask(block, c, c, c, c);
+    });
+}
+
+struct Keyword {
+    std::string_view Text;
+    FastTokenKind Kind;
+};
+
+constexpr std::array<Keyword, 34> kKeywords = {{
+    {"auto", FastTokenKind::kAuto}, {"break", FastTokenKind::kBreak},
+    {"case", FastTokenKind::kCase}, {"char", FastTokenKind::kChar},
+    {"const", FastTokenKind::kConst}, {"continue", FastTokenKind::kContinue},
+    {"default", FastTokenKind::kDefault}, {"do", FastTokenKind::kDo},
+    {"double", FastTokenKind::kDouble}, {"else", FastTokenKind::kElse},
+    {"enum", FastTokenKind::kEnum}, {"extern", FastTokenKind::kExtern},
+    {"float", FastTokenKind::kFloat}, {"for", FastTokenKind::kFor},
+    {"goto", FastTokenKind::kGoto}, {"if", FastTokenKind::kIf},
+    {"inline", FastTokenKind::kInline}, {"int", FastTokenKind::kInt},
+    {"long", FastTokenKind::kLong}, {"register", FastTokenKind::kRegister},
+    {"restrict", FastTokenKind::kRestrict}, {"return", FastTokenKind::kReturn},
+    {"short", FastTokenKind::kShort}, {"signed", FastTokenKind::kSigned},
+    {"sizeof", FastTokenKind::kSizeof}, {"static", FastTokenKind::kStatic},
+    {"struct", FastTokenKind::kStruct}, {"switch", FastTokenKind::kSwitch},
+    {"typedef", FastTokenKind::kTypedef}, {"union", FastTokenKind::kUnion},
+    {"unsigned", FastTokenKind::kUnsigned}, {"void", FastTokenKind::kVoid},
+    {"volatile", FastTokenKind::kVolatile}, {"while", FastTokenKind::kWhile},
+}};
+
+// Keywords bucketed by the first letter
+using TKeywordTable = std::array<std::vector<Keyword>, 26>;
+
+TKeywordTable buildKeywordTable() {
+    TKeywordTable table;
+    for (const Keyword& keyword : kKeywords) {
+        table[keyword.Text[0] - 'a'].push_back(keyword);
+    }
+    return table;
+}
+
+FastTokenKind lookupKeyword(std::string_view text) {
+    static const TKeywordTable kKeywordTable = buildKeywordTable();
+
+    if (text.size() < 2 || text.size() > 8 || text[0] < 'a' || text[0] > 'z') {
+        return FastTokenKind::kIdentifier;
+    }
+    for (const Keyword& keyword : kKeywordTable[text[0] - 'a']) {
+        if (keyword.Text == text) {
+            return keyword.Kind;
+        }
+    }
+    return FastTokenKind::kIdentifier;
+}
+
+}  // namespace
+
+FastLexer::FastLexer(std::string buffer)
+        : m_Buffer(std::move(buffer)), m_Size(m_Buffer.size()) {
+    if (m_Size > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Input is too large for the fast lexer");
+    }
+    m_Buffer.append(kBlockSize, '\0');
+
+    for (size_t pos = 0; pos < m_Size && !m_HasNonASCII; pos += kBlockSize) {
+        uint32_t mask = nonASCIIMask(m_Buffer.data() + pos);
+        if (m_Size - pos < kBlockSize) {
+            mask &= (1u << (m_Size - pos)) - 1;
+        }
+        m_HasNonASCII = mask != 0;
+    }
+}
+
+void FastLexer::Tokenize() {
+    m_Tokens.clear();
+    // Roughly one token per five bytes of C source
+    m_Tokens.reserve(m_Size / 5 + 1);
+
+    m_Pos = 0;
+    m_Line = 1;
+    m_LineStart = 0;
+    m_ErrorsNumber = 0;
+
+    while (true) {
+        skipWhitespace();
+        if (m_Pos >= m_Size) {
+            break;
+        }
+        lexToken();
+    }
+}
+
+void FastLexer::lexToken() {
+    char c = peek();
+
+    if (isNondigit(c)) {
+        // Encoding prefixes of character constants and string literals
+        if (c == 'u' && peek(1) == '8' && peek(2) == '"') {
+            return lexQuoted('"', 2);
+        }
+        if ((c == 'L' || c == 'u' || c == 'U') && (peek(1) == '\'' || peek(1) == '"')) {
+            return lexQuoted(peek(1), 1);
+        }
+        return lexIdentifier();
+    }
+
+    if (isDigit(c) || (c == '.' && isDigit(peek(1)))) {
+        return lexNumber();
+    }
+
+    switch (c) {
+        case '\'':
+        case '"':
+            return lexQuoted(c, 0);
+
+        case '#':
+            return lexDirective();
+
+        case '/':
+            if (peek(1) == '*') {
+                return skipBlockComment();
+            }
+            if (peek(1) == '/') {
+                return skipLineComment();
+            }
+            break;
+
+        case '\\':
+            if (scanUniversalCharacterName(m_Pos) != m_Pos) {
+                return lexIdentifier();
+            }
+            return reportError(m_Pos, scanUniversalCharacterNameError(m_Pos));
+
+        default:
+            break;
+    }
+
+    lexPunctuator();
+}
+
+void FastLexer::lexIdentifier() {
+    size_t begin = m_Pos;
+    size_t pos = begin;
+    while (true) {
+        pos = scanIdentifierTail(pos);
+        size_t ucnEnd = scanUniversalCharacterName(pos);
+        if (ucnEnd == pos) {
+            break;
+        }
+        pos = ucnEnd;
+    }
+
+    std::string_view text = std::string_view(m_Buffer).substr(begin, pos - begin);
+    addToken(lookupKeyword(text), begin, pos);
+    m_Pos = pos;
+}
+
+void FastLexer::lexNumber() {
+    // Longest match wins, ties are resolved by the rule order of CLexer.g4
+    size_t integerLength = scanIntegerLength();
+    size_t floatLength = scanFloatLength();
+    size_t digitsLength = scanDigits(m_Pos) - m_Pos;
+
+    FastTokenKind kind = FastTokenKind::kIntegerConstant;
+    size_t length = integerLength;
+    if (floatLength > length) {
+        kind = FastTokenKind::kFloatingConstant;
+        length = floatLength;
+    }
+    if (digitsLength > length) {
+        kind = FastTokenKind::kDigitSequence;
+        length = digitsLength;
+    }
+
+    addToken(kind, m_Pos, m_Pos + length);
+    m_Pos += length;
+}
+
+void FastLexer::lexQuoted(char quote, size_t prefixLength) {
+    size_t begin = m_Pos;
+    size_t pos = begin + prefixLength + 1;
+    bool isString = (quote == '"');
+
+    const char* data = m_Buffer.data();
+    while (true) {
+        pos = findMatching(data, pos, m_Size, [quote](const char* block) {
+            return anyOfMask(block, quote, '\\', '\n', '\r');
+        });
+        if (pos >= m_Size || data[pos] == '\n' || data[pos] == '\r') {
+            break;
+        }
+
+        if (data[pos] == quote) {
+            // Character constant must not be empty
+            if (!isString && pos == begin + prefixLength + 1) {
+                break;
+            }
+            size_t end = pos + 1;
+            addToken(isString ? FastTokenKind::kStringLiteral : FastTokenKind::kCharacterConstant,
+                     begin, end);
+            countNewlines(begin, end);
+            m_Pos = end;
+            return;
+        }
+
+        size_t escapeEnd = scanEscapeSequence(pos);
+        if (escapeEnd == pos && isString) {
+            // Line continuation inside a string literal
+            if (data[pos + 1] == '\n') {
+                escapeEnd = pos + 2;
+            } else if (data[pos + 1] == '\r' && data[pos + 2] == '\n') {
+                escapeEnd = pos + 3;
+            }
+        }
+        if (escapeEnd == pos) {
+            pos = scanEscapeError(pos, isString);
+            break;
+        }
+        pos = escapeEnd;
+    }
+
+    // Not a literal: the prefix is an ordinary identifier
+    if (prefixLength > 0) {
+        return lexIdentifier();
+    }
+    reportError(begin, pos);
+}
+
+void FastLexer::lexDirective() {
+    const char* data = m_Buffer.data();
+    size_t begin = m_Pos;
+
+    // Directive and MultiLineMacro run to the end of the (continued) line
+    size_t end = findByte(data, begin, m_Size, '\n');
+    while (end < m_Size) {
+        size_t last = end;
+        if (last > begin && data[last - 1] == '\r') {
+            --last;
+        }
+        bool isContinued = last > begin && data[last - 1] == '\\';
+        if (!isContinued || end + 1 >= m_Size || data[end + 1] == '\n') {
+            break;
+        }
+        end = findByte(data, end + 1, m_Size, '\n');
+    }
+
+    // '#line ' DecimalConstant ' ' '"' SCharSequence? '"'
+    constexpr std::string_view kLinePrefix = "#line ";
+    std::string_view text = std::string_view(m_Buffer).substr(begin, end - begin);
+    if (text.starts_with(kLinePrefix) && text.size() > kLinePrefix.size() &&
+            text[kLinePrefix.size()] >= '1' && text[kLinePrefix.size()] <= '9') {
+        size_t numberBegin = begin + kLinePrefix.size();
+        size_t numberEnd = scanDigits(numberBegin);
+        size_t nameBegin = numberEnd + 2;
+        if (data[numberEnd] == ' ' && data[numberEnd + 1] == '"' &&
+                end > nameBegin && data[end - 1] == '"' &&
+                findByte(data, nameBegin, end - 1, '"') == end - 1) {
+            uint64_t line = 0;
+            for (size_t pos = numberBegin; pos < numberEnd; ++pos) {
+                line = line * 10 + (data[pos] - '0');
+            }
+
+            addToken(FastTokenKind::kLineDirective, begin, end);
+            m_Tokens.back().Offset = nameBegin;
+            m_Tokens.back().Length = end - 1 - nameBegin;
+
+            // The newline after the directive starts the line with the given number
+            m_Line = line - 1;
+            m_Pos = end;
+            return;
+        }
+    }
+
+    countNewlines(begin, end);
+    m_Pos = end;
+}
+
+void FastLexer::lexPunctuator() {
+    auto punctuator = [this](FastTokenKind kind, size_t length) {
+        addToken(kind, m_Pos, m_Pos + length);
+        m_Pos += length;
+    };
+
+    char next = peek(1);
+    switch (peek()) {
+        case '(': return punctuator(FastTokenKind::kLeftParen, 1);
+        case ')': return punctuator(FastTokenKind::kRightParen, 1);
+        case '[': return punctuator(FastTokenKind::kLeftBracket, 1);
+        case ']': return punctuator(FastTokenKind::kRightBracket, 1);
+        case '{': return punctuator(FastTokenKind::kLeftBrace, 1);
+        case '}': return punctuator(FastTokenKind::kRightBrace, 1);
+        case '?': return punctuator(FastTokenKind::kQuestion, 1);
+        case ':': return punctuator(FastTokenKind::kColon, 1);
+        case ';': return punctuator(FastTokenKind::kSemi, 1);
+        case ',': return punctuator(FastTokenKind::kComma, 1);
+        case '~': return punctuator(FastTokenKind::kTilde, 1);
+
+        case '<':
+            if (next == '<') {
+                return peek(2) == '=' ? punctuator(FastTokenKind::kLeftShiftAssign, 3)
+                                      : punctuator(FastTokenKind::kLeftShift, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kLessEqual, 2)
+                               : punctuator(FastTokenKind::kLess, 1);
+
+        case '>':
+            if (next == '>') {
+                return peek(2) == '=' ? punctuator(FastTokenKind::kRightShiftAssign, 3)
+                                      : punctuator(FastTokenKind::kRightShift, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kGreaterEqual, 2)
+                               : punctuator(FastTokenKind::kGreater, 1);
+
+        case '+':
+            if (next == '+') {
+                return punctuator(FastTokenKind::kPlusPlus, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kPlusAssign, 2)
+                               : punctuator(FastTokenKind::kPlus, 1);
+
+        case '-':
+            if (next == '-') {
+                return punctuator(FastTokenKind::kMinusMinus, 2);
+            }
+            if (next == '>') {
+                return punctuator(FastTokenKind::kArrow, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kMinusAssign, 2)
+                               : punctuator(FastTokenKind::kMinus, 1);
+
+        case '*':
+            return next == '=' ? punctuator(FastTokenKind::kStarAssign, 2)
+                               : punctuator(FastTokenKind::kStar, 1);
+
+        case '/':
+            return next == '=' ? punctuator(FastTokenKind::kDivAssign, 2)
+                               : punctuator(FastTokenKind::kDiv, 1);
+
+        case '%':
+            return next == '=' ? punctuator(FastTokenKind::kModAssign, 2)
+                               : punctuator(FastTokenKind::kMod, 1);
+
+        case '&':
+            if (next == '&') {
+                return punctuator(FastTokenKind::kAndAnd, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kAndAssign, 2)
+                               : punctuator(FastTokenKind::kAnd, 1);
+
+        case '|':
+            if (next == '|') {
+                return punctuator(FastTokenKind::kOrOr, 2);
+            }
+            return next == '=' ? punctuator(FastTokenKind::kOrAssign, 2)
+                               : punctuator(FastTokenKind::kOr, 1);
+
+        case '^':
+            return next == '=' ? punctuator(FastTokenKind::kXorAssign, 2)
+                               : punctuator(FastTokenKind::kCaret, 1);
+
+        case '!':
+            return next == '=' ? punctuator(FastTokenKind::kNotEqual, 2)
+                               : punctuator(FastTokenKind::kNot, 1);
+
+        case '=':
+            return next == '=' ? punctuator(FastTokenKind::kEqual, 2)
+                               : punctuator(FastTokenKind::kAssign, 1);
+
+        case '.':
+            if (next == '.' && peek(2) == '.') {
+                return punctuator(FastTokenKind::kEllipsis, 3);
+            }
+            return punctuator(FastTokenKind::kDot, 1);
+
+        default:
+            return reportError(m_Pos, m_Pos);
+    }
+}
+
+void FastLexer::skipWhitespace() {
+    size_t begin = m_Pos;
+    m_Pos = skipMatching(m_Buffer.data(), m_Pos, whitespaceMask);
+    if (m_Pos != begin) {
+        countNewlines(begin, m_Pos);
+    }
+}
+
+void FastLexer::skipBlockComment() {
+    const char* data = m_Buffer.data();
+    size_t begin = m_Pos;
+    size_t pos = begin + 2;
+    while (true) {
+        pos = findByte(data, pos, m_Size, '*');
+        if (pos + 1 >= m_Size) {
+            // Unterminated comment is lexed as '/' '*'
+            return lexPunctuator();
+        }
+        if (data[pos + 1] == '/') {
+            break;
+        }
+        ++pos;
+    }
+
+    size_t end = pos + 2;
+    countNewlines(begin, end);
+    m_Pos = end;
+}
+
+void FastLexer::skipLineComment() {
+    m_Pos = findMatching(m_Buffer.data(), m_Pos, m_Size, [](const char* block) {
+        return anyOfMask(block, '\n', '\r', '\n', '\r');
+    });
+}
+
+size_t FastLexer::scanIdentifierTail(size_t pos) const {
+    return skipMatching(m_Buffer.data(), pos, identifierMask);
+}
+
+size_t FastLexer::scanDigits(size_t pos) const {
+    while (isDigit(m_Buffer[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+size_t FastLexer::scanHexDigits(size_t pos) const {
+    while (isHexDigit(m_Buffer[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+size_t FastLexer::scanEscapeSequence(size_t pos) const {
+    if (m_Buffer[pos] != '\\') {
+        return pos;
+    }
+
+    char c = m_Buffer[pos + 1];
+    switch (c) {
+        case '\'': case '"': case '?': case '\\':
+        case 'a': case 'b': case 'f': case 'n':
+        case 'r': case 't': case 'v':
+            return pos + 2;
+
+        case 'x': {
+            size_t end = scanHexDigits(pos + 2);
+            return end > pos + 2 ? end : pos;
+        }
+
+        case 'u':
+        case 'U':
+            return scanUniversalCharacterName(pos);
+
+        default:
+            break;
+    }
+
+    if (isOctalDigit(c)) {
+        size_t end = pos + 2;
+        while (end < pos + 4 && isOctalDigit(m_Buffer[end])) {
+            ++end;
+        }
+        return end;
+    }
+
+    return pos;
+}
+
+size_t FastLexer::scanUniversalCharacterName(size_t pos) const {
+    if (m_Buffer[pos] != '\\') {
+        return pos;
+    }
+
+    size_t digitsNumber = 0;
+    if (m_Buffer[pos + 1] == 'u') {
+        digitsNumber = 4;
+    } else if (m_Buffer[pos + 1] == 'U') {
+        digitsNumber = 8;
+    } else {
+        return pos;
+    }
+
+    for (size_t i = 0; i < digitsNumber; ++i) {
+        if (!isHexDigit(m_Buffer[pos + 2 + i])) {
+            return pos;
+        }
+    }
+    return pos + 2 + digitsNumber;
+}
+
+// Position of the first character that does not continue the escape sequence,
+// called when the sequence is invalid
+size_t FastLexer::scanEscapeError(size_t pos, bool isString) const {
+    char c = m_Buffer[pos + 1];
+    if (c == 'x') {
+        return pos + 2;
+    }
+    if (c == 'u' || c == 'U') {
+        return scanUniversalCharacterNameError(pos);
+    }
+    if (isString && c == '\r') {
+        return pos + 2;
+    }
+    return pos + 1;
+}
+
+// Same for the universal character name
+size_t FastLexer::scanUniversalCharacterNameError(size_t pos) const {
+    char c = m_Buffer[pos + 1];
+    if (c != 'u' && c != 'U') {
+        return pos + 1;
+    }
+
+    size_t end = pos + 2;
+    size_t digitsEnd = end + (c == 'u' ? 4 : 8);
+    while (end < digitsEnd && isHexDigit(m_Buffer[end])) {
+        ++end;
+    }
+    return end;
+}
+
+size_t FastLexer::scanIntegerLength() const {
+    const char* data = m_Buffer.data();
+    size_t pos = m_Pos;
+    if (!isDigit(data[pos])) {
+        return 0;
+    }
+
+    bool isScanned = false;
+    if (data[pos] == '0' && (data[pos + 1] | 0x20) == 'x') {
+        size_t end = scanHexDigits(pos + 2);
+        if (end > pos + 2) {
+            pos = end;
+            isScanned = true;
+        }
+    } else if (data[pos] == '0' && (data[pos + 1] | 0x20) == 'b') {
+        size_t end = pos + 2;
+        while (data[end] == '0' || data[end] == '1') {
+            ++end;
+        }
+        // BinaryConstant has no suffix
+        if (end > pos + 2) {
+            return end - m_Pos;
+        }
+    }
+
+    if (!isScanned) {
+        if (data[pos] == '0') {
+            ++pos;
+            while (isOctalDigit(data[pos])) {
+                ++pos;
+            }
+        } else {
+            pos = scanDigits(pos);
+        }
+    }
+
+    auto isUnsigned = [data](size_t p) { return (data[p] | 0x20) == 'u'; };
+    auto isLong = [data](size_t p) { return data[p] == 'l' || data[p] == 'L'; };
+    auto isLongLong = [data](size_t p) {
+        return (data[p] == 'l' && data[p + 1] == 'l') || (data[p] == 'L' && data[p + 1] == 'L');
+    };
+
+    if (isUnsigned(pos)) {
+        ++pos;
+        if (isLongLong(pos)) {
+            pos += 2;
+        } else if (isLong(pos)) {
+            ++pos;
+        }
+    } else if (isLongLong(pos)) {
+        pos += 2;
+        pos += isUnsigned(pos);
+    } else if (isLong(pos)) {
+        ++pos;
+        pos += isUnsigned(pos);
+    }
+
+    return pos - m_Pos;
+}
+
+size_t FastLexer::scanFloatLength() const {
+    const char* data = m_Buffer.data();
+
+    auto scanExponent = [this, data](size_t pos, char letter) -> size_t {
+        if ((data[pos] | 0x20) != letter) {
+            return 0;
+        }
+        size_t digitsBegin = pos + 1;
+        if (data[digitsBegin] == '+' || data[digitsBegin] == '-') {
+            ++digitsBegin;
+        }
+        size_t digitsEnd = scanDigits(digitsBegin);
+        return digitsEnd > digitsBegin ? digitsEnd : 0;
+    };
+
+    auto scanSuffix = [data](size_t pos) -> size_t {
+        char c = data[pos] | 0x20;
+        return (c == 'f' || c == 'l') ? pos + 1 : pos;
+    };
+
+    size_t begin = m_Pos;
+    if (data[begin] == '0' && (data[begin + 1] | 0x20) == 'x') {
+        size_t integerEnd = scanHexDigits(begin + 2);
+        size_t mantissaEnd = integerEnd;
+        bool hasMantissa = integerEnd > begin + 2;
+        if (data[integerEnd] == '.') {
+            size_t fractionEnd = scanHexDigits(integerEnd + 1);
+            hasMantissa = hasMantissa || fractionEnd > integerEnd + 1;
+            mantissaEnd = fractionEnd;
+        }
+        if (!hasMantissa) {
+            return 0;
+        }
+        size_t exponentEnd = scanExponent(mantissaEnd, 'p');
+        return exponentEnd ? scanSuffix(exponentEnd) - begin : 0;
+    }
+
+    size_t integerEnd = scanDigits(begin);
+    bool hasInteger = integerEnd > begin;
+    if (data[integerEnd] == '.') {
+        size_t fractionEnd = scanDigits(integerEnd + 1);
+        if (!hasInteger && fractionEnd == integerEnd + 1) {
+            return 0;
+        }
+        size_t end = fractionEnd;
+        if (size_t exponentEnd = scanExponent(end, 'e')) {
+            end = exponentEnd;
+        }
+        return scanSuffix(end) - begin;
+    }
+
+    if (!hasInteger) {
+        return 0;
+    }
+    size_t exponentEnd = scanExponent(integerEnd, 'e');
+    return exponentEnd ? scanSuffix(exponentEnd) - begin : 0;
+}
+
+void FastLexer::countNewlines(size_t begin, size_t end) {
+    const char* data = m_Buffer.data();
+    for (size_t pos = begin; pos < end; pos += kBlockSize) {
+        uint32_t mask = anyOfMask(data + pos, '\n', '\n', '\n', '\n');
+        if (end - pos < kBlockSize) {
+            mask &= (1u << (end - pos)) - 1;
+        }
+        if (mask) {
+            m_Line += std::popcount(mask);
+            m_LineStart = pos + (31 - std::countl_zero(mask)) + 1;
+        }
+    }
+}
+
+void FastLexer::addToken(FastTokenKind kind, size_t begin, size_t end) {
+    FastToken token;
+    token.Offset = begin;
+    token.Length = end - begin;
+    token.Line = m_Line;
+    token.Column = getColumn(begin);
+    token.Kind = kind;
+    m_Tokens.push_back(token);
+}
+
+// Like ANTLR, skips the text up to and including the character
+// that no token can continue with
+void FastLexer::reportError(size_t begin, size_t errorPos) {
+    size_t end = m_Size;
+    if (errorPos < m_Size) {
+        // Skip the whole UTF-8 sequence of the bad character
+        auto lead = static_cast<unsigned char>(m_Buffer[errorPos]);
+        size_t length = 1;
+        if (lead >= 0xF0) {
+            length = 4;
+        } else if (lead >= 0xE0) {
+            length = 3;
+        } else if (lead >= 0xC0) {
+            length = 2;
+        }
+        end = std::min(errorPos + length, m_Size);
+    }
+
+    ANCL_ERROR("line {}:{} token recognition error at: '{}'",
+               m_Line, getColumn(begin), m_Buffer.substr(begin, end - begin));
+    ++m_ErrorsNumber;
+    countNewlines(begin, end);
+    m_Pos = end;
+}
+
+uint32_t FastLexer::getColumn(size_t pos) const {
+    if (!m_HasNonASCII) {
+        return pos - m_LineStart;
+    }
+
+    // Columns count code points like ANTLR does, not bytes
+    uint32_t column = 0;
+    for (size_t i = m_LineStart; i < pos; ++i) {
+        column += (static_cast<unsigned char>(m_Buffer[i]) & 0xC0) != 0x80;
+    }
+    return column;
+}
+
+}  // namespace anclgrammar
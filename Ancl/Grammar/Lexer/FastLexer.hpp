@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Ancl/Grammar/Lexer/FastToken.hpp>
+
+
+namespace anclgrammar {
+
+// Hand-written table-driven lexer for the CLexer.g4 grammar.
+// Works on the UTF-8 bytes directly and scans whitespace, identifiers,
+// comments and literals 16 bytes at a time (SSE2, scalar fallback otherwise).
+class FastLexer {
+public:
+    FastLexer(std::string buffer);
+
+    void Tokenize();
+
+    const std::vector<FastToken>& GetTokens() const {
+        return m_Tokens;
+    }
+
+    std::string_view GetText(const FastToken& token) const {
+        return std::string_view(m_Buffer).substr(token.Offset, token.Length);
+    }
+
+    size_t GetErrorsNumber() const {
+        return m_ErrorsNumber;
+    }
+
+private:
+    void lexToken();
+
+    void lexIdentifier();
+    void lexNumber();
+    void lexQuoted(char quote, size_t prefixLength);
+    void lexDirective();
+    void lexPunctuator();
+
+    void skipWhitespace();
+    void skipBlockComment();
+    void skipLineComment();
+
+    size_t scanIdentifierTail(size_t pos) const;
+    size_t scanDigits(size_t pos) const;
+    size_t scanHexDigits(size_t pos) const;
+    size_t scanEscapeSequence(size_t pos) const;
+    size_t scanUniversalCharacterName(size_t pos) const;
+    size_t scanEscapeError(size_t pos, bool isString) const;
+    size_t scanUniversalCharacterNameError(size_t pos) const;
+
+    size_t scanIntegerLength() const;
+    size_t scanFloatLength() const;
+
+    void countNewlines(size_t begin, size_t end);
+
+    void addToken(FastTokenKind kind, size_t begin, size_t end);
+    void reportError(size_t begin, size_t errorPos);
+
+    uint32_t getColumn(size_t pos) const;
+
+    char peek(size_t offset = 0) const {
+        return m_Buffer[m_Pos + offset];
+    }
+
+private:
+    std::string m_Buffer;
+    size_t m_Size = 0;
+
+    size_t m_Pos = 0;
+    size_t m_Line = 1;
+    size_t m_LineStart = 0;
+    bool m_HasNonASCII = false;
+
+    size_t m_ErrorsNumber = 0;
+
+    std::vector<FastToken> m_Tokens;
+};
+
+}  // namespace anclgrammar
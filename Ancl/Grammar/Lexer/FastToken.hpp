@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace anclgrammar {
+
+// Token kinds in the same order and with the same names as the rules of CLexer.g4.
+// Hidden-channel rules (whitespace, comments, directives) are never emitted.
+#define ANCL_FAST_TOKEN_LIST(X) \
+    X(Auto) X(Break) X(Case) X(Char) X(Const) X(Continue) X(Default) X(Do) \
+    X(Double) X(Else) X(Enum) X(Extern) X(Float) X(For) X(Goto) X(If) \
+    X(Inline) X(Int) X(Long) X(Register) X(Restrict) X(Return) X(Short) \
+    X(Signed) X(Sizeof) X(Static) X(Struct) X(Switch) X(Typedef) X(Union) \
+    X(Unsigned) X(Void) X(Volatile) X(While) \
+    X(LeftParen) X(RightParen) X(LeftBracket) X(RightBracket) \
+    X(LeftBrace) X(RightBrace) X(Less) X(LessEqual) X(Greater) \
+    X(GreaterEqual) X(LeftShift) X(RightShift) X(Plus) X(PlusPlus) \
+    X(Minus) X(MinusMinus) X(Star) X(Div) X(Mod) X(And) X(Or) X(AndAnd) \
+    X(OrOr) X(Caret) X(Not) X(Tilde) X(Question) X(Colon) X(Semi) \
+    X(Comma) X(Assign) X(StarAssign) X(DivAssign) X(ModAssign) \
+    X(PlusAssign) X(MinusAssign) X(LeftShiftAssign) X(RightShiftAssign) \
+    X(AndAssign) X(XorAssign) X(OrAssign) X(Equal) X(NotEqual) X(Arrow) \
+    X(Dot) X(Ellipsis) \
+    X(Identifier) X(IntegerConstant) X(FloatingConstant) X(DigitSequence) \
+    X(CharacterConstant) X(StringLiteral) X(LineDirective)
+
+enum class FastTokenKind: uint8_t {
+#define ANCL_FAST_TOKEN_ENUM(name) k##name,
+    ANCL_FAST_TOKEN_LIST(ANCL_FAST_TOKEN_ENUM)
+#undef ANCL_FAST_TOKEN_ENUM
+    kEOF,
+};
+
+// 20 bytes per token: the text is not copied, it is a slice of the lexer buffer.
+// For LineDirective the slice is the file name without quotes.
+struct FastToken {
+    uint32_t Offset = 0;
+    uint32_t Length = 0;
+    uint32_t Line = 0;
+    uint32_t Column = 0;
+    FastTokenKind Kind = FastTokenKind::kEOF;
+};
+
+}  // namespace anclgrammar
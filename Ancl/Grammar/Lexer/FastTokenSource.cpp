@@ -0,0 +1,62 @@
+#include <Ancl/Grammar/Lexer/FastTokenSource.hpp>
+
+#include "CLexer.h"
+
+
+namespace anclgrammar {
+
+FastTokenSource::FastTokenSource(const FastLexer& lexer, std::string sourceName)
+    : m_Lexer(lexer), m_SourceName(std::move(sourceName)) {}
+
+std::unique_ptr<antlr4::Token> FastTokenSource::nextToken() {
+    const std::vector<FastToken>& tokens = m_Lexer.GetTokens();
+    std::pair<antlr4::TokenSource*, antlr4::CharStream*> source{this, nullptr};
+
+    if (m_TokenIndex >= tokens.size()) {
+        return getTokenFactory()->create(source, antlr4::Token::EOF, "<EOF>",
+                                         antlr4::Token::DEFAULT_CHANNEL,
+                                         antlr4::INVALID_INDEX, antlr4::INVALID_INDEX,
+                                         getLine(), getCharPositionInLine());
+    }
+
+    const FastToken& token = tokens[m_TokenIndex++];
+    size_t channel = antlr4::Token::DEFAULT_CHANNEL;
+    if (token.Kind == FastTokenKind::kLineDirective) {
+        channel = CLexer::LINE;
+    }
+
+    return getTokenFactory()->create(source, getTokenType(token.Kind),
+                                     std::string(m_Lexer.GetText(token)), channel,
+                                     token.Offset, token.Offset + token.Length - 1,
+                                     token.Line, token.Column);
+}
+
+size_t FastTokenSource::getLine() const {
+    const std::vector<FastToken>& tokens = m_Lexer.GetTokens();
+    if (tokens.empty()) {
+        return 1;
+    }
+    return tokens[std::min(m_TokenIndex, tokens.size() - 1)].Line;
+}
+
+size_t FastTokenSource::getCharPositionInLine() {
+    const std::vector<FastToken>& tokens = m_Lexer.GetTokens();
+    if (m_TokenIndex >= tokens.size()) {
+        return 0;
+    }
+    return tokens[m_TokenIndex].Column;
+}
+
+size_t FastTokenSource::getTokenType(FastTokenKind kind) {
+    switch (kind) {
+#define ANCL_FAST_TOKEN_TYPE(name) case FastTokenKind::k##name: return CLexer::name;
+        ANCL_FAST_TOKEN_LIST(ANCL_FAST_TOKEN_TYPE)
+#undef ANCL_FAST_TOKEN_TYPE
+
+        case FastTokenKind::kEOF:
+            return antlr4::Token::EOF;
+    }
+    return antlr4::Token::INVALID_TYPE;
+}
+
+}  // namespace anclgrammar
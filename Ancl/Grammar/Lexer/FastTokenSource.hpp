@@ -0,0 +1,44 @@
+#pragma once
+
+#include "antlr4-runtime.h"
+
+#include <Ancl/Grammar/Lexer/FastLexer.hpp>
+
+
+namespace anclgrammar {
+
+// Feeds the compact token array of FastLexer into CParser.
+// An ANTLR token object is created only when the token stream pulls it,
+// source locations are registered from the token array instead.
+class FastTokenSource: public antlr4::TokenSource {
+public:
+    FastTokenSource(const FastLexer& lexer, std::string sourceName = "");
+
+    std::unique_ptr<antlr4::Token> nextToken() override;
+
+    size_t getLine() const override;
+    size_t getCharPositionInLine() override;
+
+    antlr4::CharStream* getInputStream() override {
+        return nullptr;
+    }
+
+    std::string getSourceName() override {
+        return m_SourceName;
+    }
+
+    antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() override {
+        return antlr4::CommonTokenFactory::DEFAULT.get();
+    }
+
+private:
+    static size_t getTokenType(FastTokenKind kind);
+
+private:
+    const FastLexer& m_Lexer;
+    std::string m_SourceName;
+
+    size_t m_TokenIndex = 0;
+};
+
+}  // namespace anclgrammar
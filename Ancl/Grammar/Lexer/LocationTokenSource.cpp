@@ -0,0 +1,26 @@
+#include <Ancl/Grammar/Lexer/LocationTokenSource.hpp>
+
+#include "CLexer.h"
+
+
+namespace anclgrammar {
+
+LocationTokenSource::LocationTokenSource(antlr4::TokenSource& source, SourceManager& sourceManager)
+    : m_Source(source), m_SourceManager(sourceManager) {}
+
+std::unique_ptr<antlr4::Token> LocationTokenSource::nextToken() {
+    std::unique_ptr<antlr4::Token> token = m_Source.nextToken();
+
+    // Locations refer to the tokens of the default channel only
+    if (token->getChannel() == CLexer::LINE) {
+        m_SourceManager.AddFileMarker(token->getText());
+    } else if (token->getChannel() == antlr4::Token::DEFAULT_CHANNEL &&
+               token->getType() != antlr4::Token::EOF) {
+        m_SourceManager.AddToken(token->getStartIndex(), token->getLine(),
+                                 token->getCharPositionInLine() + 1);
+    }
+
+    return token;
+}
+
+}  // namespace anclgrammar
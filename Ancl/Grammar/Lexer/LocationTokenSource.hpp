@@ -0,0 +1,43 @@
+#pragma once
+
+#include "antlr4-runtime.h"
+
+#include <Ancl/Grammar/AST/Base/SourceManager.hpp>
+
+
+namespace anclgrammar {
+
+// Registers the lines and the #line files of the tokens in the source manager
+// as the token stream pulls them from the wrapped lexer
+class LocationTokenSource: public antlr4::TokenSource {
+public:
+    LocationTokenSource(antlr4::TokenSource& source, SourceManager& sourceManager);
+
+    std::unique_ptr<antlr4::Token> nextToken() override;
+
+    size_t getLine() const override {
+        return m_Source.getLine();
+    }
+
+    size_t getCharPositionInLine() override {
+        return m_Source.getCharPositionInLine();
+    }
+
+    antlr4::CharStream* getInputStream() override {
+        return m_Source.getInputStream();
+    }
+
+    std::string getSourceName() override {
+        return m_Source.getSourceName();
+    }
+
+    antlr4::TokenFactory<antlr4::CommonToken>* getTokenFactory() override {
+        return m_Source.getTokenFactory();
+    }
+
+private:
+    antlr4::TokenSource& m_Source;
+    SourceManager& m_SourceManager;
+};
+
+}  // namespace anclgrammar
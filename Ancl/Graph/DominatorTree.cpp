@@ -1,167 +1,683 @@
 #include <Ancl/Graph/DominatorTree.hpp>
 
-#include <functional>
+#include <algorithm>
+#include <queue>
+#include <utility>
 
 
-DominatorTree::DominatorTree(ir::Function* function, bool isReverse) {
+namespace {
+
+ir::BasicBlock* getEntryBlock(ir::Function* function, bool isReverse) {
     if (isReverse) {
-        setEntryBlock(function->GetLastBlock());
-    } else {
-        setEntryBlock(function->GetEntryBlock());
+        return function->GetLastBlock();
+    }
+    return function->GetEntryBlock();
+}
+
+gen::MBasicBlock* getEntryBlock(gen::MFunction* function, bool isReverse) {
+    if (isReverse) {
+        return function->GetLastBasicBlock();
     }
+    return function->GetFirstBasicBlock();
+}
+
+// Semi-NCA link-eval with path compression over preorder positions
+uint32_t evalSemiNCA(uint32_t vertex, uint32_t lastLinked, std::vector<uint32_t>& ancestors,
+                     std::vector<uint32_t>& labels, const std::vector<uint32_t>& semis,
+                     std::vector<uint32_t>& stack) {
+    if (ancestors[vertex] < lastLinked) {
+        return labels[vertex];
+    }
+
+    stack.clear();
+    do {
+        stack.push_back(vertex);
+        vertex = ancestors[vertex];
+    } while (ancestors[vertex] >= lastLinked);
+
+    uint32_t ancestor = vertex;
+    uint32_t ancestorLabel = labels[ancestor];
+    do {
+        vertex = stack.back();
+        stack.pop_back();
 
+        ancestors[vertex] = ancestors[ancestor];
+        if (semis[ancestorLabel] < semis[labels[vertex]]) {
+            labels[vertex] = ancestorLabel;
+        } else {
+            ancestorLabel = labels[vertex];
+        }
+        ancestor = vertex;
+    } while (!stack.empty());
+
+    return labels[vertex];
+}
+
+}  // namespace
+
+
+template <typename TFunction, typename TBlock>
+DominatorTreeBase<TFunction, TBlock>::DominatorTreeBase(TFunction* function, bool isReverse,
+                                                        Algorithm algorithm)
+        : m_Function(function), m_IsReverse(isReverse), m_Algorithm(algorithm) {
     setEdgeDirections(isReverse);
+    Recalculate();
+}
 
-    computeReversePostorder();
-    solveDominance();
-    updateChildren();
-    computeDominanceFrontiers();
+template <typename TFunction, typename TBlock>
+TBlock* DominatorTreeBase<TFunction, TBlock>::GetImmediateDominator(TBlock* block) const {
+    uint32_t idom = m_IDoms[m_Numbering.at(block)];
+    if (idom == kNone) {
+        return nullptr;
+    }
+    return m_Blocks[idom];
 }
 
-ir::BasicBlock* DominatorTree::GetImmediateDominator(ir::BasicBlock* block) const {
-    return m_Dominators.at(block);
+template <typename TFunction, typename TBlock>
+const std::vector<TBlock*>& DominatorTreeBase<TFunction, TBlock>::GetChildren(
+        TBlock* block) const {
+    uint32_t number = getNumber(block);
+    if (number == kNone) {
+        static const std::vector<TBlock*> kEmptyBlocks;
+        return kEmptyBlocks;
+    }
+    return m_Children[number];
 }
 
-std::vector<ir::BasicBlock*> DominatorTree::GetChildren(ir::BasicBlock* block) const {
-    if (m_Children.contains(block)) {
-        return m_Children.at(block);
+template <typename TFunction, typename TBlock>
+const std::vector<TBlock*>& DominatorTreeBase<TFunction, TBlock>::GetDominanceFrontier(
+        TBlock* block) const {
+    uint32_t number = getNumber(block);
+    if (number == kNone) {
+        static const std::vector<TBlock*> kEmptyBlocks;
+        return kEmptyBlocks;
+    }
+
+    if (!m_HasFrontiers) {
+        computeDominanceFrontiers();
     }
-    return {};
+    return m_DominanceFrontiers[number];
 }
 
-std::unordered_set<ir::BasicBlock*> DominatorTree::GetDominanceFrontier(ir::BasicBlock* block) const {
-    if (m_DominanceFrontierSet.contains(block)) {
-        return m_DominanceFrontierSet.at(block);
+template <typename TFunction, typename TBlock>
+bool DominatorTreeBase<TFunction, TBlock>::Contains(TBlock* block) const {
+    return m_Numbering.contains(block);
+}
+
+template <typename TFunction, typename TBlock>
+TBlock* DominatorTreeBase<TFunction, TBlock>::GetRoot() const {
+    return m_EntryBlock;
+}
+
+template <typename TFunction, typename TBlock>
+bool DominatorTreeBase<TFunction, TBlock>::Dominates(TBlock* dominator, TBlock* block) const {
+    uint32_t dominatorNumber = getNumber(dominator);
+    uint32_t number = getNumber(block);
+    if (dominatorNumber == kNone || number == kNone) {
+        return false;
+    }
+
+    while (m_Levels[number] > m_Levels[dominatorNumber]) {
+        number = m_IDoms[number];
     }
-    return {};
+    return number == dominatorNumber;
 }
 
-void DominatorTree::setEntryBlock(ir::BasicBlock* basicBlock) {
-    m_EntryBlock = basicBlock;
+template <typename TFunction, typename TBlock>
+TBlock* DominatorTreeBase<TFunction, TBlock>::FindNearestCommonDominator(
+        TBlock* firstBlock, TBlock* secondBlock) const {
+    uint32_t first = m_Numbering.at(firstBlock);
+    uint32_t second = m_Numbering.at(secondBlock);
+    while (first != second) {
+        if (m_Levels[first] < m_Levels[second]) {
+            std::swap(first, second);
+        }
+        first = m_IDoms[first];
+    }
+    return m_Blocks[first];
 }
 
-void DominatorTree::setEdgeDirections(bool isReverse) {
-    if (isReverse) {
-        p_GetPredecessors = &ir::BasicBlock::GetSuccessors;
-        p_GetSuccessors = &ir::BasicBlock::GetPredecessors;
+template <typename TFunction, typename TBlock>
+uint64_t DominatorTreeBase<TFunction, TBlock>::GetLevel(TBlock* block) const {
+    return m_Levels[m_Numbering.at(block)];
+}
+
+template <typename TFunction, typename TBlock>
+uint64_t DominatorTreeBase<TFunction, TBlock>::GetRPONumber(TBlock* block) const {
+    uint32_t number = m_Numbering.at(block);
+    if (!m_HasRPONumbers) {
+        computeReversePostorderNumbers();
+    }
+    return m_RPONumbers[number];
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::Recalculate() {
+    setEntryBlock(getEntryBlock(m_Function, m_IsReverse));
+
+    DepthFirstOrder order;
+    traverseDepthFirst(m_EntryBlock, nullptr, order);
+
+    m_Blocks.assign(order.Postorder.rbegin(), order.Postorder.rend());
+    m_Numbering.clear();
+    m_Numbering.reserve(m_Blocks.size());
+    for (size_t i = 0; i < m_Blocks.size(); ++i) {
+        m_Numbering[m_Blocks[i]] = i;
+    }
+
+    m_IDoms.assign(m_Blocks.size(), kNone);
+    if (m_Algorithm == Algorithm::kIterative) {
+        solveDominanceIterative();
     } else {
-        p_GetPredecessors = &ir::BasicBlock::GetPredecessors;
-        p_GetSuccessors = &ir::BasicBlock::GetSuccessors; 
+        std::vector<uint32_t> idoms = solveDominanceSemiNCA(order);
+        for (size_t i = 1; i < order.Preorder.size(); ++i) {
+            m_IDoms[getNumber(order.Preorder[i])] = idoms[i];
+        }
     }
+
+    updateChildren();
+
+    invalidateOrders();
+
+    // The numbering is the reverse postorder until the first update
+    m_RPONumbers.resize(m_Blocks.size());
+    for (size_t i = 0; i < m_Blocks.size(); ++i) {
+        m_RPONumbers[i] = i;
+    }
+    m_HasRPONumbers = true;
 }
 
-void DominatorTree::computeDominanceFrontiers() {
-    for (ir::BasicBlock* block : m_RPOrder) {
-        std::vector<ir::BasicBlock*> preds = std::invoke(p_GetPredecessors, block);
+template <typename TFunction, typename TBlock>
+bool DominatorTreeBase<TFunction, TBlock>::Verify() const {
+    DominatorTreeBase tree(m_Function, m_IsReverse, Algorithm::kSemiNCA);
+    if (tree.m_Numbering.size() != m_Numbering.size() || tree.GetRoot() != GetRoot()) {
+        return false;
+    }
 
-        // Entry block or obvious immediate dominator
-        if (preds.size() <= 1) {
-            continue;
+    for (TBlock* block : tree.m_Blocks) {
+        if (!Contains(block) || tree.GetImmediateDominator(block) != GetImmediateDominator(block) ||
+                tree.GetLevel(block) != GetLevel(block)) {
+            return false;
+        }
+
+        // Children are kept in the order of updates
+        std::vector<TBlock*> children = GetChildren(block);
+        std::vector<TBlock*> treeChildren = tree.GetChildren(block);
+        std::sort(children.begin(), children.end());
+        std::sort(treeChildren.begin(), treeChildren.end());
+        if (children != treeChildren) {
+            return false;
         }
+    }
+
+    return true;
+}
+
+// Depth-based search of the affected blocks,
+// Georgiadis et al., An Experimental Study of Dynamic Dominators
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::InsertEdge(TBlock* from, TBlock* to) {
+    uint32_t fromNumber = getNumber(from);
+    if (fromNumber == kNone) {
+        return;
+    }
+
+    uint32_t toNumber = getNumber(to);
+    if (toNumber == kNone) {
+        // New blocks become reachable and need numbers
+        Recalculate();
+        return;
+    }
+
+    invalidateOrders();
+
+    uint32_t nca = m_Numbering.at(FindNearestCommonDominator(from, to));
+    uint32_t ncaLevel = m_Levels[nca];
+    if (m_Levels[toNumber] <= ncaLevel + 1) {
+        return;
+    }
 
-        for (ir::BasicBlock* pred : preds) {
-            auto predDominator = pred;
-            while (predDominator != GetImmediateDominator(block)) {
-                m_DominanceFrontierSet[predDominator].insert(block);
-                predDominator = GetImmediateDominator(predDominator);
+    // Blocks whose immediate dominator becomes the common dominator
+    std::vector<uint32_t> affected;
+
+    std::vector<bool> visited(m_Blocks.size(), false);
+    std::priority_queue<std::pair<uint32_t, uint32_t>> bucket;
+    std::vector<uint32_t> stack;
+
+    bucket.emplace(m_Levels[toNumber], toNumber);
+    visited[toNumber] = true;
+    while (!bucket.empty()) {
+        auto [currentLevel, current] = bucket.top();
+        bucket.pop();
+        affected.push_back(current);
+
+        stack.push_back(current);
+        while (!stack.empty()) {
+            uint32_t number = stack.back();
+            stack.pop_back();
+
+            for (TBlock* successor : getSuccessors(m_Blocks[number])) {
+                uint32_t successorNumber = getNumber(successor);
+                uint32_t successorLevel = m_Levels[successorNumber];
+                if (successorLevel <= ncaLevel + 1 || visited[successorNumber]) {
+                    continue;
+                }
+                visited[successorNumber] = true;
+
+                if (successorLevel > currentLevel) {
+                    stack.push_back(successorNumber);
+                } else {
+                    bucket.emplace(successorLevel, successorNumber);
+                }
             }
         }
     }
+
+    for (uint32_t number : affected) {
+        setImmediateDominator(number, nca);
+    }
+    updateLevels(nca);
 }
 
-void DominatorTree::updateChildren() {
-    for (ir::BasicBlock* block : m_RPOrder) {
-        auto dominator = GetImmediateDominator(block);
-        if (dominator) {
-            m_Children[dominator].push_back(block);
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::DeleteEdge(TBlock* from, TBlock* to) {
+    uint32_t fromNumber = getNumber(from);
+    uint32_t toNumber = getNumber(to);
+    if (fromNumber == kNone || toNumber == kNone) {
+        return;
+    }
+
+    invalidateOrders();
+
+    // Paths through an edge into a dominator are never simple
+    if (Dominates(to, from)) {
+        return;
+    }
+
+    // A leaf is reachable by a path avoiding it from any of its other predecessors.
+    // An unreachable one leaves the tree and its edges to the successors go with it
+    if (m_Children[toNumber].empty()) {
+        std::vector<TBlock*> preds = getPredecessors(to);
+        bool isReachable = std::any_of(preds.begin(), preds.end(), [&](TBlock* pred) {
+            return getNumber(pred) != kNone;
+        });
+        if (!isReachable) {
+            eraseBlock(toNumber);
+            for (TBlock* successor : getSuccessors(to)) {
+                uint32_t successorNumber = getNumber(successor);
+                if (successorNumber != kNone && m_IDoms[successorNumber] != kNone) {
+                    solveSubtree(m_IDoms[successorNumber]);
+                }
+            }
+            return;
         }
     }
+
+    solveSubtree(m_IDoms[toNumber]);
 }
 
-ir::BasicBlock* DominatorTree::intersectTwoDoms(ir::BasicBlock* firstBlock, ir::BasicBlock* secondBlock) {
-    auto firstDom = firstBlock;
-    auto secondDom = secondBlock;
-    uint64_t firstNumber = m_RPONumbering[firstDom];
-    uint64_t secondNumber = m_RPONumbering[secondDom];
-    while (firstNumber != secondNumber) {
-        while (firstNumber > secondNumber) {
-            firstDom = m_Dominators[firstDom];
-            firstNumber = m_RPONumbering[firstDom];
+// Every path to the subtree of the immediate dominator of a block
+// that lost an edge still enters it through the root,
+// so only the subtree has to be solved again
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::solveSubtree(uint32_t root) {
+    std::vector<bool> inSubtree(m_Blocks.size(), false);
+    size_t subtreeSize = 0;
+    std::vector<uint32_t> stack = {root};
+    while (!stack.empty()) {
+        uint32_t number = stack.back();
+        stack.pop_back();
+
+        inSubtree[number] = true;
+        ++subtreeSize;
+        for (TBlock* child : m_Children[number]) {
+            stack.push_back(getNumber(child));
         }
-        while (secondNumber > firstNumber) {
-            secondDom = m_Dominators[secondDom];
-            secondNumber = m_RPONumbering[secondDom];
+    }
+
+    DepthFirstOrder order;
+    traverseDepthFirst(m_Blocks[root], [&](TBlock* block) {
+        uint32_t number = getNumber(block);
+        return number != kNone && inSubtree[number];
+    }, order);
+
+    if (order.Preorder.size() != subtreeSize) {
+        // Some blocks became unreachable and leave the numbering
+        Recalculate();
+        return;
+    }
+
+    std::vector<uint32_t> idoms = solveDominanceSemiNCA(order);
+    for (size_t i = 1; i < order.Preorder.size(); ++i) {
+        uint32_t number = getNumber(order.Preorder[i]);
+        if (m_IDoms[number] != idoms[i]) {
+            setImmediateDominator(number, idoms[i]);
         }
     }
-    return firstDom;
+    updateLevels(root);
 }
 
-ir::BasicBlock* DominatorTree::intersectPredsDoms(const std::vector<ir::BasicBlock*>& preds) {
-    if (preds.empty()) {
-        return nullptr;
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::MergeBlocks(TBlock* removed, TBlock* kept) {
+    uint32_t removedNumber = getNumber(removed);
+    uint32_t keptNumber = getNumber(kept);
+    if (removedNumber == kNone || removed == kept) {
+        return;
+    }
+    if (keptNumber == kNone || (m_IDoms[removedNumber] == kNone && m_IDoms[keptNumber] != removedNumber)) {
+        Recalculate();
+        return;
     }
 
-    ir::BasicBlock* newIDom = preds[0];
+    invalidateOrders();
 
-    if (preds.size() == 1) {
-        return newIDom;
+    // Dominance is kept by every other block, the merged block takes the higher place
+    if (m_IDoms[keptNumber] == removedNumber) {
+        uint32_t idom = m_IDoms[removedNumber];
+        if (idom == kNone) {
+            std::vector<TBlock*>& siblings = m_Children[removedNumber];
+            siblings.erase(std::find(siblings.begin(), siblings.end(), kept));
+            m_IDoms[keptNumber] = kNone;
+            setEntryBlock(kept);
+        } else {
+            setImmediateDominator(keptNumber, idom);
+        }
+        m_Levels[keptNumber] = m_Levels[removedNumber];
     }
 
-    for (size_t i = 1; i < preds.size(); ++i) {
-        auto block = preds[i];
-        if (m_Dominators[block]) {
-            newIDom = intersectTwoDoms(block, newIDom);
-        }
+    std::vector<TBlock*> children = m_Children[removedNumber];
+    for (TBlock* child : children) {
+        setImmediateDominator(getNumber(child), keptNumber);
     }
 
-    return newIDom;
+    eraseBlock(removedNumber);
+    updateLevels(keptNumber);
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::setEntryBlock(TBlock* basicBlock) {
+    m_EntryBlock = basicBlock;
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::setEdgeDirections(bool isReverse) {
+    if (isReverse) {
+        p_GetPredecessors = &TBlock::GetSuccessors;
+        p_GetSuccessors = &TBlock::GetPredecessors;
+    } else {
+        p_GetPredecessors = &TBlock::GetPredecessors;
+        p_GetSuccessors = &TBlock::GetSuccessors;
+    }
 }
 
-void DominatorTree::solveDominance() {
-    for (size_t i = 0; i < m_RPOrder.size(); ++i) {
-        m_RPONumbering[m_RPOrder[i]] = i;
+template <typename TFunction, typename TBlock>
+std::vector<TBlock*> DominatorTreeBase<TFunction, TBlock>::getPredecessors(
+        TBlock* block) const {
+    return std::invoke(p_GetPredecessors, block);
+}
+
+template <typename TFunction, typename TBlock>
+std::vector<TBlock*> DominatorTreeBase<TFunction, TBlock>::getSuccessors(
+        TBlock* block) const {
+    return std::invoke(p_GetSuccessors, block);
+}
+
+template <typename TFunction, typename TBlock>
+uint32_t DominatorTreeBase<TFunction, TBlock>::getNumber(TBlock* block) const {
+    auto it = m_Numbering.find(block);
+    if (it == m_Numbering.end()) {
+        return kNone;
+    }
+    return it->second;
+}
+
+// Iterative, long chains of blocks overflow the call stack
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::traverseDepthFirst(
+        TBlock* root, const std::function<bool(TBlock*)>& filter, DepthFirstOrder& order) const {
+    struct Frame {
+        TBlock* Block;
+        std::vector<TBlock*> Successors;
+        size_t NextSuccessor = 0;
+    };
+
+    std::unordered_map<TBlock*, bool> visited;
+    std::vector<Frame> stack;
+
+    visited[root] = true;
+    order.Preorder.push_back(root);
+    order.Parents.push_back(nullptr);
+    stack.push_back({root, getSuccessors(root)});
+
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.NextSuccessor == frame.Successors.size()) {
+            order.Postorder.push_back(frame.Block);
+            stack.pop_back();
+            continue;
+        }
+
+        TBlock* next = frame.Successors[frame.NextSuccessor++];
+        if (visited[next] || (filter && !filter(next))) {
+            continue;
+        }
+
+        visited[next] = true;
+        order.Preorder.push_back(next);
+        order.Parents.push_back(frame.Block);
+        stack.push_back({next, getSuccessors(next)});
     }
+}
 
-    ir::BasicBlock* startBlock = m_RPOrder[0];
-    m_Dominators[startBlock] = startBlock;
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::solveDominanceIterative() {
+    m_IDoms[0] = 0;
 
     bool changed = true;
     while (changed) {
         changed = false;
 
         // Skip start block
-        for (size_t i = 1; i < m_RPOrder.size(); ++i) {
-            ir::BasicBlock* block = m_RPOrder[i];
-            ir::BasicBlock* newIDom = intersectPredsDoms(std::invoke(p_GetPredecessors, block));
-            if (m_Dominators[block] != newIDom) {
-                m_Dominators[block] = newIDom;
+        for (uint32_t number = 1; number < m_Blocks.size(); ++number) {
+            uint32_t newIDom = kNone;
+            for (TBlock* pred : getPredecessors(m_Blocks[number])) {
+                uint32_t predNumber = getNumber(pred);
+                if (predNumber == kNone || m_IDoms[predNumber] == kNone) {
+                    continue;
+                }
+
+                if (newIDom == kNone) {
+                    newIDom = predNumber;
+                } else {
+                    newIDom = intersectTwoDoms(predNumber, newIDom);
+                }
+            }
+
+            if (m_IDoms[number] != newIDom) {
+                m_IDoms[number] = newIDom;
                 changed = true;
             }
         }
     }
 
-    m_Dominators[startBlock] = nullptr;
+    m_IDoms[0] = kNone;
+}
+
+// Block numbers are reverse postorder numbers here
+template <typename TFunction, typename TBlock>
+uint32_t DominatorTreeBase<TFunction, TBlock>::intersectTwoDoms(uint32_t first,
+                                                               uint32_t second) const {
+    while (first != second) {
+        while (first > second) {
+            first = m_IDoms[first];
+        }
+        while (second > first) {
+            second = m_IDoms[second];
+        }
+    }
+    return first;
+}
+
+template <typename TFunction, typename TBlock>
+std::vector<uint32_t> DominatorTreeBase<TFunction, TBlock>::solveDominanceSemiNCA(
+        const DepthFirstOrder& order) const {
+    size_t size = order.Preorder.size();
+
+    std::vector<uint32_t> positions(m_Blocks.size(), kNone);
+    for (size_t i = 0; i < size; ++i) {
+        positions[getNumber(order.Preorder[i])] = i;
+    }
+
+    std::vector<uint32_t> semis(size);
+    std::vector<uint32_t> labels(size);
+    std::vector<uint32_t> ancestors(size);
+    std::vector<uint32_t> idoms(size);
+    for (size_t i = 0; i < size; ++i) {
+        semis[i] = i;
+        labels[i] = i;
+        ancestors[i] = (i == 0) ? 0 : positions[getNumber(order.Parents[i])];
+        idoms[i] = ancestors[i];
+    }
+
+    // Semidominators in reverse preorder
+    std::vector<uint32_t> stack;
+    for (size_t i = size - 1; i >= 1; --i) {
+        for (TBlock* pred : getPredecessors(order.Preorder[i])) {
+            uint32_t predNumber = getNumber(pred);
+            if (predNumber == kNone || positions[predNumber] == kNone) {
+                continue;
+            }
+
+            uint32_t label = evalSemiNCA(positions[predNumber], i + 1, ancestors, labels, semis, stack);
+            semis[i] = std::min(semis[i], semis[label]);
+        }
+    }
+
+    // Nearest common ancestor of the parent and the semidominator
+    for (size_t i = 1; i < size; ++i) {
+        uint32_t candidate = idoms[i];
+        while (candidate > semis[i]) {
+            candidate = idoms[candidate];
+        }
+        idoms[i] = candidate;
+    }
+
+    for (size_t i = 1; i < size; ++i) {
+        idoms[i] = getNumber(order.Preorder[idoms[i]]);
+    }
+    idoms[0] = kNone;
+
+    return idoms;
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::updateChildren() {
+    m_Children.assign(m_Blocks.size(), {});
+    m_Levels.assign(m_Blocks.size(), 0);
+
+    // The immediate dominator precedes the block in RPO
+    for (uint32_t number = 0; number < m_Blocks.size(); ++number) {
+        uint32_t dominator = m_IDoms[number];
+        if (dominator != kNone) {
+            m_Children[dominator].push_back(m_Blocks[number]);
+            m_Levels[number] = m_Levels[dominator] + 1;
+        }
+    }
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::updateLevels(uint32_t root) {
+    std::vector<uint32_t> stack = {root};
+    while (!stack.empty()) {
+        uint32_t number = stack.back();
+        stack.pop_back();
+
+        for (TBlock* child : m_Children[number]) {
+            uint32_t childNumber = getNumber(child);
+            m_Levels[childNumber] = m_Levels[number] + 1;
+            stack.push_back(childNumber);
+        }
+    }
 }
 
-void DominatorTree::computeReversePostorder() {
-    std::unordered_map<ir::BasicBlock*, bool> visited;
-    std::stack<ir::BasicBlock*> postorder;
-    traversePostorder(m_EntryBlock, postorder, visited);
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::setImmediateDominator(uint32_t number, uint32_t idom) {
+    uint32_t oldIDom = m_IDoms[number];
+    if (oldIDom == idom) {
+        return;
+    }
+
+    std::vector<TBlock*>& oldSiblings = m_Children[oldIDom];
+    oldSiblings.erase(std::find(oldSiblings.begin(), oldSiblings.end(), m_Blocks[number]));
+
+    m_Children[idom].push_back(m_Blocks[number]);
+    m_IDoms[number] = idom;
+}
 
-    m_RPOrder.clear();
-    while (!postorder.empty()) {
-        m_RPOrder.push_back(postorder.top());
-        postorder.pop();
+// The number stays unused until the next recalculation
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::eraseBlock(uint32_t number) {
+    uint32_t idom = m_IDoms[number];
+    if (idom != kNone) {
+        std::vector<TBlock*>& siblings = m_Children[idom];
+        siblings.erase(std::find(siblings.begin(), siblings.end(), m_Blocks[number]));
     }
+
+    m_Numbering.erase(m_Blocks[number]);
+    m_Blocks[number] = nullptr;
+    m_IDoms[number] = kNone;
+    m_Children[number].clear();
 }
 
-void DominatorTree::traversePostorder(ir::BasicBlock* block, std::stack<ir::BasicBlock*>& postorder,
-                        std::unordered_map<ir::BasicBlock*, bool>& visited) {
-    visited[block] = true;
-    for (ir::BasicBlock* next : std::invoke(p_GetSuccessors, block)) {
-        if (!visited[next]) {
-            traversePostorder(next, postorder, visited);
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::invalidateOrders() {
+    m_HasFrontiers = false;
+    m_HasRPONumbers = false;
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::computeDominanceFrontiers() const {
+    m_DominanceFrontiers.assign(m_Blocks.size(), {});
+
+    for (uint32_t number = 0; number < m_Blocks.size(); ++number) {
+        if (!m_Blocks[number]) {
+            continue;
         }
+
+        // A single predecessor is the immediate dominator unless the block is the entry
+        for (TBlock* pred : getPredecessors(m_Blocks[number])) {
+            uint32_t runner = getNumber(pred);
+            if (runner == kNone) {
+                continue;
+            }
+
+            while (runner != m_IDoms[number]) {
+                std::vector<TBlock*>& frontier = m_DominanceFrontiers[runner];
+                if (!frontier.empty() && frontier.back() == m_Blocks[number]) {
+                    // Already reached from another predecessor
+                    break;
+                }
+                frontier.push_back(m_Blocks[number]);
+                runner = m_IDoms[runner];
+            }
+        }
+    }
+
+    m_HasFrontiers = true;
+}
+
+template <typename TFunction, typename TBlock>
+void DominatorTreeBase<TFunction, TBlock>::computeReversePostorderNumbers() const {
+    DepthFirstOrder order;
+    traverseDepthFirst(m_EntryBlock, nullptr, order);
+
+    m_RPONumbers.resize(m_Blocks.size());
+    for (size_t i = 0; i < order.Postorder.size(); ++i) {
+        m_RPONumbers[getNumber(order.Postorder[i])] = order.Postorder.size() - 1 - i;
     }
-    postorder.push(block);
+
+    m_HasRPONumbers = true;
 }
+
+template class DominatorTreeBase<ir::Function, ir::BasicBlock>;
+template class DominatorTreeBase<gen::MFunction, gen::MBasicBlock>;
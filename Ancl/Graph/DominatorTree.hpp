@@ -1,56 +1,135 @@
 #pragma once
 
 #include <cstdint>
-#include <stack>
+#include <functional>
+#include <limits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include <Ancl/AnclIR/BasicBlock.hpp>
 #include <Ancl/AnclIR/Constant/Function.hpp>
+#include <Ancl/CodeGen/MachineIR/MBasicBlock.hpp>
+#include <Ancl/CodeGen/MachineIR/MFunction.hpp>
+
+
+// Blocks reachable from the entry are numbered densely in reverse postorder
+// and all dominator data is kept in vectors indexed by that number.
+// Instantiated for Ancl IR and machine IR, see the aliases below.
+//
+// kIterative: http://www.hipersoft.rice.edu/grads/publications/dom14.pdf
+// kSemiNCA: L. Georgiadis, Linear-Time Algorithms for Dominators and Related Problems
+template <typename TFunction, typename TBlock>
+class DominatorTreeBase {
+public:
+    enum class Algorithm {
+        kIterative = 0,
+        kSemiNCA,
+    };
 
-
-// http://www.hipersoft.rice.edu/grads/publications/dom14.pdf
-class DominatorTree {
 public:
-    DominatorTree(ir::Function* function, bool isReverse = false);
+    DominatorTreeBase(TFunction* function, bool isReverse = false,
+                      Algorithm algorithm = Algorithm::kSemiNCA);
+
+    TBlock* GetImmediateDominator(TBlock* block) const;
+
+    const std::vector<TBlock*>& GetChildren(TBlock* block) const;
+
+    const std::vector<TBlock*>& GetDominanceFrontier(TBlock* block) const;
+
+    // Blocks unreachable from the entry are not in the tree
+    bool Contains(TBlock* block) const;
+
+    TBlock* GetRoot() const;
+
+    bool Dominates(TBlock* dominator, TBlock* block) const;
+
+    TBlock* FindNearestCommonDominator(TBlock* firstBlock, TBlock* secondBlock) const;
+
+    // Depth in the dominator tree, the entry block has level 0
+    uint64_t GetLevel(TBlock* block) const;
+
+    uint64_t GetRPONumber(TBlock* block) const;
 
-    ir::BasicBlock* GetImmediateDominator(ir::BasicBlock* block) const;
+    // Incremental updates, called after the edge has been changed in the CFG.
+    // Edges are given in the direction of the tree (reversed for a postdominator tree)
+    void InsertEdge(TBlock* from, TBlock* to);
+    void DeleteEdge(TBlock* from, TBlock* to);
 
-    std::vector<ir::BasicBlock*> GetChildren(ir::BasicBlock* block) const;
+    // Called after the removed block has been merged into the kept one,
+    // when the kept block was its only successor or its only predecessor
+    void MergeBlocks(TBlock* removed, TBlock* kept);
 
-    std::unordered_set<ir::BasicBlock*> GetDominanceFrontier(ir::BasicBlock* block) const;
+    void Recalculate();
+
+    // Compares the tree with a new one built by Semi-NCA
+    bool Verify() const;
 
 private:
-    void setEntryBlock(ir::BasicBlock* basicBlock);
+    static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+    struct DepthFirstOrder {
+        std::vector<TBlock*> Preorder;
+        std::vector<TBlock*> Parents;  // DFS tree parents, aligned with Preorder
+        std::vector<TBlock*> Postorder;
+    };
+
+    void setEntryBlock(TBlock* basicBlock);
     void setEdgeDirections(bool isReverse);
 
-    void computeDominanceFrontiers();
+    std::vector<TBlock*> getPredecessors(TBlock* block) const;
+    std::vector<TBlock*> getSuccessors(TBlock* block) const;
 
-    void updateChildren();
+    uint32_t getNumber(TBlock* block) const;
+
+    void traverseDepthFirst(TBlock* root, const std::function<bool(TBlock*)>& filter,
+                            DepthFirstOrder& order) const;
 
-    ir::BasicBlock* intersectTwoDoms(ir::BasicBlock* firstBlock, ir::BasicBlock* secondBlock);
+    void solveDominanceIterative();
+    uint32_t intersectTwoDoms(uint32_t first, uint32_t second) const;
 
-    ir::BasicBlock* intersectPredsDoms(const std::vector<ir::BasicBlock*>& preds);
+    // Immediate dominators of all blocks in the order except its root
+    std::vector<uint32_t> solveDominanceSemiNCA(const DepthFirstOrder& order) const;
 
-    void solveDominance();
+    void updateChildren();
+    void updateLevels(uint32_t root);
 
-    void computeReversePostorder();
+    void solveSubtree(uint32_t root);
 
-    void traversePostorder(ir::BasicBlock* block, std::stack<ir::BasicBlock*>& postorder,
-                           std::unordered_map<ir::BasicBlock*, bool>& visited);
+    void setImmediateDominator(uint32_t number, uint32_t idom);
+    void eraseBlock(uint32_t number);
+
+    void invalidateOrders();
+    void computeDominanceFrontiers() const;
+    void computeReversePostorderNumbers() const;
 
 private:
-    ir::BasicBlock* m_EntryBlock = nullptr;
-    std::vector<ir::BasicBlock*> (ir::BasicBlock::*p_GetPredecessors)() const = nullptr;
-    std::vector<ir::BasicBlock*> (ir::BasicBlock::*p_GetSuccessors)() const = nullptr;
+    TFunction* m_Function = nullptr;
+    bool m_IsReverse = false;
+    Algorithm m_Algorithm = Algorithm::kSemiNCA;
+
+    TBlock* m_EntryBlock = nullptr;
+    std::vector<TBlock*> (TBlock::*p_GetPredecessors)() const = nullptr;
+    std::vector<TBlock*> (TBlock::*p_GetSuccessors)() const = nullptr;
+
+    // Dense numbering, assigned in reverse postorder on recalculation,
+    // merged and unreachable blocks leave null holes until the next one
+    std::vector<TBlock*> m_Blocks;
+    std::unordered_map<TBlock*, uint32_t> m_Numbering;
 
-    std::unordered_map<ir::BasicBlock*, ir::BasicBlock*> m_Dominators;
-    std::unordered_map<ir::BasicBlock*, std::vector<ir::BasicBlock*>> m_Children;
+    std::vector<uint32_t> m_IDoms;
+    std::vector<std::vector<TBlock*>> m_Children;
+    std::vector<uint32_t> m_Levels;
 
-    std::unordered_map<ir::BasicBlock*, std::unordered_set<ir::BasicBlock*>> m_DominanceFrontierSet;
+    // Recomputed on demand after incremental updates
+    mutable bool m_HasFrontiers = false;
+    mutable std::vector<std::vector<TBlock*>> m_DominanceFrontiers;
 
-    // Reverse postorder info
-    std::vector<ir::BasicBlock*> m_RPOrder;
-    std::unordered_map<ir::BasicBlock*, uint64_t> m_RPONumbering;
+    mutable bool m_HasRPONumbers = false;
+    mutable std::vector<uint32_t> m_RPONumbers;
 };
+
+using DominatorTree = DominatorTreeBase<ir::Function, ir::BasicBlock>;
+using MDominatorTree = DominatorTreeBase<gen::MFunction, gen::MBasicBlock>;
+
+extern template class DominatorTreeBase<ir::Function, ir::BasicBlock>;
+extern template class DominatorTreeBase<gen::MFunction, gen::MBasicBlock>;
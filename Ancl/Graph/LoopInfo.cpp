@@ -0,0 +1,285 @@
+#include <Ancl/Graph/LoopInfo.hpp>
+
+#include <algorithm>
+
+
+template <typename TBlock>
+LoopBase<TBlock>::LoopBase(TBlock* header)
+    : m_Header(header) {}
+
+template <typename TBlock>
+TBlock* LoopBase<TBlock>::GetHeader() const {
+    return m_Header;
+}
+
+template <typename TBlock>
+LoopBase<TBlock>* LoopBase<TBlock>::GetParentLoop() const {
+    return m_ParentLoop;
+}
+
+template <typename TBlock>
+const std::vector<LoopBase<TBlock>*>& LoopBase<TBlock>::GetSubLoops() const {
+    return m_SubLoops;
+}
+
+template <typename TBlock>
+const std::vector<TBlock*>& LoopBase<TBlock>::GetBlocks() const {
+    return m_Blocks;
+}
+
+template <typename TBlock>
+bool LoopBase<TBlock>::Contains(TBlock* block) const {
+    return m_BlockSet.contains(block);
+}
+
+template <typename TBlock>
+bool LoopBase<TBlock>::Contains(const LoopBase* loop) const {
+    while (loop && loop != this) {
+        loop = loop->GetParentLoop();
+    }
+    return loop == this;
+}
+
+template <typename TBlock>
+uint64_t LoopBase<TBlock>::GetDepth() const {
+    return m_Depth;
+}
+
+template <typename TBlock>
+std::vector<TBlock*> LoopBase<TBlock>::GetLatches() const {
+    std::vector<TBlock*> latches;
+    for (TBlock* pred : m_Header->GetPredecessors()) {
+        if (Contains(pred) && std::find(latches.begin(), latches.end(), pred) == latches.end()) {
+            latches.push_back(pred);
+        }
+    }
+    return latches;
+}
+
+template <typename TBlock>
+TBlock* LoopBase<TBlock>::GetLatch() const {
+    std::vector<TBlock*> latches = GetLatches();
+    if (latches.size() != 1) {
+        return nullptr;
+    }
+    return latches[0];
+}
+
+template <typename TBlock>
+TBlock* LoopBase<TBlock>::GetPreheader() const {
+    TBlock* preheader = nullptr;
+    for (TBlock* pred : m_Header->GetPredecessors()) {
+        if (Contains(pred)) {
+            continue;
+        }
+        if (preheader && preheader != pred) {
+            return nullptr;
+        }
+        preheader = pred;
+    }
+
+    if (!preheader || preheader->GetSuccessors().size() != 1) {
+        return nullptr;
+    }
+    return preheader;
+}
+
+template <typename TBlock>
+std::vector<TBlock*> LoopBase<TBlock>::GetExitBlocks() const {
+    std::vector<TBlock*> exitBlocks;
+    std::unordered_set<TBlock*> visited;
+    for (TBlock* block : m_Blocks) {
+        for (TBlock* successor : block->GetSuccessors()) {
+            if (!Contains(successor) && visited.insert(successor).second) {
+                exitBlocks.push_back(successor);
+            }
+        }
+    }
+    return exitBlocks;
+}
+
+template <typename TBlock>
+std::vector<TBlock*> LoopBase<TBlock>::GetExitingBlocks() const {
+    std::vector<TBlock*> exitingBlocks;
+    for (TBlock* block : m_Blocks) {
+        for (TBlock* successor : block->GetSuccessors()) {
+            if (!Contains(successor)) {
+                exitingBlocks.push_back(block);
+                break;
+            }
+        }
+    }
+    return exitingBlocks;
+}
+
+template <typename TBlock>
+void LoopBase<TBlock>::setParentLoop(LoopBase* loop) {
+    m_ParentLoop = loop;
+}
+
+template <typename TBlock>
+void LoopBase<TBlock>::addSubLoop(LoopBase* loop) {
+    m_SubLoops.push_back(loop);
+}
+
+template <typename TBlock>
+void LoopBase<TBlock>::addBlock(TBlock* block) {
+    m_Blocks.push_back(block);
+    m_BlockSet.insert(block);
+}
+
+
+template <typename TFunction, typename TBlock>
+LoopInfoBase<TFunction, TBlock>::LoopInfoBase(const DominatorTreeBase<TFunction, TBlock>& domTree)
+        : m_DomTree(domTree) {
+    std::vector<TBlock*> preorder;
+    collectDominatorTreePreorder(preorder);
+
+    // Headers of inner loops are deeper in the dominator tree,
+    // so the inner loops are discovered first
+    for (auto it = preorder.rbegin(); it != preorder.rend(); ++it) {
+        TBlock* header = *it;
+
+        std::vector<TBlock*> backEdges;
+        for (TBlock* pred : header->GetPredecessors()) {
+            if (m_DomTree.Contains(pred) && m_DomTree.Dominates(header, pred)) {
+                backEdges.push_back(pred);
+            }
+        }
+
+        if (!backEdges.empty()) {
+            discoverLoop(header, backEdges);
+        }
+    }
+
+    buildLoopNest(preorder);
+}
+
+template <typename TFunction, typename TBlock>
+LoopBase<TBlock>* LoopInfoBase<TFunction, TBlock>::GetLoopFor(TBlock* block) const {
+    auto it = m_BlockLoops.find(block);
+    if (it == m_BlockLoops.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+template <typename TFunction, typename TBlock>
+uint64_t LoopInfoBase<TFunction, TBlock>::GetLoopDepth(TBlock* block) const {
+    Loop* loop = GetLoopFor(block);
+    if (!loop) {
+        return 0;
+    }
+    return loop->GetDepth();
+}
+
+template <typename TFunction, typename TBlock>
+bool LoopInfoBase<TFunction, TBlock>::IsLoopHeader(TBlock* block) const {
+    Loop* loop = GetLoopFor(block);
+    return loop && loop->GetHeader() == block;
+}
+
+template <typename TFunction, typename TBlock>
+const std::vector<LoopBase<TBlock>*>& LoopInfoBase<TFunction, TBlock>::GetTopLevelLoops() const {
+    return m_TopLevelLoops;
+}
+
+template <typename TFunction, typename TBlock>
+std::vector<LoopBase<TBlock>*> LoopInfoBase<TFunction, TBlock>::GetLoopsInPreorder() const {
+    std::vector<Loop*> loops;
+    std::vector<Loop*> stack(m_TopLevelLoops.rbegin(), m_TopLevelLoops.rend());
+    while (!stack.empty()) {
+        Loop* loop = stack.back();
+        stack.pop_back();
+
+        loops.push_back(loop);
+        const std::vector<Loop*>& subLoops = loop->GetSubLoops();
+        stack.insert(stack.end(), subLoops.rbegin(), subLoops.rend());
+    }
+    return loops;
+}
+
+// Walks backwards from the latches, already found loops are entered
+// through their outermost loop so that only its header is visited
+template <typename TFunction, typename TBlock>
+void LoopInfoBase<TFunction, TBlock>::discoverLoop(TBlock* header,
+                                                   const std::vector<TBlock*>& backEdges) {
+    Loop* loop = m_Loops.emplace_back(CreateScope<Loop>(header)).get();
+    m_BlockLoops[header] = loop;
+
+    std::vector<TBlock*> workList = backEdges;
+    while (!workList.empty()) {
+        TBlock* block = workList.back();
+        workList.pop_back();
+
+        Loop* subLoop = GetLoopFor(block);
+        if (!subLoop) {
+            m_BlockLoops[block] = loop;
+            for (TBlock* pred : block->GetPredecessors()) {
+                if (m_DomTree.Contains(pred)) {
+                    workList.push_back(pred);
+                }
+            }
+            continue;
+        }
+
+        while (subLoop->GetParentLoop()) {
+            subLoop = subLoop->GetParentLoop();
+        }
+        if (subLoop == loop) {
+            continue;
+        }
+
+        subLoop->setParentLoop(loop);
+        for (TBlock* pred : subLoop->GetHeader()->GetPredecessors()) {
+            if (m_DomTree.Contains(pred)) {
+                workList.push_back(pred);
+            }
+        }
+    }
+}
+
+template <typename TFunction, typename TBlock>
+void LoopInfoBase<TFunction, TBlock>::collectDominatorTreePreorder(
+        std::vector<TBlock*>& preorder) const {
+    std::vector<TBlock*> stack = {m_DomTree.GetRoot()};
+    while (!stack.empty()) {
+        TBlock* block = stack.back();
+        stack.pop_back();
+
+        preorder.push_back(block);
+        const std::vector<TBlock*>& children = m_DomTree.GetChildren(block);
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+}
+
+// Parent headers dominate the loops nested in them, so in preorder
+// every loop is placed after its parent
+template <typename TFunction, typename TBlock>
+void LoopInfoBase<TFunction, TBlock>::buildLoopNest(const std::vector<TBlock*>& preorder) {
+    for (TBlock* block : preorder) {
+        Loop* loop = GetLoopFor(block);
+        if (!loop) {
+            continue;
+        }
+
+        if (loop->GetHeader() == block) {
+            if (Loop* parentLoop = loop->GetParentLoop()) {
+                parentLoop->addSubLoop(loop);
+                loop->m_Depth = parentLoop->GetDepth() + 1;
+            } else {
+                m_TopLevelLoops.push_back(loop);
+            }
+        }
+
+        for (Loop* current = loop; current; current = current->GetParentLoop()) {
+            current->addBlock(block);
+        }
+    }
+}
+
+template class LoopBase<ir::BasicBlock>;
+template class LoopBase<gen::MBasicBlock>;
+
+template class LoopInfoBase<ir::Function, ir::BasicBlock>;
+template class LoopInfoBase<gen::MFunction, gen::MBasicBlock>;
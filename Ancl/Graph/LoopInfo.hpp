@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Ancl/Base.hpp>
+#include <Ancl/Graph/DominatorTree.hpp>
+
+
+// Natural loop: the header dominates every block of the loop
+// and each back edge goes from a latch to the header
+template <typename TBlock>
+class LoopBase {
+public:
+    LoopBase(TBlock* header);
+
+    TBlock* GetHeader() const;
+
+    LoopBase* GetParentLoop() const;
+    const std::vector<LoopBase*>& GetSubLoops() const;
+
+    // The header comes first, then the blocks in dominator tree preorder
+    const std::vector<TBlock*>& GetBlocks() const;
+    bool Contains(TBlock* block) const;
+    bool Contains(const LoopBase* loop) const;
+
+    // Outermost loops have depth 1
+    uint64_t GetDepth() const;
+
+    std::vector<TBlock*> GetLatches() const;
+    TBlock* GetLatch() const;
+
+    // The only predecessor outside the loop, if the header is its only successor
+    TBlock* GetPreheader() const;
+
+    // Blocks outside the loop that are entered from it
+    std::vector<TBlock*> GetExitBlocks() const;
+    std::vector<TBlock*> GetExitingBlocks() const;
+
+private:
+    template <typename TFunction, typename TLoopBlock>
+    friend class LoopInfoBase;
+
+    void setParentLoop(LoopBase* loop);
+    void addSubLoop(LoopBase* loop);
+    void addBlock(TBlock* block);
+
+private:
+    TBlock* m_Header = nullptr;
+
+    LoopBase* m_ParentLoop = nullptr;
+    std::vector<LoopBase*> m_SubLoops;
+
+    std::vector<TBlock*> m_Blocks;
+    std::unordered_set<TBlock*> m_BlockSet;
+
+    uint64_t m_Depth = 1;
+};
+
+// Loops are found from the back edges of the dominator tree of the function,
+// so irreducible cycles are not reported
+template <typename TFunction, typename TBlock>
+class LoopInfoBase {
+public:
+    using Loop = LoopBase<TBlock>;
+
+public:
+    LoopInfoBase(const DominatorTreeBase<TFunction, TBlock>& domTree);
+
+    // Innermost loop containing the block
+    Loop* GetLoopFor(TBlock* block) const;
+
+    // Zero outside of loops
+    uint64_t GetLoopDepth(TBlock* block) const;
+
+    bool IsLoopHeader(TBlock* block) const;
+
+    const std::vector<Loop*>& GetTopLevelLoops() const;
+
+    // Outer loops come before the loops nested in them
+    std::vector<Loop*> GetLoopsInPreorder() const;
+
+private:
+    void discoverLoop(TBlock* header, const std::vector<TBlock*>& backEdges);
+
+    void collectDominatorTreePreorder(std::vector<TBlock*>& preorder) const;
+
+    void buildLoopNest(const std::vector<TBlock*>& preorder);
+
+private:
+    const DominatorTreeBase<TFunction, TBlock>& m_DomTree;
+
+    std::vector<TScopePtr<Loop>> m_Loops;
+    std::vector<Loop*> m_TopLevelLoops;
+
+    std::unordered_map<TBlock*, Loop*> m_BlockLoops;
+};
+
+using Loop = LoopBase<ir::BasicBlock>;
+using LoopInfo = LoopInfoBase<ir::Function, ir::BasicBlock>;
+
+using MLoop = LoopBase<gen::MBasicBlock>;
+using MLoopInfo = LoopInfoBase<gen::MFunction, gen::MBasicBlock>;
+
+extern template class LoopBase<ir::BasicBlock>;
+extern template class LoopBase<gen::MBasicBlock>;
+
+extern template class LoopInfoBase<ir::Function, ir::BasicBlock>;
+extern template class LoopInfoBase<gen::MFunction, gen::MBasicBlock>;
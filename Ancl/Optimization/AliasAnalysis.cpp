@@ -0,0 +1,231 @@
+#include <Ancl/Optimization/AliasAnalysis.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+#include <Ancl/DataLayout/Alignment.hpp>
+
+
+namespace ir {
+
+AliasAnalysis::AliasAnalysis(Function* function)
+    : m_Function(function) {
+    computeEscapedAllocas();
+}
+
+AliasAnalysis::AliasResult AliasAnalysis::Alias(const MemoryLocation& first,
+                                                const MemoryLocation& second) const {
+    DecomposedPointer firstPointer = decompose(first.Pointer);
+    DecomposedPointer secondPointer = decompose(second.Pointer);
+
+    if (firstPointer.Object == secondPointer.Object) {
+        if (!firstPointer.IsOffsetKnown || !secondPointer.IsOffsetKnown) {
+            return AliasResult::kMayAlias;
+        }
+
+        int64_t firstOffset = firstPointer.Offset;
+        int64_t secondOffset = secondPointer.Offset;
+        if (firstOffset == secondOffset) {
+            bool isSameSize = first.Size == second.Size && first.Size != kUnknownSize;
+            return isSameSize ? AliasResult::kMustAlias : AliasResult::kMayAlias;
+        }
+
+        // The lower access ends before the higher one starts
+        const MemoryLocation& lower = firstOffset < secondOffset ? first : second;
+        uint64_t distance = firstOffset < secondOffset ? secondOffset - firstOffset
+                                                       : firstOffset - secondOffset;
+        if (lower.Size != kUnknownSize && lower.Size <= distance) {
+            return AliasResult::kNoAlias;
+        }
+        return AliasResult::kMayAlias;
+    }
+
+    if (IsIdentifiedObject(firstPointer.Object) && IsIdentifiedObject(secondPointer.Object)) {
+        return AliasResult::kNoAlias;
+    }
+    if (isLocalObject(firstPointer.Object) || isLocalObject(secondPointer.Object)) {
+        return AliasResult::kNoAlias;
+    }
+
+    // Type-based rules hold only between different objects,
+    // so the union members of one pointer still alias
+    if (first.AccessType && second.AccessType && isTypeDisjoint(first.AccessType, second.AccessType)) {
+        return AliasResult::kNoAlias;
+    }
+
+    return AliasResult::kMayAlias;
+}
+
+bool AliasAnalysis::Covers(const MemoryLocation& outer, const MemoryLocation& inner) const {
+    if (outer.Size == kUnknownSize || inner.Size == kUnknownSize) {
+        return false;
+    }
+
+    DecomposedPointer outerPointer = decompose(outer.Pointer);
+    DecomposedPointer innerPointer = decompose(inner.Pointer);
+    if (outerPointer.Object != innerPointer.Object ||
+            !outerPointer.IsOffsetKnown || !innerPointer.IsOffsetKnown) {
+        return false;
+    }
+
+    int64_t outerEnd = outerPointer.Offset + static_cast<int64_t>(outer.Size);
+    int64_t innerEnd = innerPointer.Offset + static_cast<int64_t>(inner.Size);
+    return outerPointer.Offset <= innerPointer.Offset && innerEnd <= outerEnd;
+}
+
+bool AliasAnalysis::IsLocalMemory(Value* pointer) const {
+    return isLocalObject(GetUnderlyingObject(pointer));
+}
+
+bool AliasAnalysis::IsModifiedByCall(Value* pointer) const {
+    return !IsLocalMemory(pointer);
+}
+
+AliasAnalysis::MemoryLocation AliasAnalysis::GetLoadLocation(LoadInstruction* load) {
+    return MemoryLocation{
+        .Pointer = load->GetPtrOperand(),
+        .Size = Alignment::GetTypeSize(load->GetType()),
+        .AccessType = load->GetType(),
+    };
+}
+
+AliasAnalysis::MemoryLocation AliasAnalysis::GetStoreLocation(StoreInstruction* store) {
+    Type* type = store->GetValueOperand()->GetType();
+    return MemoryLocation{
+        .Pointer = store->GetAddressOperand(),
+        .Size = Alignment::GetTypeSize(type),
+        .AccessType = type,
+    };
+}
+
+Value* AliasAnalysis::GetUnderlyingObject(Value* pointer) {
+    return decompose(pointer).Object;
+}
+
+bool AliasAnalysis::IsIdentifiedObject(Value* object) {
+    return dynamic_cast<GlobalVariable*>(object) || dynamic_cast<AllocaInstruction*>(object);
+}
+
+void AliasAnalysis::computeEscapedAllocas() {
+    std::unordered_map<Value*, std::vector<Instruction*>> users;
+    std::vector<AllocaInstruction*> allocas;
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (operand) {
+                    users[operand].push_back(instruction);
+                }
+            }
+            if (auto* alloca = dynamic_cast<AllocaInstruction*>(instruction)) {
+                allocas.push_back(alloca);
+            }
+        }
+    }
+
+    for (AllocaInstruction* alloca : allocas) {
+        std::vector<Value*> workList{alloca};
+        while (!workList.empty() && !m_EscapedAllocas.contains(alloca)) {
+            Value* pointer = workList.back();
+            workList.pop_back();
+
+            for (Instruction* user : users[pointer]) {
+                auto* member = dynamic_cast<MemberInstruction*>(user);
+                auto* cast = dynamic_cast<CastInstruction*>(user);
+                if ((member && member->GetPtrOperand() == pointer && member->GetIndex() != pointer) ||
+                        (cast && cast->GetOpType() == CastInstruction::OpType::kBitcast)) {
+                    workList.push_back(user);
+                } else if (isEscapingUse(user, pointer)) {
+                    m_EscapedAllocas.insert(alloca);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Loads, stores, copies and compares use the address without publishing it
+bool AliasAnalysis::isEscapingUse(Instruction* user, Value* pointer) const {
+    if (dynamic_cast<LoadInstruction*>(user) || dynamic_cast<CompareInstruction*>(user)) {
+        return false;
+    }
+    if (auto* store = dynamic_cast<StoreInstruction*>(user)) {
+        return store->GetValueOperand() == pointer;
+    }
+    if (dynamic_cast<MemoryCopyInstruction*>(user) || dynamic_cast<MemorySetInstruction*>(user)) {
+        return false;
+    }
+    return true;
+}
+
+bool AliasAnalysis::isLocalObject(Value* object) const {
+    auto* alloca = dynamic_cast<AllocaInstruction*>(object);
+    return alloca && !m_EscapedAllocas.contains(alloca);
+}
+
+// The same offsets as MIRGenerator computes for members
+AliasAnalysis::DecomposedPointer AliasAnalysis::decompose(Value* pointer) {
+    DecomposedPointer result;
+    while (true) {
+        if (auto* cast = dynamic_cast<CastInstruction*>(pointer);
+                cast && cast->GetOpType() == CastInstruction::OpType::kBitcast) {
+            pointer = cast->GetFromOperand();
+            continue;
+        }
+
+        auto* member = dynamic_cast<MemberInstruction*>(pointer);
+        if (!member) {
+            break;
+        }
+
+        Value* basePointer = member->GetPtrOperand();
+        auto* index = dynamic_cast<IntConstant*>(member->GetIndex());
+        auto* pointerType = dynamic_cast<PointerType*>(basePointer->GetType());
+        if (!index || !pointerType) {
+            result.IsOffsetKnown = false;
+            pointer = basePointer;
+            continue;
+        }
+
+        int64_t indexValue = index->GetValue().GetSignedValue();
+        Type* subType = pointerType->GetSubType();
+        if (auto* arrayType = dynamic_cast<ArrayType*>(subType)) {
+            result.Offset += indexValue * Alignment::GetTypeSize(arrayType->GetSubType());
+        } else if (!member->IsDeref()) {
+            result.Offset += indexValue * Alignment::GetTypeSize(subType);
+        } else if (auto* structType = dynamic_cast<StructType*>(subType);
+                        structType && indexValue >= 0 &&
+                        indexValue < static_cast<int64_t>(structType->GetElementsNumber())) {
+            result.Offset += Alignment::GetStructLayout(structType).Offsets[indexValue];
+        } else {
+            result.IsOffsetKnown = false;
+        }
+        pointer = basePointer;
+    }
+
+    result.Object = pointer;
+    return result;
+}
+
+// Bytes alias everything, as char does in C
+bool AliasAnalysis::isTypeDisjoint(Type* first, Type* second) {
+    auto isByte = [](Type* type) {
+        auto* intType = dynamic_cast<IntType*>(type);
+        return intType && intType->GetBytesNumber() == 1;
+    };
+    if (isByte(first) || isByte(second)) {
+        return false;
+    }
+
+    auto* firstFloat = dynamic_cast<FloatType*>(first);
+    auto* secondFloat = dynamic_cast<FloatType*>(second);
+    if (firstFloat && secondFloat) {
+        return firstFloat->GetKind() != secondFloat->GetKind();
+    }
+
+    auto isIntOrPointer = [](Type* type) {
+        return dynamic_cast<IntType*>(type) || dynamic_cast<PointerType*>(type);
+    };
+    return (firstFloat && isIntOrPointer(second)) || (secondFloat && isIntOrPointer(first));
+}
+
+}  // namespace ir
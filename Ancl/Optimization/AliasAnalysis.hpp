@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    Alias Analysis:
+    pointers are decomposed into an underlying object and a constant offset,
+    distinct globals and allocas never overlap, an alloca whose address does not
+    escape is reachable only through its own members, and scalar accesses
+    of incompatible types (floats against integers wider than a byte) are disjoint
+*/
+class AliasAnalysis {
+public:
+    enum class AliasResult {
+        kNoAlias,
+        kMayAlias,
+        kMustAlias,
+    };
+
+    static constexpr uint64_t kUnknownSize = std::numeric_limits<uint64_t>::max();
+
+    struct MemoryLocation {
+        Value* Pointer = nullptr;
+        uint64_t Size = kUnknownSize;
+
+        // Type of the loaded or stored value, nullptr for copies and sets
+        Type* AccessType = nullptr;
+    };
+
+public:
+    AliasAnalysis(Function* function);
+
+    AliasResult Alias(const MemoryLocation& first, const MemoryLocation& second) const;
+
+    // The outer location is known to overwrite every byte of the inner one
+    bool Covers(const MemoryLocation& outer, const MemoryLocation& inner) const;
+
+    // Memory of the allocas that do not escape is invisible to callers and callees
+    bool IsLocalMemory(Value* pointer) const;
+
+    // Calls can reach everything except the allocas that do not escape
+    bool IsModifiedByCall(Value* pointer) const;
+
+    static MemoryLocation GetLoadLocation(LoadInstruction* load);
+    static MemoryLocation GetStoreLocation(StoreInstruction* store);
+
+    static Value* GetUnderlyingObject(Value* pointer);
+    static bool IsIdentifiedObject(Value* object);
+
+private:
+    struct DecomposedPointer {
+        Value* Object = nullptr;
+        int64_t Offset = 0;
+        bool IsOffsetKnown = true;
+    };
+
+    void computeEscapedAllocas();
+    bool isEscapingUse(Instruction* user, Value* pointer) const;
+
+    bool isLocalObject(Value* object) const;
+
+    static DecomposedPointer decompose(Value* pointer);
+    static bool isTypeDisjoint(Type* first, Type* second);
+
+private:
+    Function* m_Function = nullptr;
+
+    std::unordered_set<AllocaInstruction*> m_EscapedAllocas;
+};
+
+}  // namespace ir
@@ -8,8 +8,8 @@
 
 namespace ir {
 
-CleanPass::CleanPass(Function* function)
-    : m_Function(function) {}
+CleanPass::CleanPass(Function* function, DominatorTree* domTree)
+    : m_Function(function), m_DomTree(domTree) {}
 
 void CleanPass::Run() {
     bool isChanged = true;
@@ -73,9 +73,24 @@ bool CleanPass::removeEmptyBlock(BasicBlock* basicBlock, BasicBlock* successor)
         return false;
     }
 
+    // Each case of a switch keeps its own block, the edges must stay distinct
+    for (BasicBlock* predecessor : basicBlock->GetPredecessors()) {
+        if (dynamic_cast<SwitchInstruction*>(predecessor->GetTerminator())) {
+            return false;
+        }
+    }
+
     if (m_Function->GetEntryBlock() == basicBlock) {
+        // A loop into the entry keeps its block
+        if (basicBlock->GetPredecessorsNumber() != 0) {
+            return false;
+        }
+
         successor->RemovePredecessor(basicBlock);
         m_Function->SetEntryBlock(successor);
+        if (m_DomTree) {
+            m_DomTree->MergeBlocks(basicBlock, successor);
+        }
         return true;
     }
 
@@ -106,12 +121,13 @@ bool CleanPass::removeEmptyBlock(BasicBlock* basicBlock, BasicBlock* successor)
                 }
                 successor->AddPredecessor(predecessor);
             }
-        } else {
-            // TODO: Handle switch
         }
     }
 
     successor->RemovePredecessor(basicBlock);
+    if (m_DomTree) {
+        m_DomTree->MergeBlocks(basicBlock, successor);
+    }
 
     return true;
 }
@@ -133,7 +149,12 @@ bool CleanPass::combineBlocks(BasicBlock* basicBlock, BasicBlock* successor) {
         newSuccessor->ReplacePredecessor(successor, basicBlock);
     }
 
-    basicBlock->ReplaceTerminator(terminator);
+    // The edges are moved with their phi values, ReplaceTerminator would add them again
+    basicBlock->GetInstructionsRef().back() = terminator;
+    terminator->SetBasicBlock(basicBlock);
+    if (m_DomTree) {
+        m_DomTree->MergeBlocks(successor, basicBlock);
+    }
 
     return true;
 }
@@ -148,8 +169,28 @@ bool CleanPass::hoistBranch(BasicBlock* basicBlock, BasicBlock* successor,
 
     successor->RemovePredecessor(basicBlock);
 
+    // The new terminator adds the edges to the successors of the empty block,
+    // they carry the phi values of the edges from it
     for (BasicBlock* newSuccessor : successor->GetSuccessors()) {
-        newSuccessor->AddPredecessor(basicBlock);
+        for (PhiInstruction* phi : newSuccessor->GetPhiFunctions()) {
+            Value* value = nullptr;
+            for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+                if (phi->GetIncomingBlock(i) == successor) {
+                    value = phi->GetIncomingValue(i);
+                }
+            }
+            for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+                if (phi->GetIncomingBlock(i) == basicBlock && !phi->GetIncomingValue(i)) {
+                    phi->SetIncomingValue(i, value);
+                }
+            }
+        }
+    }
+
+    if (m_DomTree) {
+        m_DomTree->InsertEdge(basicBlock, successorBranch->GetTrueBasicBlock());
+        m_DomTree->InsertEdge(basicBlock, successorBranch->GetFalseBasicBlock());
+        m_DomTree->DeleteEdge(basicBlock, successor);
     }
 
     return true;
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/DominatorTree.hpp>
 
 
 namespace ir {
 
 /*
     Useless Control Flow and Unreachable Code Elimination
+
+    The given dominator tree is updated with every change of the CFG
 */
 class CleanPass {
 public:
-    CleanPass(Function* function);
+    CleanPass(Function* function, DominatorTree* domTree = nullptr);
 
     void Run();
 
@@ -33,6 +36,7 @@ private:
 
 private:
     Function* m_Function = nullptr;
+    DominatorTree* m_DomTree = nullptr;
 };
 
 }  // namespace
@@ -1,5 +1,7 @@
 #include <Ancl/Optimization/DCEPass.hpp>
 
+#include <Ancl/AnclIR/IRProgram.hpp>
+
 
 namespace ir {
 
@@ -49,11 +51,11 @@ void DCEPass::runMark() {
         BasicBlock* basicBlock = instruction->GetBasicBlock();
         for (BasicBlock* reverseFrontier : m_ReverseDomTree.GetDominanceFrontier(basicBlock)) {
             TerminatorInstruction* terminator = reverseFrontier->GetTerminator();
-            if (auto* branch = dynamic_cast<BranchInstruction*>(terminator)) {
-                if (!isMarkedInstruction(branch)) {
-                    markInstruction(branch);
-                    workList.push_back(branch);
-                }
+            bool isBranch = dynamic_cast<BranchInstruction*>(terminator) ||
+                            dynamic_cast<SwitchInstruction*>(terminator);
+            if (isBranch && !isMarkedInstruction(terminator)) {
+                markInstruction(terminator);
+                workList.push_back(terminator);
             }
         }
     }
@@ -73,12 +75,15 @@ void DCEPass::runSweep() {
             if (auto* terminator = dynamic_cast<TerminatorInstruction*>(instruction)) {
                 auto* branch = dynamic_cast<BranchInstruction*>(terminator);
                 if (branch && branch->IsConditional()) {
-                    // NB: Iteration will end because the exit block is marked
-                    BasicBlock* nearestMarkedDominator = m_ReverseDomTree.GetImmediateDominator(basicBlock);
-                    while (!isMarkedBasicBlock(nearestMarkedDominator)) {
-                        nearestMarkedDominator = m_ReverseDomTree.GetImmediateDominator(nearestMarkedDominator);
+                    branch->ToUnconditional(getNearestMarkedPostDominator(basicBlock));
+                } else if (dynamic_cast<SwitchInstruction*>(terminator)) {
+                    BasicBlock* target = getNearestMarkedPostDominator(basicBlock);
+                    for (BasicBlock* successor : basicBlock->GetSuccessors()) {
+                        successor->RemovePredecessor(basicBlock);
                     }
-                    branch->ToUnconditional(nearestMarkedDominator);
+
+                    IRProgram& program = m_Function->GetProgram();
+                    basicBlock->ReplaceTerminator(program.CreateValue<BranchInstruction>(target, basicBlock));
                 }
                 ++it;
             } else {
@@ -88,6 +93,15 @@ void DCEPass::runSweep() {
     }
 }
 
+// NB: Iteration will end because the exit block is marked
+BasicBlock* DCEPass::getNearestMarkedPostDominator(BasicBlock* basicBlock) const {
+    BasicBlock* nearestMarkedDominator = m_ReverseDomTree.GetImmediateDominator(basicBlock);
+    while (!isMarkedBasicBlock(nearestMarkedDominator)) {
+        nearestMarkedDominator = m_ReverseDomTree.GetImmediateDominator(nearestMarkedDominator);
+    }
+    return nearestMarkedDominator;
+}
+
 bool DCEPass::isCriticalInstruction(Instruction* instruction) const {
     if (auto* storeInstr = dynamic_cast<StoreInstruction*>(instruction)) {
         return true;
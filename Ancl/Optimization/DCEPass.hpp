@@ -21,6 +21,8 @@ private:
     void runMark();
     void runSweep();
 
+    BasicBlock* getNearestMarkedPostDominator(BasicBlock* basicBlock) const;
+
     bool isCriticalInstruction(Instruction* instruction) const;
 
     bool isMarkedInstruction(Instruction* instruction) const;
@@ -0,0 +1,187 @@
+#include <Ancl/Optimization/DSEPass.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+
+namespace ir {
+
+DSEPass::DSEPass(Function* function)
+    : m_Function(function),
+      m_DomTree(function),
+      m_ReverseDomTree(function, /*isReverse=*/true),
+      m_AliasAnalysis(function) {}
+
+void DSEPass::Run() {
+    findDeadLocalMemory();
+
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            auto* store = dynamic_cast<StoreInstruction*>(instruction);
+            if (store && !store->IsVolatile() && !m_DeadInstructions.contains(store) &&
+                    isDeadStore(store)) {
+                m_DeadInstructions.insert(store);
+            }
+        }
+    }
+
+    // A store killed by a dead store is also killed by the store that kills that one,
+    // so all of them are removed at once
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        std::erase_if(block->GetInstructionsRef(), [this](Instruction* instruction) {
+            return m_DeadInstructions.contains(instruction);
+        });
+    }
+}
+
+void DSEPass::findDeadLocalMemory() {
+    std::unordered_map<Value*, bool> isRead;
+    std::vector<Instruction*> writes;
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+                isRead[AliasAnalysis::GetUnderlyingObject(load->GetPtrOperand())] = true;
+            } else if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+                isRead[AliasAnalysis::GetUnderlyingObject(memoryCopy->GetSourceOperand())] = true;
+                writes.push_back(memoryCopy);
+            } else if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+                if (!store->IsVolatile()) {
+                    writes.push_back(store);
+                }
+            } else if (dynamic_cast<MemorySetInstruction*>(instruction)) {
+                writes.push_back(instruction);
+            }
+        }
+    }
+
+    for (Instruction* write : writes) {
+        Value* pointer = nullptr;
+        if (auto* store = dynamic_cast<StoreInstruction*>(write)) {
+            pointer = store->GetAddressOperand();
+        } else if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(write)) {
+            pointer = memoryCopy->GetDestinationOperand();
+        } else {
+            pointer = static_cast<MemorySetInstruction*>(write)->GetDestinationOperand();
+        }
+
+        Value* object = AliasAnalysis::GetUnderlyingObject(pointer);
+        if (m_AliasAnalysis.IsLocalMemory(object) && !isRead[object]) {
+            m_DeadInstructions.insert(write);
+        }
+    }
+}
+
+// Paths are followed forward until the location is read or overwritten.
+// A path must not reach a block that dominates the store: the values
+// the address is computed from would be redefined there
+bool DSEPass::isDeadStore(StoreInstruction* store) const {
+    BasicBlock* storeBlock = store->GetBasicBlock();
+    if (!m_DomTree.Contains(storeBlock) || !m_ReverseDomTree.Contains(storeBlock)) {
+        return false;
+    }
+
+    AliasAnalysis::MemoryLocation location = AliasAnalysis::GetStoreLocation(store);
+    size_t budget = kMaxScannedInstructions;
+
+    const std::list<Instruction*>& instructions = storeBlock->GetInstructionsRef();
+    auto it = std::next(std::find(instructions.begin(), instructions.end(), store));
+    AccessKind kind = scanBlock(it, instructions.end(), location, budget);
+    if (kind != AccessKind::kNone) {
+        return kind == AccessKind::kKill;
+    }
+
+    std::vector<BasicBlock*> workList = storeBlock->GetSuccessors();
+    std::unordered_set<BasicBlock*> visited;
+    while (!workList.empty()) {
+        BasicBlock* block = workList.back();
+        workList.pop_back();
+
+        if (!visited.insert(block).second) {
+            continue;
+        }
+
+        // Blocks that never reach the exit are not post-dominated by anything
+        if (m_DomTree.Dominates(block, storeBlock) || !m_ReverseDomTree.Contains(block)) {
+            return false;
+        }
+
+        const std::list<Instruction*>& blockInstructions = block->GetInstructionsRef();
+        kind = scanBlock(blockInstructions.begin(), blockInstructions.end(), location, budget);
+        if (kind == AccessKind::kRead) {
+            return false;
+        }
+        if (kind == AccessKind::kNone) {
+            std::vector<BasicBlock*> successors = block->GetSuccessors();
+            if (successors.empty()) {
+                return false;
+            }
+            workList.insert(workList.end(), successors.begin(), successors.end());
+        }
+    }
+
+    return true;
+}
+
+DSEPass::AccessKind DSEPass::scanBlock(std::list<Instruction*>::const_iterator begin,
+                                       std::list<Instruction*>::const_iterator end,
+                                       const AliasAnalysis::MemoryLocation& location,
+                                       size_t& budget) const {
+    for (auto it = begin; it != end; ++it) {
+        if (budget == 0) {
+            return AccessKind::kRead;
+        }
+        --budget;
+
+        AccessKind kind = getAccessKind(*it, location);
+        if (kind != AccessKind::kNone) {
+            return kind;
+        }
+    }
+    return AccessKind::kNone;
+}
+
+DSEPass::AccessKind DSEPass::getAccessKind(Instruction* instruction,
+                                           const AliasAnalysis::MemoryLocation& location) const {
+    using AliasResult = AliasAnalysis::AliasResult;
+
+    if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+        AliasResult result = m_AliasAnalysis.Alias(AliasAnalysis::GetLoadLocation(load), location);
+        return result == AliasResult::kNoAlias ? AccessKind::kNone : AccessKind::kRead;
+    }
+
+    if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+        bool isCovered = m_AliasAnalysis.Covers(AliasAnalysis::GetStoreLocation(store), location);
+        return isCovered ? AccessKind::kKill : AccessKind::kNone;
+    }
+
+    if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+        uint64_t size = memoryCopy->GetSizeConstant()->GetValue().GetUnsignedValue();
+        AliasAnalysis::MemoryLocation source{.Pointer = memoryCopy->GetSourceOperand(), .Size = size};
+        if (m_AliasAnalysis.Alias(source, location) != AliasResult::kNoAlias) {
+            return AccessKind::kRead;
+        }
+
+        AliasAnalysis::MemoryLocation destination{.Pointer = memoryCopy->GetDestinationOperand(), .Size = size};
+        return m_AliasAnalysis.Covers(destination, location) ? AccessKind::kKill : AccessKind::kNone;
+    }
+
+    if (auto* memorySet = dynamic_cast<MemorySetInstruction*>(instruction)) {
+        uint64_t size = memorySet->GetBytesNumber()->GetValue().GetUnsignedValue();
+        AliasAnalysis::MemoryLocation destination{.Pointer = memorySet->GetDestinationOperand(), .Size = size};
+        return m_AliasAnalysis.Covers(destination, location) ? AccessKind::kKill : AccessKind::kNone;
+    }
+
+    if (dynamic_cast<CallInstruction*>(instruction)) {
+        return m_AliasAnalysis.IsModifiedByCall(location.Pointer) ? AccessKind::kRead : AccessKind::kNone;
+    }
+
+    // The caller sees everything but the local memory
+    if (dynamic_cast<ReturnInstruction*>(instruction)) {
+        return m_AliasAnalysis.IsLocalMemory(location.Pointer) ? AccessKind::kKill : AccessKind::kRead;
+    }
+
+    return AccessKind::kNone;
+}
+
+}  // namespace ir
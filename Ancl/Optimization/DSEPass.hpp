@@ -0,0 +1,55 @@
+#pragma once
+
+#include <list>
+#include <unordered_set>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/DominatorTree.hpp>
+#include <Ancl/Optimization/AliasAnalysis.hpp>
+
+
+namespace ir {
+
+/*
+    Dead Store Elimination:
+    a store is dead when every path from it overwrites the whole location
+    before anything may read it, for the allocas that do not escape
+    leaving the function also kills the store,
+    all writes to such an alloca are dead if it is never read
+*/
+class DSEPass {
+public:
+    DSEPass(Function* function);
+
+    void Run();
+
+private:
+    enum class AccessKind {
+        kNone,
+        kRead,
+        kKill,
+    };
+
+    void findDeadLocalMemory();
+
+    bool isDeadStore(StoreInstruction* store) const;
+    AccessKind scanBlock(std::list<Instruction*>::const_iterator begin,
+                         std::list<Instruction*>::const_iterator end,
+                         const AliasAnalysis::MemoryLocation& location, size_t& budget) const;
+    AccessKind getAccessKind(Instruction* instruction,
+                             const AliasAnalysis::MemoryLocation& location) const;
+
+private:
+    static constexpr size_t kMaxScannedInstructions = 512;
+
+private:
+    Function* m_Function = nullptr;
+    DominatorTree m_DomTree;
+    DominatorTree m_ReverseDomTree;
+    AliasAnalysis m_AliasAnalysis;
+
+    std::unordered_set<Instruction*> m_DeadInstructions;
+};
+
+}  // namespace ir
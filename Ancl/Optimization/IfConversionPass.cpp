@@ -0,0 +1,254 @@
+#include <Ancl/Optimization/IfConversionPass.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+
+
+namespace ir {
+
+IfConversionPass::IfConversionPass(Function* function)
+    : m_Function(function) {}
+
+void IfConversionPass::Run() {
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+            isChanged |= convertBlock(block);
+        }
+    }
+}
+
+bool IfConversionPass::convertBlock(BasicBlock* head) {
+    auto* branch = dynamic_cast<BranchInstruction*>(head->GetTerminator());
+    if (!branch || branch->IsUnconditional() || dynamic_cast<Constant*>(branch->GetCondition())) {
+        return false;
+    }
+
+    BasicBlock* trueBlock = branch->GetTrueBasicBlock();
+    BasicBlock* falseBlock = branch->GetFalseBasicBlock();
+    if (trueBlock == falseBlock) {
+        return false;
+    }
+
+    BasicBlock* trueArm = isArm(trueBlock, head) ? trueBlock : nullptr;
+    BasicBlock* falseArm = isArm(falseBlock, head) ? falseBlock : nullptr;
+
+    BasicBlock* joinBlock = nullptr;
+    if (trueArm && falseArm && getSuccessor(trueArm) == getSuccessor(falseArm)) {
+        joinBlock = getSuccessor(trueArm);
+    } else if (trueArm && getSuccessor(trueArm) == falseBlock) {
+        joinBlock = falseBlock;
+        falseArm = nullptr;
+    } else if (falseArm && getSuccessor(falseArm) == trueBlock) {
+        joinBlock = trueBlock;
+        trueArm = nullptr;
+    } else {
+        return false;
+    }
+
+    if (joinBlock == head) {
+        return false;
+    }
+
+    // The edge that skips an arm comes right from the head
+    BasicBlock* trueSource = trueArm ? trueArm : head;
+    BasicBlock* falseSource = falseArm ? falseArm : head;
+
+    std::vector<PhiInstruction*> phis = joinBlock->GetPhiFunctions();
+    std::vector<std::pair<Value*, Value*>> incomingValues;
+    size_t selectsNumber = 0;
+    for (PhiInstruction* phi : phis) {
+        Value* trueValue = nullptr;
+        Value* falseValue = nullptr;
+        for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+            if (phi->GetIncomingBlock(i) == trueSource) {
+                trueValue = phi->GetIncomingValue(i);
+            }
+            if (phi->GetIncomingBlock(i) == falseSource) {
+                falseValue = phi->GetIncomingValue(i);
+            }
+        }
+
+        if (trueValue != falseValue) {
+            if (!isSelectableType(phi->GetType())) {
+                return false;
+            }
+            ++selectsNumber;
+        }
+        incomingValues.emplace_back(trueValue, falseValue);
+    }
+
+    size_t trueCost = trueArm ? getArmCost(trueArm) : 0;
+    size_t falseCost = falseArm ? getArmCost(falseArm) : 0;
+    if (trueCost > kMaxArmCost || falseCost > kMaxArmCost ||
+            trueCost + falseCost + selectsNumber > kMaxConversionCost) {
+        return false;
+    }
+
+    std::vector<BasicBlock*> arms;
+    if (trueArm) {
+        moveArmInstructions(trueArm, head);
+        arms.push_back(trueArm);
+    }
+    if (falseArm) {
+        moveArmInstructions(falseArm, head);
+        arms.push_back(falseArm);
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    std::vector<Value*> newValues;
+    for (auto [trueValue, falseValue] : incomingValues) {
+        if (trueValue == falseValue) {
+            newValues.push_back(trueValue);
+            continue;
+        }
+
+        auto* select = program.CreateValue<SelectInstruction>(branch->GetCondition(), trueValue,
+                                                              falseValue, "select", head);
+        head->InsertInstructionBeforeTerminator(select);
+        newValues.push_back(select);
+    }
+
+    joinBlock->RemovePredecessor(trueSource);
+    joinBlock->RemovePredecessor(falseSource);
+
+    auto* jump = program.CreateValue<BranchInstruction>(joinBlock, head);
+    head->ReplaceTerminator(jump);
+    for (size_t i = 0; i < phis.size(); ++i) {
+        phis[i]->SetIncomingValue(phis[i]->GetArgumentsNumber() - 1, newValues[i]);
+    }
+
+    removeBlocks(arms);
+
+    if (joinBlock->GetPredecessorsNumber() == 1) {
+        std::list<Instruction*>& joinInstructions = joinBlock->GetInstructionsRef();
+        for (size_t i = 0; i < phis.size(); ++i) {
+            replaceAllUses(phis[i], newValues[i]);
+            std::erase(joinInstructions, phis[i]);
+        }
+
+        // The last block keeps the return, so it is merged later by the cleanup
+        if (joinBlock != m_Function->GetLastBlock()) {
+            mergeJoinBlock(head, joinBlock);
+        }
+    }
+
+    return true;
+}
+
+// An arm is entered only from the head and jumps right to the join block
+bool IfConversionPass::isArm(BasicBlock* block, BasicBlock* head) const {
+    if (block == head || block->GetPredecessorsNumber() != 1 || !getSuccessor(block)) {
+        return false;
+    }
+
+    const std::list<Instruction*>& instructions = block->GetInstructionsRef();
+    return std::all_of(instructions.begin(), std::prev(instructions.end()), isSpeculatable);
+}
+
+BasicBlock* IfConversionPass::getSuccessor(BasicBlock* block) const {
+    auto* branch = dynamic_cast<BranchInstruction*>(block->GetTerminator());
+    if (!branch || branch->IsConditional()) {
+        return nullptr;
+    }
+    return branch->GetTrueBasicBlock();
+}
+
+void IfConversionPass::moveArmInstructions(BasicBlock* arm, BasicBlock* head) {
+    std::list<Instruction*>& instructions = arm->GetInstructionsRef();
+    for (auto it = instructions.begin(); it != std::prev(instructions.end()); ++it) {
+        head->InsertInstructionBeforeTerminator(*it);
+    }
+}
+
+void IfConversionPass::removeBlocks(const std::vector<BasicBlock*>& blocks) {
+    std::vector<BasicBlock*> functionBlocks = m_Function->GetBasicBlocks();
+    std::erase_if(functionBlocks, [&blocks](BasicBlock* block) {
+        return std::find(blocks.begin(), blocks.end(), block) != blocks.end();
+    });
+    m_Function->SetBasicBlocks(functionBlocks);
+}
+
+// The join block of an inner diamond becomes a part of an arm of the outer one
+void IfConversionPass::mergeJoinBlock(BasicBlock* head, BasicBlock* join) {
+    std::list<Instruction*>& joinInstructions = join->GetInstructionsRef();
+    TerminatorInstruction* terminator = join->GetTerminator();
+    for (Instruction* instruction : joinInstructions) {
+        if (instruction == terminator) {
+            break;
+        }
+        head->InsertInstructionBeforeTerminator(instruction);
+    }
+
+    for (BasicBlock* successor : join->GetSuccessors()) {
+        successor->ReplacePredecessor(join, head);
+    }
+
+    // The edges from the join block are already moved to the head
+    terminator->SetBasicBlock(head);
+    head->GetInstructionsRef().back() = terminator;
+    joinInstructions.clear();
+
+    removeBlocks({join});
+}
+
+void IfConversionPass::replaceAllUses(Value* from, Value* to) {
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+                if (instruction->GetOperand(i) == from) {
+                    instruction->SetOperand(to, i);
+                }
+            }
+        }
+    }
+}
+
+// Division traps on a zero divisor, memory accesses may fault,
+// the float division is slower than the branch
+bool IfConversionPass::isSpeculatable(Instruction* instruction) {
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        using OpType = BinaryInstruction::OpType;
+        switch (binary->GetOpType()) {
+            case OpType::kSDiv:
+            case OpType::kUDiv:
+            case OpType::kSRem:
+            case OpType::kURem:
+            case OpType::kFDiv:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    return dynamic_cast<CompareInstruction*>(instruction) || dynamic_cast<CastInstruction*>(instruction) ||
+           dynamic_cast<MemberInstruction*>(instruction) || dynamic_cast<SelectInstruction*>(instruction);
+}
+
+// CMOV has no byte form, the float values keep their branches
+bool IfConversionPass::isSelectableType(Type* type) {
+    if (auto* intType = dynamic_cast<IntType*>(type)) {
+        return intType->GetBytesNumber() >= 2;
+    }
+    return dynamic_cast<PointerType*>(type) != nullptr;
+}
+
+size_t IfConversionPass::getArmCost(BasicBlock* arm) {
+    size_t cost = 0;
+    for (Instruction* instruction : arm->GetInstructionsRef()) {
+        if (instruction == arm->GetTerminator()) {
+            break;
+        }
+
+        auto* binary = dynamic_cast<BinaryInstruction*>(instruction);
+        bool isMultiply = binary && (binary->GetOpType() == BinaryInstruction::OpType::kMul ||
+                                     binary->GetOpType() == BinaryInstruction::OpType::kFMul);
+        cost += isMultiply ? kMultiplyCost : 1;
+    }
+    return cost;
+}
+
+}  // namespace ir
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    If-Conversion:
+    small diamonds and triangles whose arms have no side effects
+    are replaced with selects in the head block, the arms are executed
+    unconditionally, so the branch is removed when both arms are cheaper
+    than a mispredicted jump
+*/
+class IfConversionPass {
+public:
+    IfConversionPass(Function* function);
+
+    void Run();
+
+private:
+    bool convertBlock(BasicBlock* head);
+
+    bool isArm(BasicBlock* block, BasicBlock* head) const;
+    BasicBlock* getSuccessor(BasicBlock* block) const;
+
+    void moveArmInstructions(BasicBlock* arm, BasicBlock* head);
+    void removeBlocks(const std::vector<BasicBlock*>& blocks);
+    void mergeJoinBlock(BasicBlock* head, BasicBlock* join);
+
+    void replaceAllUses(Value* from, Value* to);
+
+    static bool isSpeculatable(Instruction* instruction);
+    static bool isSelectableType(Type* type);
+    static size_t getArmCost(BasicBlock* arm);
+
+private:
+    // A mispredicted branch costs about as much as several simple instructions
+    static constexpr size_t kMaxArmCost = 4;
+    static constexpr size_t kMaxConversionCost = 6;
+
+    static constexpr size_t kMultiplyCost = 3;
+
+private:
+    Function* m_Function = nullptr;
+};
+
+}  // namespace ir
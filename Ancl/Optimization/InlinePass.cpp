@@ -0,0 +1,452 @@
+#include <Ancl/Optimization/InlinePass.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace ir {
+
+InlinePass::InlinePass(IRProgram& program)
+    : m_Program(program) {}
+
+void InlinePass::Run() {
+    collectDefinitions();
+    buildCallGraph();
+
+    // Program order keeps the inlining decisions deterministic
+    for (Function* function : m_Program.GetFunctions()) {
+        Function* definition = getDefinition(function);
+        if (definition && !m_Indices.contains(definition)) {
+            findComponents(definition);
+        }
+    }
+
+    for (Function* caller : m_BottomUpOrder) {
+        inlineCalls(caller);
+    }
+}
+
+void InlinePass::RunOnFunction(Function* function) {
+    collectDefinitions();
+    buildCallGraph();
+
+    // The callees were compiled earlier with their own calls inlined
+    findComponents(function);
+    inlineCalls(function);
+}
+
+bool InlinePass::IsInlineCandidate(Function* function) {
+    // The cheapest call passes constants for all the parameters
+    int cost = -kCallBonus - static_cast<int>(function->GetParameters().size());
+    for (BasicBlock* block : function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (dynamic_cast<PhiInstruction*>(instruction)) {
+                continue;
+            }
+            ++cost;
+
+            for (Value* operand : instruction->GetOperands()) {
+                if (dynamic_cast<Parameter*>(operand)) {
+                    cost -= kConstantArgumentBonus;
+                    break;
+                }
+            }
+        }
+    }
+
+    int threshold = function->IsInline() ? kInlineHintThreshold : kInlineThreshold;
+    return cost <= threshold;
+}
+
+void InlinePass::collectDefinitions() {
+    for (Function* function : m_Program.GetFunctions()) {
+        if (!function->IsDeclaration() && function->GetEntryBlock()) {
+            m_Definitions[function->GetName()] = function;
+        }
+    }
+}
+
+void InlinePass::buildCallGraph() {
+    for (const auto& [name, function] : m_Definitions) {
+        std::vector<Function*>& callees = m_Callees[function];
+        for (BasicBlock* block : function->GetBasicBlocks()) {
+            for (Instruction* instruction : block->GetInstructionsRef()) {
+                auto* call = dynamic_cast<CallInstruction*>(instruction);
+                if (!call) {
+                    continue;
+                }
+
+                Function* callee = getDefinition(call->GetCallee());
+                if (callee && std::find(callees.begin(), callees.end(), callee) == callees.end()) {
+                    callees.push_back(callee);
+                }
+            }
+        }
+    }
+}
+
+void InlinePass::findComponents(Function* function) {
+    size_t index = m_Indices.size();
+    m_Indices[function] = index;
+    m_LowLinks[function] = index;
+
+    m_Stack.push_back(function);
+    m_OnStack.insert(function);
+
+    for (Function* callee : m_Callees[function]) {
+        if (!m_Indices.contains(callee)) {
+            findComponents(callee);
+            m_LowLinks[function] = std::min(m_LowLinks[function], m_LowLinks[callee]);
+        } else if (m_OnStack.contains(callee)) {
+            m_LowLinks[function] = std::min(m_LowLinks[function], m_Indices[callee]);
+        }
+    }
+
+    if (m_LowLinks[function] != m_Indices[function]) {
+        return;
+    }
+
+    Function* member = nullptr;
+    while (member != function) {
+        member = m_Stack.back();
+        m_Stack.pop_back();
+        m_OnStack.erase(member);
+
+        m_Components[member] = m_ComponentsNumber;
+        m_BottomUpOrder.push_back(member);
+    }
+    ++m_ComponentsNumber;
+}
+
+void InlinePass::inlineCalls(Function* caller) {
+    // Calls that come with inlined bodies were already considered in the callees
+    std::vector<CallInstruction*> calls;
+    for (BasicBlock* block : caller->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (auto* call = dynamic_cast<CallInstruction*>(instruction)) {
+                calls.push_back(call);
+            }
+        }
+    }
+
+    for (CallInstruction* call : calls) {
+        Function* callee = getDefinition(call->GetCallee());
+        if (shouldInline(call, caller, callee)) {
+            inlineCall(call, caller, callee);
+        }
+    }
+}
+
+bool InlinePass::shouldInline(CallInstruction* call, Function* caller, Function* callee) const {
+    if (!isInlinable(call, caller, callee)) {
+        return false;
+    }
+
+    if (getInstructionsNumber(caller) + getInstructionsNumber(callee) > kMaxCallerSize) {
+        return false;
+    }
+
+    int threshold = callee->IsInline() ? kInlineHintThreshold : kInlineThreshold;
+    return getInlineCost(call, callee) <= threshold;
+}
+
+bool InlinePass::isInlinable(CallInstruction* call, Function* caller, Function* callee) const {
+    if (!callee || m_Components.at(callee) == m_Components.at(caller)) {
+        return false;
+    }
+
+    auto* functionType = static_cast<FunctionType*>(callee->GetType());
+    if (functionType->IsVariadic() ||
+            callee->GetParameters().size() != call->GetArgumentsNumber()) {
+        return false;
+    }
+
+    if (callee->GetEntryBlock()->GetPredecessorsNumber() != 0) {
+        return false;
+    }
+
+    bool hasReturn = false;
+    bool isVoid = dynamic_cast<VoidType*>(functionType->GetReturnType());
+    for (BasicBlock* block : callee->GetBasicBlocks()) {
+        TerminatorInstruction* terminator = block->GetTerminator();
+        if (auto* ret = dynamic_cast<ReturnInstruction*>(terminator)) {
+            if (!isVoid && !ret->HasReturnValue()) {
+                return false;
+            }
+            hasReturn = true;
+        }
+    }
+
+    return hasReturn;
+}
+
+// Instructions of the callee without the call sequence and the instructions
+// that fold with the constant arguments
+int InlinePass::getInlineCost(CallInstruction* call, Function* callee) const {
+    std::vector<Parameter*> parameters = callee->GetParameters();
+    std::unordered_set<Value*> constantParameters;
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        Value* argument = call->GetOperand(i);
+        if (dynamic_cast<IntConstant*>(argument) || dynamic_cast<FloatConstant*>(argument)) {
+            constantParameters.insert(parameters[i]);
+        }
+    }
+
+    int cost = -kCallBonus - static_cast<int>(parameters.size());
+    for (BasicBlock* block : callee->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (dynamic_cast<PhiInstruction*>(instruction)) {
+                continue;
+            }
+            ++cost;
+
+            for (Value* operand : instruction->GetOperands()) {
+                if (constantParameters.contains(operand)) {
+                    cost -= kConstantArgumentBonus;
+                    break;
+                }
+            }
+        }
+    }
+
+    return cost;
+}
+
+void InlinePass::inlineCall(CallInstruction* call, Function* caller, Function* callee) {
+    BasicBlock* callBlock = call->GetBasicBlock();
+    BasicBlock* continueBlock = splitBlock(call);
+
+    std::unordered_map<Value*, Value*> valueMap;
+    std::vector<Parameter*> parameters = callee->GetParameters();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        valueMap[parameters[i]] = call->GetOperand(i);
+    }
+
+    std::vector<BasicBlock*> calleeBlocks = callee->GetBasicBlocks();
+    std::vector<BasicBlock*> newBlocks;
+    for (BasicBlock* block : calleeBlocks) {
+        auto* newBlock = m_Program.CreateValue<BasicBlock>(block->GetName(),
+                                                           LabelType::Create(m_Program), caller);
+        valueMap[block] = newBlock;
+        newBlocks.push_back(newBlock);
+    }
+
+    // Predecessors keep their order, so the phi arguments are copied as they are
+    for (size_t i = 0; i < calleeBlocks.size(); ++i) {
+        for (BasicBlock* predecessor : calleeBlocks[i]->GetPredecessors()) {
+            newBlocks[i]->AddPredecessor(static_cast<BasicBlock*>(valueMap.at(predecessor)));
+        }
+    }
+
+    // Allocas of the callee are static in the caller as well
+    BasicBlock* entryBlock = caller->GetEntryBlock();
+    std::vector<Instruction*> newInstructions;
+    for (size_t i = 0; i < calleeBlocks.size(); ++i) {
+        for (Instruction* instruction : calleeBlocks[i]->GetInstructionsRef()) {
+            Instruction* newInstruction = cloneInstruction(instruction, newBlocks[i], valueMap);
+            valueMap[instruction] = newInstruction;
+            newInstructions.push_back(newInstruction);
+
+            if (dynamic_cast<AllocaInstruction*>(newInstruction)) {
+                entryBlock->AddInstructionToBegin(newInstruction);
+            } else {
+                newBlocks[i]->GetInstructionsRef().push_back(newInstruction);
+            }
+        }
+    }
+
+    for (Instruction* instruction : newInstructions) {
+        for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+            auto it = valueMap.find(instruction->GetOperand(i));
+            if (it != valueMap.end()) {
+                instruction->SetOperand(it->second, i);
+            }
+        }
+    }
+
+    // Returns jump to the continuation, the result is merged there
+    std::vector<BasicBlock*> returnBlocks;
+    std::vector<Value*> returnValues;
+    for (BasicBlock* block : newBlocks) {
+        auto* ret = dynamic_cast<ReturnInstruction*>(block->GetTerminator());
+        if (!ret) {
+            continue;
+        }
+
+        returnBlocks.push_back(block);
+        returnValues.push_back(ret->HasReturnValue() ? ret->GetReturnValue() : nullptr);
+
+        block->GetInstructionsRef().pop_back();
+        block->AddInstruction(m_Program.CreateValue<BranchInstruction>(continueBlock, block));
+    }
+
+    callBlock->AddInstruction(m_Program.CreateValue<BranchInstruction>(newBlocks.front(), callBlock));
+
+    std::vector<BasicBlock*> blocks = caller->GetBasicBlocks();
+    auto callBlockIt = std::find(blocks.begin(), blocks.end(), callBlock);
+    newBlocks.push_back(continueBlock);
+    blocks.insert(callBlockIt + 1, newBlocks.begin(), newBlocks.end());
+    caller->SetBasicBlocks(blocks);
+
+    if (!dynamic_cast<VoidType*>(call->GetType())) {
+        Value* result = returnValues.front();
+        if (returnBlocks.size() > 1) {
+            auto* phi = m_Program.CreateValue<PhiInstruction>(call->GetType(), call->GetName(),
+                                                              continueBlock);
+            continueBlock->AddPhiFunction(phi);
+            for (size_t i = 0; i < returnBlocks.size(); ++i) {
+                phi->SetIncomingBlock(i, returnBlocks[i]);
+                phi->SetIncomingValue(i, returnValues[i]);
+            }
+            result = phi;
+        }
+        replaceAllUses(caller, call, result);
+    }
+
+}
+
+// Moves the instructions after the call to a new block, the call is removed
+BasicBlock* InlinePass::splitBlock(CallInstruction* call) {
+    BasicBlock* block = call->GetBasicBlock();
+    Function* function = block->GetFunction();
+    auto* newBlock = m_Program.CreateValue<BasicBlock>(block->GetName() + ".split",
+                                                       LabelType::Create(m_Program), function);
+
+    auto& instructions = block->GetInstructionsRef();
+    auto callIt = std::find(instructions.begin(), instructions.end(), call);
+    for (auto it = std::next(callIt); it != instructions.end(); ++it) {
+        (*it)->SetBasicBlock(newBlock);
+        newBlock->GetInstructionsRef().push_back(*it);
+    }
+    instructions.erase(callIt, instructions.end());
+
+    for (BasicBlock* successor : newBlock->GetSuccessors()) {
+        successor->ReplacePredecessor(block, newBlock);
+    }
+
+    return newBlock;
+}
+
+// Operands are remapped when all the instructions of the callee are cloned
+Instruction* InlinePass::cloneInstruction(Instruction* instruction, BasicBlock* block,
+                                          const std::unordered_map<Value*, Value*>& valueMap) {
+    auto getBlock = [&valueMap](BasicBlock* block) {
+        return static_cast<BasicBlock*>(valueMap.at(block));
+    };
+
+    Instruction* newInstruction = nullptr;
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<BinaryInstruction>(
+                            binary->GetOpType(), binary->GetName(),
+                            binary->GetLeftOperand(), binary->GetRightOperand(), block);
+    } else if (auto* compare = dynamic_cast<CompareInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<CompareInstruction>(
+                            compare->GetOpType(), compare->GetName(),
+                            compare->GetLeftOperand(), compare->GetRightOperand(), block);
+    } else if (auto* cast = dynamic_cast<CastInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<CastInstruction>(
+                            cast->GetOpType(), cast->GetName(),
+                            cast->GetFromOperand(), cast->GetToType(), block);
+    } else if (auto* select = dynamic_cast<SelectInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<SelectInstruction>(
+                            select->GetCondition(), select->GetTrueValue(),
+                            select->GetFalseValue(), select->GetName(), block);
+    } else if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+        auto* newLoad = m_Program.CreateValue<LoadInstruction>(
+                            load->GetPtrOperand(), load->GetType(), load->GetName(), block);
+        if (load->IsVolatile()) {
+            newLoad->SetVolatile();
+        }
+        newInstruction = newLoad;
+    } else if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+        auto* newStore = m_Program.CreateValue<StoreInstruction>(
+                            store->GetValueOperand(), store->GetAddressOperand(),
+                            store->GetName(), block);
+        if (store->IsVolatile()) {
+            newStore->SetVolatile();
+        }
+        newInstruction = newStore;
+    } else if (auto* member = dynamic_cast<MemberInstruction*>(instruction)) {
+        auto* newMember = m_Program.CreateValue<MemberInstruction>(
+                            member->GetPtrOperand(), member->GetIndex(),
+                            member->GetName(), member->GetType(), block);
+        newMember->SetDeref(member->IsDeref());
+        newInstruction = newMember;
+    } else if (auto* alloca = dynamic_cast<AllocaInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<AllocaInstruction>(
+                            alloca->GetAllocaType(), alloca->GetName(), block);
+    } else if (auto* call = dynamic_cast<CallInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<CallInstruction>(
+                            call->GetCallee(), call->GetArguments(), call->GetName(), block);
+    } else if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<MemoryCopyInstruction>(
+                            memoryCopy->GetDestinationOperand(), memoryCopy->GetSourceOperand(),
+                            memoryCopy->GetSizeConstant(), block);
+    } else if (auto* memorySet = dynamic_cast<MemorySetInstruction*>(instruction)) {
+        newInstruction = m_Program.CreateValue<MemorySetInstruction>(
+                            memorySet->GetDestinationOperand(), memorySet->GetFillByte(),
+                            memorySet->GetBytesNumber(), block);
+    } else if (auto* phi = dynamic_cast<PhiInstruction*>(instruction)) {
+        auto* newPhi = m_Program.CreateValue<PhiInstruction>(phi->GetType(), phi->GetName(), block);
+        for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+            newPhi->SetIncomingBlock(i, getBlock(phi->GetIncomingBlock(i)));
+            newPhi->SetIncomingValue(i, phi->GetIncomingValue(i));
+        }
+        newInstruction = newPhi;
+    } else if (auto* branch = dynamic_cast<BranchInstruction*>(instruction)) {
+        if (branch->IsConditional()) {
+            newInstruction = m_Program.CreateValue<BranchInstruction>(
+                                branch->GetCondition(), getBlock(branch->GetTrueBasicBlock()),
+                                getBlock(branch->GetFalseBasicBlock()), block);
+        } else {
+            newInstruction = m_Program.CreateValue<BranchInstruction>(
+                                getBlock(branch->GetTrueBasicBlock()), block);
+        }
+    } else if (auto* switchInstr = dynamic_cast<SwitchInstruction*>(instruction)) {
+        auto* newSwitch = m_Program.CreateValue<SwitchInstruction>(
+                            switchInstr->GetValue(), getBlock(switchInstr->GetDefaultBasicBlock()), block);
+        for (const auto& switchCase : switchInstr->GetCases()) {
+            newSwitch->AddCase({switchCase.CaseValue, getBlock(switchCase.CaseBasicBlock)});
+        }
+        newInstruction = newSwitch;
+    } else if (auto* ret = dynamic_cast<ReturnInstruction*>(instruction)) {
+        if (ret->HasReturnValue()) {
+            newInstruction = m_Program.CreateValue<ReturnInstruction>(ret->GetReturnValue(), block);
+        } else {
+            newInstruction = m_Program.CreateValue<ReturnInstruction>(block);
+        }
+    }
+
+    assert(newInstruction);
+    return newInstruction;
+}
+
+void InlinePass::replaceAllUses(Function* function, Value* from, Value* to) {
+    for (BasicBlock* block : function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+                if (instruction->GetOperand(i) == from) {
+                    instruction->SetOperand(to, i);
+                }
+            }
+        }
+    }
+}
+
+Function* InlinePass::getDefinition(Function* function) const {
+    auto it = m_Definitions.find(function->GetName());
+    if (it == m_Definitions.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+size_t InlinePass::getInstructionsNumber(Function* function) {
+    size_t instructionsNumber = 0;
+    for (BasicBlock* block : function->GetBasicBlocks()) {
+        instructionsNumber += block->GetInstructionsRef().size();
+    }
+    return instructionsNumber;
+}
+
+}  // namespace ir
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/AnclIR/IRProgram.hpp>
+
+
+namespace ir {
+
+/*
+    Function Inlining:
+    call sites are visited bottom-up over the strongly connected components
+    of the call graph, so a callee is inlined with its own calls already inlined,
+    calls inside one component (recursion) are kept
+*/
+class InlinePass {
+public:
+    InlinePass(IRProgram& program);
+
+    void Run();
+
+    // Streaming compilation: inlines the calls of one function into it,
+    // the callees are the definitions that are still in the program
+    void RunOnFunction(Function* function);
+
+    // Whether some call could inline the function, streaming compilation
+    // keeps the bodies of such functions after their code is emitted
+    static bool IsInlineCandidate(Function* function);
+
+private:
+    void collectDefinitions();
+    void buildCallGraph();
+
+    void findComponents(Function* function);
+
+    void inlineCalls(Function* caller);
+
+    bool shouldInline(CallInstruction* call, Function* caller, Function* callee) const;
+    bool isInlinable(CallInstruction* call, Function* caller, Function* callee) const;
+
+    int getInlineCost(CallInstruction* call, Function* callee) const;
+
+    void inlineCall(CallInstruction* call, Function* caller, Function* callee);
+
+    BasicBlock* splitBlock(CallInstruction* call);
+    Instruction* cloneInstruction(Instruction* instruction, BasicBlock* block,
+                                  const std::unordered_map<Value*, Value*>& valueMap);
+
+    void replaceAllUses(Function* function, Value* from, Value* to);
+
+    Function* getDefinition(Function* function) const;
+    static size_t getInstructionsNumber(Function* function);
+
+private:
+    // Costs are measured in IR instructions
+    static constexpr int kInlineThreshold = 40;
+    static constexpr int kInlineHintThreshold = 160;
+    static constexpr int kConstantArgumentBonus = 4;
+    static constexpr int kCallBonus = 4;
+    static constexpr size_t kMaxCallerSize = 2000;
+
+    IRProgram& m_Program;
+
+    // Calls refer to the latest declaration of the callee
+    std::unordered_map<std::string, Function*> m_Definitions;
+
+    std::unordered_map<Function*, std::vector<Function*>> m_Callees;
+
+    // Tarjan's algorithm state, components are completed callees first
+    std::unordered_map<Function*, size_t> m_Indices;
+    std::unordered_map<Function*, size_t> m_LowLinks;
+    std::vector<Function*> m_Stack;
+    std::unordered_set<Function*> m_OnStack;
+    std::unordered_map<Function*, size_t> m_Components;
+    std::vector<Function*> m_BottomUpOrder;
+    size_t m_ComponentsNumber = 0;
+};
+
+}  // namespace ir
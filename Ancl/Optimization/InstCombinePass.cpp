@@ -0,0 +1,643 @@
+#include <Ancl/Optimization/InstCombinePass.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+
+
+namespace ir {
+
+InstCombinePass::InstCombinePass(Function* function)
+    : m_Function(function) {}
+
+void InstCombinePass::Run() {
+    std::vector<Instruction*> instructions;
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (operand) {
+                    m_Users[operand].push_back(instruction);
+                }
+            }
+            instructions.push_back(instruction);
+        }
+    }
+
+    // The worklist is a stack, so the instructions are visited in program order
+    for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+        addToWorklist(*it);
+    }
+
+    while (!m_Worklist.empty()) {
+        Instruction* instruction = m_Worklist.back();
+        m_Worklist.pop_back();
+        m_InWorklist.erase(instruction);
+
+        if (m_Erased.contains(instruction)) {
+            continue;
+        }
+
+        if (isDeadInstruction(instruction)) {
+            eraseInstruction(instruction);
+            continue;
+        }
+
+        Value* result = combineInstruction(instruction);
+        if (!result) {
+            continue;
+        }
+
+        if (result == instruction) {
+            addToWorklist(instruction);
+            addUsersToWorklist(instruction);
+            continue;
+        }
+
+        replaceAllUses(instruction, result);
+        if (auto* resultInstruction = dynamic_cast<Instruction*>(result)) {
+            addToWorklist(resultInstruction);
+        }
+        eraseInstruction(instruction);
+    }
+}
+
+Value* InstCombinePass::combineInstruction(Instruction* instruction) {
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        return combineBinary(binary);
+    }
+    if (auto* compare = dynamic_cast<CompareInstruction*>(instruction)) {
+        return combineCompare(compare);
+    }
+    if (auto* cast = dynamic_cast<CastInstruction*>(instruction)) {
+        return combineCast(cast);
+    }
+    return nullptr;
+}
+
+Value* InstCombinePass::combineBinary(BinaryInstruction* binary) {
+    using OpType = BinaryInstruction::OpType;
+
+    Value* left = binary->GetLeftOperand();
+    Value* right = binary->GetRightOperand();
+
+    if (binary->IsCommutative() && getOperandRank(left) < getOperandRank(right)) {
+        setOperand(binary, 0, right);
+        setOperand(binary, 1, left);
+        return binary;
+    }
+
+    // Floats have signed zeros and NaNs, so only the order is canonical
+    // and the exact divisions become multiplications
+    auto* intType = dynamic_cast<IntType*>(binary->GetType());
+    if (!intType) {
+        auto* constant = dynamic_cast<FloatConstant*>(right);
+        if (constant && binary->GetOpType() == OpType::kFDiv) {
+            return combineFloatDivision(binary, constant);
+        }
+        return nullptr;
+    }
+
+    if (left == right) {
+        switch (binary->GetOpType()) {
+            case OpType::kSub:
+            case OpType::kXor:
+                return getIntConstant(intType, 0);
+            case OpType::kAnd:
+            case OpType::kOr:
+                return left;
+            default:
+                break;
+        }
+    }
+
+    if (auto* constant = dynamic_cast<IntConstant*>(right)) {
+        return combineConstantOperand(binary, constant);
+    }
+
+    // Negations: x + (0 - y) = x - y, (0 - x) + y = y - x, x - (0 - y) = x + y
+    auto isNegation = [](Value* value) {
+        auto* binary = dynamic_cast<BinaryInstruction*>(value);
+        return binary && binary->GetOpType() == OpType::kSub &&
+               isIntConstant(binary->GetLeftOperand(), 0);
+    };
+    auto getNegated = [](Value* value) {
+        return static_cast<BinaryInstruction*>(value)->GetRightOperand();
+    };
+
+    switch (binary->GetOpType()) {
+        case OpType::kAdd:
+            if (isNegation(right)) {
+                return insertBinary(OpType::kSub, left, getNegated(right), binary);
+            }
+            if (isNegation(left)) {
+                return insertBinary(OpType::kSub, right, getNegated(left), binary);
+            }
+            break;
+        case OpType::kSub:
+            if (isNegation(right)) {
+                if (isIntConstant(left, 0)) {
+                    return getNegated(right);
+                }
+                return insertBinary(OpType::kAdd, left, getNegated(right), binary);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+Value* InstCombinePass::combineConstantOperand(BinaryInstruction* binary, IntConstant* constant) {
+    using OpType = BinaryInstruction::OpType;
+
+    auto* intType = static_cast<IntType*>(binary->GetType());
+    Value* left = binary->GetLeftOperand();
+    uint64_t value = constant->GetValue().GetUnsignedValue();
+
+    switch (binary->GetOpType()) {
+        case OpType::kAdd:
+        case OpType::kOr:
+        case OpType::kXor:
+            if (isIntConstant(constant, 0)) {
+                return left;
+            }
+            break;
+        case OpType::kSub:
+            if (isIntConstant(constant, 0)) {
+                return left;
+            }
+            // Additions of constants are reassociated
+            return insertBinary(OpType::kAdd, left, getIntConstant(intType, -value), binary);
+        case OpType::kMul:
+            if (isIntConstant(constant, 0)) {
+                return getIntConstant(intType, 0);
+            }
+            if (isIntConstant(constant, 1)) {
+                return left;
+            }
+            if (isIntConstant(constant, -1)) {
+                return insertBinary(OpType::kSub, getIntConstant(intType, 0), left, binary);
+            }
+            if (int64_t signedValue = static_cast<int64_t>(value);
+                    signedValue > 0 && (value & (value - 1)) == 0) {
+                uint64_t shift = std::countr_zero(value);
+                return insertBinary(OpType::kShiftL, left, getIntConstant(intType, shift), binary);
+            }
+            break;
+        case OpType::kAnd:
+            if (isIntConstant(constant, 0)) {
+                return getIntConstant(intType, 0);
+            }
+            if (isAllOnes(constant)) {
+                return left;
+            }
+            break;
+        case OpType::kShiftL:
+        case OpType::kLShiftR:
+        case OpType::kAShiftR:
+            if (isIntConstant(constant, 0)) {
+                return left;
+            }
+            return combineShifts(binary, constant);
+        case OpType::kSDiv:
+            if (isIntConstant(constant, 1)) {
+                return left;
+            }
+            return nullptr;
+        case OpType::kUDiv:
+            if (isIntConstant(constant, 1)) {
+                return left;
+            }
+            if (uint64_t divisor = getUnsignedValue(constant); std::has_single_bit(divisor)) {
+                uint64_t shift = std::countr_zero(divisor);
+                return insertBinary(OpType::kLShiftR, left, getIntConstant(intType, shift), binary);
+            }
+            return nullptr;
+        case OpType::kSRem:
+            if (isIntConstant(constant, 1)) {
+                return getIntConstant(intType, 0);
+            }
+            return nullptr;
+        case OpType::kURem:
+            if (isIntConstant(constant, 1)) {
+                return getIntConstant(intType, 0);
+            }
+            if (uint64_t divisor = getUnsignedValue(constant); std::has_single_bit(divisor)) {
+                return insertBinary(OpType::kAnd, left, getIntConstant(intType, divisor - 1), binary);
+            }
+            return nullptr;
+        default:
+            return nullptr;
+    }
+
+    if (binary->GetOpType() == OpType::kOr && isAllOnes(constant)) {
+        return getIntConstant(intType, ~uint64_t(0));
+    }
+
+    // (x op c1) op c2 = x op (c1 op c2)
+    auto* inner = dynamic_cast<BinaryInstruction*>(left);
+    if (!inner || inner->GetOpType() != binary->GetOpType() || !hasOneUser(inner)) {
+        return nullptr;
+    }
+
+    auto* innerConstant = dynamic_cast<IntConstant*>(inner->GetRightOperand());
+    if (!innerConstant) {
+        return nullptr;
+    }
+
+    uint64_t innerValue = innerConstant->GetValue().GetUnsignedValue();
+    uint64_t result = 0;
+    switch (binary->GetOpType()) {
+        case OpType::kAdd: result = innerValue + value; break;
+        case OpType::kMul: result = innerValue * value; break;
+        case OpType::kAnd: result = innerValue & value; break;
+        case OpType::kOr: result = innerValue | value; break;
+        case OpType::kXor: result = innerValue ^ value; break;
+        default: return nullptr;
+    }
+
+    setOperand(binary, 0, inner->GetLeftOperand());
+    setOperand(binary, 1, getIntConstant(intType, result));
+    return binary;
+}
+
+// x / 2^k = x * 2^-k is exact while the reciprocal is a normal number of the type
+Value* InstCombinePass::combineFloatDivision(BinaryInstruction* binary, FloatConstant* constant) {
+    double value = constant->GetValue().GetValue();
+    int exponent = 0;
+    if (!std::isfinite(value) || std::abs(std::frexp(value, &exponent)) != 0.5) {
+        return nullptr;
+    }
+
+    auto* floatType = static_cast<FloatType*>(binary->GetType());
+    bool isFloat = floatType->GetKind() == FloatType::Kind::kFloat;
+
+    double reciprocal = 1.0 / value;
+    if (isFloat ? !std::isnormal(static_cast<float>(reciprocal)) : !std::isnormal(reciprocal)) {
+        return nullptr;
+    }
+
+    FloatValue reciprocalValue = isFloat ? FloatValue(static_cast<float>(reciprocal)) : FloatValue(reciprocal);
+
+    IRProgram& program = m_Function->GetProgram();
+    auto* reciprocalConstant = program.CreateValue<FloatConstant>(floatType, reciprocalValue);
+    return insertBinary(BinaryInstruction::OpType::kFMul, binary->GetLeftOperand(), reciprocalConstant, binary);
+}
+
+// (x << a) << b = x << (a + b), the shift out of the width gives zero
+// for the logical shifts and the sign for the arithmetic one
+Value* InstCombinePass::combineShifts(BinaryInstruction* binary, IntConstant* constant) {
+    auto* inner = dynamic_cast<BinaryInstruction*>(binary->GetLeftOperand());
+    if (!inner || inner->GetOpType() != binary->GetOpType() || !hasOneUser(inner)) {
+        return nullptr;
+    }
+
+    auto* innerConstant = dynamic_cast<IntConstant*>(inner->GetRightOperand());
+    if (!innerConstant) {
+        return nullptr;
+    }
+
+    uint64_t bitsNumber = getBitsNumber(binary->GetType());
+    uint64_t outerShift = constant->GetValue().GetUnsignedValue();
+    uint64_t innerShift = innerConstant->GetValue().GetUnsignedValue();
+    if (outerShift >= bitsNumber || innerShift >= bitsNumber) {
+        return nullptr;
+    }
+
+    auto* intType = static_cast<IntType*>(binary->GetType());
+    uint64_t shift = outerShift + innerShift;
+    if (shift >= bitsNumber) {
+        if (binary->GetOpType() != BinaryInstruction::OpType::kAShiftR) {
+            return getIntConstant(intType, 0);
+        }
+        shift = bitsNumber - 1;
+    }
+
+    setOperand(binary, 0, inner->GetLeftOperand());
+    setOperand(binary, 1, getIntConstant(intType, shift));
+    return binary;
+}
+
+Value* InstCombinePass::combineCompare(CompareInstruction* compare) {
+    using OpType = CompareInstruction::OpType;
+
+    Value* left = compare->GetLeftOperand();
+    Value* right = compare->GetRightOperand();
+    OpType opType = compare->GetOpType();
+
+    if (getOperandRank(left) == 0 && getOperandRank(right) != 0) {
+        return insertCompare(getSwappedOpType(opType), right, left, compare);
+    }
+
+    auto* resultType = static_cast<IntType*>(compare->GetType());
+    if (left == right && !compare->IsFloat()) {
+        bool isTrue = compare->IsEqual() || compare->IsLessEq() || compare->IsGreaterEq();
+        return getIntConstant(resultType, isTrue);
+    }
+
+    // Compares of the boolean results: (a < b) != 0 = a < b, (a < b) == 0 = a >= b
+    if (opType != OpType::kIEqual && opType != OpType::kINEqual) {
+        return nullptr;
+    }
+
+    bool isZero = isIntConstant(right, 0);
+    if (!isZero && !isIntConstant(right, 1)) {
+        return nullptr;
+    }
+
+    Value* value = left;
+    if (auto* cast = dynamic_cast<CastInstruction*>(left)) {
+        bool isExtension = cast->GetOpType() == CastInstruction::OpType::kZExt ||
+                           (isZero && cast->GetOpType() == CastInstruction::OpType::kSExt);
+        if (!isExtension) {
+            return nullptr;
+        }
+        value = cast->GetFromOperand();
+    }
+
+    auto* inner = dynamic_cast<CompareInstruction*>(value);
+    if (!inner) {
+        return nullptr;
+    }
+
+    bool isSame = (opType == OpType::kINEqual) == isZero;
+    if (isSame) {
+        return inner;
+    }
+    if (inner->IsFloat()) {
+        return nullptr;
+    }
+    return insertCompare(getInverseOpType(inner->GetOpType()),
+                         inner->GetLeftOperand(), inner->GetRightOperand(), compare);
+}
+
+Value* InstCombinePass::combineCast(CastInstruction* cast) {
+    using OpType = CastInstruction::OpType;
+
+    Value* from = cast->GetFromOperand();
+    Type* toType = cast->GetToType();
+    OpType opType = cast->GetOpType();
+
+    bool isIntCast = opType == OpType::kZExt || opType == OpType::kSExt ||
+                     opType == OpType::kITrunc || opType == OpType::kBitcast;
+    if (isIntCast && isSameIntType(from->GetType(), toType)) {
+        return from;
+    }
+
+    auto* inner = dynamic_cast<CastInstruction*>(from);
+    if (!inner || !dynamic_cast<IntType*>(toType)) {
+        return nullptr;
+    }
+
+    Value* value = inner->GetFromOperand();
+    if (!dynamic_cast<IntType*>(value->GetType())) {
+        return nullptr;
+    }
+
+    OpType innerOpType = inner->GetOpType();
+    bool isInnerExtension = innerOpType == OpType::kZExt || innerOpType == OpType::kSExt;
+
+    // zext(zext x), sext(sext x), sext(zext x) = zext x
+    if ((opType == OpType::kZExt || opType == OpType::kSExt) && isInnerExtension) {
+        OpType newOpType = opType == innerOpType ? opType : OpType::kZExt;
+        if (opType == OpType::kZExt && innerOpType == OpType::kSExt) {
+            return nullptr;
+        }
+        return insertCast(newOpType, value, toType, cast);
+    }
+
+    if (opType != OpType::kITrunc) {
+        return nullptr;
+    }
+
+    if (innerOpType == OpType::kITrunc) {
+        return insertCast(OpType::kITrunc, value, toType, cast);
+    }
+
+    // trunc(ext x) is x, a shorter truncation or a shorter extension of it
+    if (isInnerExtension) {
+        uint64_t valueBits = getBitsNumber(value->GetType());
+        uint64_t toBits = getBitsNumber(toType);
+        if (toBits == valueBits) {
+            return value;
+        }
+        return insertCast(toBits < valueBits ? OpType::kITrunc : innerOpType, value, toType, cast);
+    }
+
+    return nullptr;
+}
+
+Instruction* InstCombinePass::insertBinary(BinaryInstruction::OpType opType, Value* left,
+                                           Value* right, Instruction* before) {
+    IRProgram& program = m_Function->GetProgram();
+    auto* binary = program.CreateValue<BinaryInstruction>(opType, before->GetName(), left, right,
+                                                          before->GetBasicBlock());
+    insertBefore(binary, before);
+    return binary;
+}
+
+Instruction* InstCombinePass::insertCompare(CompareInstruction::OpType opType, Value* left,
+                                            Value* right, Instruction* before) {
+    IRProgram& program = m_Function->GetProgram();
+    auto* compare = program.CreateValue<CompareInstruction>(opType, before->GetName(), left, right,
+                                                            before->GetBasicBlock());
+    insertBefore(compare, before);
+    return compare;
+}
+
+Instruction* InstCombinePass::insertCast(CastInstruction::OpType opType, Value* from,
+                                         Type* toType, Instruction* before) {
+    IRProgram& program = m_Function->GetProgram();
+    auto* cast = program.CreateValue<CastInstruction>(opType, before->GetName(), from, toType,
+                                                      before->GetBasicBlock());
+    insertBefore(cast, before);
+    return cast;
+}
+
+void InstCombinePass::insertBefore(Instruction* instruction, Instruction* before) {
+    auto& instructions = before->GetBasicBlock()->GetInstructionsRef();
+    instructions.insert(std::find(instructions.begin(), instructions.end(), before), instruction);
+
+    for (Value* operand : instruction->GetOperands()) {
+        m_Users[operand].push_back(instruction);
+    }
+}
+
+void InstCombinePass::setOperand(Instruction* instruction, size_t index, Value* value) {
+    Value* operand = instruction->GetOperand(index);
+    std::vector<Instruction*>& users = m_Users[operand];
+    users.erase(std::find(users.begin(), users.end(), instruction));
+
+    // The operand may become dead
+    if (auto* operandInstruction = dynamic_cast<Instruction*>(operand)) {
+        addToWorklist(operandInstruction);
+    }
+
+    instruction->SetOperand(value, index);
+    m_Users[value].push_back(instruction);
+}
+
+void InstCombinePass::replaceAllUses(Instruction* from, Value* to) {
+    std::vector<Instruction*> users = m_Users[from];
+    for (Instruction* user : users) {
+        for (size_t i = 0; i < user->GetOperandsNumber(); ++i) {
+            if (user->GetOperand(i) == from) {
+                setOperand(user, i, to);
+            }
+        }
+        addToWorklist(user);
+    }
+}
+
+void InstCombinePass::eraseInstruction(Instruction* instruction) {
+    auto& instructions = instruction->GetBasicBlock()->GetInstructionsRef();
+    instructions.erase(std::find(instructions.begin(), instructions.end(), instruction));
+    m_Erased.insert(instruction);
+
+    for (Value* operand : instruction->GetOperands()) {
+        std::vector<Instruction*>& users = m_Users[operand];
+        users.erase(std::find(users.begin(), users.end(), instruction));
+
+        if (auto* operandInstruction = dynamic_cast<Instruction*>(operand)) {
+            addToWorklist(operandInstruction);
+        }
+    }
+}
+
+void InstCombinePass::addToWorklist(Instruction* instruction) {
+    if (m_InWorklist.insert(instruction).second) {
+        m_Worklist.push_back(instruction);
+    }
+}
+
+void InstCombinePass::addUsersToWorklist(Value* value) {
+    for (Instruction* user : m_Users[value]) {
+        addToWorklist(user);
+    }
+}
+
+bool InstCombinePass::hasOneUser(Value* value) const {
+    auto it = m_Users.find(value);
+    return it != m_Users.end() && it->second.size() == 1;
+}
+
+// Divisions may trap, so they stay
+bool InstCombinePass::isDeadInstruction(Instruction* instruction) const {
+    auto it = m_Users.find(instruction);
+    if (it != m_Users.end() && !it->second.empty()) {
+        return false;
+    }
+
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        switch (binary->GetOpType()) {
+            case BinaryInstruction::OpType::kSDiv:
+            case BinaryInstruction::OpType::kUDiv:
+            case BinaryInstruction::OpType::kSRem:
+            case BinaryInstruction::OpType::kURem:
+                return false;
+            default:
+                return true;
+        }
+    }
+
+    return dynamic_cast<CompareInstruction*>(instruction) ||
+           dynamic_cast<CastInstruction*>(instruction);
+}
+
+// Narrow integers are kept sign-extended to 64 bits, as IntValue(-1) is
+IntConstant* InstCombinePass::getIntConstant(IntType* type, uint64_t value) {
+    uint64_t bitsNumber = type->GetBytesNumber() * 8;
+    if (bitsNumber < 64) {
+        uint64_t signBit = uint64_t(1) << (bitsNumber - 1);
+        value = ((value & ((signBit << 1) - 1)) ^ signBit) - signBit;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    return program.CreateValue<IntConstant>(type, IntValue(value));
+}
+
+bool InstCombinePass::isIntConstant(Value* value, int64_t expected) {
+    auto* constant = dynamic_cast<IntConstant*>(value);
+    if (!constant) {
+        return false;
+    }
+
+    uint64_t bitsNumber = getBitsNumber(constant->GetType());
+    uint64_t mask = bitsNumber >= 64 ? ~uint64_t(0) : (uint64_t(1) << bitsNumber) - 1;
+    return ((constant->GetValue().GetUnsignedValue() ^ static_cast<uint64_t>(expected)) & mask) == 0;
+}
+
+bool InstCombinePass::isAllOnes(Value* value) {
+    return isIntConstant(value, -1);
+}
+
+int InstCombinePass::getOperandRank(Value* value) {
+    if (dynamic_cast<IntConstant*>(value) || dynamic_cast<FloatConstant*>(value)) {
+        return 0;
+    }
+    if (dynamic_cast<Instruction*>(value)) {
+        return 2;
+    }
+    return 1;
+}
+
+uint64_t InstCombinePass::getBitsNumber(Type* type) {
+    return static_cast<IntType*>(type)->GetBytesNumber() * 8;
+}
+
+// The value without the sign extension of the narrow types
+uint64_t InstCombinePass::getUnsignedValue(IntConstant* constant) {
+    uint64_t value = constant->GetValue().GetUnsignedValue();
+    uint64_t bitsNumber = getBitsNumber(constant->GetType());
+    if (bitsNumber < 64) {
+        value &= (uint64_t(1) << bitsNumber) - 1;
+    }
+    return value;
+}
+
+bool InstCombinePass::isSameIntType(Type* left, Type* right) {
+    auto* leftInt = dynamic_cast<IntType*>(left);
+    auto* rightInt = dynamic_cast<IntType*>(right);
+    return leftInt && rightInt && leftInt->GetBytesNumber() == rightInt->GetBytesNumber();
+}
+
+CompareInstruction::OpType InstCombinePass::getSwappedOpType(CompareInstruction::OpType opType) {
+    using OpType = CompareInstruction::OpType;
+    switch (opType) {
+        case OpType::kIULess: return OpType::kIUGreater;
+        case OpType::kIUGreater: return OpType::kIULess;
+        case OpType::kIULessEq: return OpType::kIUGreaterEq;
+        case OpType::kIUGreaterEq: return OpType::kIULessEq;
+        case OpType::kISLess: return OpType::kISGreater;
+        case OpType::kISGreater: return OpType::kISLess;
+        case OpType::kISLessEq: return OpType::kISGreaterEq;
+        case OpType::kISGreaterEq: return OpType::kISLessEq;
+        case OpType::kFLess: return OpType::kFGreater;
+        case OpType::kFGreater: return OpType::kFLess;
+        case OpType::kFLessEq: return OpType::kFGreaterEq;
+        case OpType::kFGreaterEq: return OpType::kFLessEq;
+        default: return opType;
+    }
+}
+
+CompareInstruction::OpType InstCombinePass::getInverseOpType(CompareInstruction::OpType opType) {
+    using OpType = CompareInstruction::OpType;
+    switch (opType) {
+        case OpType::kIULess: return OpType::kIUGreaterEq;
+        case OpType::kIUGreater: return OpType::kIULessEq;
+        case OpType::kIULessEq: return OpType::kIUGreater;
+        case OpType::kIUGreaterEq: return OpType::kIULess;
+        case OpType::kISLess: return OpType::kISGreaterEq;
+        case OpType::kISGreater: return OpType::kISLessEq;
+        case OpType::kISLessEq: return OpType::kISGreater;
+        case OpType::kISGreaterEq: return OpType::kISLess;
+        case OpType::kIEqual: return OpType::kINEqual;
+        case OpType::kINEqual: return OpType::kIEqual;
+        default: return opType;
+    }
+}
+
+}  // namespace ir
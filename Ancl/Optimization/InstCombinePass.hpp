@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    Instruction Combining:
+    algebraic identities, constant reassociation and redundant compares and casts
+    are simplified with a worklist until nothing changes,
+    commutative operands are ordered (instructions, other values, constants)
+    and constants go to the right of compares
+*/
+class InstCombinePass {
+public:
+    InstCombinePass(Function* function);
+
+    void Run();
+
+private:
+    // nullptr: nothing changed, the instruction itself: changed in place,
+    // another value: replaces the instruction
+    Value* combineInstruction(Instruction* instruction);
+
+    Value* combineBinary(BinaryInstruction* binary);
+    Value* combineCompare(CompareInstruction* compare);
+    Value* combineCast(CastInstruction* cast);
+
+    Value* combineConstantOperand(BinaryInstruction* binary, IntConstant* constant);
+    Value* combineShifts(BinaryInstruction* binary, IntConstant* constant);
+    Value* combineFloatDivision(BinaryInstruction* binary, FloatConstant* constant);
+
+    Instruction* insertBinary(BinaryInstruction::OpType opType, Value* left, Value* right,
+                              Instruction* before);
+    Instruction* insertCompare(CompareInstruction::OpType opType, Value* left, Value* right,
+                               Instruction* before);
+    Instruction* insertCast(CastInstruction::OpType opType, Value* from, Type* toType,
+                            Instruction* before);
+    void insertBefore(Instruction* instruction, Instruction* before);
+
+    void setOperand(Instruction* instruction, size_t index, Value* value);
+    void replaceAllUses(Instruction* from, Value* to);
+    void eraseInstruction(Instruction* instruction);
+
+    void addToWorklist(Instruction* instruction);
+    void addUsersToWorklist(Value* value);
+
+    bool hasOneUser(Value* value) const;
+    bool isDeadInstruction(Instruction* instruction) const;
+
+    IntConstant* getIntConstant(IntType* type, uint64_t value);
+
+    static bool isIntConstant(Value* value, int64_t expected);
+    static bool isAllOnes(Value* value);
+    static int getOperandRank(Value* value);
+    static uint64_t getBitsNumber(Type* type);
+    static uint64_t getUnsignedValue(IntConstant* constant);
+    static bool isSameIntType(Type* left, Type* right);
+
+    static CompareInstruction::OpType getSwappedOpType(CompareInstruction::OpType opType);
+    static CompareInstruction::OpType getInverseOpType(CompareInstruction::OpType opType);
+
+private:
+    Function* m_Function = nullptr;
+
+    std::unordered_map<Value*, std::vector<Instruction*>> m_Users;
+
+    std::vector<Instruction*> m_Worklist;
+    std::unordered_set<Instruction*> m_InWorklist;
+    std::unordered_set<Instruction*> m_Erased;
+};
+
+}  // namespace ir
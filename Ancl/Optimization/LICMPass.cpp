@@ -0,0 +1,320 @@
+#include <Ancl/Optimization/LICMPass.hpp>
+
+#include <unordered_map>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+#include <Ancl/DataLayout/Alignment.hpp>
+#include <Ancl/Optimization/LoopSimplifyPass.hpp>
+#include <Ancl/Optimization/SSAPass.hpp>
+
+
+namespace ir {
+
+LICMPass::LICMPass(Function* function)
+    : m_Function(function),
+      m_AliasAnalysis(function) {}
+
+void LICMPass::Run() {
+    LoopSimplifyPass loopSimplifyPass(m_Function);
+    loopSimplifyPass.Run();
+
+    DominatorTree domTree(m_Function);
+    LoopInfo loopInfo(domTree);
+
+    // Inner loops come first, so that their invariants
+    // hoisted to the preheaders are visited by the outer loops
+    std::vector<Loop*> loops = loopInfo.GetLoopsInPreorder();
+    bool hasPromotedGlobals = false;
+    for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+        Loop* loop = *it;
+        if (!loop->GetPreheader()) {
+            continue;
+        }
+
+        hoistInvariants(loop, domTree);
+        hasPromotedGlobals |= promoteGlobals(loop);
+    }
+
+    // Promoted globals live in allocas until SSA is rebuilt
+    if (hasPromotedGlobals) {
+        SSAPass ssaPass(m_Function, /*isPruned=*/true);
+        ssaPass.Run();
+    }
+}
+
+// Blocks are visited in dominator tree preorder,
+// so the operands of an instruction are hoisted before it
+void LICMPass::hoistInvariants(Loop* loop, const DominatorTree& domTree) {
+    BasicBlock* preheader = loop->GetPreheader();
+    MemoryAccesses accesses = collectMemoryAccesses(loop);
+
+    for (BasicBlock* block : loop->GetBlocks()) {
+        auto& instructions = block->GetInstructionsRef();
+        for (auto it = instructions.begin(); it != instructions.end();) {
+            Instruction* instruction = *it;
+            if (!isInvariant(instruction, loop) ||
+                    !isHoistable(instruction, loop, domTree, accesses)) {
+                ++it;
+                continue;
+            }
+
+            it = instructions.erase(it);
+            preheader->InsertInstructionBeforeTerminator(instruction);
+        }
+    }
+}
+
+// Every access to the global must be a direct load or store
+// and no other memory access of the loop may alias it
+bool LICMPass::promoteGlobals(Loop* loop) {
+    MemoryAccesses accesses = collectMemoryAccesses(loop);
+    if (accesses.HasCalls) {
+        return false;
+    }
+
+    std::vector<BasicBlock*> exitBlocks = loop->GetExitBlocks();
+    for (BasicBlock* exitBlock : exitBlocks) {
+        for (BasicBlock* pred : exitBlock->GetPredecessors()) {
+            if (!loop->Contains(pred)) {
+                return false;
+            }
+        }
+    }
+
+    struct GlobalAccesses {
+        Type* AccessType = nullptr;
+        bool IsStored = false;
+        bool IsPromotable = true;
+    };
+    std::unordered_map<GlobalVariable*, GlobalAccesses> globalAccesses;
+    std::vector<GlobalVariable*> globals;
+
+    auto visitOperands = [&](Instruction* instruction) {
+        auto* load = dynamic_cast<LoadInstruction*>(instruction);
+        auto* store = dynamic_cast<StoreInstruction*>(instruction);
+
+        for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+            auto* global = dynamic_cast<GlobalVariable*>(instruction->GetOperand(i));
+            if (!global) {
+                continue;
+            }
+
+            Type* type = nullptr;
+            if (load && i == 0 && !load->IsVolatile()) {
+                type = load->GetType();
+            } else if (store && i == 1 && !store->IsVolatile()) {
+                type = store->GetValueOperand()->GetType();
+            }
+
+            auto [it, isInserted] = globalAccesses.emplace(global, GlobalAccesses{type});
+            if (isInserted) {
+                globals.push_back(global);
+            }
+
+            GlobalAccesses& info = it->second;
+            if (!type || !isSameScalarType(info.AccessType, type)) {
+                info.IsPromotable = false;
+            }
+            if (store) {
+                info.IsStored = true;
+            }
+        }
+    };
+
+    for (BasicBlock* block : loop->GetBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            visitOperands(instruction);
+        }
+    }
+
+    bool isChanged = false;
+    for (GlobalVariable* global : globals) {
+        const GlobalAccesses& info = globalAccesses[global];
+        // Loads of the globals that are not stored in the loop are already hoisted
+        if (!info.IsPromotable || !info.IsStored) {
+            continue;
+        }
+
+        AliasAnalysis::MemoryLocation globalLocation{
+            .Pointer = global,
+            .Size = Alignment::GetTypeSize(info.AccessType),
+            .AccessType = info.AccessType,
+        };
+
+        bool hasAliases = false;
+        for (const auto* locations : {&accesses.ReadLocations, &accesses.WrittenLocations}) {
+            for (const AliasAnalysis::MemoryLocation& location : *locations) {
+                if (location.Pointer != global &&
+                        m_AliasAnalysis.Alias(location, globalLocation) != AliasAnalysis::AliasResult::kNoAlias) {
+                    hasAliases = true;
+                }
+            }
+        }
+        if (hasAliases) {
+            continue;
+        }
+
+        promoteGlobal(loop, global, info.AccessType);
+        isChanged = true;
+    }
+
+    return isChanged;
+}
+
+// The global is loaded to an alloca in the preheader and stored back
+// in the dedicated exit blocks, then SSA promotes the alloca
+void LICMPass::promoteGlobal(Loop* loop, GlobalVariable* global, Type* type) {
+    IRProgram& program = m_Function->GetProgram();
+
+    BasicBlock* entryBlock = m_Function->GetEntryBlock();
+    auto* alloca = program.CreateValue<AllocaInstruction>(type, global->GetName() + ".promoted",
+                                                          entryBlock);
+    entryBlock->AddInstructionToBegin(alloca);
+
+    BasicBlock* preheader = loop->GetPreheader();
+    auto* initLoad = program.CreateValue<LoadInstruction>(global, type, "", preheader);
+    auto* initStore = program.CreateValue<StoreInstruction>(initLoad, alloca, "", preheader);
+    preheader->InsertInstructionBeforeTerminator(initLoad);
+    preheader->InsertInstructionBeforeTerminator(initStore);
+
+    for (BasicBlock* block : loop->GetBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+                if (load->GetPtrOperand() == global) {
+                    load->SetOperand(alloca, 0);
+                }
+            } else if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+                if (store->GetAddressOperand() == global) {
+                    store->SetOperand(alloca, 1);
+                }
+            }
+        }
+    }
+
+    for (BasicBlock* exitBlock : loop->GetExitBlocks()) {
+        auto* load = program.CreateValue<LoadInstruction>(alloca, type, "", exitBlock);
+        auto* store = program.CreateValue<StoreInstruction>(load, global, "", exitBlock);
+
+        auto& instructions = exitBlock->GetInstructionsRef();
+        auto it = instructions.begin();
+        while (dynamic_cast<PhiInstruction*>(*it)) {
+            ++it;
+        }
+        instructions.insert(it, {load, store});
+    }
+}
+
+bool LICMPass::isInvariant(Instruction* instruction, Loop* loop) const {
+    for (Value* operand : instruction->GetOperands()) {
+        auto* operandInstr = dynamic_cast<Instruction*>(operand);
+        if (operandInstr && loop->Contains(operandInstr->GetBasicBlock())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LICMPass::isHoistable(Instruction* instruction, Loop* loop, const DominatorTree& domTree,
+                           const MemoryAccesses& accesses) const {
+    auto* load = dynamic_cast<LoadInstruction*>(instruction);
+    if (!load) {
+        return isSafeToSpeculate(instruction);
+    }
+
+    Value* pointer = load->GetPtrOperand();
+    if (load->IsVolatile() || (accesses.HasCalls && m_AliasAnalysis.IsModifiedByCall(pointer))) {
+        return false;
+    }
+
+    AliasAnalysis::MemoryLocation location = AliasAnalysis::GetLoadLocation(load);
+    for (const AliasAnalysis::MemoryLocation& writtenLocation : accesses.WrittenLocations) {
+        if (m_AliasAnalysis.Alias(writtenLocation, location) != AliasAnalysis::AliasResult::kNoAlias) {
+            return false;
+        }
+    }
+
+    // Globals and allocas can be read on any path
+    return AliasAnalysis::IsIdentifiedObject(pointer) ||
+           isGuaranteedToExecute(load->GetBasicBlock(), loop, domTree);
+}
+
+// Division by zero and the overflowing signed division trap
+bool LICMPass::isSafeToSpeculate(Instruction* instruction) const {
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        BinaryInstruction::OpType opType = binary->GetOpType();
+        bool isSigned = opType == BinaryInstruction::OpType::kSDiv ||
+                        opType == BinaryInstruction::OpType::kSRem;
+        bool isUnsigned = opType == BinaryInstruction::OpType::kUDiv ||
+                          opType == BinaryInstruction::OpType::kURem;
+        if (!isSigned && !isUnsigned) {
+            return true;
+        }
+
+        auto* divisor = dynamic_cast<IntConstant*>(binary->GetRightOperand());
+        if (!divisor) {
+            return false;
+        }
+
+        auto* intType = dynamic_cast<IntType*>(divisor->GetType());
+        uint64_t bitsNumber = intType->GetBytesNumber() * 8;
+        uint64_t mask = bitsNumber >= 64 ? ~uint64_t(0) : (uint64_t(1) << bitsNumber) - 1;
+        uint64_t value = divisor->GetValue().GetUnsignedValue() & mask;
+        return value != 0 && (isUnsigned || value != mask);
+    }
+
+    return dynamic_cast<CompareInstruction*>(instruction) ||
+           dynamic_cast<CastInstruction*>(instruction) ||
+           dynamic_cast<MemberInstruction*>(instruction);
+}
+
+bool LICMPass::isGuaranteedToExecute(BasicBlock* block, Loop* loop,
+                                     const DominatorTree& domTree) const {
+    std::vector<BasicBlock*> exitingBlocks = loop->GetExitingBlocks();
+    if (exitingBlocks.empty()) {
+        return false;
+    }
+
+    for (BasicBlock* exitingBlock : exitingBlocks) {
+        if (!domTree.Dominates(block, exitingBlock)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LICMPass::MemoryAccesses LICMPass::collectMemoryAccesses(Loop* loop) const {
+    MemoryAccesses accesses;
+    for (BasicBlock* block : loop->GetBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+                accesses.ReadLocations.push_back(AliasAnalysis::GetLoadLocation(load));
+            } else if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+                accesses.WrittenLocations.push_back(AliasAnalysis::GetStoreLocation(store));
+            } else if (auto* memCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+                uint64_t size = memCopy->GetSizeConstant()->GetValue().GetUnsignedValue();
+                accesses.ReadLocations.push_back({.Pointer = memCopy->GetSourceOperand(), .Size = size});
+                accesses.WrittenLocations.push_back({.Pointer = memCopy->GetDestinationOperand(), .Size = size});
+            } else if (auto* memSet = dynamic_cast<MemorySetInstruction*>(instruction)) {
+                uint64_t size = memSet->GetBytesNumber()->GetValue().GetUnsignedValue();
+                accesses.WrittenLocations.push_back({.Pointer = memSet->GetDestinationOperand(), .Size = size});
+            } else if (dynamic_cast<CallInstruction*>(instruction)) {
+                accesses.HasCalls = true;
+            }
+        }
+    }
+    return accesses;
+}
+
+bool LICMPass::isSameScalarType(Type* lhs, Type* rhs) {
+    if (auto* lhsInt = dynamic_cast<IntType*>(lhs)) {
+        auto* rhsInt = dynamic_cast<IntType*>(rhs);
+        return rhsInt && lhsInt->GetBytesNumber() == rhsInt->GetBytesNumber();
+    }
+    if (auto* lhsFloat = dynamic_cast<FloatType*>(lhs)) {
+        auto* rhsFloat = dynamic_cast<FloatType*>(rhs);
+        return rhsFloat && lhsFloat->GetKind() == rhsFloat->GetKind();
+    }
+    return dynamic_cast<PointerType*>(lhs) && dynamic_cast<PointerType*>(rhs);
+}
+
+}  // namespace ir
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/DominatorTree.hpp>
+#include <Ancl/Graph/LoopInfo.hpp>
+#include <Ancl/Optimization/AliasAnalysis.hpp>
+
+
+namespace ir {
+
+/*
+    Loop Invariant Code Motion:
+    invariant computations and loads are hoisted to the preheader,
+    globals accessed only directly in the loop are promoted to registers
+*/
+class LICMPass {
+public:
+    LICMPass(Function* function);
+
+    void Run();
+
+private:
+    struct MemoryAccesses {
+        bool HasCalls = false;
+
+        std::vector<AliasAnalysis::MemoryLocation> ReadLocations;
+        std::vector<AliasAnalysis::MemoryLocation> WrittenLocations;
+    };
+
+    void hoistInvariants(Loop* loop, const DominatorTree& domTree);
+
+    bool promoteGlobals(Loop* loop);
+
+    void promoteGlobal(Loop* loop, GlobalVariable* global, Type* type);
+
+    bool isInvariant(Instruction* instruction, Loop* loop) const;
+
+    bool isHoistable(Instruction* instruction, Loop* loop, const DominatorTree& domTree,
+                     const MemoryAccesses& accesses) const;
+
+    bool isSafeToSpeculate(Instruction* instruction) const;
+
+    bool isGuaranteedToExecute(BasicBlock* block, Loop* loop,
+                               const DominatorTree& domTree) const;
+
+    MemoryAccesses collectMemoryAccesses(Loop* loop) const;
+
+    static bool isSameScalarType(Type* lhs, Type* rhs);
+
+private:
+    Function* m_Function = nullptr;
+    AliasAnalysis m_AliasAnalysis;
+};
+
+}  // namespace ir
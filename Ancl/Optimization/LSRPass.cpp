@@ -0,0 +1,577 @@
+#include <Ancl/Optimization/LSRPass.hpp>
+
+#include <algorithm>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+#include <Ancl/DataLayout/Alignment.hpp>
+#include <Ancl/Optimization/LoopSimplifyPass.hpp>
+
+
+namespace ir {
+
+LSRPass::LSRPass(Function* function)
+    : m_Function(function) {}
+
+void LSRPass::Run() {
+    LoopSimplifyPass loopSimplifyPass(m_Function);
+    loopSimplifyPass.Run();
+
+    DominatorTree domTree(m_Function);
+    LoopInfo loopInfo(domTree);
+
+    // New instructions never change the blocks of the loops
+    std::vector<Loop*> loops = loopInfo.GetLoopsInPreorder();
+    for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+        reduceLoop(*it);
+    }
+}
+
+void LSRPass::reduceLoop(Loop* loop) {
+    if (!loop->GetPreheader() || !loop->GetLatch()) {
+        return;
+    }
+
+    std::vector<InductionVariable> ivs;
+    for (PhiInstruction* phi : loop->GetHeader()->GetPhiFunctions()) {
+        if (auto iv = findInductionVariable(phi, loop)) {
+            ivs.push_back(*iv);
+        }
+    }
+
+    for (const InductionVariable& iv : ivs) {
+        collectUsers();
+
+        std::vector<ReducedVariable> reduced;
+        for (BasicBlock* block : loop->GetBlocks()) {
+            for (Instruction* instruction : block->GetInstructions()) {
+                if (auto* member = dynamic_cast<MemberInstruction*>(instruction)) {
+                    if (auto variable = reduceMember(member, iv, loop)) {
+                        reduced.push_back(*variable);
+                    }
+                }
+            }
+        }
+
+        collectUsers();
+        eraseDeadInstructions(loop);
+
+        // Outer products go first, the products they use become dead
+        for (BasicBlock* block : loop->GetBlocks()) {
+            std::list<Instruction*> instructions = block->GetInstructions();
+            for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+                auto* product = dynamic_cast<BinaryInstruction*>(*it);
+                if (!product || product->GetBasicBlock() != block || m_Users[product].empty()) {
+                    continue;
+                }
+                if (auto variable = reduceProduct(product, iv, loop)) {
+                    reduced.push_back(*variable);
+                    eraseDeadInstructions(loop);
+                }
+            }
+        }
+
+        collectUsers();
+        eraseDeadInstructions(loop);
+
+        rewriteExitTest(iv, reduced, loop);
+    }
+}
+
+std::optional<LSRPass::InductionVariable> LSRPass::findInductionVariable(PhiInstruction* phi,
+                                                                           Loop* loop) const {
+    if (!dynamic_cast<IntType*>(phi->GetType()) || phi->GetArgumentsNumber() != 2) {
+        return std::nullopt;
+    }
+
+    InductionVariable iv;
+    iv.Phi = phi;
+
+    Value* latchValue = nullptr;
+    for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+        if (phi->GetIncomingBlock(i) == loop->GetPreheader()) {
+            iv.Start = phi->GetIncomingValue(i);
+        } else if (phi->GetIncomingBlock(i) == loop->GetLatch()) {
+            latchValue = phi->GetIncomingValue(i);
+        }
+    }
+
+    auto* increment = dynamic_cast<BinaryInstruction*>(latchValue);
+    if (!iv.Start || !increment) {
+        return std::nullopt;
+    }
+
+    auto* step = dynamic_cast<IntConstant*>(increment->GetRightOperand());
+    if (increment->GetLeftOperand() != phi || !step) {
+        return std::nullopt;
+    }
+
+    if (increment->GetOpType() == BinaryInstruction::OpType::kAdd) {
+        iv.Step = getSignedValue(step);
+    } else if (increment->GetOpType() == BinaryInstruction::OpType::kSub) {
+        iv.Step = -getSignedValue(step);
+    } else {
+        return std::nullopt;
+    }
+
+    iv.Increment = increment;
+    if (iv.Step == 0) {
+        return std::nullopt;
+    }
+    return iv;
+}
+
+// The member becomes a pointer advanced by a constant offset in the latch
+std::optional<LSRPass::ReducedVariable> LSRPass::reduceMember(MemberInstruction* member,
+                                                              const InductionVariable& iv,
+                                                              Loop* loop) {
+    Value* base = member->GetPtrOperand();
+    if (auto* baseInstr = dynamic_cast<Instruction*>(base);
+            baseInstr && loop->Contains(baseInstr->GetBasicBlock())) {
+        return std::nullopt;
+    }
+
+    std::optional<int64_t> scale = getScale(member->GetIndex(), iv, loop);
+    if (!scale || *scale == 0) {
+        return std::nullopt;
+    }
+
+    // Units of the member index and of the pointer arithmetic on the result
+    std::optional<uint64_t> indexUnit = getMemberUnit(base->GetType(), member->IsDeref());
+    std::optional<uint64_t> resultUnit = getMemberUnit(member->GetType(), /*isDeref=*/false);
+    if (!indexUnit || !resultUnit || *resultUnit == 0) {
+        return std::nullopt;
+    }
+
+    int64_t stepBytes = *scale * iv.Step * static_cast<int64_t>(*indexUnit);
+    if (stepBytes % static_cast<int64_t>(*resultUnit) != 0) {
+        return std::nullopt;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* preheader = loop->GetPreheader();
+
+    Value* startIndex = expandAt(member->GetIndex(), iv, iv.Start, preheader, loop);
+    auto* start = program.CreateValue<MemberInstruction>(base, startIndex, member->GetName(),
+                                                         member->GetType(), preheader);
+    start->SetDeref(member->IsDeref());
+    preheader->InsertInstructionBeforeTerminator(start);
+
+    PhiInstruction* phi = createPhi(member->GetType(), start, loop);
+
+    auto* intType = IntType::Create(program, Alignment::GetPointerTypeSize());
+    auto* offset = program.CreateValue<IntConstant>(
+                        intType, IntValue(stepBytes / static_cast<int64_t>(*resultUnit)));
+    auto* next = program.CreateValue<MemberInstruction>(phi, offset, "iv.next",
+                                                        member->GetType(), loop->GetLatch());
+    auto* resultType = static_cast<PointerType*>(member->GetType());
+    next->SetDeref(dynamic_cast<ArrayType*>(resultType->GetSubType()));
+    setLatchValue(phi, next, loop);
+
+    replaceAllUses(member, phi);
+    eraseInstruction(member);
+
+    return ReducedVariable{member, phi, next};
+}
+
+// The product becomes an integer advanced by a constant in the latch
+std::optional<LSRPass::ReducedVariable> LSRPass::reduceProduct(BinaryInstruction* product,
+                                                               const InductionVariable& iv,
+                                                               Loop* loop) {
+    BinaryInstruction::OpType opType = product->GetOpType();
+    if (opType != BinaryInstruction::OpType::kMul &&
+            opType != BinaryInstruction::OpType::kShiftL) {
+        return std::nullopt;
+    }
+
+    auto* intType = dynamic_cast<IntType*>(product->GetType());
+    std::optional<int64_t> scale = getScale(product, iv, loop);
+    if (!intType || !scale || *scale == 0) {
+        return std::nullopt;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* preheader = loop->GetPreheader();
+
+    Value* start = expandAt(product, iv, iv.Start, preheader, loop);
+    PhiInstruction* phi = createPhi(intType, start, loop);
+
+    auto* step = program.CreateValue<IntConstant>(intType, IntValue(*scale * iv.Step));
+    auto* next = program.CreateValue<BinaryInstruction>(BinaryInstruction::OpType::kAdd, "iv.next",
+                                                        phi, step, loop->GetLatch());
+    setLatchValue(phi, next, loop);
+
+    replaceAllUses(product, phi);
+    eraseInstruction(product);
+
+    return ReducedVariable{product, phi, next};
+}
+
+// The counter is dead when the exit test is its only user besides the increment,
+// then the test compares a reduced pointer with the address at the bound instead
+bool LSRPass::rewriteExitTest(const InductionVariable& iv,
+                              const std::vector<ReducedVariable>& reduced, Loop* loop) {
+    std::vector<CompareInstruction*> compares;
+    for (Instruction* counter : {static_cast<Instruction*>(iv.Phi),
+                                 static_cast<Instruction*>(iv.Increment)}) {
+        for (Instruction* user : m_Users[counter]) {
+            auto* compare = dynamic_cast<CompareInstruction*>(user);
+            if (compare && std::find(compares.begin(), compares.end(), compare) == compares.end()) {
+                compares.push_back(compare);
+            }
+        }
+    }
+    if (compares.size() != 1) {
+        return false;
+    }
+
+    CompareInstruction* compare = compares[0];
+    std::vector<Instruction*> phiUsers = {iv.Increment, compare};
+    std::vector<Instruction*> incrementUsers = {iv.Phi, compare};
+    if (!hasOnlyUsers(iv.Phi, phiUsers) || !hasOnlyUsers(iv.Increment, incrementUsers)) {
+        return false;
+    }
+
+    // Addresses of one object keep the order of the signed indices, they do not wrap
+    using OpType = CompareInstruction::OpType;
+    Value* counter = compare->GetLeftOperand();
+    Value* bound = compare->GetRightOperand();
+    OpType opType = compare->GetOpType();
+    if (counter != iv.Phi && counter != iv.Increment) {
+        std::swap(counter, bound);
+        switch (opType) {
+            case OpType::kISLess: opType = OpType::kISGreater; break;
+            case OpType::kISGreater: opType = OpType::kISLess; break;
+            case OpType::kISLessEq: opType = OpType::kISGreaterEq; break;
+            case OpType::kISGreaterEq: opType = OpType::kISLessEq; break;
+            default: break;
+        }
+    }
+
+    switch (opType) {
+        case OpType::kISLess: opType = OpType::kIULess; break;
+        case OpType::kISGreater: opType = OpType::kIUGreater; break;
+        case OpType::kISLessEq: opType = OpType::kIULessEq; break;
+        case OpType::kISGreaterEq: opType = OpType::kIUGreaterEq; break;
+        case OpType::kIEqual: case OpType::kINEqual: break;
+        default: return false;
+    }
+
+    if (auto* boundInstr = dynamic_cast<Instruction*>(bound);
+            boundInstr && loop->Contains(boundInstr->GetBasicBlock())) {
+        return false;
+    }
+    if (counter == iv.Increment && compare->GetBasicBlock() != loop->GetLatch()) {
+        return false;
+    }
+
+    // The pointer must be the base indexed by the counter itself
+    const ReducedVariable* pointer = nullptr;
+    CastInstruction* indexCast = nullptr;
+    for (const ReducedVariable& variable : reduced) {
+        auto* member = dynamic_cast<MemberInstruction*>(variable.Original);
+        if (!member) {
+            continue;
+        }
+
+        Value* index = member->GetIndex();
+        auto* cast = dynamic_cast<CastInstruction*>(index);
+        if (cast && cast->GetOpType() == CastInstruction::OpType::kSExt) {
+            index = cast->GetFromOperand();
+        } else {
+            cast = nullptr;
+        }
+
+        if (index == iv.Phi) {
+            pointer = &variable;
+            indexCast = cast;
+            break;
+        }
+    }
+    if (!pointer) {
+        return false;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* preheader = loop->GetPreheader();
+    auto* member = static_cast<MemberInstruction*>(pointer->Original);
+
+    Value* endIndex = bound;
+    if (indexCast) {
+        auto* endCast = program.CreateValue<CastInstruction>(indexCast->GetOpType(), "iv.end", bound,
+                                                             indexCast->GetToType(), preheader);
+        preheader->InsertInstructionBeforeTerminator(endCast);
+        endIndex = endCast;
+    }
+
+    auto* end = program.CreateValue<MemberInstruction>(member->GetPtrOperand(), endIndex, "iv.end",
+                                                       member->GetType(), preheader);
+    end->SetDeref(member->IsDeref());
+    preheader->InsertInstructionBeforeTerminator(end);
+
+    BasicBlock* block = compare->GetBasicBlock();
+    Value* newCounter = counter == iv.Phi ? static_cast<Value*>(pointer->Phi) : pointer->Next;
+    auto* newCompare = program.CreateValue<CompareInstruction>(opType, compare->GetName(),
+                                                               newCounter, end, block);
+
+    auto& instructions = block->GetInstructionsRef();
+    instructions.insert(std::find(instructions.begin(), instructions.end(), compare), newCompare);
+
+    m_Users[newCounter].push_back(newCompare);
+    replaceAllUses(compare, newCompare);
+    eraseInstruction(compare);
+    eraseInstruction(iv.Increment);
+    eraseInstruction(iv.Phi);
+
+    return true;
+}
+
+// Coefficient of the induction variable, if the value is affine in it,
+// the signed overflow that would break sign extensions is undefined
+std::optional<int64_t> LSRPass::getScale(Value* value, const InductionVariable& iv,
+                                         Loop* loop) const {
+    constexpr int64_t kMaxScale = int64_t(1) << 32;
+
+    if (value == iv.Phi) {
+        return 1;
+    }
+
+    auto* instruction = dynamic_cast<Instruction*>(value);
+    if (!instruction || !loop->Contains(instruction->GetBasicBlock())) {
+        return 0;
+    }
+
+    std::optional<int64_t> scale;
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        std::optional<int64_t> left = getScale(binary->GetLeftOperand(), iv, loop);
+        std::optional<int64_t> right = getScale(binary->GetRightOperand(), iv, loop);
+        if (!left || !right) {
+            return std::nullopt;
+        }
+
+        auto* leftConstant = dynamic_cast<IntConstant*>(binary->GetLeftOperand());
+        auto* rightConstant = dynamic_cast<IntConstant*>(binary->GetRightOperand());
+
+        switch (binary->GetOpType()) {
+            case BinaryInstruction::OpType::kAdd:
+                scale = *left + *right;
+                break;
+            case BinaryInstruction::OpType::kSub:
+                scale = *left - *right;
+                break;
+            case BinaryInstruction::OpType::kMul:
+                if (rightConstant) {
+                    scale = *left * getSignedValue(rightConstant);
+                } else if (leftConstant) {
+                    scale = *right * getSignedValue(leftConstant);
+                }
+                break;
+            case BinaryInstruction::OpType::kShiftL:
+                if (rightConstant && static_cast<uint64_t>(getSignedValue(rightConstant)) < 32) {
+                    scale = *left * (int64_t(1) << getSignedValue(rightConstant));
+                }
+                break;
+            default:
+                break;
+        }
+    } else if (auto* cast = dynamic_cast<CastInstruction*>(instruction)) {
+        auto* fromType = dynamic_cast<IntType*>(cast->GetFromType());
+        if (cast->GetOpType() == CastInstruction::OpType::kSExt &&
+                fromType && fromType->GetBytesNumber() >= 4) {
+            scale = getScale(cast->GetFromOperand(), iv, loop);
+        }
+    }
+
+    if (!scale || *scale > kMaxScale || *scale < -kMaxScale) {
+        return std::nullopt;
+    }
+    return scale;
+}
+
+// Copies the affine computation to the end of the block
+// with the induction variable replaced by the value
+Value* LSRPass::expandAt(Value* value, const InductionVariable& iv, Value* ivValue,
+                         BasicBlock* block, Loop* loop) {
+    if (value == iv.Phi) {
+        return ivValue;
+    }
+
+    auto* instruction = dynamic_cast<Instruction*>(value);
+    if (!instruction || !loop->Contains(instruction->GetBasicBlock())) {
+        return value;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    Instruction* copy = nullptr;
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        Value* left = expandAt(binary->GetLeftOperand(), iv, ivValue, block, loop);
+        Value* right = expandAt(binary->GetRightOperand(), iv, ivValue, block, loop);
+        copy = program.CreateValue<BinaryInstruction>(binary->GetOpType(), binary->GetName(),
+                                                      left, right, block);
+    } else {
+        auto* cast = static_cast<CastInstruction*>(instruction);
+        Value* from = expandAt(cast->GetFromOperand(), iv, ivValue, block, loop);
+        copy = program.CreateValue<CastInstruction>(cast->GetOpType(), cast->GetName(),
+                                                    from, cast->GetToType(), block);
+    }
+
+    block->InsertInstructionBeforeTerminator(copy);
+    return copy;
+}
+
+PhiInstruction* LSRPass::createPhi(Type* type, Value* start, Loop* loop) {
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* header = loop->GetHeader();
+
+    auto* phi = program.CreateValue<PhiInstruction>(type, "iv", header);
+    header->AddPhiFunction(phi);
+
+    std::vector<BasicBlock*> preds = header->GetPredecessors();
+    for (size_t i = 0; i < preds.size(); ++i) {
+        phi->SetIncomingBlock(i, preds[i]);
+        if (preds[i] == loop->GetPreheader()) {
+            phi->SetIncomingValue(i, start);
+        }
+    }
+    return phi;
+}
+
+// The increment goes to the start of the latch, so it dominates the exit test there
+void LSRPass::setLatchValue(PhiInstruction* phi, Instruction* next, Loop* loop) {
+    BasicBlock* latch = loop->GetLatch();
+
+    auto& instructions = latch->GetInstructionsRef();
+    auto it = instructions.begin();
+    while (dynamic_cast<PhiInstruction*>(*it)) {
+        ++it;
+    }
+    instructions.insert(it, next);
+
+    for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+        if (phi->GetIncomingBlock(i) == latch) {
+            phi->SetIncomingValue(i, next);
+        }
+    }
+
+    m_Users[phi].push_back(next);
+    m_Users[next].push_back(phi);
+}
+
+void LSRPass::collectUsers() {
+    m_Users.clear();
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (operand) {
+                    m_Users[operand].push_back(instruction);
+                }
+            }
+        }
+    }
+}
+
+void LSRPass::replaceAllUses(Instruction* from, Value* to) {
+    std::vector<Instruction*> users = std::move(m_Users[from]);
+    m_Users.erase(from);
+
+    for (Instruction* user : users) {
+        for (size_t i = 0; i < user->GetOperandsNumber(); ++i) {
+            if (user->GetOperand(i) == from) {
+                user->SetOperand(to, i);
+            }
+        }
+        m_Users[to].push_back(user);
+    }
+}
+
+void LSRPass::eraseInstruction(Instruction* instruction) {
+    auto& instructions = instruction->GetBasicBlock()->GetInstructionsRef();
+    instructions.erase(std::find(instructions.begin(), instructions.end(), instruction));
+
+    for (Value* operand : instruction->GetOperands()) {
+        auto it = m_Users.find(operand);
+        if (it == m_Users.end()) {
+            continue;
+        }
+        std::vector<Instruction*>& users = it->second;
+        auto userIt = std::find(users.begin(), users.end(), instruction);
+        if (userIt != users.end()) {
+            users.erase(userIt);
+        }
+    }
+}
+
+// Address and index computations of the reduced values
+void LSRPass::eraseDeadInstructions(Loop* loop) {
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (BasicBlock* block : loop->GetBlocks()) {
+            for (Instruction* instruction : block->GetInstructions()) {
+                auto* binary = dynamic_cast<BinaryInstruction*>(instruction);
+                bool isPure = dynamic_cast<CastInstruction*>(instruction) ||
+                              dynamic_cast<CompareInstruction*>(instruction) ||
+                              dynamic_cast<MemberInstruction*>(instruction) ||
+                              (binary && !isDivision(binary));
+                if (isPure && m_Users[instruction].empty()) {
+                    eraseInstruction(instruction);
+                    isChanged = true;
+                }
+            }
+        }
+    }
+}
+
+bool LSRPass::isDivision(BinaryInstruction* binary) {
+    switch (binary->GetOpType()) {
+        case BinaryInstruction::OpType::kSDiv: case BinaryInstruction::OpType::kUDiv:
+        case BinaryInstruction::OpType::kSRem: case BinaryInstruction::OpType::kURem:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool LSRPass::hasOnlyUsers(Instruction* instruction,
+                           const std::vector<Instruction*>& users) const {
+    auto it = m_Users.find(instruction);
+    if (it == m_Users.end()) {
+        return true;
+    }
+
+    for (Instruction* user : it->second) {
+        if (std::find(users.begin(), users.end(), user) == users.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Bytes of one index step, members of structs are indexed by the field
+std::optional<uint64_t> LSRPass::getMemberUnit(Type* pointerType, bool isDeref) {
+    auto* ptrType = dynamic_cast<PointerType*>(pointerType);
+    if (!ptrType) {
+        return std::nullopt;
+    }
+
+    Type* subType = ptrType->GetSubType();
+    if (auto* arrayType = dynamic_cast<ArrayType*>(subType)) {
+        return Alignment::GetTypeSize(arrayType->GetSubType());
+    }
+    if (isDeref) {
+        return std::nullopt;
+    }
+    return Alignment::GetTypeSize(subType);
+}
+
+int64_t LSRPass::getSignedValue(IntConstant* constant) {
+    uint64_t value = constant->GetValue().GetUnsignedValue();
+    uint64_t bitsNumber = static_cast<IntType*>(constant->GetType())->GetBytesNumber() * 8;
+    if (bitsNumber < 64) {
+        uint64_t signBit = uint64_t(1) << (bitsNumber - 1);
+        value &= (signBit << 1) - 1;
+        value = (value ^ signBit) - signBit;
+    }
+    return static_cast<int64_t>(value);
+}
+
+}  // namespace ir
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/LoopInfo.hpp>
+
+
+namespace ir {
+
+/*
+    Loop Strength Reduction:
+    addresses and products that are affine in a basic induction variable
+    become induction variables advanced by additions in the latch,
+    the counter is removed when the exit test can compare the pointers
+*/
+class LSRPass {
+public:
+    LSRPass(Function* function);
+
+    void Run();
+
+private:
+    // phi = [Start, preheader], [phi + Step, latch]
+    struct InductionVariable {
+        PhiInstruction* Phi = nullptr;
+        BinaryInstruction* Increment = nullptr;
+        Value* Start = nullptr;
+        int64_t Step = 0;
+    };
+
+    // Replaces the instruction that is affine in the induction variable
+    struct ReducedVariable {
+        Instruction* Original = nullptr;
+        PhiInstruction* Phi = nullptr;
+        Instruction* Next = nullptr;
+    };
+
+    void reduceLoop(Loop* loop);
+
+    std::optional<InductionVariable> findInductionVariable(PhiInstruction* phi, Loop* loop) const;
+
+    std::optional<ReducedVariable> reduceMember(MemberInstruction* member,
+                                                const InductionVariable& iv, Loop* loop);
+    std::optional<ReducedVariable> reduceProduct(BinaryInstruction* product,
+                                                 const InductionVariable& iv, Loop* loop);
+
+    bool rewriteExitTest(const InductionVariable& iv, const std::vector<ReducedVariable>& reduced,
+                         Loop* loop);
+
+    std::optional<int64_t> getScale(Value* value, const InductionVariable& iv, Loop* loop) const;
+
+    Value* expandAt(Value* value, const InductionVariable& iv, Value* ivValue,
+                    BasicBlock* block, Loop* loop);
+
+    PhiInstruction* createPhi(Type* type, Value* start, Loop* loop);
+    void setLatchValue(PhiInstruction* phi, Instruction* next, Loop* loop);
+
+    void collectUsers();
+    void replaceAllUses(Instruction* from, Value* to);
+    void eraseInstruction(Instruction* instruction);
+    void eraseDeadInstructions(Loop* loop);
+
+    bool hasOnlyUsers(Instruction* instruction, const std::vector<Instruction*>& users) const;
+
+    static bool isDivision(BinaryInstruction* binary);
+    static std::optional<uint64_t> getMemberUnit(Type* pointerType, bool isDeref);
+
+    static int64_t getSignedValue(IntConstant* constant);
+
+private:
+    Function* m_Function = nullptr;
+
+    std::unordered_map<Value*, std::vector<Instruction*>> m_Users;
+};
+
+}  // namespace ir
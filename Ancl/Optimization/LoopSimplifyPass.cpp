@@ -0,0 +1,180 @@
+#include <Ancl/Optimization/LoopSimplifyPass.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+
+
+namespace ir {
+
+LoopSimplifyPass::LoopSimplifyPass(Function* function)
+    : m_Function(function) {}
+
+void LoopSimplifyPass::Run() {
+    DominatorTree domTree(m_Function);
+    LoopInfo loopInfo(domTree);
+
+    // New blocks only enter the header of the simplified loop,
+    // loops nested in it come later, so the loop info stays valid for them
+    for (Loop* loop : loopInfo.GetLoopsInPreorder()) {
+        simplifyLoop(loop);
+    }
+
+    DominatorTree newDomTree(m_Function);
+    LoopInfo newLoopInfo(newDomTree);
+
+    // Exit blocks split from an inner loop are outside of it
+    // and outside of every outer loop it exits, so inner loops go first
+    std::vector<Loop*> loops = newLoopInfo.GetLoopsInPreorder();
+    for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+        formDedicatedExits(*it);
+    }
+}
+
+bool LoopSimplifyPass::simplifyLoop(Loop* loop) {
+    BasicBlock* header = loop->GetHeader();
+    if (header == m_Function->GetEntryBlock()) {
+        return false;
+    }
+
+    std::vector<BasicBlock*> outsidePreds;
+    std::vector<BasicBlock*> latches;
+    for (BasicBlock* pred : header->GetPredecessors()) {
+        std::vector<BasicBlock*>& preds = loop->Contains(pred) ? latches : outsidePreds;
+        if (std::find(preds.begin(), preds.end(), pred) == preds.end()) {
+            preds.push_back(pred);
+        }
+    }
+
+    bool isChanged = false;
+
+    if (!outsidePreds.empty() && !loop->GetPreheader() && canRedirectBranches(outsidePreds)) {
+        splitPredecessors(header, outsidePreds, header->GetName() + ".preheader",
+                          getBlockIndex(header));
+        isChanged = true;
+    }
+
+    if (latches.size() > 1 && canRedirectBranches(latches)) {
+        size_t lastLatchIndex = 0;
+        for (BasicBlock* latch : latches) {
+            lastLatchIndex = std::max(lastLatchIndex, getBlockIndex(latch));
+        }
+
+        // The return block stays the last one
+        splitPredecessors(header, latches, header->GetName() + ".latch", lastLatchIndex + 1);
+        isChanged = true;
+    }
+
+    return isChanged;
+}
+
+bool LoopSimplifyPass::formDedicatedExits(Loop* loop) {
+    bool isChanged = false;
+
+    for (BasicBlock* exitBlock : loop->GetExitBlocks()) {
+        std::vector<BasicBlock*> insidePreds;
+        bool isDedicated = true;
+        for (BasicBlock* pred : exitBlock->GetPredecessors()) {
+            if (!loop->Contains(pred)) {
+                isDedicated = false;
+            } else if (std::find(insidePreds.begin(), insidePreds.end(), pred) == insidePreds.end()) {
+                insidePreds.push_back(pred);
+            }
+        }
+
+        if (!isDedicated && canRedirectBranches(insidePreds)) {
+            splitPredecessors(exitBlock, insidePreds, exitBlock->GetName() + ".loopexit",
+                              getBlockIndex(exitBlock));
+            isChanged = true;
+        }
+    }
+
+    return isChanged;
+}
+
+// Moves the edges from the predecessors to a new block that jumps to the block,
+// phi arguments of the predecessors are merged by phis in the new block
+BasicBlock* LoopSimplifyPass::splitPredecessors(BasicBlock* block,
+                                                const std::vector<BasicBlock*>& preds,
+                                                const std::string& name, size_t blockIndex) {
+    IRProgram& program = m_Function->GetProgram();
+    auto* newBlock = program.CreateValue<BasicBlock>(name, LabelType::Create(program), m_Function);
+    m_Function->InsertBasicBlock(blockIndex, newBlock);
+
+    std::vector<PhiInstruction*> phis = block->GetPhiFunctions();
+    std::vector<std::unordered_map<BasicBlock*, Value*>> predValues(phis.size());
+    for (size_t i = 0; i < phis.size(); ++i) {
+        for (size_t j = 0; j < phis[i]->GetArgumentsNumber(); ++j) {
+            predValues[i].emplace(phis[i]->GetIncomingBlock(j), phis[i]->GetIncomingValue(j));
+        }
+    }
+
+    for (BasicBlock* pred : preds) {
+        redirectBranch(pred, block, newBlock);
+    }
+
+    auto* branch = program.CreateValue<BranchInstruction>(block, newBlock);
+    newBlock->AddInstruction(branch);
+
+    std::vector<BasicBlock*> newPreds = newBlock->GetPredecessors();
+    for (size_t i = 0; i < phis.size(); ++i) {
+        PhiInstruction* phi = phis[i];
+
+        Value* value = predValues[i].at(newPreds[0]);
+        for (BasicBlock* pred : newPreds) {
+            if (predValues[i].at(pred) != value) {
+                value = nullptr;
+                break;
+            }
+        }
+
+        if (!value) {
+            auto* newPhi = program.CreateValue<PhiInstruction>(phi->GetType(), "phi", newBlock);
+            newBlock->AddPhiFunction(newPhi);
+            for (size_t j = 0; j < newPreds.size(); ++j) {
+                newPhi->SetIncomingBlock(j, newPreds[j]);
+                newPhi->SetIncomingValue(j, predValues[i].at(newPreds[j]));
+            }
+            value = newPhi;
+        }
+
+        // The new block is the last predecessor of the block
+        phi->SetIncomingValue(phi->GetArgumentsNumber() - 1, value);
+    }
+
+    return newBlock;
+}
+
+void LoopSimplifyPass::redirectBranch(BasicBlock* pred, BasicBlock* fromBlock,
+                                      BasicBlock* toBlock) {
+    auto* branch = dynamic_cast<BranchInstruction*>(pred->GetTerminator());
+
+    if (branch->GetTrueBasicBlock() == fromBlock) {
+        branch->SetTrueBasicBlock(toBlock);
+        fromBlock->RemovePredecessor(pred);
+        toBlock->AddPredecessor(pred);
+    }
+    if (branch->IsConditional() && branch->GetFalseBasicBlock() == fromBlock) {
+        branch->SetFalseBasicBlock(toBlock);
+        fromBlock->RemovePredecessor(pred);
+        toBlock->AddPredecessor(pred);
+    }
+}
+
+// Predecessors of switch targets are not tracked by the blocks
+bool LoopSimplifyPass::canRedirectBranches(const std::vector<BasicBlock*>& preds) const {
+    for (BasicBlock* pred : preds) {
+        if (!dynamic_cast<BranchInstruction*>(pred->GetTerminator())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t LoopSimplifyPass::getBlockIndex(BasicBlock* block) const {
+    std::vector<BasicBlock*> blocks = m_Function->GetBasicBlocks();
+    return std::find(blocks.begin(), blocks.end(), block) - blocks.begin();
+}
+
+}  // namespace ir
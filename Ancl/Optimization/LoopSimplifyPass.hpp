@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/LoopInfo.hpp>
+
+
+namespace ir {
+
+/*
+    Loop Simplification:
+    every loop gets a dedicated preheader, a single latch
+    and exit blocks that are entered only from the loop
+*/
+class LoopSimplifyPass {
+public:
+    LoopSimplifyPass(Function* function);
+
+    void Run();
+
+private:
+    bool simplifyLoop(Loop* loop);
+
+    bool formDedicatedExits(Loop* loop);
+
+    BasicBlock* splitPredecessors(BasicBlock* block, const std::vector<BasicBlock*>& preds,
+                                  const std::string& name, size_t blockIndex);
+
+    void redirectBranch(BasicBlock* pred, BasicBlock* fromBlock, BasicBlock* toBlock);
+
+    bool canRedirectBranches(const std::vector<BasicBlock*>& preds) const;
+
+    size_t getBlockIndex(BasicBlock* block) const;
+
+private:
+    Function* m_Function = nullptr;
+};
+
+}  // namespace ir
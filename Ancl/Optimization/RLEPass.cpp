@@ -0,0 +1,144 @@
+#include <Ancl/Optimization/RLEPass.hpp>
+
+#include <algorithm>
+
+
+namespace ir {
+
+RLEPass::RLEPass(Function* function)
+    : m_Function(function),
+      m_DomTree(function),
+      m_AliasAnalysis(function) {}
+
+void RLEPass::Run() {
+    collectUsers();
+    runPreorderRLE(m_Function->GetEntryBlock(), MemoryState{});
+}
+
+void RLEPass::collectUsers() {
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (operand) {
+                    m_Users[operand].push_back(instruction);
+                }
+            }
+        }
+    }
+}
+
+void RLEPass::runPreorderRLE(BasicBlock* block, MemoryState state) {
+    // The state of the parent holds only on the edge from it
+    if (block->GetPredecessors().size() != 1) {
+        state.clear();
+    }
+
+    std::list<Instruction*>& instructions = block->GetInstructionsRef();
+    for (auto it = instructions.begin(); it != instructions.end();) {
+        Instruction* instruction = *it;
+
+        if (auto* load = dynamic_cast<LoadInstruction*>(instruction)) {
+            if (!load->IsVolatile()) {
+                if (Value* value = findAvailableValue(state, load)) {
+                    replaceAllUses(load, value);
+                    it = instructions.erase(it);
+                    continue;
+                }
+                state.push_back(AvailableValue{AliasAnalysis::GetLoadLocation(load), load});
+            }
+        } else if (auto* store = dynamic_cast<StoreInstruction*>(instruction)) {
+            AliasAnalysis::MemoryLocation location = AliasAnalysis::GetStoreLocation(store);
+            clobber(state, location);
+            if (!store->IsVolatile()) {
+                state.push_back(AvailableValue{location, store->GetValueOperand()});
+            }
+        } else if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+            uint64_t size = memoryCopy->GetSizeConstant()->GetValue().GetUnsignedValue();
+            clobber(state, AliasAnalysis::MemoryLocation{
+                .Pointer = memoryCopy->GetDestinationOperand(),
+                .Size = size,
+            });
+        } else if (auto* memorySet = dynamic_cast<MemorySetInstruction*>(instruction)) {
+            uint64_t size = memorySet->GetBytesNumber()->GetValue().GetUnsignedValue();
+            clobber(state, AliasAnalysis::MemoryLocation{
+                .Pointer = memorySet->GetDestinationOperand(),
+                .Size = size,
+            });
+        } else if (dynamic_cast<CallInstruction*>(instruction)) {
+            clobberByCall(state);
+        }
+
+        ++it;
+    }
+
+    for (BasicBlock* child : m_DomTree.GetChildren(block)) {
+        runPreorderRLE(child, state);
+    }
+}
+
+Value* RLEPass::findAvailableValue(const MemoryState& state, LoadInstruction* load) const {
+    AliasAnalysis::MemoryLocation location = AliasAnalysis::GetLoadLocation(load);
+    for (auto it = state.rbegin(); it != state.rend(); ++it) {
+        if (m_AliasAnalysis.Alias(it->Location, location) != AliasAnalysis::AliasResult::kMustAlias) {
+            continue;
+        }
+
+        // Bytes of another type need a cast, the load stays
+        if (!isSameType(it->StoredValue->GetType(), load->GetType())) {
+            return nullptr;
+        }
+        return it->StoredValue;
+    }
+    return nullptr;
+}
+
+void RLEPass::clobber(MemoryState& state, const AliasAnalysis::MemoryLocation& location) const {
+    std::erase_if(state, [this, &location](const AvailableValue& available) {
+        return m_AliasAnalysis.Alias(available.Location, location) != AliasAnalysis::AliasResult::kNoAlias;
+    });
+}
+
+void RLEPass::clobberByCall(MemoryState& state) const {
+    std::erase_if(state, [this](const AvailableValue& available) {
+        return m_AliasAnalysis.IsModifiedByCall(available.Location.Pointer);
+    });
+}
+
+void RLEPass::replaceAllUses(Instruction* from, Value* to) {
+    for (Instruction* user : m_Users[from]) {
+        for (size_t i = 0; i < user->GetOperandsNumber(); ++i) {
+            if (user->GetOperand(i) == from) {
+                user->SetOperand(to, i);
+                m_Users[to].push_back(user);
+            }
+        }
+    }
+    m_Users.erase(from);
+}
+
+// Pointer types are not unique, members need the same pointee
+bool RLEPass::isSameType(Type* first, Type* second) {
+    if (first == second) {
+        return true;
+    }
+    if (auto* firstInt = dynamic_cast<IntType*>(first)) {
+        auto* secondInt = dynamic_cast<IntType*>(second);
+        return secondInt && firstInt->GetBytesNumber() == secondInt->GetBytesNumber();
+    }
+    if (auto* firstFloat = dynamic_cast<FloatType*>(first)) {
+        auto* secondFloat = dynamic_cast<FloatType*>(second);
+        return secondFloat && firstFloat->GetKind() == secondFloat->GetKind();
+    }
+    if (auto* firstPointer = dynamic_cast<PointerType*>(first)) {
+        auto* secondPointer = dynamic_cast<PointerType*>(second);
+        return secondPointer && isSameType(firstPointer->GetSubType(), secondPointer->GetSubType());
+    }
+    if (auto* firstArray = dynamic_cast<ArrayType*>(first)) {
+        auto* secondArray = dynamic_cast<ArrayType*>(second);
+        return secondArray && firstArray->GetSize() == secondArray->GetSize() &&
+               isSameType(firstArray->GetSubType(), secondArray->GetSubType());
+    }
+    return false;
+}
+
+}  // namespace ir
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+#include <Ancl/Graph/DominatorTree.hpp>
+#include <Ancl/Optimization/AliasAnalysis.hpp>
+
+
+namespace ir {
+
+/*
+    Redundant Load Elimination:
+    the known memory contents are carried down the dominator tree,
+    a load of a location that was loaded or stored before is replaced
+    with that value unless a store, copy or call in between may clobber it,
+    memory state is dropped at the blocks with several predecessors
+*/
+class RLEPass {
+public:
+    RLEPass(Function* function);
+
+    void Run();
+
+private:
+    struct AvailableValue {
+        AliasAnalysis::MemoryLocation Location;
+        Value* StoredValue = nullptr;
+    };
+
+    using MemoryState = std::vector<AvailableValue>;
+
+    void collectUsers();
+
+    void runPreorderRLE(BasicBlock* block, MemoryState state);
+
+    Value* findAvailableValue(const MemoryState& state, LoadInstruction* load) const;
+
+    void clobber(MemoryState& state, const AliasAnalysis::MemoryLocation& location) const;
+    void clobberByCall(MemoryState& state) const;
+
+    void replaceAllUses(Instruction* from, Value* to);
+
+    static bool isSameType(Type* first, Type* second);
+
+private:
+    Function* m_Function = nullptr;
+    DominatorTree m_DomTree;
+    AliasAnalysis m_AliasAnalysis;
+
+    std::unordered_map<Value*, std::vector<Instruction*>> m_Users;
+};
+
+}  // namespace ir
@@ -0,0 +1,437 @@
+#include <Ancl/Optimization/SCCPPass.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+
+
+namespace ir {
+
+SCCPPass::SCCPPass(Function* function)
+    : m_Function(function),
+      m_Constexpr(function->GetProgram()) {}
+
+void SCCPPass::Run() {
+    collectUsers();
+
+    BasicBlock* entryBlock = m_Function->GetEntryBlock();
+    m_ExecutableBlocks.insert(entryBlock);
+    visitBlock(entryBlock);
+
+    while (!m_EdgeWorklist.empty() || !m_InstructionWorklist.empty()) {
+        while (!m_EdgeWorklist.empty()) {
+            auto [from, to] = m_EdgeWorklist.front();
+            m_EdgeWorklist.pop();
+
+            // Only the phis see the new edge of a visited block
+            if (m_ExecutableBlocks.insert(to).second) {
+                visitBlock(to);
+            } else {
+                for (PhiInstruction* phi : to->GetPhiFunctions()) {
+                    visitPhi(phi);
+                }
+            }
+        }
+
+        while (!m_InstructionWorklist.empty()) {
+            Instruction* instruction = m_InstructionWorklist.front();
+            m_InstructionWorklist.pop();
+
+            if (m_ExecutableBlocks.contains(instruction->GetBasicBlock())) {
+                visitInstruction(instruction);
+            }
+        }
+    }
+
+    rewriteFunction();
+}
+
+void SCCPPass::collectUsers() {
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (dynamic_cast<Instruction*>(operand)) {
+                    m_Users[operand].push_back(instruction);
+                }
+            }
+        }
+    }
+}
+
+void SCCPPass::markEdgeExecutable(BasicBlock* from, BasicBlock* to) {
+    if (m_ExecutableEdges.insert({from, to}).second) {
+        m_EdgeWorklist.push({from, to});
+    }
+}
+
+void SCCPPass::visitBlock(BasicBlock* block) {
+    for (Instruction* instruction : block->GetInstructionsRef()) {
+        visitInstruction(instruction);
+    }
+}
+
+void SCCPPass::visitInstruction(Instruction* instruction) {
+    if (auto* phi = dynamic_cast<PhiInstruction*>(instruction)) {
+        visitPhi(phi);
+    } else if (auto* branch = dynamic_cast<BranchInstruction*>(instruction)) {
+        visitBranch(branch);
+    } else if (auto* switchInstr = dynamic_cast<SwitchInstruction*>(instruction)) {
+        visitSwitch(switchInstr);
+    } else if (auto* terminator = dynamic_cast<TerminatorInstruction*>(instruction)) {
+        BasicBlock* block = terminator->GetBasicBlock();
+        for (BasicBlock* successor : block->GetSuccessors()) {
+            markEdgeExecutable(block, successor);
+        }
+    } else if (!dynamic_cast<VoidType*>(instruction->GetType())) {
+        updateLatticeValue(instruction, evaluate(instruction));
+    }
+}
+
+// Meet of the values that come through the executable edges
+void SCCPPass::visitPhi(PhiInstruction* phi) {
+    BasicBlock* block = phi->GetBasicBlock();
+
+    LatticeValue result;
+    for (size_t i = 0; i < phi->GetArgumentsNumber(); ++i) {
+        if (!m_ExecutableEdges.contains({phi->GetIncomingBlock(i), block})) {
+            continue;
+        }
+
+        LatticeValue value = getLatticeValue(phi->GetIncomingValue(i));
+        if (value.State == LatticeState::kOverdefined) {
+            result = value;
+            break;
+        }
+        if (value.State == LatticeState::kUndefined) {
+            continue;
+        }
+
+        if (result.State == LatticeState::kUndefined) {
+            result = value;
+        } else if (!isSameConstant(result.ConstantValue, value.ConstantValue)) {
+            result = LatticeValue{LatticeState::kOverdefined, nullptr};
+            break;
+        }
+    }
+
+    updateLatticeValue(phi, result);
+}
+
+void SCCPPass::visitBranch(BranchInstruction* branch) {
+    BasicBlock* block = branch->GetBasicBlock();
+    if (branch->IsUnconditional()) {
+        markEdgeExecutable(block, branch->GetTrueBasicBlock());
+        return;
+    }
+
+    LatticeValue condition = getLatticeValue(branch->GetCondition());
+    if (condition.State == LatticeState::kOverdefined) {
+        markEdgeExecutable(block, branch->GetTrueBasicBlock());
+        markEdgeExecutable(block, branch->GetFalseBasicBlock());
+    } else if (condition.State == LatticeState::kConstant) {
+        auto* intConstant = static_cast<IntConstant*>(condition.ConstantValue);
+        if (intConstant->GetValue().GetUnsignedValue()) {
+            markEdgeExecutable(block, branch->GetTrueBasicBlock());
+        } else {
+            markEdgeExecutable(block, branch->GetFalseBasicBlock());
+        }
+    }
+}
+
+void SCCPPass::visitSwitch(SwitchInstruction* switchInstr) {
+    BasicBlock* block = switchInstr->GetBasicBlock();
+
+    LatticeValue value = getLatticeValue(switchInstr->GetValue());
+    if (value.State == LatticeState::kOverdefined) {
+        for (BasicBlock* successor : block->GetSuccessors()) {
+            markEdgeExecutable(block, successor);
+        }
+    } else if (value.State == LatticeState::kConstant) {
+        markEdgeExecutable(block, getSwitchTarget(switchInstr, value.ConstantValue));
+    }
+}
+
+SCCPPass::LatticeValue SCCPPass::evaluate(Instruction* instruction) {
+    LatticeValue overdefined{LatticeState::kOverdefined, nullptr};
+    if (!dynamic_cast<BinaryInstruction*>(instruction) &&
+            !dynamic_cast<CompareInstruction*>(instruction) &&
+            !dynamic_cast<CastInstruction*>(instruction)) {
+        return overdefined;
+    }
+
+    std::vector<Constant*> constants;
+    for (Value* operand : instruction->GetOperands()) {
+        LatticeValue value = getLatticeValue(operand);
+        if (value.State != LatticeState::kConstant) {
+            return value.State == LatticeState::kUndefined ? LatticeValue{} : overdefined;
+        }
+        constants.push_back(value.ConstantValue);
+    }
+
+    Constant* result = fold(instruction, constants);
+    if (!result) {
+        return overdefined;
+    }
+    return LatticeValue{LatticeState::kConstant, result};
+}
+
+// Constexpr evaluates in 64 bits, so the folds that depend on the width
+// of a narrow type or trap at run time are left to the program
+Constant* SCCPPass::fold(Instruction* instruction, const std::vector<Constant*>& constants) {
+    if (auto* binary = dynamic_cast<BinaryInstruction*>(instruction)) {
+        if (isWidthSensitive(binary)) {
+            return nullptr;
+        }
+
+        auto* right = dynamic_cast<IntConstant*>(constants[1]);
+        switch (binary->GetOpType()) {
+            case BinaryInstruction::OpType::kSDiv:
+            case BinaryInstruction::OpType::kUDiv:
+            case BinaryInstruction::OpType::kSRem:
+            case BinaryInstruction::OpType::kURem:
+                if (right->GetValue().GetUnsignedValue() == 0 ||
+                        (right->GetValue().GetSignedValue() == -1 &&
+                         static_cast<IntConstant*>(constants[0])->GetValue().GetSignedValue() ==
+                            std::numeric_limits<int64_t>::min())) {
+                    return nullptr;
+                }
+                break;
+            case BinaryInstruction::OpType::kShiftL:
+            case BinaryInstruction::OpType::kLShiftR:
+            case BinaryInstruction::OpType::kAShiftR:
+                if (right->GetValue().GetUnsignedValue() >= 64) {
+                    return nullptr;
+                }
+                break;
+            default:
+                break;
+        }
+
+        return normalize(m_Constexpr.EvaluateBinaryConstExpr(constants[0], constants[1],
+                                                             binary->GetOpType()));
+    }
+
+    if (auto* compare = dynamic_cast<CompareInstruction*>(instruction)) {
+        return m_Constexpr.EvaluateCompareConstExpr(constants[0], constants[1],
+                                                    compare->GetOpType());
+    }
+
+    auto* cast = static_cast<CastInstruction*>(instruction);
+    switch (cast->GetOpType()) {
+        case CastInstruction::OpType::kZExt: {
+            auto* intConstant = static_cast<IntConstant*>(constants[0]);
+            if (intConstant->GetValue().GetSignedValue() < 0) {
+                return nullptr;
+            }
+            break;
+        }
+        case CastInstruction::OpType::kBitcast:
+            if (!dynamic_cast<IntType*>(cast->GetFromType()) ||
+                    !dynamic_cast<IntType*>(cast->GetToType())) {
+                return nullptr;
+            }
+            break;
+        case CastInstruction::OpType::kSExt:
+        case CastInstruction::OpType::kITrunc:
+        case CastInstruction::OpType::kSIToF:
+        case CastInstruction::OpType::kFExt:
+        case CastInstruction::OpType::kFTrunc:
+            break;
+        default:
+            return nullptr;
+    }
+
+    return normalize(m_Constexpr.EvaluateCastConstExpr(constants[0], cast->GetToType()));
+}
+
+SCCPPass::LatticeValue SCCPPass::getLatticeValue(Value* value) const {
+    if (dynamic_cast<IntConstant*>(value) || dynamic_cast<FloatConstant*>(value)) {
+        return LatticeValue{LatticeState::kConstant, static_cast<Constant*>(value)};
+    }
+
+    // Parameters, globals and the arguments lost by earlier passes
+    auto* instruction = dynamic_cast<Instruction*>(value);
+    if (!instruction) {
+        return LatticeValue{LatticeState::kOverdefined, nullptr};
+    }
+
+    auto it = m_Values.find(instruction);
+    if (it == m_Values.end()) {
+        return LatticeValue{};
+    }
+    return it->second;
+}
+
+void SCCPPass::updateLatticeValue(Instruction* instruction, const LatticeValue& value) {
+    LatticeValue& current = m_Values[instruction];
+    if (current.State == value.State) {
+        if (value.State != LatticeState::kConstant ||
+                isSameConstant(current.ConstantValue, value.ConstantValue)) {
+            return;
+        }
+    }
+
+    // The values only go down the lattice
+    if (current.State == LatticeState::kOverdefined) {
+        return;
+    }
+    if (current.State == LatticeState::kConstant) {
+        current = LatticeValue{LatticeState::kOverdefined, nullptr};
+    } else {
+        current = value;
+    }
+
+    for (Instruction* user : m_Users[instruction]) {
+        m_InstructionWorklist.push(user);
+    }
+}
+
+void SCCPPass::rewriteFunction() {
+    std::vector<Instruction*> constantInstructions;
+    std::vector<BranchInstruction*> constantBranches;
+    std::vector<SwitchInstruction*> constantSwitches;
+
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        if (!m_ExecutableBlocks.contains(block)) {
+            continue;
+        }
+
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            auto it = m_Values.find(instruction);
+            if (it != m_Values.end() && it->second.State == LatticeState::kConstant) {
+                constantInstructions.push_back(instruction);
+            }
+
+            auto* branch = dynamic_cast<BranchInstruction*>(instruction);
+            if (branch && branch->IsConditional() &&
+                    getLatticeValue(branch->GetCondition()).State == LatticeState::kConstant) {
+                constantBranches.push_back(branch);
+            }
+
+            auto* switchInstr = dynamic_cast<SwitchInstruction*>(instruction);
+            if (switchInstr && getLatticeValue(switchInstr->GetValue()).State == LatticeState::kConstant) {
+                constantSwitches.push_back(switchInstr);
+            }
+        }
+    }
+
+    for (Instruction* instruction : constantInstructions) {
+        replaceAllUses(instruction, m_Values[instruction].ConstantValue);
+
+        auto& instructions = instruction->GetBasicBlock()->GetInstructionsRef();
+        instructions.erase(std::find(instructions.begin(), instructions.end(), instruction));
+    }
+
+    // Conditions are already replaced with the constants
+    for (BranchInstruction* branch : constantBranches) {
+        auto* condition = static_cast<IntConstant*>(branch->GetCondition());
+        if (condition->GetValue().GetUnsignedValue()) {
+            branch->ToUnconditionalTrue();
+        } else {
+            branch->ToUnconditionalFalse();
+        }
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    for (SwitchInstruction* switchInstr : constantSwitches) {
+        auto* value = static_cast<Constant*>(switchInstr->GetValue());
+        BasicBlock* target = getSwitchTarget(switchInstr, value);
+
+        BasicBlock* block = switchInstr->GetBasicBlock();
+        for (BasicBlock* successor : block->GetSuccessors()) {
+            if (successor != target) {
+                successor->RemovePredecessor(block);
+            }
+        }
+
+        // The target keeps its edge and the phi arguments of it
+        block->GetInstructionsRef().back() = program.CreateValue<BranchInstruction>(target, block);
+    }
+}
+
+void SCCPPass::replaceAllUses(Instruction* from, Value* to) {
+    for (Instruction* user : m_Users[from]) {
+        for (size_t i = 0; i < user->GetOperandsNumber(); ++i) {
+            if (user->GetOperand(i) == from) {
+                user->SetOperand(to, i);
+            }
+        }
+    }
+}
+
+BasicBlock* SCCPPass::getSwitchTarget(SwitchInstruction* switchInstr, Constant* value) {
+    for (const auto& switchCase : switchInstr->GetCases()) {
+        if (isSameConstant(switchCase.CaseValue, value)) {
+            return switchCase.CaseBasicBlock;
+        }
+    }
+    return switchInstr->GetDefaultBasicBlock();
+}
+
+// Narrow integers are kept sign-extended to 64 bits, as IntValue(-1) is
+Constant* SCCPPass::normalize(Constant* constant) {
+    auto* intConstant = dynamic_cast<IntConstant*>(constant);
+    if (!intConstant) {
+        return constant;
+    }
+
+    auto* intType = static_cast<IntType*>(intConstant->GetType());
+    uint64_t bitsNumber = intType->GetBytesNumber() * 8;
+    if (bitsNumber >= 64) {
+        return constant;
+    }
+
+    uint64_t value = intConstant->GetValue().GetUnsignedValue();
+    uint64_t signBit = uint64_t(1) << (bitsNumber - 1);
+    uint64_t normalized = ((value & ((signBit << 1) - 1)) ^ signBit) - signBit;
+    if (normalized == value) {
+        return constant;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    return program.CreateValue<IntConstant>(intType, IntValue(normalized,
+                                                              intConstant->GetValue().IsSigned()));
+}
+
+bool SCCPPass::isSameConstant(Constant* left, Constant* right) {
+    if (left == right) {
+        return true;
+    }
+
+    auto* leftInt = dynamic_cast<IntConstant*>(left);
+    auto* rightInt = dynamic_cast<IntConstant*>(right);
+    if (leftInt && rightInt) {
+        uint64_t bitsNumber = static_cast<IntType*>(leftInt->GetType())->GetBytesNumber() * 8;
+        uint64_t mask = bitsNumber >= 64 ? ~uint64_t(0) : (uint64_t(1) << bitsNumber) - 1;
+        return (leftInt->GetValue().GetUnsignedValue() & mask) ==
+               (rightInt->GetValue().GetUnsignedValue() & mask);
+    }
+
+    auto* leftFloat = dynamic_cast<FloatConstant*>(left);
+    auto* rightFloat = dynamic_cast<FloatConstant*>(right);
+    if (leftFloat && rightFloat) {
+        return leftFloat->GetValue().GetValue() == rightFloat->GetValue().GetValue();
+    }
+
+    return false;
+}
+
+bool SCCPPass::isWidthSensitive(Instruction* instruction) {
+    auto* binary = dynamic_cast<BinaryInstruction*>(instruction);
+    auto* intType = dynamic_cast<IntType*>(instruction->GetType());
+    if (!binary || !intType || intType->GetBytesNumber() >= 8) {
+        return false;
+    }
+
+    switch (binary->GetOpType()) {
+        case BinaryInstruction::OpType::kUDiv:
+        case BinaryInstruction::OpType::kURem:
+        case BinaryInstruction::OpType::kLShiftR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace ir
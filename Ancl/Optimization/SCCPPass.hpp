@@ -0,0 +1,86 @@
+#pragma once
+
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <Ancl/AnclIR/Constexpr.hpp>
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    Sparse Conditional Constant Propagation (Wegman-Zadeck):
+    values are evaluated only in the blocks reached through executable edges,
+    so constants pass through phis around loops and folded branches,
+    the blocks that become unreachable are left for CleanPass
+*/
+class SCCPPass {
+public:
+    SCCPPass(Function* function);
+
+    void Run();
+
+private:
+    enum class LatticeState {
+        kUndefined,
+        kConstant,
+        kOverdefined,
+    };
+
+    struct LatticeValue {
+        LatticeState State = LatticeState::kUndefined;
+        Constant* ConstantValue = nullptr;
+    };
+
+    using Edge = std::pair<BasicBlock*, BasicBlock*>;
+
+    struct EdgeHash {
+        size_t operator()(const Edge& edge) const {
+            return std::hash<BasicBlock*>()(edge.first) ^ (std::hash<BasicBlock*>()(edge.second) << 1);
+        }
+    };
+
+    void collectUsers();
+
+    void markEdgeExecutable(BasicBlock* from, BasicBlock* to);
+
+    void visitBlock(BasicBlock* block);
+    void visitInstruction(Instruction* instruction);
+    void visitPhi(PhiInstruction* phi);
+    void visitBranch(BranchInstruction* branch);
+    void visitSwitch(SwitchInstruction* switchInstr);
+
+    LatticeValue evaluate(Instruction* instruction);
+    Constant* fold(Instruction* instruction, const std::vector<Constant*>& constants);
+
+    LatticeValue getLatticeValue(Value* value) const;
+    void updateLatticeValue(Instruction* instruction, const LatticeValue& value);
+
+    void rewriteFunction();
+    void replaceAllUses(Instruction* from, Value* to);
+
+    Constant* normalize(Constant* constant);
+
+    static bool isSameConstant(Constant* left, Constant* right);
+    static BasicBlock* getSwitchTarget(SwitchInstruction* switchInstr, Constant* value);
+    static bool isWidthSensitive(Instruction* instruction);
+
+private:
+    Function* m_Function = nullptr;
+    Constexpr m_Constexpr;
+
+    std::unordered_map<Value*, std::vector<Instruction*>> m_Users;
+    std::unordered_map<Instruction*, LatticeValue> m_Values;
+
+    std::unordered_set<BasicBlock*> m_ExecutableBlocks;
+    std::unordered_set<Edge, EdgeHash> m_ExecutableEdges;
+
+    std::queue<Edge> m_EdgeWorklist;
+    std::queue<Instruction*> m_InstructionWorklist;
+};
+
+}  // namespace ir
@@ -0,0 +1,454 @@
+#include <Ancl/Optimization/SROAPass.hpp>
+
+#include <algorithm>
+#include <string>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+#include <Ancl/DataLayout/Alignment.hpp>
+
+
+namespace ir {
+
+SROAPass::SROAPass(Function* function)
+    : m_Function(function) {}
+
+void SROAPass::Run() {
+    // IRGen and the inliner put all allocas to the entry block
+    std::vector<AllocaInstruction*> allocas;
+    for (Instruction* instruction : m_Function->GetEntryBlock()->GetInstructionsRef()) {
+        if (auto* alloca = dynamic_cast<AllocaInstruction*>(instruction)) {
+            Type* type = alloca->GetAllocaType();
+            if (dynamic_cast<StructType*>(type) || dynamic_cast<ArrayType*>(type)) {
+                allocas.push_back(alloca);
+            }
+        }
+    }
+
+    if (allocas.empty()) {
+        return;
+    }
+
+    // Copies and sets are expanded one alloca at a time,
+    // the other side of a copy may be an alloca that is split later
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        collectUsers();
+
+        for (AllocaInstruction* alloca : allocas) {
+            AllocaUses uses;
+            if (!analyzeAlloca(alloca, uses) || uses.MemoryInstructions.empty()) {
+                continue;
+            }
+
+            for (Instruction* instruction : uses.MemoryInstructions) {
+                if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+                    expandMemoryCopy(memoryCopy, uses);
+                } else {
+                    expandMemorySet(static_cast<MemorySetInstruction*>(instruction), uses);
+                }
+            }
+
+            isChanged = true;
+            break;
+        }
+    }
+
+    collectUsers();
+
+    std::vector<std::pair<AllocaInstruction*, AllocaUses>> splitAllocas;
+    for (AllocaInstruction* alloca : allocas) {
+        AllocaUses uses;
+        if (analyzeAlloca(alloca, uses)) {
+            splitAllocas.emplace_back(alloca, std::move(uses));
+        }
+    }
+
+    for (auto& [alloca, uses] : splitAllocas) {
+        splitAlloca(alloca, uses);
+    }
+}
+
+void SROAPass::collectUsers() {
+    m_Users.clear();
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (Value* operand : instruction->GetOperands()) {
+                if (operand) {
+                    m_Users[operand].push_back(instruction);
+                }
+            }
+        }
+    }
+}
+
+bool SROAPass::analyzeAlloca(AllocaInstruction* alloca, AllocaUses& uses) {
+    Type* type = alloca->GetAllocaType();
+    if (!collectScalars(type, 0, uses.Scalars)) {
+        return false;
+    }
+    uses.Size = Alignment::GetTypeSize(type);
+
+    uses.Offsets[alloca] = 0;
+    std::vector<Value*> workList{alloca};
+    while (!workList.empty()) {
+        Value* pointer = workList.back();
+        workList.pop_back();
+
+        for (Instruction* user : m_Users[pointer]) {
+            if (!analyzeUser(user, pointer, uses, workList)) {
+                return false;
+            }
+        }
+    }
+
+    // A copy inside one alloca has no scalar form
+    for (Instruction* instruction : uses.MemoryInstructions) {
+        if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(instruction)) {
+            if (uses.Offsets.contains(memoryCopy->GetDestinationOperand()) &&
+                    uses.Offsets.contains(memoryCopy->GetSourceOperand())) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SROAPass::analyzeUser(Instruction* user, Value* pointer, AllocaUses& uses,
+                           std::vector<Value*>& workList) {
+    int64_t offset = uses.Offsets[pointer];
+
+    if (auto* member = dynamic_cast<MemberInstruction*>(user)) {
+        auto* index = dynamic_cast<IntConstant*>(member->GetIndex());
+        auto* pointerType = dynamic_cast<PointerType*>(pointer->GetType());
+        if (member->GetPtrOperand() != pointer || !index || !pointerType) {
+            return false;
+        }
+
+        // The same offsets as MIRGenerator computes
+        int64_t indexValue = index->GetValue().GetSignedValue();
+        Type* subType = pointerType->GetSubType();
+        if (auto* arrayType = dynamic_cast<ArrayType*>(subType)) {
+            offset += indexValue * Alignment::GetTypeSize(arrayType->GetSubType());
+        } else if (!member->IsDeref()) {
+            offset += indexValue * Alignment::GetTypeSize(subType);
+        } else if (auto* structType = dynamic_cast<StructType*>(subType)) {
+            if (indexValue < 0 || indexValue >= static_cast<int64_t>(structType->GetElementsNumber())) {
+                return false;
+            }
+            offset += Alignment::GetStructLayout(structType).Offsets[indexValue];
+        } else {
+            return false;
+        }
+
+        if (!uses.Offsets.contains(member)) {
+            uses.Offsets[member] = offset;
+            uses.Pointers.push_back(member);
+            workList.push_back(member);
+        }
+        return true;
+    }
+
+    if (auto* cast = dynamic_cast<CastInstruction*>(user)) {
+        if (cast->GetOpType() != CastInstruction::OpType::kBitcast ||
+                !dynamic_cast<PointerType*>(cast->GetToType())) {
+            return false;
+        }
+
+        if (!uses.Offsets.contains(cast)) {
+            uses.Offsets[cast] = offset;
+            uses.Pointers.push_back(cast);
+            workList.push_back(cast);
+        }
+        return true;
+    }
+
+    if (auto* load = dynamic_cast<LoadInstruction*>(user)) {
+        int64_t index = findScalar(uses, offset, load->GetType());
+        if (load->IsVolatile() || index < 0) {
+            return false;
+        }
+        uses.Accesses.emplace_back(load, index);
+        return true;
+    }
+
+    if (auto* store = dynamic_cast<StoreInstruction*>(user)) {
+        Value* value = store->GetValueOperand();
+        if (store->IsVolatile() || value == pointer) {
+            return false;
+        }
+
+        int64_t index = findScalar(uses, offset, value->GetType());
+        if (index < 0) {
+            return false;
+        }
+        uses.Accesses.emplace_back(store, index);
+        return true;
+    }
+
+    std::vector<size_t> indices;
+    if (auto* memoryCopy = dynamic_cast<MemoryCopyInstruction*>(user)) {
+        uint64_t size = memoryCopy->GetSizeConstant()->GetValue().GetUnsignedValue();
+        if (!getCoveredScalars(uses, offset, size, indices)) {
+            return false;
+        }
+        uses.MemoryInstructions.push_back(memoryCopy);
+        return true;
+    }
+
+    if (auto* memorySet = dynamic_cast<MemorySetInstruction*>(user)) {
+        if (memorySet->GetDestinationOperand() != pointer) {
+            return false;
+        }
+
+        uint64_t size = memorySet->GetBytesNumber()->GetValue().GetUnsignedValue();
+        if (!getCoveredScalars(uses, offset, size, indices)) {
+            return false;
+        }
+
+        // Only zeros have the same bytes in floats and pointers
+        uint64_t fillByte = memorySet->GetFillByte()->GetValue().GetUnsignedValue() & 0xFF;
+        for (size_t index : indices) {
+            if (fillByte != 0 && !dynamic_cast<IntType*>(uses.Scalars[index].ScalarType)) {
+                return false;
+            }
+        }
+
+        uses.MemoryInstructions.push_back(memorySet);
+        return true;
+    }
+
+    return false;
+}
+
+bool SROAPass::collectScalars(Type* type, uint64_t offset, std::vector<Scalar>& scalars) {
+    if (isScalarType(type)) {
+        scalars.push_back(Scalar{.Offset = offset, .ScalarType = type});
+        return scalars.size() <= kMaxScalarsNumber;
+    }
+
+    if (auto* structType = dynamic_cast<StructType*>(type)) {
+        Alignment::StructLayout layout = Alignment::GetStructLayout(structType);
+        for (size_t i = 0; i < structType->GetElementsNumber(); ++i) {
+            if (!collectScalars(structType->GetElementType(i), offset + layout.Offsets[i], scalars)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (auto* arrayType = dynamic_cast<ArrayType*>(type)) {
+        if (arrayType->GetSize() > kMaxScalarsNumber) {
+            return false;
+        }
+
+        uint64_t elementSize = Alignment::GetTypeSize(arrayType->GetSubType());
+        for (uint64_t i = 0; i < arrayType->GetSize(); ++i) {
+            if (!collectScalars(arrayType->GetSubType(), offset + i * elementSize, scalars)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+int64_t SROAPass::findScalar(const AllocaUses& uses, int64_t offset, Type* type) const {
+    if (!isScalarType(type)) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < uses.Scalars.size(); ++i) {
+        const Scalar& scalar = uses.Scalars[i];
+        if (static_cast<int64_t>(scalar.Offset) == offset &&
+                isSameScalarType(scalar.ScalarType, type)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Copies and sets must not cut a scalar, the padding between them is dropped
+bool SROAPass::getCoveredScalars(const AllocaUses& uses, int64_t offset, uint64_t size,
+                                 std::vector<size_t>& indices) const {
+    if (offset < 0 || offset + size > uses.Size) {
+        return false;
+    }
+
+    uint64_t begin = offset;
+    uint64_t end = offset + size;
+    for (size_t i = 0; i < uses.Scalars.size(); ++i) {
+        const Scalar& scalar = uses.Scalars[i];
+        uint64_t scalarBegin = scalar.Offset;
+        uint64_t scalarEnd = scalar.Offset + Alignment::GetTypeSize(scalar.ScalarType);
+        if (scalarEnd <= begin || scalarBegin >= end) {
+            continue;
+        }
+        if (scalarBegin < begin || scalarEnd > end) {
+            return false;
+        }
+        indices.push_back(i);
+    }
+    return true;
+}
+
+void SROAPass::expandMemoryCopy(MemoryCopyInstruction* memoryCopy, const AllocaUses& uses) {
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* block = memoryCopy->GetBasicBlock();
+
+    Value* destination = memoryCopy->GetDestinationOperand();
+    Value* source = memoryCopy->GetSourceOperand();
+
+    Value* pointer = uses.Offsets.contains(destination) ? destination : source;
+    int64_t offset = uses.Offsets.at(pointer);
+    uint64_t size = memoryCopy->GetSizeConstant()->GetValue().GetUnsignedValue();
+
+    std::vector<size_t> indices;
+    getCoveredScalars(uses, offset, size, indices);
+
+    for (size_t index : indices) {
+        const Scalar& scalar = uses.Scalars[index];
+        uint64_t scalarOffset = scalar.Offset - offset;
+
+        Value* sourcePointer = getBytePointer(source, scalarOffset, scalar.ScalarType, memoryCopy);
+        auto* load = program.CreateValue<LoadInstruction>(sourcePointer, scalar.ScalarType, "", block);
+        insertBefore(load, memoryCopy);
+
+        Value* destinationPointer = getBytePointer(destination, scalarOffset, scalar.ScalarType, memoryCopy);
+        auto* store = program.CreateValue<StoreInstruction>(load, destinationPointer, "", block);
+        insertBefore(store, memoryCopy);
+    }
+
+    eraseInstruction(memoryCopy);
+}
+
+void SROAPass::expandMemorySet(MemorySetInstruction* memorySet, const AllocaUses& uses) {
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* block = memorySet->GetBasicBlock();
+
+    Value* destination = memorySet->GetDestinationOperand();
+    int64_t offset = uses.Offsets.at(destination);
+    uint64_t size = memorySet->GetBytesNumber()->GetValue().GetUnsignedValue();
+    uint8_t fillByte = memorySet->GetFillByte()->GetValue().GetUnsignedValue() & 0xFF;
+
+    std::vector<size_t> indices;
+    getCoveredScalars(uses, offset, size, indices);
+
+    for (size_t index : indices) {
+        const Scalar& scalar = uses.Scalars[index];
+        Value* pointer = getBytePointer(destination, scalar.Offset - offset, scalar.ScalarType, memorySet);
+        auto* store = program.CreateValue<StoreInstruction>(getSplatConstant(scalar.ScalarType, fillByte),
+                                                            pointer, "", block);
+        insertBefore(store, memorySet);
+    }
+
+    eraseInstruction(memorySet);
+}
+
+// Bitcasts and a byte member, the split alloca sees the same offset
+Value* SROAPass::getBytePointer(Value* pointer, uint64_t offset, Type* type, Instruction* before) {
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* block = before->GetBasicBlock();
+
+    auto* bytePointerType = PointerType::Create(IntType::Create(program, 1));
+    auto* bytePointer = program.CreateValue<CastInstruction>(CastInstruction::OpType::kBitcast, "cast",
+                                                             pointer, bytePointerType, block);
+    insertBefore(bytePointer, before);
+
+    Instruction* result = bytePointer;
+    if (offset != 0) {
+        auto* indexType = IntType::Create(program, Alignment::GetPointerTypeSize());
+        auto* index = program.CreateValue<IntConstant>(indexType, IntValue(offset, /*isSigned=*/false));
+        result = program.CreateValue<MemberInstruction>(bytePointer, index, "add.ptr", bytePointerType, block);
+        insertBefore(result, before);
+    }
+
+    auto* typedPointer = program.CreateValue<CastInstruction>(CastInstruction::OpType::kBitcast, "cast",
+                                                              result, PointerType::Create(type), block);
+    insertBefore(typedPointer, before);
+    return typedPointer;
+}
+
+void SROAPass::splitAlloca(AllocaInstruction* alloca, AllocaUses& uses) {
+    IRProgram& program = m_Function->GetProgram();
+    BasicBlock* entryBlock = alloca->GetBasicBlock();
+
+    for (auto [access, index] : uses.Accesses) {
+        Scalar& scalar = uses.Scalars[index];
+        if (!scalar.Alloca) {
+            std::string name = alloca->GetName() + "." + std::to_string(index);
+            scalar.Alloca = program.CreateValue<AllocaInstruction>(scalar.ScalarType, name, entryBlock);
+            insertBefore(scalar.Alloca, alloca);
+
+            // Fields read before any write get zero, as undefined values in IRGen,
+            // so SSAPass always has a reaching store
+            auto* store = program.CreateValue<StoreInstruction>(getSplatConstant(scalar.ScalarType, 0),
+                                                                scalar.Alloca, "", entryBlock);
+            insertBefore(store, alloca);
+        }
+
+        if (auto* load = dynamic_cast<LoadInstruction*>(access)) {
+            load->SetOperand(scalar.Alloca, 0);
+        } else {
+            access->SetOperand(scalar.Alloca, 1);
+        }
+    }
+
+    for (auto it = uses.Pointers.rbegin(); it != uses.Pointers.rend(); ++it) {
+        eraseInstruction(*it);
+    }
+    eraseInstruction(alloca);
+}
+
+void SROAPass::insertBefore(Instruction* instruction, Instruction* before) {
+    auto& instructions = before->GetBasicBlock()->GetInstructionsRef();
+    instructions.insert(std::find(instructions.begin(), instructions.end(), before), instruction);
+}
+
+void SROAPass::eraseInstruction(Instruction* instruction) {
+    auto& instructions = instruction->GetBasicBlock()->GetInstructionsRef();
+    instructions.erase(std::find(instructions.begin(), instructions.end(), instruction));
+}
+
+Constant* SROAPass::getSplatConstant(Type* type, uint8_t byte) {
+    IRProgram& program = m_Function->GetProgram();
+
+    if (auto* floatType = dynamic_cast<FloatType*>(type)) {
+        return program.CreateValue<FloatConstant>(floatType, FloatValue(0.));
+    }
+
+    if (auto* intType = dynamic_cast<IntType*>(type)) {
+        uint64_t bitsNumber = intType->GetBytesNumber() * 8;
+        uint64_t value = byte * 0x0101010101010101ULL;
+        if (bitsNumber < 64) {
+            uint64_t signBit = uint64_t(1) << (bitsNumber - 1);
+            value = ((value & ((signBit << 1) - 1)) ^ signBit) - signBit;
+        }
+        return program.CreateValue<IntConstant>(intType, IntValue(value));
+    }
+
+    // Null pointer
+    auto* intType = IntType::Create(program, Alignment::GetPointerTypeSize());
+    return program.CreateValue<IntConstant>(intType, IntValue(0));
+}
+
+bool SROAPass::isScalarType(Type* type) {
+    return dynamic_cast<IntType*>(type) || dynamic_cast<FloatType*>(type) ||
+           dynamic_cast<PointerType*>(type);
+}
+
+bool SROAPass::isSameScalarType(Type* left, Type* right) {
+    if (auto* leftInt = dynamic_cast<IntType*>(left)) {
+        auto* rightInt = dynamic_cast<IntType*>(right);
+        return rightInt && leftInt->GetBytesNumber() == rightInt->GetBytesNumber();
+    }
+    if (auto* leftFloat = dynamic_cast<FloatType*>(left)) {
+        auto* rightFloat = dynamic_cast<FloatType*>(right);
+        return rightFloat && leftFloat->GetKind() == rightFloat->GetKind();
+    }
+    return dynamic_cast<PointerType*>(left) && dynamic_cast<PointerType*>(right);
+}
+
+}  // namespace ir
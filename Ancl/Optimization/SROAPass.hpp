@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    Scalar Replacement of Aggregates:
+    struct and array allocas that do not escape and are accessed only
+    through constant offsets are split into one alloca per scalar field,
+    copies and sets of them become per-field loads and stores,
+    so SSAPass can promote the fields to registers
+*/
+class SROAPass {
+public:
+    SROAPass(Function* function);
+
+    void Run();
+
+private:
+    struct Scalar {
+        uint64_t Offset = 0;
+        Type* ScalarType = nullptr;
+        AllocaInstruction* Alloca = nullptr;
+    };
+
+    struct AllocaUses {
+        uint64_t Size = 0;
+        std::vector<Scalar> Scalars;
+
+        // Pointers into the alloca in the order they were found
+        std::vector<Instruction*> Pointers;
+        std::unordered_map<Value*, int64_t> Offsets;
+
+        // Loads and stores with the indices of their scalars
+        std::vector<std::pair<Instruction*, size_t>> Accesses;
+        std::vector<Instruction*> MemoryInstructions;
+    };
+
+    void collectUsers();
+
+    bool analyzeAlloca(AllocaInstruction* alloca, AllocaUses& uses);
+    bool analyzeUser(Instruction* user, Value* pointer, AllocaUses& uses,
+                     std::vector<Value*>& workList);
+
+    bool collectScalars(Type* type, uint64_t offset, std::vector<Scalar>& scalars);
+    int64_t findScalar(const AllocaUses& uses, int64_t offset, Type* type) const;
+    bool getCoveredScalars(const AllocaUses& uses, int64_t offset, uint64_t size,
+                           std::vector<size_t>& indices) const;
+
+    void expandMemoryCopy(MemoryCopyInstruction* memoryCopy, const AllocaUses& uses);
+    void expandMemorySet(MemorySetInstruction* memorySet, const AllocaUses& uses);
+    Value* getBytePointer(Value* pointer, uint64_t offset, Type* type, Instruction* before);
+
+    void splitAlloca(AllocaInstruction* alloca, AllocaUses& uses);
+
+    void insertBefore(Instruction* instruction, Instruction* before);
+    void eraseInstruction(Instruction* instruction);
+
+    Constant* getSplatConstant(Type* type, uint8_t byte);
+
+    static bool isScalarType(Type* type);
+    static bool isSameScalarType(Type* left, Type* right);
+
+private:
+    static constexpr size_t kMaxScalarsNumber = 16;
+
+private:
+    Function* m_Function = nullptr;
+
+    std::unordered_map<Value*, std::vector<Instruction*>> m_Users;
+};
+
+}  // namespace ir
@@ -1,6 +1,8 @@
 #include <Ancl/Optimization/SSAPass.hpp>
 
 #include <cassert>
+#include <queue>
+#include <utility>
 
 #include <Ancl/AnclIR/IRProgram.hpp>
 #include <Ancl/Logger/Logger.hpp>
@@ -8,8 +10,8 @@
 
 namespace ir {
 
-SSAPass::SSAPass(Function* function)
-    : m_Function(function), m_DomTree(function) {}
+SSAPass::SSAPass(Function* function, bool isPruned)
+    : m_Function(function), m_DomTree(function), m_IsPruned(isPruned) {}
 
 void SSAPass::Run() {
     for (BasicBlock* block : m_Function->GetBasicBlocks()) {
@@ -23,16 +25,33 @@ void SSAPass::Run() {
     }
 
     for (AllocaInstruction* alloca : m_Globals) {
+        if (m_IsPruned) {
+            computeLiveInBlocks(alloca);
+        }
         insertPhiFunctions(alloca);
     }
 
     renameAllocas(m_Function->GetEntryBlock());
 }
 
+bool SSAPass::HasAllocas(Function* function) {
+    // IRGen puts all allocas to the entry block
+    for (Instruction* instruction : function->GetEntryBlock()->GetInstructionsRef()) {
+        if (dynamic_cast<AllocaInstruction*>(instruction)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void SSAPass::renameAllocas(BasicBlock* block) {
     std::unordered_map<AllocaInstruction*, int> stacksGrowth;
 
     for (PhiInstruction* phi : block->GetPhiFunctions()) {
+        // Phis of the scalar variables are built by IRGen
+        if (!m_PhiAllocaMap.contains(phi)) {
+            continue;
+        }
         auto* alloca = m_PhiAllocaMap[phi];
         m_AllocaValueStacks[alloca].push(phi);
         ++stacksGrowth[alloca];
@@ -125,35 +144,88 @@ void SSAPass::renameAllocas(BasicBlock* block) {
 }
 
 void SSAPass::insertPhiFunctions(AllocaInstruction* alloca) {
-    auto allocaInfo = m_PromotableAllocaInfo[alloca];
-    auto workSet = allocaInfo.DefBlocks;
+    // Iterated dominance frontier with a priority queue (Sreedhar and Gao):
+    // the deepest blocks are processed first, so each block is visited once
+    const AllocaInfo& allocaInfo = m_PromotableAllocaInfo[alloca];
+
+    using BlockKey = std::pair<uint64_t, uint64_t>;  // Level, RPO number
+    std::priority_queue<std::pair<BlockKey, BasicBlock*>> queue;
+    auto getKey = [this](BasicBlock* block) {
+        return BlockKey{m_DomTree.GetLevel(block), m_DomTree.GetRPONumber(block)};
+    };
+
+    for (BasicBlock* defBlock : allocaInfo.DefBlocks) {
+        if (m_DomTree.Contains(defBlock)) {
+            queue.emplace(getKey(defBlock), defBlock);
+        }
+    }
 
+    std::unordered_set<BasicBlock*> visitedQueue;
+    std::unordered_set<BasicBlock*> visitedWorkList;
     std::vector<BasicBlock*> workList;
-    workList.insert(workList.end(), workSet.begin(), workSet.end());
+    while (!queue.empty()) {
+        BasicBlock* root = queue.top().second;
+        queue.pop();
+        uint64_t rootLevel = m_DomTree.GetLevel(root);
+
+        // Walk the dominator subtree of the root looking for join edges
+        workList.push_back(root);
+        visitedWorkList.insert(root);
+        while (!workList.empty()) {
+            BasicBlock* block = workList.back();
+            workList.pop_back();
+
+            for (BasicBlock* next : block->GetSuccessors()) {
+                // Edges inside the subtree are not join edges
+                if (m_DomTree.GetLevel(next) > rootLevel) {
+                    continue;
+                }
+                if (!visitedQueue.insert(next).second) {
+                    continue;
+                }
+                if (m_IsPruned && !allocaInfo.LiveInBlocks.contains(next)) {
+                    continue;
+                }
+
+                addPhiFunction(alloca, next);
 
+                if (!allocaInfo.DefBlocks.contains(next)) {
+                    queue.emplace(getKey(next), next);
+                }
+            }
+
+            for (BasicBlock* child : m_DomTree.GetChildren(block)) {
+                if (visitedWorkList.insert(child).second) {
+                    workList.push_back(child);
+                }
+            }
+        }
+    }
+}
+
+void SSAPass::computeLiveInBlocks(AllocaInstruction* alloca) {
+    AllocaInfo& allocaInfo = m_PromotableAllocaInfo[alloca];
+
+    std::vector<BasicBlock*> workList(allocaInfo.LiveInBlocks.begin(),
+                                      allocaInfo.LiveInBlocks.end());
     while (!workList.empty()) {
-        BasicBlock* block = std::move(workList.back());
+        BasicBlock* block = workList.back();
         workList.pop_back();
-        workSet.erase(block);
 
-        for (BasicBlock* frontier : m_DomTree.GetDominanceFrontier(block)) {
-            if (m_PhiBasicBlocks[alloca].contains(frontier)) {
+        for (BasicBlock* pred : block->GetPredecessors()) {
+            // The store kills the value unless the block has an upward-exposed load,
+            // those blocks are live-in from the start
+            if (allocaInfo.DefBlocks.contains(pred)) {
                 continue;
             }
-
-            addPhiFunction(alloca, frontier);
-
-            if (!workSet.contains(frontier)) {
-                workList.push_back(frontier);
-                workSet.insert(frontier);
+            if (allocaInfo.LiveInBlocks.insert(pred).second) {
+                workList.push_back(pred);
             }
         }
     }
 }
 
 void SSAPass::addPhiFunction(AllocaInstruction* alloca, BasicBlock* block) {
-    m_PhiBasicBlocks[alloca].insert(block);
-
     auto allocaPtrType = dynamic_cast<PointerType*>(alloca->GetType());
     assert(allocaPtrType);
 
@@ -209,6 +281,7 @@ void SSAPass::computeAllocasInfo() {
 
                         if (!storedAllocas.contains(alloca)) {
                             m_Globals.insert(alloca);  // Alloca with upward-exposed use
+                            m_PromotableAllocaInfo[alloca].LiveInBlocks.insert(block);
                         }
                     }
                 }
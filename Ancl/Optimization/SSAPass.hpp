@@ -14,15 +14,20 @@ namespace ir {
 
 class SSAPass {
 public:
-    SSAPass(Function* function);
+    // Pruned SSA places phis only where the alloca is live-in
+    SSAPass(Function* function, bool isPruned = false);
 
     void Run();
 
+    static bool HasAllocas(Function* function);
+
 private:
     void renameAllocas(BasicBlock* block);
 
     void insertPhiFunctions(AllocaInstruction* alloca);
 
+    void computeLiveInBlocks(AllocaInstruction* alloca);
+
     void addPhiFunction(AllocaInstruction* alloca, BasicBlock* block);
 
     void tryPromoteAlloca(AllocaInstruction* alloca, size_t& index);
@@ -41,12 +46,13 @@ private:
     Function* m_Function = nullptr;
     DominatorTree m_DomTree;
 
+    bool m_IsPruned = false;
+
     std::unordered_map<AllocaInstruction*, bool> m_BadAllocas;
 
     std::vector<AllocaInstruction*> m_PromotableAllocaList;
 
     std::unordered_set<AllocaInstruction*> m_Globals;
-    std::unordered_map<AllocaInstruction*, std::unordered_set<BasicBlock*>> m_PhiBasicBlocks;
 
     struct AllocaInfo {
         std::list<Instruction*>::iterator Iterator;
@@ -56,6 +62,7 @@ private:
 
         std::unordered_set<BasicBlock*> DefBlocks;  // Store
         std::unordered_set<BasicBlock*> UseBlocks;  // Load
+        std::unordered_set<BasicBlock*> LiveInBlocks;  // Upward-exposed Load at first
 
         bool IsOneBlock = true;
         BasicBlock* Block = nullptr;
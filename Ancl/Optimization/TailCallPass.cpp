@@ -0,0 +1,244 @@
+#include <Ancl/Optimization/TailCallPass.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+#include <Ancl/AnclIR/IRProgram.hpp>
+#include <Ancl/Optimization/AliasAnalysis.hpp>
+
+
+namespace ir {
+
+TailCallPass::TailCallPass(Function* function)
+    : m_Function(function) {}
+
+void TailCallPass::Run() {
+    // The variadic arguments and the escaped allocas live in the frame that is released
+    auto* functionType = static_cast<FunctionType*>(m_Function->GetType());
+    if (functionType->IsVariadic() || hasEscapedAllocas()) {
+        return;
+    }
+
+    BasicBlock* exitBlock = m_Function->GetLastBlock();
+    if (dynamic_cast<ReturnInstruction*>(exitBlock->GetTerminator())) {
+        duplicateReturn(exitBlock);
+    }
+
+    std::vector<BasicBlock*> recursionBlocks;
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        CallInstruction* call = getReturnedCall(block);
+        if (!call) {
+            continue;
+        }
+
+        if (call->GetCallee() != m_Function) {
+            call->SetTailCall();
+        } else if (call->GetArgumentsNumber() == m_Function->GetParameters().size()) {
+            recursionBlocks.push_back(block);
+        }
+    }
+
+    if (!recursionBlocks.empty()) {
+        eliminateTailRecursion(recursionBlocks);
+    }
+}
+
+bool TailCallPass::hasEscapedAllocas() const {
+    AliasAnalysis aliasAnalysis(m_Function);
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            auto* alloca = dynamic_cast<AllocaInstruction*>(instruction);
+            if (alloca && !aliasAnalysis.IsLocalMemory(alloca)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Only the register arguments are supported by the backend,
+// so the stack area of the caller is never needed by the callee
+bool TailCallPass::isTailCallCandidate(CallInstruction* call) const {
+    auto isRegisterType = [](Type* type) {
+        return dynamic_cast<IntType*>(type) || dynamic_cast<PointerType*>(type) ||
+               dynamic_cast<FloatType*>(type);
+    };
+
+    auto* calleeType = static_cast<FunctionType*>(call->GetCallee()->GetType());
+    Type* returnType = calleeType->GetReturnType();
+    if (!dynamic_cast<VoidType*>(returnType) && !isRegisterType(returnType)) {
+        return false;
+    }
+
+    size_t intArgumentsNumber = 0;
+    size_t floatArgumentsNumber = 0;
+    for (Value* argument : call->GetArguments()) {
+        Type* argumentType = argument->GetType();
+        if (!isRegisterType(argumentType)) {
+            return false;
+        }
+
+        if (dynamic_cast<FloatType*>(argumentType)) {
+            ++floatArgumentsNumber;
+        } else {
+            ++intArgumentsNumber;
+        }
+    }
+
+    return intArgumentsNumber <= kMaxIntRegisterArguments &&
+           floatArgumentsNumber <= kMaxFloatRegisterArguments;
+}
+
+// The predecessors that jump to the return block right after a call
+// return the call result themselves
+void TailCallPass::duplicateReturn(BasicBlock* exitBlock) {
+    std::list<Instruction*>& exitInstructions = exitBlock->GetInstructionsRef();
+    bool hasOnlyPhis = std::all_of(exitInstructions.begin(), std::prev(exitInstructions.end()),
+                                   [](Instruction* instruction) {
+        return dynamic_cast<PhiInstruction*>(instruction) != nullptr;
+    });
+    if (!hasOnlyPhis) {
+        return;
+    }
+
+    auto* exitReturn = static_cast<ReturnInstruction*>(exitBlock->GetTerminator());
+    Value* exitValue = exitReturn->HasReturnValue() ? exitReturn->GetReturnValue() : nullptr;
+    auto* exitPhi = dynamic_cast<PhiInstruction*>(exitValue);
+    if (exitPhi && exitPhi->GetBasicBlock() != exitBlock) {
+        exitPhi = nullptr;
+    }
+
+    IRProgram& program = m_Function->GetProgram();
+    for (BasicBlock* pred : exitBlock->GetPredecessors()) {
+        auto* branch = dynamic_cast<BranchInstruction*>(pred->GetTerminator());
+        std::list<Instruction*>& instructions = pred->GetInstructionsRef();
+        if (pred == exitBlock || !branch || branch->IsConditional() || instructions.size() < 2) {
+            continue;
+        }
+
+        auto* call = dynamic_cast<CallInstruction*>(*std::prev(instructions.end(), 2));
+        if (!call || !isTailCallCandidate(call)) {
+            continue;
+        }
+
+        Value* returnValue = exitValue;
+        if (exitPhi) {
+            for (size_t i = 0; i < exitPhi->GetArgumentsNumber(); ++i) {
+                if (exitPhi->GetIncomingBlock(i) == pred) {
+                    returnValue = exitPhi->GetIncomingValue(i);
+                    break;
+                }
+            }
+        }
+        if (returnValue && returnValue != call) {
+            continue;
+        }
+
+        ReturnInstruction* ret = nullptr;
+        if (returnValue) {
+            ret = program.CreateValue<ReturnInstruction>(returnValue, pred);
+        } else {
+            ret = program.CreateValue<ReturnInstruction>(pred);
+        }
+        pred->ReplaceTerminator(ret);
+        exitBlock->RemovePredecessor(pred);
+    }
+
+    if (exitBlock->GetPredecessorsNumber() == 0) {
+        std::vector<BasicBlock*> blocks = m_Function->GetBasicBlocks();
+        std::erase(blocks, exitBlock);
+        m_Function->SetBasicBlocks(blocks);
+    }
+}
+
+CallInstruction* TailCallPass::getReturnedCall(BasicBlock* block) const {
+    auto* ret = dynamic_cast<ReturnInstruction*>(block->GetTerminator());
+    std::list<Instruction*>& instructions = block->GetInstructionsRef();
+    if (!ret || instructions.size() < 2) {
+        return nullptr;
+    }
+
+    auto* call = dynamic_cast<CallInstruction*>(*std::prev(instructions.end(), 2));
+    if (!call || (ret->HasReturnValue() && ret->GetReturnValue() != call)) {
+        return nullptr;
+    }
+    return isTailCallCandidate(call) ? call : nullptr;
+}
+
+// The old entry becomes the loop header with a phi for each parameter,
+// the new entry keeps the allocas and passes the incoming parameters
+void TailCallPass::eliminateTailRecursion(const std::vector<BasicBlock*>& recursionBlocks) {
+    IRProgram& program = m_Function->GetProgram();
+
+    BasicBlock* headerBlock = m_Function->GetEntryBlock();
+    headerBlock->SetName(m_Function->GetNewBasicBlockName("tailrecurse"));
+
+    auto* entryBlock = program.CreateValue<BasicBlock>("entry", LabelType::Create(program), m_Function);
+    m_Function->InsertBasicBlock(0, entryBlock);
+    m_Function->SetEntryBlock(entryBlock);
+
+    std::list<Instruction*>& headerInstructions = headerBlock->GetInstructionsRef();
+    for (auto it = headerInstructions.begin(); it != headerInstructions.end();) {
+        if (dynamic_cast<AllocaInstruction*>(*it)) {
+            entryBlock->AddInstruction(*it);
+            it = headerInstructions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::vector<Parameter*> parameters = m_Function->GetParameters();
+    std::vector<BasicBlock*> headerPreds = headerBlock->GetPredecessors();
+    std::unordered_map<Value*, PhiInstruction*> parameterPhis;
+    std::vector<PhiInstruction*> phis;
+    for (Parameter* parameter : parameters) {
+        auto* phi = program.CreateValue<PhiInstruction>(parameter->GetType(), parameter->GetName(),
+                                                        headerBlock);
+        // The old back edges keep the value of the current iteration
+        for (size_t i = 0; i < headerPreds.size(); ++i) {
+            phi->SetIncomingBlock(i, headerPreds[i]);
+            phi->SetIncomingValue(i, phi);
+        }
+        parameterPhis[parameter] = phi;
+        phis.push_back(phi);
+    }
+
+    for (BasicBlock* block : m_Function->GetBasicBlocks()) {
+        for (Instruction* instruction : block->GetInstructionsRef()) {
+            for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+                auto it = parameterPhis.find(instruction->GetOperand(i));
+                if (it != parameterPhis.end()) {
+                    instruction->SetOperand(it->second, i);
+                }
+            }
+        }
+    }
+
+    for (PhiInstruction* phi : phis) {
+        headerBlock->AddPhiFunction(phi);
+    }
+
+    auto setLastIncomingValues = [&phis](const std::vector<Value*>& values) {
+        for (size_t i = 0; i < phis.size(); ++i) {
+            phis[i]->SetIncomingValue(phis[i]->GetArgumentsNumber() - 1, values[i]);
+        }
+    };
+
+    auto* entryBranch = program.CreateValue<BranchInstruction>(headerBlock, entryBlock);
+    entryBlock->AddInstruction(entryBranch);
+    setLastIncomingValues(std::vector<Value*>(parameters.begin(), parameters.end()));
+
+    for (BasicBlock* block : recursionBlocks) {
+        std::list<Instruction*>& instructions = block->GetInstructionsRef();
+        instructions.pop_back();
+        auto* call = static_cast<CallInstruction*>(instructions.back());
+        instructions.pop_back();
+
+        auto* branch = program.CreateValue<BranchInstruction>(headerBlock, block);
+        block->AddInstruction(branch);
+        setLastIncomingValues(call->GetArguments());
+    }
+}
+
+}  // namespace ir
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include <Ancl/AnclIR/IR.hpp>
+
+
+namespace ir {
+
+/*
+    Tail Call Elimination:
+    a call whose result is returned right away reuses the frame of the caller,
+    the return block is duplicated into the predecessors that only pass
+    such a result to it, self tail recursion becomes a loop to the entry block,
+    nothing is done when the address of some alloca escapes
+*/
+class TailCallPass {
+public:
+    TailCallPass(Function* function);
+
+    void Run();
+
+private:
+    bool hasEscapedAllocas() const;
+
+    bool isTailCallCandidate(CallInstruction* call) const;
+
+    void duplicateReturn(BasicBlock* exitBlock);
+    CallInstruction* getReturnedCall(BasicBlock* block) const;
+
+    void eliminateTailRecursion(const std::vector<BasicBlock*>& recursionBlocks);
+
+private:
+    // System V AMD64 passes these arguments in registers, the rest go to the stack
+    static constexpr size_t kMaxIntRegisterArguments = 6;
+    static constexpr size_t kMaxFloatRegisterArguments = 8;
+
+private:
+    Function* m_Function = nullptr;
+};
+
+}  // namespace ir
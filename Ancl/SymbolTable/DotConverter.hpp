@@ -95,7 +95,7 @@ private:
                 m_OutputStream << "VarDecl ";
             }
 
-            m_OutputStream << std::format("\\\"{}\\\" ", symbol);
+            m_OutputStream << std::format("\\\"{}\\\" ", symbol.GetString());
             m_OutputStream << "\\l";
 
             // if (type->IsFunctionType()) {
@@ -1,11 +1,14 @@
 #include <Ancl/SymbolTable/Scope.hpp>
 
-#include <cassert>
+#include <stdexcept>
+
+#include <Ancl/SymbolTable/SymbolTable.hpp>
 
 
 namespace ast {
 
-Scope::Scope(const std::string& name): m_Name(name) {}
+Scope::Scope(SymbolTable& symbolTable, const std::string& name)
+    : m_SymbolTable(symbolTable), m_Name(name) {}
 
 std::string Scope::GetName() const {
     return m_Name;
@@ -20,6 +23,12 @@ void Scope::AddChild(Scope* child) {
     child->m_ParentScope = this;
 }
 
+void Scope::RemoveChildrenSince(size_t index) {
+    if (index < m_ChildrenScopes.size()) {
+        m_ChildrenScopes.resize(index);
+    }
+}
+
 std::vector<Scope*> Scope::GetChildrenScopes() const {
     return m_ChildrenScopes;
 }
@@ -28,33 +37,35 @@ bool Scope::IsGlobalScope() const {
     return !m_ParentScope;
 }
 
+void Scope::SetRecordScope() {
+    m_IsRecordScope = true;
+}
+
+bool Scope::IsRecordScope() const {
+    return m_IsRecordScope;
+}
+
 void Scope::AddSymbol(NamespaceType type, const Symbol& symbol, Declaration* decl) {
     m_OrderedSymbols.push_back({symbol, decl});
-    UpdateSymbol(type, symbol, decl);
+    m_SymbolTable.bind(type, symbol, this, decl);
+    m_UndoLog.emplace_back(type, symbol);
 }
 
 void Scope::UpdateSymbol(NamespaceType type, const Symbol& symbol, Declaration* decl) {
-    switch (type) {
-        case NamespaceType::Label:
-            m_LabelNamespace[symbol] = static_cast<LabelDeclaration*>(decl);
-            break;
-        case NamespaceType::Tag:
-            m_TagNamespace[symbol] = static_cast<TagDeclaration*>(decl);
-            break;
-        default:
-            m_IdentNamespace[symbol] = decl;
+    if (SymbolTable::Binding* binding = m_SymbolTable.findOwnBinding(type, symbol, this)) {
+        binding->Decl = decl;
+        return;
     }
+    m_SymbolTable.bind(type, symbol, this, decl);
+    m_UndoLog.emplace_back(type, symbol);
 }
 
 Declaration* Scope::GetSymbol(NamespaceType type, const Symbol& symbol) {
-    switch (type) {
-        case NamespaceType::Label:
-            return m_LabelNamespace.at(symbol);
-        case NamespaceType::Tag:
-            return m_TagNamespace.at(symbol);
-        default:
-            return m_IdentNamespace.at(symbol);
+    SymbolTable::Binding* binding = m_SymbolTable.findOwnBinding(type, symbol, this);
+    if (!binding) {
+        throw std::out_of_range("Symbol is not declared in the scope");
     }
+    return binding->Decl;
 }
 
 const Scope::TSymbols& Scope::GetSymbols() const {
@@ -62,42 +73,14 @@ const Scope::TSymbols& Scope::GetSymbols() const {
 }
 
 bool Scope::HasSymbol(NamespaceType type, const Symbol& symbol) const {
-    switch (type) {
-        case NamespaceType::Label:
-            return m_LabelNamespace.contains(symbol);
-        case NamespaceType::Tag:
-            return m_TagNamespace.contains(symbol);
-        default:
-            return m_IdentNamespace.contains(symbol);
-    }
+    return m_SymbolTable.findOwnBinding(type, symbol, this);
 }
 
 std::optional<Declaration*> Scope::FindSymbol(NamespaceType type, const Symbol& symbol) {
-    Scope* scope = findScopeBySymbol(type, symbol);
-    if (scope->HasSymbol(type, symbol)) {
-        return scope->GetSymbol(type, symbol);
+    if (const SymbolTable::Binding* binding = m_SymbolTable.findVisibleBinding(type, symbol, this)) {
+        return binding->Decl;
     }
     return std::nullopt;
 }
 
-Scope* Scope::findScopeBySymbol(NamespaceType type, const Symbol& symbol) {
-    Scope* scope = this;
-    while (!scope->IsGlobalScope() && !scope->HasSymbol(type, symbol)) {
-        Scope* parent = scope->GetParentScope();
-        assert(parent);
-        scope = parent;
-    }
-    return scope;
-}
-
-// INamespace& Scope::dispatch(Declaration* decl) {
-//     if (std::dynamic_cast<LabelDeclaration*>(decl)) {
-//         return m_LabelNamespace;
-//     }
-//     if (std::dynamic_cast<TagDeclaration*>(decl)) {
-//         return m_TagNamespace;
-//     }
-//     return m_IdentNamespace;
-// }
-
 }  // namespace ast
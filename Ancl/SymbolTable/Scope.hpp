@@ -2,9 +2,10 @@
 
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <Ancl/Grammar/AST/Base/Identifier.hpp>
 #include <Ancl/Grammar/AST/Declaration/Declaration.hpp>
 #include <Ancl/Grammar/AST/Declaration/LabelDeclaration.hpp>
 #include <Ancl/Grammar/AST/Declaration/TagDeclaration.hpp>
@@ -12,9 +13,13 @@
 
 namespace ast {
 
+class SymbolTable;
+
+// Symbols are stored in the flat tables of SymbolTable,
+// a scope keeps only its declaration order and the undo log
 class Scope {
 public:
-    using Symbol = std::string;
+    using Symbol = Identifier;
     using TSymbols = std::vector<std::pair<Symbol, Declaration*>>;
 
     enum class NamespaceType {
@@ -24,19 +29,23 @@ public:
     };
 
 public:
-    Scope() = default; 
-    Scope(const std::string& name);
+    Scope(SymbolTable& symbolTable, const std::string& name);
 
     std::string GetName() const;
 
     Scope* GetParentScope() const;
 
     void AddChild(Scope* child);
+    void RemoveChildrenSince(size_t index);
 
     std::vector<Scope*> GetChildrenScopes() const;
 
     bool IsGlobalScope() const;
 
+    // Record members are visible only from the record scope itself
+    void SetRecordScope();
+    bool IsRecordScope() const;
+
     void AddSymbol(NamespaceType type, const Symbol& symbol, Declaration* decl);
 
     void UpdateSymbol(NamespaceType type, const Symbol& symbol, Declaration* decl);
@@ -47,22 +56,25 @@ public:
 
     bool HasSymbol(NamespaceType type, const Symbol& symbol) const;
 
+    // Must be called on the innermost scope
     std::optional<Declaration*> FindSymbol(NamespaceType type, const Symbol& symbol);
 
 private:
-    Scope* findScopeBySymbol(NamespaceType type, const Symbol& symbol);
+    friend class SymbolTable;
+
+    SymbolTable& m_SymbolTable;
 
-private:
     std::string m_Name;
 
     Scope* m_ParentScope = nullptr;
     std::vector<Scope*> m_ChildrenScopes;
 
+    bool m_IsRecordScope = false;
+
     TSymbols m_OrderedSymbols;
 
-    std::unordered_map<Symbol, LabelDeclaration*> m_LabelNamespace;
-    std::unordered_map<Symbol, TagDeclaration*> m_TagNamespace;
-    std::unordered_map<Symbol, Declaration*> m_IdentNamespace;
+    // Bindings to remove from the symbol table when the scope is exited
+    std::vector<std::pair<NamespaceType, Symbol>> m_UndoLog;
 };
 
 }  // namespace ast
@@ -0,0 +1,69 @@
+#include <Ancl/SymbolTable/SymbolTable.hpp>
+
+#include <algorithm>
+#include <ranges>
+
+
+namespace ast {
+
+Scope* SymbolTable::ExitScope(Scope* scope) {
+    for (const auto& [type, symbol] : std::views::reverse(scope->m_UndoLog)) {
+        TBindingStack& bindings = getNamespace(type).at(symbol);
+
+        // The scope bindings are on top unless an outer scope was extended meanwhile
+        auto it = std::find_if(bindings.rbegin(), bindings.rend(), [scope](const Binding& binding) {
+            return binding.Owner == scope;
+        });
+        bindings.erase(std::next(it).base());
+    }
+    scope->m_UndoLog.clear();
+
+    return scope->GetParentScope();
+}
+
+void SymbolTable::bind(Scope::NamespaceType type, const Scope::Symbol& symbol,
+                       Scope* owner, Declaration* decl) {
+    getNamespace(type)[symbol].push_back(Binding{owner, decl});
+}
+
+SymbolTable::Binding* SymbolTable::findOwnBinding(Scope::NamespaceType type, const Scope::Symbol& symbol,
+                                                  const Scope* owner) {
+    TNamespaceTable& table = getNamespace(type);
+    auto tableIt = table.find(symbol);
+    if (tableIt == table.end()) {
+        return nullptr;
+    }
+
+    TBindingStack& bindings = tableIt->second;
+    for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+        if (it->Owner == owner) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+const SymbolTable::Binding* SymbolTable::findVisibleBinding(Scope::NamespaceType type,
+                                                            const Scope::Symbol& symbol,
+                                                            const Scope* scope) const {
+    const TNamespaceTable& table = getNamespace(type);
+    auto tableIt = table.find(symbol);
+    if (tableIt != table.end()) {
+        // Only the scopes on the path to the innermost one have bindings,
+        // except record scopes that are left to declare nested tags
+        const TBindingStack& bindings = tableIt->second;
+        for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+            if (it->Owner == scope || !it->Owner->IsRecordScope()) {
+                return &*it;
+            }
+        }
+    }
+
+    // All scopes of the frozen table are exited, only global bindings are left
+    if (m_FrozenTable) {
+        return m_FrozenTable->findVisibleBinding(type, symbol, m_FrozenTable->m_GlobalScope);
+    }
+    return nullptr;
+}
+
+}  // namespace ast
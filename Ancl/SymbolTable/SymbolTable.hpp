@@ -1,21 +1,36 @@
 #pragma once
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include <Ancl/SymbolTable/Scope.hpp>
 #include <Ancl/Tracker.hpp>
 
 
 namespace ast {
 
+// Flat scoped symbol table: every namespace maps an identifier to the stack
+// of its declarations in the entered scopes, the innermost one on top.
+// Scopes are entered by CreateScope() and exited by ExitScope(),
+// which pops the bindings recorded in the scope undo log.
 class SymbolTable {
 public:
-    SymbolTable(): m_GlobalScope(m_Tracker.Allocate<Scope>("global")) {}
+    SymbolTable(): m_GlobalScope(m_Tracker.Allocate<Scope>(*this, "global")) {}
+
+    // Table of a function body checked in parallel: names that are not
+    // declared in the body come from the global scope of `frozenTable`,
+    // which must not change while the table is in use
+    explicit SymbolTable(const SymbolTable* frozenTable)
+        : m_FrozenTable(frozenTable),
+          m_GlobalScope(m_Tracker.Allocate<Scope>(*this, "global")) {}
 
     Scope* GetGlobalScope() const {
         return m_GlobalScope;
     }
 
     Scope* CreateScope(const std::string& name = "", Scope* parent = nullptr) {
-        auto* scope = m_Tracker.Allocate<Scope>(name);
+        auto* scope = m_Tracker.Allocate<Scope>(*this, name);
         if (!parent) {
             parent = m_GlobalScope;
         }
@@ -23,9 +38,60 @@ public:
         return scope;
     }
 
+    // Returns the parent scope
+    Scope* ExitScope(Scope* scope);
+
+    // Scopes created after the mark can be released,
+    // they must form subtrees hanging off the global scope
+    struct Mark {
+        size_t ScopesNumber = 0;
+        size_t GlobalChildrenNumber = 0;
+    };
+
+    Mark GetMark() const {
+        return Mark{
+            .ScopesNumber = m_Tracker.GetAllocatedNumber(),
+            .GlobalChildrenNumber = m_GlobalScope->GetChildrenScopes().size(),
+        };
+    }
+
+    void ReleaseScopes(const Mark& mark) {
+        m_GlobalScope->RemoveChildrenSince(mark.GlobalChildrenNumber);
+        m_Tracker.DeallocateSince(mark.ScopesNumber);
+    }
+
+private:
+    friend class Scope;
+
+    struct Binding {
+        Scope* Owner;
+        Declaration* Decl;
+    };
+
+    using TBindingStack = std::vector<Binding>;
+    using TNamespaceTable = std::unordered_map<Scope::Symbol, TBindingStack>;
+
+    TNamespaceTable& getNamespace(Scope::NamespaceType type) {
+        return m_Namespaces[static_cast<size_t>(type) - 1];
+    }
+
+    const TNamespaceTable& getNamespace(Scope::NamespaceType type) const {
+        return m_Namespaces[static_cast<size_t>(type) - 1];
+    }
+
+    void bind(Scope::NamespaceType type, const Scope::Symbol& symbol, Scope* owner, Declaration* decl);
+
+    Binding* findOwnBinding(Scope::NamespaceType type, const Scope::Symbol& symbol, const Scope* owner);
+    const Binding* findVisibleBinding(Scope::NamespaceType type, const Scope::Symbol& symbol,
+                                      const Scope* scope) const;
+
 private:
+    const SymbolTable* m_FrozenTable = nullptr;
+
     Tracker<Scope> m_Tracker;
 
+    std::array<TNamespaceTable, 3> m_Namespaces;
+
     Scope* m_GlobalScope;
 };
 
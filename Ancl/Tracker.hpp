@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 
 template <typename T>
 class Tracker {
@@ -21,16 +26,54 @@ public:
         static_assert(std::is_base_of_v<T, U>);
         U* result = new U(args...);
         m_Allocated.push_back(result);
+        m_AllocatedSizes.push_back(sizeof(U));
+        m_AllocatedBytes += sizeof(U);
         return result;
     }
 
+    size_t GetAllocatedNumber() const {
+        return m_Allocated.size();
+    }
+
+    // Size of the tracked objects themselves, their own heap buffers are not counted
+    size_t GetAllocatedBytes() const {
+        return m_AllocatedBytes;
+    }
+
+    // Deallocates entries allocated after the first `mark` ones
+    // that satisfy the predicate, the remaining entries keep their order
+    template<typename TPredicate>
+    void DeallocateSince(size_t mark, TPredicate predicate) {
+        size_t keptEnd = mark;
+        for (size_t i = mark; i < m_Allocated.size(); ++i) {
+            if (predicate(m_Allocated[i])) {
+                delete m_Allocated[i];
+                m_AllocatedBytes -= m_AllocatedSizes[i];
+            } else {
+                m_Allocated[keptEnd] = m_Allocated[i];
+                m_AllocatedSizes[keptEnd] = m_AllocatedSizes[i];
+                ++keptEnd;
+            }
+        }
+        m_Allocated.resize(keptEnd);
+        m_AllocatedSizes.resize(keptEnd);
+    }
+
+    void DeallocateSince(size_t mark) {
+        DeallocateSince(mark, [](T*) { return true; });
+    }
+
     void DeallocateAll() {
         for (T* entry : m_Allocated) {
             delete entry;
         }
         m_Allocated.clear();
+        m_AllocatedSizes.clear();
+        m_AllocatedBytes = 0;
     }
 
 private:
     std::vector<T*> m_Allocated;
+    std::vector<uint32_t> m_AllocatedSizes;
+    size_t m_AllocatedBytes = 0;
 };
@@ -4,6 +4,7 @@
 #include <format>
 
 #include <Ancl/Grammar/AST/AST.hpp>
+#include <Ancl/Grammar/AST/Base/SourceManager.hpp>
 #include <Ancl/Visitor/AstVisitor.hpp>
 
 
@@ -11,7 +12,8 @@ namespace ast {
 
 class AstDotVisitor: public AstVisitor {
 public:
-    AstDotVisitor(const std::string& filename): m_OutputStream(filename) {}
+    AstDotVisitor(const std::string& filename, const SourceManager& sourceManager)
+        : m_OutputStream(filename), m_SourceManager(sourceManager) {}
 
 public:
     /*
@@ -28,7 +30,7 @@ public:
         printNode("enumconst_declaration",
                   std::format("EnumConstDecl [\\\"{}\\\"]",
                               enumConstDecl.GetName()),
-                  enumConstDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(enumConstDecl.GetLocation()));
 
         if (enumConstDecl.HasInit()) {
             acceptNode(enumConstDecl.GetInit(), "Init");
@@ -39,7 +41,7 @@ public:
         printNode("enum_declaration",
                   std::format("EnumDecl [\\\"{}\\\"]",
                               enumDecl.GetName()),
-                  enumDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(enumDecl.GetLocation()));
 
         acceptNodeList(enumDecl.GetEnumerators(), "Enumerator");
     }
@@ -48,7 +50,7 @@ public:
         printNode("field_declaration",
                   std::format("FieldDecl [\\\"{}\\\"]",
                               fieldDecl.GetName()),
-                  fieldDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(fieldDecl.GetLocation()));
 
         // acceptQualType(fieldDecl.GetType(), "Type");
     }
@@ -77,7 +79,7 @@ public:
         printNode("function_declaration",
                   std::format("FunctionDecl [\\\"{}\\\"{}]",
                               funcDecl.GetName(), traitsStr),
-                  funcDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(funcDecl.GetLocation()));
     
         auto body = funcDecl.GetBody();
         if (body) {
@@ -92,7 +94,7 @@ public:
         printNode("label_declaration",
                   std::format("LabelDecl [\\\"{}\\\"]",
                               labelDecl.GetName()),
-                  labelDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(labelDecl.GetLocation()));
 
         acceptNode(labelDecl.GetStatement(), "Statement");
     }
@@ -112,7 +114,7 @@ public:
         printNode("parameter_declaration",
                   std::format("ParameterDecl [\\\"{}\\\"{}]",
                               paramDecl.GetName(), traitsStr),
-                  paramDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(paramDecl.GetLocation()));
 
         acceptQualType(paramDecl.GetType(), "Type");
     }
@@ -125,7 +127,7 @@ public:
         printNode("record_declaration",
                   std::format("RecordDecl [\\\"{}\\\"{}]",
                               recordDecl.GetName(), traitsStr),
-                  recordDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(recordDecl.GetLocation()));
 
         acceptNodeList(recordDecl.GetInternalDecls(), "InternalDecl");
     }
@@ -162,7 +164,7 @@ public:
         printNode("typedef_declaration",
                   std::format("TypedefDecl [\\\"{}\\\"]",
                               typedefDecl.GetName()),
-                  typedefDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(typedefDecl.GetLocation()));
 
         acceptQualType(typedefDecl.GetType(), "Type");
     }
@@ -172,7 +174,7 @@ public:
         printNode("value_declaration",
                   std::format("ValueDecl [\\\"{}\\\"]",
                               valueDecl.GetName()),
-                  valueDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(valueDecl.GetLocation()));
     }
 
     void Visit(VariableDeclaration& varDecl) override {
@@ -196,7 +198,7 @@ public:
         printNode("variable_declaration",
                   std::format("VariableDecl [\\\"{}\\\"{}]",
                               varDecl.GetName(), traitsStr),
-                  varDecl.GetLocation().ToString());
+                  m_SourceManager.ToString(varDecl.GetLocation()));
 
         acceptQualType(varDecl.GetType(), "Type");
 
@@ -219,7 +221,7 @@ public:
 
     void Visit(CaseStatement& caseStmt) override {
         printNode("case_statement", "CaseStmt",
-                  caseStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(caseStmt.GetLocation()));
 
         acceptNode(caseStmt.GetExpression(), "ConstExpr");
         acceptNode(caseStmt.GetBody(), "Body");
@@ -227,28 +229,28 @@ public:
 
     void Visit(CompoundStatement& compoundStmt) override {
         printNode("compound_statement", "CompoundStmt",
-                  compoundStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(compoundStmt.GetLocation()));
 
         acceptNodeList(compoundStmt.GetBody(), "Stmt");
     }
 
     void Visit(DeclStatement& declStmt) override {
         printNode("decl_statement", "DeclStmt",
-                  declStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(declStmt.GetLocation()));
 
         acceptNodeList(declStmt.GetDeclarations(), "Decl");
     }
 
     void Visit(DefaultStatement& defaultStmt) override {
         printNode("default_statement", "DefaultStmt",
-                  defaultStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(defaultStmt.GetLocation()));
 
         acceptNode(defaultStmt.GetBody(), "Body");
     }
 
     void Visit(DoStatement& doStmt) override {
         printNode("do_statement", "DoStmt",
-                  doStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(doStmt.GetLocation()));
 
         acceptNode(doStmt.GetCondition(), "Condition");
         acceptNode(doStmt.GetBody(), "Body");
@@ -256,7 +258,7 @@ public:
 
     void Visit(ForStatement& forStmt) override {
         printNode("for_statement", "ForStmt",
-                  forStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(forStmt.GetLocation()));
 
         if (forStmt.HasInit()) {
             acceptNode(forStmt.GetInit(), "Init");
@@ -275,14 +277,14 @@ public:
 
     void Visit(GotoStatement& gotoStmt) override {
         printNode("goto_statement", "GotoStmt",
-                  gotoStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(gotoStmt.GetLocation()));
 
         acceptNode(gotoStmt.GetLabel(), "Label");
     }
 
     void Visit(IfStatement& ifStmt) override {
         printNode("if_statement", "IfStmt",
-                  ifStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(ifStmt.GetLocation()));
 
         acceptNode(ifStmt.GetCondition(), "Condition");
         acceptNode(ifStmt.GetThen(), "Then");
@@ -293,7 +295,7 @@ public:
 
     void Visit(LabelStatement& labelStmt) override {
         printNode("label_statement", "LabelStmt",
-                  labelStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(labelStmt.GetLocation()));
 
         acceptNode(labelStmt.GetLabel(), "Label");
         acceptNode(labelStmt.GetBody(), "Body");
@@ -303,12 +305,12 @@ public:
         auto typeStr = loopJmpStmt.GetTypeStr();
         printNode("loopjump_statement",
                   std::format("LoopJumpStmt [{}]", typeStr),
-                  loopJmpStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(loopJmpStmt.GetLocation()));
     }
 
     void Visit(ReturnStatement& returnStmt) override {
         printNode("return_statement", "ReturnStmt",
-                  returnStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(returnStmt.GetLocation()));
 
         if (returnStmt.HasReturnExpression()) {
             acceptNode(returnStmt.GetReturnExpression(), "ReturnExpr");
@@ -321,7 +323,7 @@ public:
 
     void Visit(SwitchStatement& switchStmt) override {
         printNode("switch_statement", "SwitchStmt",
-                  switchStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(switchStmt.GetLocation()));
 
         acceptNode(switchStmt.GetExpression(), "Expr");
         acceptNode(switchStmt.GetBody(), "Body");
@@ -333,7 +335,7 @@ public:
 
     void Visit(WhileStatement& whileStmt) override {
         printNode("while_statement", "WhileStmt",
-                  whileStmt.GetLocation().ToString());
+                  m_SourceManager.ToString(whileStmt.GetLocation()));
 
         acceptNode(whileStmt.GetCondition(), "Condition");
         acceptNode(whileStmt.GetBody(), "Body");
@@ -354,7 +356,7 @@ public:
         auto opTypeStr = binaryExpr.GetOpTypeStr();
         printNode("binary_expression",
                   std::format("BinaryExpr [\\{}]", opTypeStr),
-                  binaryExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(binaryExpr.GetLocation()));
 
         acceptNode(binaryExpr.GetLeftOperand(), "LeftOperand");
         acceptNode(binaryExpr.GetRightOperand(), "RightOperand");
@@ -362,7 +364,7 @@ public:
 
     void Visit(CallExpression& callExpr) override {
         printNode("call_expression", "CallExpr",
-                  callExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(callExpr.GetLocation()));
 
         acceptNode(callExpr.GetCallee(), "Callee");
         acceptNodeList(callExpr.GetArguments(), "Arg");
@@ -371,11 +373,11 @@ public:
     void Visit(CastExpression& castExpr) override {
         if (castExpr.IsLValueToRValue()) {
             printNode("cast_expression", "LValueToRValue",
-                      castExpr.GetLocation().ToString());
+                      m_SourceManager.ToString(castExpr.GetLocation()));
             acceptNode(castExpr.GetSubExpression(), "SubExpr");
         } else {
             printNode("cast_expression", "CastExpr",
-                      castExpr.GetLocation().ToString());
+                      m_SourceManager.ToString(castExpr.GetLocation()));
             acceptNode(castExpr.GetSubExpression(), "SubExpr");
             acceptQualType(castExpr.GetToType(), "ToType");
         }
@@ -385,12 +387,12 @@ public:
         printNode("char_expression",
                   std::format("CharExpression ['{}']",
                               charExpr.GetCharValue()),
-                  charExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(charExpr.GetLocation()));
     }
 
     void Visit(ConditionalExpression& condExpr) override {
         printNode("conditional_expression", "CondExpr",
-                  condExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(condExpr.GetLocation()));
     
         acceptNode(condExpr.GetCondition(), "Condition");
         acceptNode(condExpr.GetTrueExpression(), "TrueExpr");
@@ -399,7 +401,7 @@ public:
 
     void Visit(ConstExpression& constExpr) override {
         printNode("const_expression", "ConstExpr",
-                  constExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(constExpr.GetLocation()));
 
         acceptNode(constExpr.GetExpression(), "Expr");
     }
@@ -408,14 +410,14 @@ public:
         ValueDeclaration* decl = declrefExpr.GetDeclaration();
 
         printNode("declref_expression", std::format("DeclRefExpr [{}]", decl->GetName()),
-                  declrefExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(declrefExpr.GetLocation()));
 
         // acceptNode(declrefExpr.GetDeclaration(), "Decl");
     }
 
     void Visit(ExpressionList& exprList) override {
         printNode("expression_list", "ExprList",
-                  exprList.GetLocation().ToString());
+                  m_SourceManager.ToString(exprList.GetLocation()));
 
         acceptNodeList(exprList.GetExpressions(), "Expr");
     }
@@ -425,12 +427,12 @@ public:
         printNode("float_expression",
                   std::format("FloatExpr [{}]",
                               floatValue.GetValue()),
-                  floatExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(floatExpr.GetLocation()));
     }
 
     void Visit(InitializerList& initList) override {
         printNode("initializer_list", "InitList",
-                  initList.GetLocation().ToString());
+                  m_SourceManager.ToString(initList.GetLocation()));
 
         acceptNodeList(initList.GetInits(), "Init");
     }
@@ -444,12 +446,12 @@ public:
         printNode("int_expression",
                   std::format("IntExpr [{},{}]",
                               intValue.GetSignedValue(), sign),
-                  intExpr.GetLocation().ToString()); 
+                  m_SourceManager.ToString(intExpr.GetLocation())); 
     }
 
     void Visit(SizeofTypeExpression& sizeofTypeExpr) override {
         printNode("sizeoftype_expression", "SizeofTypeExpr",
-                  sizeofTypeExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(sizeofTypeExpr.GetLocation()));
 
         acceptQualType(sizeofTypeExpr.GetType(), "Type");
     }
@@ -458,14 +460,14 @@ public:
         printNode("string_expression",
                   std::format("StringExpr [\\\"{}\\\"]",
                               stringExpr.GetStringValue()),
-                  stringExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(stringExpr.GetLocation()));
     }
 
     void Visit(UnaryExpression& unaryExpr) override {
         auto opTypeStr = unaryExpr.GetOpTypeStr();
         printNode("unary_expression",
                   std::format("UnaryExpr [{}]", opTypeStr),
-                  unaryExpr.GetLocation().ToString());
+                  m_SourceManager.ToString(unaryExpr.GetLocation()));
 
         acceptNode(unaryExpr.GetOperand(), "Operand");
     }
@@ -647,6 +649,7 @@ private:
 
 private:
     std::ofstream m_OutputStream;
+    const SourceManager& m_SourceManager;
     size_t m_SpaceLevel = 0;
 
     const std::string m_GraphName = "program";
@@ -1,5 +1,7 @@
 #include <Ancl/Visitor/BuildAstVisitor.hpp>
 
+#include <format>
+
 using namespace ast;
 
 
@@ -9,7 +11,7 @@ namespace anclgrammar {
 std::any BuildAstVisitor::visitPrimaryExpression(CParser::PrimaryExpressionContext* ctx) {
     if (ctx->Identifier()) {
         std::string name = ctx->getText();
-        auto* valueDecl = m_Program.CreateAstNode<ValueDeclaration>(name);
+        auto* valueDecl = m_Program.CreateAstNode<ValueDeclaration>(m_Program.GetIdentifier(name));
         auto* declExpression = m_Program.CreateAstNode<DeclRefExpression>(valueDecl);
         declExpression->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
         return static_cast<Expression*>(declExpression);
@@ -129,7 +131,7 @@ std::any BuildAstVisitor::visitPostfixExpression(CParser::PostfixExpressionConte
 
     if (ctx->tag) {
         std::string name = ctx->Identifier()->getText();
-        auto* memberDecl = m_Program.CreateAstNode<FieldDeclaration>(name);
+        auto* memberDecl = m_Program.CreateAstNode<FieldDeclaration>(m_Program.GetIdentifier(name));
         auto* memberExpression = m_Program.CreateAstNode<DeclRefExpression>(memberDecl);
         memberExpression->SetLocation(m_LocationBuilder.CreateASTLocation(ctx->Identifier()));
 
@@ -737,7 +739,7 @@ std::any BuildAstVisitor::visitTypeSpecifier(CParser::TypeSpecifierContext* ctx)
     if (ctx->typedefname) {
         std::string name = ctx->typedefname->getText();
         auto* typedefDecl = m_Program.CreateAstNode<TypedefDeclaration>();
-        typedefDecl->SetName(name);
+        typedefDecl->SetName(m_Program.GetIdentifier(name));
         auto* typedefType = m_Program.CreateType<TypedefType>(typedefDecl);
         return static_cast<Type*>(typedefType);
     }
@@ -807,7 +809,7 @@ std::any BuildAstVisitor::visitStructOrUnionSpecifier(CParser::StructOrUnionSpec
 
     auto* recordType = m_Program.CreateType<RecordType>(recordDecl);
     QualType recordQualType{recordType};
-    recordDecl->SetName(name);
+    recordDecl->SetName(m_Program.GetIdentifier(name));
     recordDecl->SetType(recordQualType);
 
     return recordType;
@@ -830,7 +832,7 @@ std::any BuildAstVisitor::visitStructDeclarationList(CParser::StructDeclarationL
                                    varDecl->GetLocation());
             }
 
-            fieldDecl = m_Program.CreateAstNode<FieldDeclaration>(varDecl->GetName(),
+            fieldDecl = m_Program.CreateAstNode<FieldDeclaration>(varDecl->GetIdentifier(),
                                                                   varDecl->GetType());
             fieldDecl->SetLocation(m_LocationBuilder.CreateASTLocation(declCtx));
         }
@@ -956,7 +958,7 @@ std::any BuildAstVisitor::visitEnumSpecifier(CParser::EnumSpecifierContext* ctx)
 
     auto* enumDecl = m_Program.CreateAstNode<EnumDeclaration>(enumerators, ctx->enumerators);
     enumDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
-    enumDecl->SetName(name);
+    enumDecl->SetName(m_Program.GetIdentifier(name));
 
     auto* enumType = m_Program.CreateType<EnumType>(enumDecl);
     QualType enumQualType{enumType};
@@ -994,7 +996,7 @@ std::any BuildAstVisitor::visitEnumerator(CParser::EnumeratorContext* ctx) {
 
     auto* enumConstDecl = m_Program.CreateAstNode<EnumConstDeclaration>(init);
     enumConstDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
-    enumConstDecl->SetName(name);
+    enumConstDecl->SetName(m_Program.GetIdentifier(name));
 
     auto* intType = m_Program.CreateType<BuiltinType>(BuiltinType::Kind::kInt);
     QualType intQualType{intType};
@@ -1122,7 +1124,7 @@ std::any BuildAstVisitor::visitDirectDeclarator(CParser::DirectDeclaratorContext
             auto* funcDecl = m_Program.CreateAstNode<FunctionDeclaration>();
             funcDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
 
-            funcDecl->SetName(declInfo.Identifier);
+            funcDecl->SetName(m_Program.GetIdentifier(declInfo.Identifier));
             funcDecl->SetType(funQualType);
 
             declInfo.FunctionDecl = funcDecl;
@@ -1473,7 +1475,7 @@ std::any BuildAstVisitor::visitLabeledStatement(CParser::LabeledStatementContext
         auto* labelDecl = m_Program.CreateAstNode<LabelDeclaration>();
         labelDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx->Identifier()));
         std::string name = ctx->Identifier()->getText();
-        labelDecl->SetName(name);
+        labelDecl->SetName(m_Program.GetIdentifier(name));
 
         Statement* statement = nullptr;
         if (ctx->statement()) {
@@ -1726,7 +1728,7 @@ std::any BuildAstVisitor::visitJumpStatement(CParser::JumpStatementContext* ctx)
     if (ctx->Goto()) {
         auto* labelDecl = m_Program.CreateAstNode<LabelDeclaration>();
         std::string name = ctx->Identifier()->getText();
-        labelDecl->SetName(name);
+        labelDecl->SetName(m_Program.GetIdentifier(name));
         auto* gotoStmt = m_Program.CreateAstNode<GotoStatement>(labelDecl);
         gotoStmt->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
         return static_cast<Statement*>(gotoStmt);
@@ -1779,6 +1781,31 @@ std::any BuildAstVisitor::visitTranslationUnit(CParser::TranslationUnitContext*
     return nullptr;
 }
 
+std::vector<Declaration*> BuildAstVisitor::BuildExternalDeclaration(CParser::ExternalDeclarationContext* ctx) {
+    TranslationUnit* translationUnit = m_Program.GetTranslationUnit();
+    if (!translationUnit) {
+        translationUnit = m_Program.CreateAstNode<TranslationUnit>();
+        m_Program.SetTranslationUnit(translationUnit);
+    }
+
+    std::any declarationAny = visitExternalDeclaration(ctx);
+    DeclarationInfo declarationInfo = std::any_cast<DeclarationInfo>(declarationAny);
+
+    std::vector<Declaration*> decls;
+    if (declarationInfo.TagPreDecl) {
+        decls.push_back(declarationInfo.TagPreDecl);
+    }
+    if (declarationInfo.Decl) {
+        decls.push_back(declarationInfo.Decl);
+    }
+
+    for (Declaration* decl : decls) {
+        translationUnit->AddDeclaration(decl);
+    }
+
+    return decls;
+}
+
 // Returns DeclarationInfo
 std::any BuildAstVisitor::visitFunctionDefinition(CParser::FunctionDefinitionContext* ctx) {
     std::any declSpecsAny = visitDeclarationSpecifiers(ctx->declspecs);
@@ -1806,7 +1833,10 @@ std::any BuildAstVisitor::visitFunctionDefinition(CParser::FunctionDefinitionCon
         }
     }
 
+    m_Program.BeginFunctionBody();
     std::any bodyAny = visitCompoundStatement(ctx->body);
+    m_Program.EndFunctionBody();
+
     auto* body = std::any_cast<Statement*>(bodyAny);
     functionDecl->SetBody(body);
 
@@ -1874,7 +1904,7 @@ BuildAstVisitor::DeclarationInfo BuildAstVisitor::createDeclaration(
                                    initDecl.Init->GetLocation());
             }
 
-            typedefDecl->SetName(declInfo.Identifier);
+            typedefDecl->SetName(m_Program.GetIdentifier(declInfo.Identifier));
             typedefDecl->SetType(declInfo.HeadType);
 
             resInfo.Decl = typedefDecl;
@@ -1915,7 +1945,7 @@ BuildAstVisitor::DeclarationInfo BuildAstVisitor::createDeclaration(
                 auto* paramDecl = m_Program.CreateAstNode<ParameterDeclaration>();
                 paramDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
 
-                paramDecl->SetName(declInfo.Identifier);
+                paramDecl->SetName(m_Program.GetIdentifier(declInfo.Identifier));
 
                 // void fun(int (int)) -> void fun(int (*)(int));
                 if (dynamic_cast<FunctionType*>(declInfo.HeadType.GetSubType())) {
@@ -1956,7 +1986,7 @@ BuildAstVisitor::DeclarationInfo BuildAstVisitor::createDeclaration(
                 auto* varDecl = m_Program.CreateAstNode<VariableDeclaration>();
                 varDecl->SetLocation(m_LocationBuilder.CreateASTLocation(ctx));
 
-                varDecl->SetName(declInfo.Identifier);
+                varDecl->SetName(m_Program.GetIdentifier(declInfo.Identifier));
                 varDecl->SetType(declInfo.HeadType);
                 varDecl->SetInit(initDecl.Init);
 
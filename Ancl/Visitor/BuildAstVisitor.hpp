@@ -14,9 +14,9 @@ class BuildAstVisitor: public CParserBaseVisitor {
 public:
     BuildAstVisitor(ast::ASTProgram& program): m_Program(program) {}
 
-    void setLineTokens(const std::vector<antlr4::Token*>& lineTokens) {
-        m_LocationBuilder.SetLineTokens(lineTokens);
-    }
+    // Streaming compilation: appends one external declaration to the translation unit
+    // and returns the declarations it introduces
+    std::vector<ast::Declaration*> BuildExternalDeclaration(CParser::ExternalDeclarationContext* ctx);
 
 public:
     std::any visitPrimaryExpression(CParser::PrimaryExpressionContext* ctx) override;
@@ -268,11 +268,11 @@ private:
 
 private:
     void printSemanticWarning(const std::string& text, const Location& location) {
-        ANCL_WARN("{} {}", location.ToString(), text);
+        ANCL_WARN("{} {}", m_Program.GetSourceManager().ToString(location), text);
     }
 
     void printSemanticError(const std::string& text, const Location& location) {
-        ANCL_ERROR("{} {}", location.ToString(), text);
+        ANCL_ERROR("{} {}", m_Program.GetSourceManager().ToString(location), text);
 
         // TODO: Handle error
         throw std::runtime_error("Semantic error");
@@ -281,63 +281,17 @@ private:
 
     class ASTLocationBuilder {
     public:
-        ASTLocationBuilder() = default;
-
-        ASTLocationBuilder(const std::vector<antlr4::Token*>& lineTokens)
-            : m_LineTokens(m_LineTokens) {}
-
-        void SetLineTokens(const std::vector<antlr4::Token*>& lineTokens) {
-            m_LineTokens = lineTokens;
-        }
-
         Location CreateASTLocation(antlr4::tree::TerminalNode* node) {
             antlr4::Token* token = node->getSymbol();
-            size_t line = token->getLine();
-            size_t column = token->getCharPositionInLine() + 1;
-
-            std::string sourceName = getLocationFileName(token->getTokenIndex());
-            Position start(sourceName, line, column);
-            Position stop(sourceName, line, column);
-            return Location(std::move(start), std::move(stop));
+            auto offset = static_cast<uint32_t>(token->getStartIndex());
+            return Location(offset, offset);
         }
 
         Location CreateASTLocation(antlr4::ParserRuleContext* ctx) {
-            antlr4::Token* startToken = ctx->getStart();
-            size_t startLine = startToken->getLine();
-            size_t startColumn = startToken->getCharPositionInLine() + 1;
-
-            antlr4::Token* stopToken = ctx->getStop();
-            size_t stopLine = stopToken->getLine();
-            size_t stopColumn = stopToken->getCharPositionInLine() + 1;
-
-            std::string sourceName = getLocationFileName(startToken->getTokenIndex());
-            Position start(sourceName, startLine, startColumn);
-            Position stop(sourceName, stopLine, stopColumn);
-            return Location(std::move(start), std::move(stop));
-        }
-
-    private:
-        std::string getLocationFileName(size_t tokenIndex) {
-            if (m_LineTokens.empty()) {
-                return "unknown";
-            }
-
-            antlr4::Token* lineToken = m_LineTokens[m_LineTokenIndex];
-            size_t lineIndex = lineToken->getTokenIndex();
-            while (m_LineTokenIndex + 1 < m_LineTokens.size() && tokenIndex > lineIndex) {
-                lineToken = m_LineTokens[m_LineTokenIndex + 1];
-                lineIndex = lineToken->getTokenIndex();
-                if (tokenIndex > lineIndex) {
-                    ++m_LineTokenIndex;
-                }
-            }
-
-            return m_LineTokens[m_LineTokenIndex]->getText();
+            auto startOffset = static_cast<uint32_t>(ctx->getStart()->getStartIndex());
+            auto stopOffset = static_cast<uint32_t>(ctx->getStop()->getStartIndex());
+            return Location(startOffset, stopOffset);
         }
-
-    private:
-        std::vector<antlr4::Token*> m_LineTokens;
-        size_t m_LineTokenIndex = 0;
     };
 
 private:
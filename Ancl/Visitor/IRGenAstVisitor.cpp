@@ -1,5 +1,8 @@
 #include <Ancl/Visitor/IRGenAstVisitor.hpp>
 
+#include <algorithm>
+#include <format>
+
 #include <Ancl/DataLayout/Alignment.hpp>
 #include <Ancl/Logger/Logger.hpp>
 
@@ -10,10 +13,53 @@ IRGenAstVisitor::IRGenAstVisitor(ir::IRProgram& irProgram)
     : m_IRProgram(irProgram),
       m_Constexpr(irProgram) {}
 
+IRGenAstVisitor::IRGenAstVisitor(ir::IRProgram& irProgram, const IRGenAstVisitor& globalVisitor)
+    : m_IRProgram(irProgram),
+      m_Constexpr(irProgram),
+      m_StructTypesMap(globalVisitor.m_StructTypesMap),
+      m_StructTypesNumber(globalVisitor.m_StructTypesNumber),
+      m_IsBodyWorker(true),
+      m_BuildSSA(globalVisitor.m_BuildSSA) {}
+
 void IRGenAstVisitor::Run(const ASTProgram& astProgram) {
     Visit(*astProgram.GetTranslationUnit());
 }
 
+void IRGenAstVisitor::Run(Declaration& decl) {
+    decl.Accept(*this);
+}
+
+void IRGenAstVisitor::RunDeclarations(const ASTProgram& astProgram,
+                                      std::vector<FunctionDefinition>& definitions) {
+    m_DeferredDefinitions = &definitions;
+    Visit(*astProgram.GetTranslationUnit());
+    m_DeferredDefinitions = nullptr;
+}
+
+void IRGenAstVisitor::RunFunctionBody(const FunctionDefinition& definition) {
+    generateFunction(*definition.Declaration, definition.Function);
+}
+
+void IRGenAstVisitor::MergeFunctionBody() {
+    for (ir::Function* function : m_PendingFunctions) {
+        m_IRProgram.AddFunction(function);
+    }
+    m_PendingFunctions.clear();
+
+    for (ir::GlobalVariable* globalVar : m_PendingGlobalVars) {
+        // String literals are labeled here, so the numbering follows the source order
+        if (!globalVar->HasName()) {
+            globalVar->SetName(m_IRProgram.CreateStringLabel());
+        }
+        m_IRProgram.AddGlobalVar(globalVar);
+    }
+    m_PendingGlobalVars.clear();
+}
+
+void IRGenAstVisitor::SetBuildSSA(bool buildSSA) {
+    m_BuildSSA = buildSSA;
+}
+
 
 /*
 =================================================================
@@ -22,6 +68,17 @@ void IRGenAstVisitor::Run(const ASTProgram& astProgram) {
 */
 
 void IRGenAstVisitor::Visit(FunctionDeclaration& funcDecl) {
+    ir::Function* functionValue = createFunction(funcDecl);
+
+    if (m_DeferredDefinitions && funcDecl.IsDefinition()) {
+        m_DeferredDefinitions->push_back(FunctionDefinition{&funcDecl, functionValue});
+        return;
+    }
+
+    generateFunction(funcDecl, functionValue);
+}
+
+ir::Function* IRGenAstVisitor::createFunction(FunctionDeclaration& funcDecl) {
     ir::Type* irType = VisitQualType(funcDecl.GetType());
     auto* funcIRType = dynamic_cast<ir::FunctionType*>(irType);
     assert(funcIRType);
@@ -38,23 +95,35 @@ void IRGenAstVisitor::Visit(FunctionDeclaration& funcDecl) {
     auto* functionValue = m_IRProgram.CreateValue<ir::Function>(
         funcIRType, linkage, funcDecl.GetName()
     );
-    m_CurrentFunction = functionValue;
 
     if (!funcDecl.IsDefinition()) {
         functionValue->SetDeclaration();
-    } else {
-        m_CurrentBB = createBasicBlock(funcDecl.GetName());
     }
-    m_IRProgram.AddFunction(functionValue);
-
-    for (ParameterDeclaration* param : funcDecl.GetParams()) {
-        param->Accept(*this);
+    if (funcDecl.IsInline()) {
+        functionValue->SetInline();
     }
+    addFunction(functionValue);
 
     if (funcDecl.IsVariadic()) {
         funcIRType->SetVariadic();
     }
 
+    return functionValue;
+}
+
+void IRGenAstVisitor::generateFunction(FunctionDeclaration& funcDecl, ir::Function* function) {
+    auto* funcIRType = static_cast<ir::FunctionType*>(function->GetType());
+
+    m_CurrentFunction = function;
+    if (funcDecl.IsDefinition()) {
+        m_CurrentBB = createBasicBlock(funcDecl.GetName());
+        sealBlock(m_CurrentBB);
+    }
+
+    for (ParameterDeclaration* param : funcDecl.GetParams()) {
+        param->Accept(*this);
+    }
+
     Statement* body = funcDecl.GetBody();
     if (body) {
         body->Accept(*this);
@@ -77,6 +146,8 @@ void IRGenAstVisitor::Visit(FunctionDeclaration& funcDecl) {
             }
 
             m_CurrentFunction->SetLastBlock(retBlockIdx);
+        } else if (m_BuildSSA && isSSAType(funcIRType->GetReturnType())) {
+            generateSSAReturnBlock(funcIRType->GetReturnType());
         } else {
             ir::AllocaInstruction* retValueAlloca = nullptr;
             if (!dynamic_cast<ir::VoidType*>(funcIRType->GetReturnType())) {
@@ -121,6 +192,10 @@ void IRGenAstVisitor::Visit(FunctionDeclaration& funcDecl) {
             }
         }
 
+        if (m_BuildSSA) {
+            finishSSA();
+        }
+
         resetFunctionData();
     }
 }
@@ -168,11 +243,26 @@ void IRGenAstVisitor::Visit(ParameterDeclaration& paramDecl) {
     auto* alloca = m_IRProgram.CreateValue<ir::AllocaInstruction>(
             paramIRType, mangledName, m_CurrentBB);
     m_AllocasMap[&paramDecl] = alloca;
-    m_AllocaBuffer.push(alloca);
+    addLocalAlloca(alloca, !isVolatileParam && !paramDecl.IsAddressTaken());
 
     createStoreInstruction(paramValue, alloca, isVolatileParam);
 }
 
+void IRGenAstVisitor::Visit(RecordDeclaration& recordDecl) {
+    // Local struct types are forgotten with the function,
+    // its declarations may be released right after it
+    if (!m_CurrentBB) {
+        return;
+    }
+
+    m_LocalRecords.push_back(&recordDecl);
+    for (Declaration* decl : recordDecl.GetInternalDecls()) {
+        if (auto* internalRecordDecl = dynamic_cast<RecordDeclaration*>(decl)) {
+            internalRecordDecl->Accept(*this);
+        }
+    }
+}
+
 void IRGenAstVisitor::Visit(TranslationUnit& unit) {
     for (Declaration* decl : unit.GetDeclarations()) {
         decl->Accept(*this);
@@ -200,7 +290,7 @@ void IRGenAstVisitor::Visit(VariableDeclaration& varDecl) {
             ptrType, linkage, name
         );
         globalVar->SetConst(m_IsConstVar);
-        m_IRProgram.AddGlobalVar(globalVar);
+        addGlobalVar(globalVar);
     } else if (storageClass == StorageClass::kStatic) {
         std::string mangledName = std::format("{}.{}", m_CurrentFunction->GetName(), name);
         auto* ptrType = ir::PointerType::Create(varIRType);
@@ -208,23 +298,29 @@ void IRGenAstVisitor::Visit(VariableDeclaration& varDecl) {
             ptrType, ir::GlobalValue::LinkageType::kStatic, mangledName
         );
         globalVar->SetConst(m_IsConstVar);
-        m_IRProgram.AddGlobalVar(globalVar);     
+        addGlobalVar(globalVar);
     } else {  // Local variable
         auto* alloca = m_IRProgram.CreateValue<ir::AllocaInstruction>(
             varIRType, name, m_CurrentBB
         );
         m_AllocasMap[&varDecl] = alloca;
-        m_AllocaBuffer.push(alloca);
+        addLocalAlloca(alloca, !isVolatileVar && !varDecl.IsAddressTaken());
 
         if (!init) {
             return;
         }
 
-        if (auto* structType = dynamic_cast<ir::StructType*>(varIRType)) {
-            // TODO: memcpy for init list and init struct (memset for zero init)
-            ANCL_CRITICAL("Struct/Union initialization is not implemented :(");
-            throw std::runtime_error("Not implemented error");
-            // exit(EXIT_FAILURE);
+        if (auto* initList = dynamic_cast<InitializerList*>(init)) {
+            // Aggregates are zeroed first, the elements without an initializer stay zero
+            if (!isSSAVariable(alloca)) {
+                createMemorySetInstruction(alloca, 0, ir::Alignment::GetTypeSize(varIRType));
+            }
+            generateInitializerList(alloca, *initList, isVolatileVar);
+            return;
+        }
+
+        if (dynamic_cast<ir::StructType*>(varIRType)) {
+            generateInitializer(alloca, init, isVolatileVar, /*isZeroed=*/false);
         } else if (auto* arrayType = dynamic_cast<ir::ArrayType*>(varIRType)) {
             if (auto* stringExpr = dynamic_cast<StringExpression*>(init)) {
                 std::string labelName = std::format(".L__const.{}.{}",
@@ -238,7 +334,7 @@ void IRGenAstVisitor::Visit(VariableDeclaration& varDecl) {
                 globalVar->SetInitString(initString);
                 globalVar->SetConst(true);
 
-                m_IRProgram.AddGlobalVar(globalVar);
+                addGlobalVar(globalVar);
 
                 createMemoryCopyInstruction(alloca, globalVar, initString.size() + 1);
             } else {
@@ -310,8 +406,18 @@ void IRGenAstVisitor::Visit(VariableDeclaration& varDecl) {
 */
 
 void IRGenAstVisitor::Visit(CaseStatement& caseStmt) {
-    // TODO: ...
-    ANCL_CRITICAL("IRGen: Switch case is not implemented :(");
+    ir::SwitchInstruction* switchInstr = m_SwitchStack.top().Switch;
+    ir::Type* switchType = switchInstr->GetValue()->GetType();
+
+    auto* constValue = static_cast<ir::Constant*>(Accept(*caseStmt.GetExpression()));
+    auto* caseValue = static_cast<ir::IntConstant*>(m_Constexpr.EvaluateCastConstExpr(constValue, switchType));
+
+    ir::BasicBlock* caseBB = generateSwitchLabelBlock("sw.case");
+    switchInstr->AddCase({caseValue, caseBB});
+    sealBlock(caseBB);
+
+    m_CurrentBB = caseBB;
+    caseStmt.GetBody()->Accept(*this);
 }
 
 void IRGenAstVisitor::Visit(CompoundStatement& compoundStmt) {
@@ -327,8 +433,14 @@ void IRGenAstVisitor::Visit(DeclStatement& declStmt) {
 }
 
 void IRGenAstVisitor::Visit(DefaultStatement& defaultStmt) {
-    // TODO: ...
-    ANCL_CRITICAL("IRGen: Switch case is not implemented :(");
+    ir::SwitchInstruction* switchInstr = m_SwitchStack.top().Switch;
+
+    ir::BasicBlock* defaultBB = generateSwitchLabelBlock("sw.default");
+    switchInstr->SetDefaultBasicBlock(defaultBB);
+    sealBlock(defaultBB);
+
+    m_CurrentBB = defaultBB;
+    defaultStmt.GetBody()->Accept(*this);
 }
 
 void IRGenAstVisitor::Visit(DoStatement& doStmt) {
@@ -354,6 +466,7 @@ void IRGenAstVisitor::Visit(DoStatement& doStmt) {
 
     // Condition
     // TODO: handle const condition
+    sealBlock(condBB);
     m_CurrentBB = condBB;
 
     Expression* condExpr = doStmt.GetCondition();
@@ -368,7 +481,9 @@ void IRGenAstVisitor::Visit(DoStatement& doStmt) {
 
     auto* condBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(condValue, bodyBB, endBB, m_CurrentBB);
     m_CurrentBB->AddInstruction(condBranch);
+    sealBlock(bodyBB);
 
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 }
 
@@ -414,6 +529,7 @@ void IRGenAstVisitor::Visit(ForStatement& forStmt) {
         auto* condBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(
                     condValue, bodyBB, endBB, m_CurrentBB);
         m_CurrentBB->AddInstruction(condBranch);
+        sealBlock(bodyBB);
         m_CurrentBB = bodyBB;
     }
 
@@ -434,12 +550,15 @@ void IRGenAstVisitor::Visit(ForStatement& forStmt) {
         m_CurrentBB->AddInstruction(stepBranch);
 
         // Step
+        sealBlock(stepBB);
         m_CurrentBB = stepBB;
         stepExpr->Accept(*this);  // Ignore result value
     }
     auto* condBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(condBB, m_CurrentBB);
     m_CurrentBB->AddInstruction(condBranch);
+    sealBlock(condBB);
 
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 }
 
@@ -488,6 +607,10 @@ void IRGenAstVisitor::Visit(IfStatement& ifStmt) {
         condBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(condValue, thenBB, endBB, m_CurrentBB);
     }
     m_CurrentBB->AddInstruction(condBranch);
+    sealBlock(thenBB);
+    if (elseBB) {
+        sealBlock(elseBB);
+    }
 
     // Then
     m_CurrentBB = thenBB;
@@ -508,6 +631,7 @@ void IRGenAstVisitor::Visit(IfStatement& ifStmt) {
         m_CurrentBB->AddInstruction(endBranch);
     }
 
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 }
 
@@ -549,7 +673,52 @@ void IRGenAstVisitor::Visit(ReturnStatement& returnStmt) {
 }
 
 void IRGenAstVisitor::Visit(SwitchStatement& switchStmt) {
-    // TODO: ...
+    ir::BasicBlock* endBB = createBasicBlock("sw.end");
+
+    // Integer promotion of the controlling expression
+    Expression* expr = switchStmt.GetExpression();
+    ir::Value* value = Accept(*expr);
+    auto* intType = static_cast<ir::IntType*>(value->GetType());
+    if (intType->GetBytesNumber() < 4) {
+        ir::Type* promotedType = ir::IntType::Create(m_IRProgram, 4);
+        if (auto* constValue = getNumberIRConstant(value)) {
+            value = m_Constexpr.EvaluateCastConstExpr(constValue, promotedType);
+        } else {
+            value = generateExtCast(value, expr->GetType().GetSubType(), promotedType);
+        }
+    }
+
+    // The switch goes to the end until the default label is met,
+    // the cases are linked as their labels are visited
+    auto* switchInstr = m_IRProgram.CreateValue<ir::SwitchInstruction>(value, endBB, m_CurrentBB);
+    m_CurrentBB->AddInstruction(switchInstr);
+
+    ir::BasicBlock* bodyBB = createBasicBlock("sw.body");
+    sealBlock(bodyBB);
+    m_CurrentBB = bodyBB;
+
+    m_SwitchStack.push({switchInstr, bodyBB});
+    m_BreakBBStack.push(endBB);
+    Statement* body = switchStmt.GetBody();
+    body->Accept(*this);
+    m_BreakBBStack.pop();
+    m_SwitchStack.pop();
+
+    auto* endBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(endBB, m_CurrentBB);
+    m_CurrentBB->AddInstruction(endBranch);
+
+    auto* bodyBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(endBB, bodyBB);
+    bodyBB->AddInstruction(bodyBranch);
+
+    // The end block is placed after the cases, so the last of them falls into it
+    // and the control leaving the function does not pass through a case
+    std::vector<ir::BasicBlock*> blocks = m_CurrentFunction->GetBasicBlocks();
+    blocks.erase(std::find(blocks.begin(), blocks.end(), endBB));
+    blocks.push_back(endBB);
+    m_CurrentFunction->SetBasicBlocks(blocks);
+
+    sealBlock(endBB);
+    m_CurrentBB = endBB;
 }
 
 void IRGenAstVisitor::Visit(WhileStatement& whileStmt) {
@@ -577,6 +746,7 @@ void IRGenAstVisitor::Visit(WhileStatement& whileStmt) {
 
     auto* condBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(condValue, bodyBB, endBB, m_CurrentBB);
     m_CurrentBB->AddInstruction(condBranch);
+    sealBlock(bodyBB);
 
     // Body
     m_CurrentBB = bodyBB;
@@ -589,7 +759,9 @@ void IRGenAstVisitor::Visit(WhileStatement& whileStmt) {
 
     auto* loopBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(condBB, m_CurrentBB);
     m_CurrentBB->AddInstruction(loopBranch);
+    sealBlock(condBB);
 
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 }
 
@@ -648,6 +820,11 @@ void IRGenAstVisitor::Visit(BinaryExpression& binaryExpr) {
         return;
     }
 
+    if (opType == BinaryExpression::OpType::kAssign && generateRecordCopy(leftValue, rightOperand)) {
+        m_IRValue = leftValue;
+        return;
+    }
+
     ir::Value* rightValue = Accept(*rightOperand);
 
     switch (opType) {
@@ -692,7 +869,11 @@ void IRGenAstVisitor::Visit(BinaryExpression& binaryExpr) {
             return;
 
         case BinaryExpression::OpType::kAssign:
-            m_IRValue = createStoreInstruction(rightValue, leftValue, leftQualType.IsVolatile());
+            if (auto* storeInstr = createStoreInstruction(rightValue, leftValue, leftQualType.IsVolatile())) {
+                m_IRValue = storeInstr;
+            } else {
+                m_IRValue = rightValue;
+            }
             return;
 
         case BinaryExpression::OpType::kArrSubscript:
@@ -732,9 +913,7 @@ void IRGenAstVisitor::Visit(CastExpression& castExpr) {
         assert(valuePtrType);
 
         QualType qualType = castExpr.GetType();
-        ir::LoadInstruction* loadInstr = createLoadInstruction(fromValue, valuePtrType->GetSubType(),
-                                                                qualType.IsVolatile());
-        m_IRValue = loadInstr; 
+        m_IRValue = createLoadInstruction(fromValue, valuePtrType->GetSubType(), qualType.IsVolatile());
         return;
     }
 
@@ -855,6 +1034,8 @@ void IRGenAstVisitor::Visit(ConditionalExpression& condExpr) {
     );
 
     m_CurrentBB->AddInstruction(branchInstr);
+    sealBlock(trueBB);
+    sealBlock(falseBB);
 
     // True
     m_CurrentBB = trueBB;
@@ -864,9 +1045,9 @@ void IRGenAstVisitor::Visit(ConditionalExpression& condExpr) {
 
     auto* result = m_IRProgram.CreateValue<ir::AllocaInstruction>(
                                 trueValue->GetType(), "tmp", m_CurrentBB);
-    m_AllocaBuffer.push(result);
+    addLocalAlloca(result);
 
-    ir::StoreInstruction* trueStoreInstr = createStoreInstruction(trueValue, result);
+    createStoreInstruction(trueValue, result);
 
     auto* trueBranchEndInstr = m_IRProgram.CreateValue<ir::BranchInstruction>(
                                 endBB, m_CurrentBB);
@@ -879,7 +1060,7 @@ void IRGenAstVisitor::Visit(ConditionalExpression& condExpr) {
     Expression* falseExpr = condExpr.GetFalseExpression();
     ir::Value* falseValue = Accept(*falseExpr);
 
-    ir::StoreInstruction* falseStoreInstr = createStoreInstruction(falseValue, result);
+    createStoreInstruction(falseValue, result);
 
     auto* falseBranchEndInstr = m_IRProgram.CreateValue<ir::BranchInstruction>(
                                     endBB, m_CurrentBB);
@@ -887,11 +1068,10 @@ void IRGenAstVisitor::Visit(ConditionalExpression& condExpr) {
     m_CurrentBB->AddInstruction(falseBranchEndInstr);
 
     // End
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 
-    ir::LoadInstruction* loadInstr = createLoadInstruction(result, trueValue->GetType());
-
-    m_IRValue = loadInstr; 
+    m_IRValue = createLoadInstruction(result, trueValue->GetType());
 }
 
 void IRGenAstVisitor::Visit(ConstExpression& constExpr) {
@@ -928,20 +1108,20 @@ void IRGenAstVisitor::Visit(DeclRefExpression& declrefExpr) {
 
     std::string name = declaration->GetName();
 
-    if (m_IRProgram.HasFunction(name)) {
-        m_IRValue = m_IRProgram.GetFunction(name);
+    if (ir::Function* function = findFunction(name)) {
+        m_IRValue = function;
         return;
     }
 
-    if (m_IRProgram.HasGlobalVar(name)) {
-        m_IRValue = m_IRProgram.GetGlobalVar(name);
+    if (ir::GlobalVariable* globalVar = findGlobalVar(name)) {
+        m_IRValue = globalVar;
         return;       
     }
 
     // Static local variable
     std::string mangledName = std::format("{}.{}", m_CurrentFunction->GetName(), name);
-    if (m_IRProgram.HasGlobalVar(mangledName)) {
-        m_IRValue = m_IRProgram.GetGlobalVar(mangledName);
+    if (ir::GlobalVariable* globalVar = findGlobalVar(mangledName)) {
+        m_IRValue = globalVar;
         return;       
     }
 
@@ -965,8 +1145,8 @@ void IRGenAstVisitor::Visit(FloatExpression& floatExpr) {
 }
 
 void IRGenAstVisitor::Visit(InitializerList& initList) {
-    // TODO: memcpy or loop
-    // TODO: -> m_ValueList
+    // Local lists are generated in place by generateInitializerList()
+    // TODO: -> m_ConstantList
 }
 
 void IRGenAstVisitor::Visit(IntExpression& intExpr) {
@@ -988,19 +1168,17 @@ void IRGenAstVisitor::Visit(SizeofTypeExpression& sizeofTypeExpr) {
 }
 
 void IRGenAstVisitor::Visit(StringExpression& stringExpr) {
-    static uint64_t counter = 0;
-
     std::string stringValue = stringExpr.GetStringValue();
     if (m_StringLabelsMap.contains(stringValue)) {
         m_IRValue = m_StringLabelsMap[stringValue];
         return;
     }
 
-    std::string label = ".L.str";
-    if (counter > 0) {
-        label = std::format(".L.str.{}", counter);
+    // Body workers leave the label to MergeFunctionBody()
+    std::string label;
+    if (!m_IsBodyWorker) {
+        label = m_IRProgram.CreateStringLabel();
     }
-    ++counter;
 
     auto* arrayType = ir::ArrayType::Create(
                         ir::IntType::Create(m_IRProgram, ir::Alignment::GetPointerTypeSize()),
@@ -1012,7 +1190,7 @@ void IRGenAstVisitor::Visit(StringExpression& stringExpr) {
     strValue->SetInitString(stringValue);
     strValue->SetConst(true);
 
-    m_IRProgram.AddGlobalVar(strValue);
+    addGlobalVar(strValue);
     m_StringLabelsMap[stringValue] = strValue;
     m_IRValue = strValue;
 }
@@ -1160,12 +1338,11 @@ void IRGenAstVisitor::Visit(RecordType& recordType) {
     auto* structIRType = m_IRProgram.CreateType<ir::StructType>(m_IRProgram, elementTypes);
     m_StructTypesMap[decl] = structIRType;
 
-    static uint64_t counter = 0;
     std::string structIRName = decl->GetName();
-    if (counter > 0) {
-        structIRName += "." + std::to_string(counter);
+    if (m_StructTypesNumber > 0) {
+        structIRName += "." + std::to_string(m_StructTypesNumber);
     }
-    ++counter;
+    ++m_StructTypesNumber;
     structIRType->SetName(structIRName);
 
     std::vector<FieldDeclaration*> fields = decl->GetFields();
@@ -1291,23 +1468,24 @@ ir::Value* IRGenAstVisitor::generateIncDecExpression(UnaryExpression::OpType opT
         constValue = m_IRProgram.CreateValue<ir::IntConstant>(intType, IntValue(inc));
     }
 
-    ir::LoadInstruction* loadInstr = createLoadInstruction(value, valueSubType, qualType.IsVolatile());
+    ir::Value* loadValue = createLoadInstruction(value, valueSubType, qualType.IsVolatile());
 
     ir::Value* resultValue = nullptr;
     if (isPointer) {
-        resultValue = generatePtrAddExpression(/*isAdd=*/true, loadInstr, constValue);
+        resultValue = generatePtrAddExpression(/*isAdd=*/true, loadValue, constValue);
     } else {
-        resultValue = createAddInstruction(loadInstr, constValue, qualType.GetSubType());
+        resultValue = createAddInstruction(loadValue, constValue, qualType.GetSubType());
     }
 
-    ir::StoreInstruction* storeInstr = createStoreInstruction(resultValue, value, qualType.IsVolatile());
+    createStoreInstruction(resultValue, value, qualType.IsVolatile());
 
     if (opType == UnaryExpression::OpType::kPreDec ||
             opType == UnaryExpression::OpType::kPreInc) {
         return resultValue;
     }
 
-    return value;
+    // Postfix result is the old value
+    return loadValue;
 }
 
 ir::BinaryInstruction* IRGenAstVisitor::generatePtrSubExpression(ir::Value* leftValue, ir::Value* rightValue) {
@@ -1661,8 +1839,122 @@ ir::MemoryCopyInstruction* IRGenAstVisitor::createMemoryCopyInstruction(ir::Valu
     return memCopyInstr;
 }
 
+ir::MemorySetInstruction* IRGenAstVisitor::createMemorySetInstruction(ir::Value* destination, uint8_t fillByte,
+                                                                      size_t size) {
+    auto* byteType = ir::IntType::Create(m_IRProgram, 1);
+    auto* fillConstant = m_IRProgram.CreateValue<ir::IntConstant>(byteType, IntValue(fillByte));
+
+    auto* intType = ir::IntType::Create(m_IRProgram, ir::Alignment::GetPointerTypeSize());
+    auto* sizeConstant = m_IRProgram.CreateValue<ir::IntConstant>(intType, IntValue(size));
+
+    auto* memSetInstr = m_IRProgram.CreateValue<ir::MemorySetInstruction>(
+                                destination, fillConstant, sizeConstant, m_CurrentBB);
+
+    m_CurrentBB->AddInstruction(memSetInstr);
+    return memSetInstr;
+}
+
+void IRGenAstVisitor::generateInitializerList(ir::Value* address, InitializerList& initList,
+                                              bool isVolatile) {
+    std::vector<Expression*> inits = initList.GetInits();
+    Type* astType = initList.GetType().GetSubType();
+
+    auto* recordType = dynamic_cast<ast::RecordType*>(astType);
+    if (!recordType && !dynamic_cast<ast::ArrayType*>(astType)) {  // Scalar in braces
+        generateInitializer(address, inits[0], isVolatile, /*isZeroed=*/false);
+        return;
+    }
+
+    auto* ptrType = static_cast<ir::PointerType*>(address->GetType());
+    for (size_t i = 0; i < inits.size(); ++i) {
+        ir::Value* elementAddress = nullptr;
+        if (!recordType) {
+            auto* intType = ir::IntType::Create(m_IRProgram, ir::Alignment::GetPointerTypeSize());
+            auto* idxValue = m_IRProgram.CreateValue<ir::IntConstant>(intType, IntValue(i));
+            elementAddress = generateArrMemberExpression(address, idxValue, nullptr);
+        } else if (RecordDeclaration* recordDecl = recordType->GetDeclaration(); recordDecl->IsUnion()) {
+            ir::Type* fieldIRType = VisitQualType(recordDecl->GetFields()[0]->GetType());
+            elementAddress = createCastInstruction(ir::CastInstruction::OpType::kBitcast, address,
+                                                   ir::PointerType::Create(fieldIRType));
+        } else {
+            auto* structType = static_cast<ir::StructType*>(ptrType->GetSubType());
+            auto* memberPtrType = ir::PointerType::Create(structType->GetElementType(i));
+
+            auto* intType = ir::IntType::Create(m_IRProgram, 4);
+            auto* idxValue = m_IRProgram.CreateValue<ir::IntConstant>(intType, IntValue(i));
+
+            auto* memberInstr = m_IRProgram.CreateValue<ir::MemberInstruction>(
+                                        address, idxValue, "member", memberPtrType, m_CurrentBB);
+            memberInstr->SetDeref(true);
+            m_CurrentBB->AddInstruction(memberInstr);
+            elementAddress = memberInstr;
+        }
+
+        generateInitializer(elementAddress, inits[i], isVolatile, /*isZeroed=*/true);
+    }
+}
+
+void IRGenAstVisitor::generateInitializer(ir::Value* address, Expression* initExpr,
+                                          bool isVolatile, bool isZeroed) {
+    if (auto* initList = dynamic_cast<InitializerList*>(initExpr)) {
+        generateInitializerList(address, *initList, isVolatile);
+        return;
+    }
+
+    auto* ptrType = static_cast<ir::PointerType*>(address->GetType());
+    ir::Type* type = ptrType->GetSubType();
+
+    auto* stringExpr = dynamic_cast<StringExpression*>(initExpr);
+    if (stringExpr && dynamic_cast<ir::ArrayType*>(type)) {
+        ir::Value* stringLabel = Accept(*stringExpr);
+        uint64_t size = std::min<uint64_t>(stringExpr->GetStringValue().size() + 1,
+                                           ir::Alignment::GetTypeSize(type));
+        createMemoryCopyInstruction(address, stringLabel, size);
+        return;
+    }
+
+    if (generateRecordCopy(address, initExpr)) {
+        return;
+    }
+
+    ir::Value* value = Accept(*initExpr);
+    if (auto* intConstant = dynamic_cast<ir::IntConstant*>(value)) {
+        if (isZeroed && !isVolatile && intConstant->GetValue().GetUnsignedValue() == 0) {
+            return;
+        }
+    }
+    createStoreInstruction(value, address, isVolatile);
+}
+
+bool IRGenAstVisitor::generateRecordCopy(ir::Value* destination, Expression* sourceExpr) {
+    auto* ptrType = static_cast<ir::PointerType*>(destination->GetType());
+    auto* structType = dynamic_cast<ir::StructType*>(ptrType->GetSubType());
+
+    // A record is copied from the address of its lvalue,
+    // the casts that only drop qualifiers are skipped
+    auto* castExpr = dynamic_cast<CastExpression*>(sourceExpr);
+    while (structType && castExpr && !castExpr->IsLValueToRValue()) {
+        castExpr = dynamic_cast<CastExpression*>(castExpr->GetSubExpression());
+    }
+    if (!structType || !castExpr) {
+        return false;
+    }
+
+    ir::Value* source = Accept(*castExpr->GetSubExpression());
+    createMemoryCopyInstruction(destination, source, ir::Alignment::GetTypeSize(structType));
+    return true;
+}
+
 ir::StoreInstruction* IRGenAstVisitor::createStoreInstruction(ir::Value* value, ir::Value* address,
                                                               bool isVolatile) {
+    if (isSSAVariable(address)) {
+        // Stores after a terminator are dead, as in AddInstruction
+        if (!m_CurrentBB->IsTerminated()) {
+            writeVariable(static_cast<ir::AllocaInstruction*>(address), m_CurrentBB, value);
+        }
+        return nullptr;
+    }
+
     // TODO:...
     auto* ptrType = static_cast<ir::PointerType*>(address->GetType());
     if (auto* ptrSubType = dynamic_cast<ir::PointerType*>(ptrType->GetSubType())) {
@@ -1685,8 +1977,12 @@ ir::StoreInstruction* IRGenAstVisitor::createStoreInstruction(ir::Value* value,
     return storeInstr;
 }
 
-ir::LoadInstruction* IRGenAstVisitor::createLoadInstruction(ir::Value* fromPointer, ir::Type* toType,
-                                                            bool isVolatile) {
+ir::Value* IRGenAstVisitor::createLoadInstruction(ir::Value* fromPointer, ir::Type* toType,
+                                                  bool isVolatile) {
+    if (isSSAVariable(fromPointer)) {
+        return readVariable(static_cast<ir::AllocaInstruction*>(fromPointer), m_CurrentBB);
+    }
+
     auto* loadInstr = m_IRProgram.CreateValue<ir::LoadInstruction>(
         fromPointer, toType, "", m_CurrentBB
     );
@@ -1727,7 +2023,7 @@ ir::Value* IRGenAstVisitor::generateLogInstruction(BinaryExpression::OpType opTy
 
     auto* result = m_IRProgram.CreateValue<ir::AllocaInstruction>(
                                 ir::IntType::Create(m_IRProgram, 1), "tmp", m_CurrentBB);
-    m_AllocaBuffer.push(result);
+    addLocalAlloca(result);
 
     ir::Value* leftValue = Accept(*leftExpr);
     ir::Instruction* leftCmpInstr = nullptr;
@@ -1745,12 +2041,13 @@ ir::Value* IRGenAstVisitor::generateLogInstruction(BinaryExpression::OpType opTy
         std::swap(trueBB, falseBB);
     }
 
-    ir::StoreInstruction* leftStoreInstr = createStoreInstruction(leftCmpInstr, result);
+    createStoreInstruction(leftCmpInstr, result);
 
     auto* branchInstr = m_IRProgram.CreateValue<ir::BranchInstruction>(
         leftCmpInstr, trueBB, falseBB, m_CurrentBB
     );
     m_CurrentBB->AddInstruction(branchInstr);
+    sealBlock(rightBB);
 
     // Right expression
     m_CurrentBB = rightBB;
@@ -1765,18 +2062,17 @@ ir::Value* IRGenAstVisitor::generateLogInstruction(BinaryExpression::OpType opTy
                             rightValue, rightType);
     }
 
-    ir::StoreInstruction* rightStoreInstr = createStoreInstruction(rightCmpInstr, result);
+    createStoreInstruction(rightCmpInstr, result);
 
     auto* branchEndInstr = m_IRProgram.CreateValue<ir::BranchInstruction>(
                             endBB, m_CurrentBB);
     m_CurrentBB->AddInstruction(branchEndInstr);
 
     // End
+    sealBlock(endBB);
     m_CurrentBB = endBB;
 
-    ir::LoadInstruction* loadInstr = createLoadInstruction(result, ir::IntType::Create(m_IRProgram, 1));
-
-    return loadInstr;
+    return createLoadInstruction(result, ir::IntType::Create(m_IRProgram, 1));
 }
 
 
@@ -2045,6 +2341,18 @@ ir::BasicBlock* IRGenAstVisitor::createBasicBlock(const std::string& name) {
     return basicBlock;
 }
 
+ir::BasicBlock* IRGenAstVisitor::generateSwitchLabelBlock(const std::string& name) {
+    ir::BasicBlock* labelBB = createBasicBlock(name);
+
+    // Fallthrough from the previous label
+    if (m_CurrentBB != m_SwitchStack.top().BodyBB) {
+        auto* fallBranch = m_IRProgram.CreateValue<ir::BranchInstruction>(labelBB, m_CurrentBB);
+        m_CurrentBB->AddInstruction(fallBranch);
+    }
+
+    return labelBB;
+}
+
 ir::Constant* IRGenAstVisitor::getNumberIRConstant(ir::Value* value) {
     if (auto* intConst = dynamic_cast<ir::IntConstant*>(value)) {
         return intConst;
@@ -2055,6 +2363,275 @@ ir::Constant* IRGenAstVisitor::getNumberIRConstant(ir::Value* value) {
     return nullptr;
 }
 
+void IRGenAstVisitor::addGlobalVar(ir::GlobalVariable* globalVar) {
+    if (m_IsBodyWorker) {
+        m_PendingGlobalVars.push_back(globalVar);
+        return;
+    }
+    m_IRProgram.AddGlobalVar(globalVar);
+}
+
+ir::GlobalVariable* IRGenAstVisitor::findGlobalVar(const std::string& name) const {
+    if (m_IRProgram.HasGlobalVar(name)) {
+        return m_IRProgram.GetGlobalVar(name);
+    }
+
+    for (ir::GlobalVariable* globalVar : m_PendingGlobalVars) {
+        if (globalVar->GetName() == name) {
+            return globalVar;
+        }
+    }
+    return nullptr;
+}
+
+void IRGenAstVisitor::addFunction(ir::Function* function) {
+    if (m_IsBodyWorker) {
+        m_PendingFunctions.push_back(function);
+        return;
+    }
+    m_IRProgram.AddFunction(function);
+}
+
+ir::Function* IRGenAstVisitor::findFunction(const std::string& name) const {
+    // The latest declaration wins, as in IRProgram
+    for (auto it = m_PendingFunctions.rbegin(); it != m_PendingFunctions.rend(); ++it) {
+        if ((*it)->GetName() == name) {
+            return *it;
+        }
+    }
+
+    if (m_IRProgram.HasFunction(name)) {
+        return m_IRProgram.GetFunction(name);
+    }
+    return nullptr;
+}
+
+void IRGenAstVisitor::addLocalAlloca(ir::AllocaInstruction* alloca, bool isPromotable) {
+    if (m_BuildSSA && isPromotable && isSSAType(alloca->GetAllocaType())) {
+        m_SSAVariables.insert(alloca);
+        return;
+    }
+    m_AllocaBuffer.push(alloca);
+}
+
+bool IRGenAstVisitor::isSSAVariable(ir::Value* value) const {
+    if (m_SSAVariables.empty()) {
+        return false;
+    }
+    auto* alloca = dynamic_cast<ir::AllocaInstruction*>(value);
+    return alloca && m_SSAVariables.contains(alloca);
+}
+
+bool IRGenAstVisitor::isSSAType(ir::Type* type) const {
+    // Pointers stay in allocas: subscript takes the address of the pointer variable
+    return dynamic_cast<ir::IntType*>(type) || dynamic_cast<ir::FloatType*>(type);
+}
+
+void IRGenAstVisitor::writeVariable(ir::AllocaInstruction* variable, ir::BasicBlock* block,
+                                    ir::Value* value) {
+    m_CurrentDefs[variable][block] = value;
+}
+
+ir::Value* IRGenAstVisitor::readVariable(ir::AllocaInstruction* variable, ir::BasicBlock* block) {
+    auto& blockDefs = m_CurrentDefs[variable];
+    if (auto it = blockDefs.find(block); it != blockDefs.end()) {
+        return it->second;
+    }
+    return readVariableRecursive(variable, block);
+}
+
+ir::Value* IRGenAstVisitor::readVariableRecursive(ir::AllocaInstruction* variable, ir::BasicBlock* block) {
+    ir::Value* value = nullptr;
+    if (!m_SealedBlocks.contains(block)) {
+        // Operands are added when the last predecessor is known
+        ir::PhiInstruction* phi = createVariablePhi(variable, block);
+        m_IncompletePhis[block].push_back(phi);
+        value = phi;
+    } else if (block->GetPredecessorsNumber() == 0) {
+        value = createUndefValue(variable->GetAllocaType());
+    } else if (block->GetPredecessorsNumber() == 1) {
+        value = readVariable(variable, block->GetPredecessors()[0]);
+    } else {
+        // The phi breaks the cycles through the loops
+        ir::PhiInstruction* phi = createVariablePhi(variable, block);
+        writeVariable(variable, block, phi);
+        addPhiOperands(variable, phi);
+        value = phi;
+    }
+
+    writeVariable(variable, block, value);
+    return value;
+}
+
+ir::PhiInstruction* IRGenAstVisitor::createVariablePhi(ir::AllocaInstruction* variable,
+                                                       ir::BasicBlock* block) {
+    auto* phi = m_IRProgram.CreateValue<ir::PhiInstruction>(variable->GetAllocaType(), "phi", block);
+    block->AddPhiFunction(phi);
+
+    m_PhiVariables[phi] = variable;
+    m_VariablePhis.push_back(phi);
+    return phi;
+}
+
+void IRGenAstVisitor::addPhiOperands(ir::AllocaInstruction* variable, ir::PhiInstruction* phi) {
+    std::vector<ir::BasicBlock*> preds = phi->GetBasicBlock()->GetPredecessors();
+    for (size_t i = 0; i < preds.size(); ++i) {
+        phi->SetIncomingBlock(i, preds[i]);
+        phi->SetIncomingValue(i, readVariable(variable, preds[i]));
+    }
+}
+
+void IRGenAstVisitor::sealBlock(ir::BasicBlock* block) {
+    if (!m_BuildSSA) {
+        return;
+    }
+
+    // Reads of the operands may add incomplete phis to other blocks
+    std::vector<ir::PhiInstruction*> incompletePhis = std::move(m_IncompletePhis[block]);
+    m_IncompletePhis.erase(block);
+    for (ir::PhiInstruction* phi : incompletePhis) {
+        addPhiOperands(m_PhiVariables[phi], phi);
+    }
+    m_SealedBlocks.insert(block);
+}
+
+void IRGenAstVisitor::generateSSAReturnBlock(ir::Type* returnType) {
+    // The returned values are merged by a phi of the "retval" variable
+    ir::BasicBlock* entryBlock = m_CurrentFunction->GetEntryBlock();
+    auto* retValueVariable = m_IRProgram.CreateValue<ir::AllocaInstruction>(
+                                    returnType, "retval", entryBlock);
+    m_SSAVariables.insert(retValueVariable);
+
+    ir::BasicBlock* newRetBlock = createBasicBlock("return");
+    for (ir::BasicBlock* retBlock : m_ReturnBlocks) {
+        auto* retInstr = dynamic_cast<ir::ReturnInstruction*>(retBlock->GetTerminator());
+        writeVariable(retValueVariable, retBlock, retInstr->GetReturnValue());
+
+        auto* branch = m_IRProgram.CreateValue<ir::BranchInstruction>(newRetBlock, retBlock);
+        retBlock->ReplaceTerminator(branch);
+    }
+
+    // The block is sealed in finishSSA(), after the unterminated blocks are linked to it
+    ir::Value* retValue = readVariable(retValueVariable, newRetBlock);
+    auto* retInstr = m_IRProgram.CreateValue<ir::ReturnInstruction>(retValue, newRetBlock);
+    newRetBlock->AddInstruction(retInstr);
+}
+
+void IRGenAstVisitor::finishSSA() {
+    // Label blocks and the return block get their last predecessors here
+    for (ir::BasicBlock* block : m_CurrentFunction->GetBasicBlocks()) {
+        if (!m_SealedBlocks.contains(block)) {
+            sealBlock(block);
+        }
+    }
+
+    // Edges added to the sealed blocks at the end of the function
+    for (size_t i = 0; i < m_VariablePhis.size(); ++i) {
+        ir::PhiInstruction* phi = m_VariablePhis[i];
+        std::vector<ir::BasicBlock*> preds = phi->GetBasicBlock()->GetPredecessors();
+        for (size_t j = 0; j < preds.size(); ++j) {
+            if (!phi->GetIncomingValue(j)) {
+                phi->SetIncomingBlock(j, preds[j]);
+                phi->SetIncomingValue(j, readVariable(m_PhiVariables[phi], preds[j]));
+            }
+        }
+    }
+
+    removeRedundantPhis();
+}
+
+void IRGenAstVisitor::removeRedundantPhis() {
+    // Trivial phis (one distinct argument besides itself) are replaced with the argument
+    std::unordered_map<ir::Value*, ir::Value*> replacements;
+    auto resolve = [&replacements](ir::Value* value) {
+        for (auto it = replacements.find(value); it != replacements.end(); it = replacements.find(value)) {
+            value = it->second;
+        }
+        return value;
+    };
+
+    bool isChanged = true;
+    while (isChanged) {
+        isChanged = false;
+        for (ir::PhiInstruction* phi : m_VariablePhis) {
+            if (replacements.contains(phi)) {
+                continue;
+            }
+
+            ir::Value* sameValue = nullptr;
+            bool isTrivial = true;
+            for (ir::Value* operand : phi->GetOperands()) {
+                operand = resolve(operand);
+                if (operand == sameValue || operand == phi) {
+                    continue;
+                }
+                if (sameValue) {
+                    isTrivial = false;
+                    break;
+                }
+                sameValue = operand;
+            }
+
+            if (isTrivial) {
+                replacements[phi] = sameValue ? sameValue : createUndefValue(phi->GetType());
+                isChanged = true;
+            }
+        }
+    }
+
+    // Phis without non-phi users are dead
+    std::unordered_set<ir::PhiInstruction*> livePhis;
+    std::vector<ir::PhiInstruction*> workList;
+    auto resolveOperands = [&](ir::Instruction* instruction) {
+        for (size_t i = 0; i < instruction->GetOperandsNumber(); ++i) {
+            ir::Value* operand = instruction->GetOperand(i);
+            ir::Value* resolved = resolve(operand);
+            if (resolved != operand) {
+                instruction->SetOperand(resolved, i);
+            }
+
+            auto* phiOperand = dynamic_cast<ir::PhiInstruction*>(resolved);
+            if (phiOperand && livePhis.insert(phiOperand).second) {
+                workList.push_back(phiOperand);
+            }
+        }
+    };
+
+    for (ir::BasicBlock* block : m_CurrentFunction->GetBasicBlocks()) {
+        for (ir::Instruction* instruction : block->GetInstructionsRef()) {
+            if (!dynamic_cast<ir::PhiInstruction*>(instruction)) {
+                resolveOperands(instruction);
+            }
+        }
+    }
+
+    while (!workList.empty()) {
+        ir::PhiInstruction* phi = workList.back();
+        workList.pop_back();
+        resolveOperands(phi);
+    }
+
+    if (m_CurrentFunction->HasReturnValue()) {
+        m_CurrentFunction->SetReturnValue(resolve(m_CurrentFunction->GetReturnValue()));
+    }
+
+    for (ir::BasicBlock* block : m_CurrentFunction->GetBasicBlocks()) {
+        block->GetInstructionsRef().remove_if([&livePhis](ir::Instruction* instruction) {
+            auto* phi = dynamic_cast<ir::PhiInstruction*>(instruction);
+            return phi && !livePhis.contains(phi);
+        });
+    }
+}
+
+ir::Value* IRGenAstVisitor::createUndefValue(ir::Type* type) {
+    // Read of an uninitialized variable, any value is fine
+    if (auto* floatType = dynamic_cast<ir::FloatType*>(type)) {
+        return m_IRProgram.CreateValue<ir::FloatConstant>(floatType, FloatValue(0.));
+    }
+    auto* intType = static_cast<ir::IntType*>(type);
+    return m_IRProgram.CreateValue<ir::IntConstant>(intType, IntValue(0));
+}
+
 void IRGenAstVisitor::generateAllocas() {
     ir::BasicBlock* entryBlock = m_CurrentFunction->GetEntryBlock(); 
     while (!m_AllocaBuffer.empty()) {
@@ -2069,6 +2646,18 @@ void IRGenAstVisitor::resetFunctionData() {
     m_ReturnBlocks.clear();
     m_FunBBMap.clear();
     m_AllocasMap.clear();
+
+    m_SSAVariables.clear();
+    m_CurrentDefs.clear();
+    m_SealedBlocks.clear();
+    m_IncompletePhis.clear();
+    m_PhiVariables.clear();
+    m_VariablePhis.clear();
+
+    for (RecordDeclaration* recordDecl : m_LocalRecords) {
+        m_StructTypesMap.erase(recordDecl);
+    }
+    m_LocalRecords.clear();
 }
 
 }  // namespace ast
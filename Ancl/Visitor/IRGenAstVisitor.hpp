@@ -2,6 +2,7 @@
 
 #include <stack>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <Ancl/Grammar/AST/AST.hpp>
 #include <Ancl/Visitor/AstVisitor.hpp>
@@ -16,11 +17,37 @@
 namespace ast {
 
 class IRGenAstVisitor: public AstVisitor {
+public:
+    struct FunctionDefinition {
+        FunctionDeclaration* Declaration;
+        ir::Function* Function;
+    };
+
 public:
     IRGenAstVisitor(ir::IRProgram& irProgram);
 
+    // Parallel generation: generates one function body, the globals and
+    // functions it creates are kept until MergeFunctionBody()
+    IRGenAstVisitor(ir::IRProgram& irProgram, const IRGenAstVisitor& globalVisitor);
+
     void Run(const ASTProgram& astProgram);
 
+    // Streaming compilation: generates one external declaration
+    void Run(Declaration& decl);
+
+    // Parallel generation: generates global variables and function values,
+    // definitions are collected in source order for RunFunctionBody()
+    void RunDeclarations(const ASTProgram& astProgram, std::vector<FunctionDefinition>& definitions);
+
+    void RunFunctionBody(const FunctionDefinition& definition);
+
+    // Adds the globals of the body to the program, bodies must be merged in source order
+    void MergeFunctionBody();
+
+    // Scalar locals are kept in SSA values instead of allocas (Braun et al.),
+    // the variables with taken address stay in memory
+    void SetBuildSSA(bool buildSSA);
+
 public:
     /*
     =================================================================
@@ -46,8 +73,7 @@ public:
 
     void Visit(ParameterDeclaration& paramDecl) override;
 
-    // Skip
-    void Visit(RecordDeclaration& recordDecl) override {}
+    void Visit(RecordDeclaration& recordDecl) override;
 
     void Visit(TagDeclaration&) override {
         // Base class
@@ -226,11 +252,23 @@ private:
     ir::MemoryCopyInstruction* createMemoryCopyInstruction(ir::Value* destination, ir::Value* source,
                                                            size_t size);
 
+    ir::MemorySetInstruction* createMemorySetInstruction(ir::Value* destination, uint8_t fillByte,
+                                                         size_t size);
+
+    void generateInitializerList(ir::Value* address, InitializerList& initList, bool isVolatile);
+
+    // Skips the zero stores when the memory is already zeroed
+    void generateInitializer(ir::Value* address, Expression* initExpr, bool isVolatile, bool isZeroed);
+
+    // Returns false when the source is not a record lvalue
+    bool generateRecordCopy(ir::Value* destination, Expression* sourceExpr);
+
+    // Returns nullptr for the SSA variables
     ir::StoreInstruction* createStoreInstruction(ir::Value* value, ir::Value* address,
                                                  bool isVolatile = false);
 
-    ir::LoadInstruction* createLoadInstruction(ir::Value* fromPointer, ir::Type* toType,
-                                               bool isVolatile = false);
+    ir::Value* createLoadInstruction(ir::Value* fromPointer, ir::Type* toType,
+                                     bool isVolatile = false);
 
     ir::CastInstruction* createCastInstruction(ir::CastInstruction::OpType opType,
                                                ir::Value* fromValue, ir::Type* toType);
@@ -274,12 +312,45 @@ private:
 
     ir::BasicBlock* createBasicBlock(const std::string& name);
 
+    // Starts the block of a case or the default label
+    ir::BasicBlock* generateSwitchLabelBlock(const std::string& name);
+
     ir::Constant* getNumberIRConstant(ir::Value* value);
 
 private:
+    ir::Function* createFunction(FunctionDeclaration& funcDecl);
+    void generateFunction(FunctionDeclaration& funcDecl, ir::Function* function);
+
+    void addGlobalVar(ir::GlobalVariable* globalVar);
+    ir::GlobalVariable* findGlobalVar(const std::string& name) const;
+
+    void addFunction(ir::Function* function);
+    ir::Function* findFunction(const std::string& name) const;
+
     void generateAllocas();
     void resetFunctionData();
 
+private:
+    void addLocalAlloca(ir::AllocaInstruction* alloca, bool isPromotable = true);
+    bool isSSAVariable(ir::Value* value) const;
+    bool isSSAType(ir::Type* type) const;
+
+    void writeVariable(ir::AllocaInstruction* variable, ir::BasicBlock* block, ir::Value* value);
+    ir::Value* readVariable(ir::AllocaInstruction* variable, ir::BasicBlock* block);
+    ir::Value* readVariableRecursive(ir::AllocaInstruction* variable, ir::BasicBlock* block);
+
+    ir::PhiInstruction* createVariablePhi(ir::AllocaInstruction* variable, ir::BasicBlock* block);
+    void addPhiOperands(ir::AllocaInstruction* variable, ir::PhiInstruction* phi);
+
+    // All predecessors of the block are known
+    void sealBlock(ir::BasicBlock* block);
+
+    void generateSSAReturnBlock(ir::Type* returnType);
+    void finishSSA();
+    void removeRedundantPhis();
+
+    ir::Value* createUndefValue(ir::Type* type);
+
 private:
     ir::IRProgram& m_IRProgram;
 
@@ -295,6 +366,8 @@ private:
 
     std::unordered_map<Declaration*, ir::AllocaInstruction*> m_AllocasMap;
     std::unordered_map<RecordDeclaration*, ir::Type*> m_StructTypesMap;
+    std::vector<RecordDeclaration*> m_LocalRecords;
+    uint64_t m_StructTypesNumber = 0;
 
     std::stack<ir::AllocaInstruction*> m_AllocaBuffer;
 
@@ -303,6 +376,13 @@ private:
     std::stack<ir::BasicBlock*> m_ContinueBBStack;
     std::stack<ir::BasicBlock*> m_BreakBBStack;
 
+    // Statements before the first label of a switch go to its unreachable body block
+    struct SwitchContext {
+        ir::SwitchInstruction* Switch;
+        ir::BasicBlock* BodyBB;
+    };
+    std::stack<SwitchContext> m_SwitchStack;
+
     ir::Type* m_IRType = nullptr;
     ir::Value* m_IRValue = nullptr;
 
@@ -311,6 +391,23 @@ private:
 
     std::vector<ir::Constant*> m_ConstantList;
     std::vector<ir::Value*> m_ValueList;
+
+    std::vector<FunctionDefinition>* m_DeferredDefinitions = nullptr;
+
+    // Body workers do not touch the shared program lists
+    bool m_IsBodyWorker = false;
+    std::vector<ir::GlobalVariable*> m_PendingGlobalVars;
+    std::vector<ir::Function*> m_PendingFunctions;
+
+    // SSA construction, the allocas of SSA variables are never emitted
+    bool m_BuildSSA = false;
+    std::unordered_set<ir::AllocaInstruction*> m_SSAVariables;
+    std::unordered_map<ir::AllocaInstruction*,
+                       std::unordered_map<ir::BasicBlock*, ir::Value*>> m_CurrentDefs;
+    std::unordered_set<ir::BasicBlock*> m_SealedBlocks;
+    std::unordered_map<ir::BasicBlock*, std::vector<ir::PhiInstruction*>> m_IncompletePhis;
+    std::unordered_map<ir::PhiInstruction*, ir::AllocaInstruction*> m_PhiVariables;
+    std::vector<ir::PhiInstruction*> m_VariablePhis;
 };
 
 }  // namespace ast
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Ancl/Grammar/AST/AST.hpp>
+#include <Ancl/Grammar/AST/Base/SourceManager.hpp>
 #include <Ancl/Visitor/AstVisitor.hpp>
 
 #include <Ancl/Grammar/AST/Value/Value.hpp>
@@ -19,7 +20,8 @@ public:
     };
 
 public:
-    IntConstExprAstVisitor() = default;
+    IntConstExprAstVisitor(const SourceManager& sourceManager)
+        : m_SourceManager(sourceManager) {}
 
     Status Evaluate(ConstExpression& constExpr) {
         Visit(constExpr);
@@ -484,11 +486,11 @@ public:
 
 private:
     void printSemanticWarning(const std::string& text, const Location& location) {
-        ANCL_WARN("{} {}", location.ToString(), text);
+        ANCL_WARN("{} {}", m_SourceManager.ToString(location), text);
     }
 
     void printSemanticError(const std::string& text, const Location& location) {
-        ANCL_ERROR("{} {}", location.ToString(), text);
+        ANCL_ERROR("{} {}", m_SourceManager.ToString(location), text);
 
         // TODO: Handle error
         throw std::runtime_error("Semantic error");
@@ -496,6 +498,8 @@ private:
     }
 
 private:
+    const SourceManager& m_SourceManager;
+
     Value m_Value = IntValue(0);
 };
 
@@ -1,5 +1,7 @@
 #include <Ancl/Visitor/SemanticAstVisitor.hpp>
 
+#include <algorithm>
+#include <format>
 #include <ranges>
 
 #include <Ancl/Visitor/IntConstExprAstVisitor.hpp>
@@ -102,11 +104,11 @@ bool areEqualTypes(const Type* leftType, const Type* rightType) {
 
 void SemanticAstVisitor::Visit(EnumConstDeclaration& enumConstDecl) {
     std::string enumConstName = enumConstDecl.GetName();
-    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, enumConstName)) {
+    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, enumConstDecl.GetIdentifier())) {
         printSemanticError(std::format("redefinition of enumerator '{}'", enumConstName),
                             enumConstDecl.GetLocation());
     } else {
-        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, enumConstName, &enumConstDecl);
+        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, enumConstDecl.GetIdentifier(), &enumConstDecl);
     }
 
     ConstExpression* initExpr = enumConstDecl.GetInit();
@@ -116,8 +118,8 @@ void SemanticAstVisitor::Visit(EnumConstDeclaration& enumConstDecl) {
 void SemanticAstVisitor::Visit(EnumDeclaration& enumDecl) {
     std::string enumName = enumDecl.GetName();
 
-    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Tag, enumName)) {
-        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Tag, enumName);
+    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Tag, enumDecl.GetIdentifier())) {
+        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Tag, enumDecl.GetIdentifier());
         auto* scopeEnumDecl = dynamic_cast<EnumDeclaration*>(decl);
         if (!scopeEnumDecl) {
             printSemanticError(std::format("use of '{}' with tag type that does not "
@@ -127,11 +129,11 @@ void SemanticAstVisitor::Visit(EnumDeclaration& enumDecl) {
             handleTagDeclaration(&enumDecl, enumName, scopeEnumDecl);
         }
     } else {
-        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, enumName);
+        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, enumDecl.GetIdentifier());
         if (decl) {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, enumName, *decl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, enumDecl.GetIdentifier(), *decl);
         } else {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, enumName, &enumDecl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, enumDecl.GetIdentifier(), &enumDecl);
         }
     }
 
@@ -151,24 +153,23 @@ void SemanticAstVisitor::Visit(FieldDeclaration& fieldDecl) {
                             fieldDecl.GetLocation());  
     }
 
-    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, fieldName)) {
+    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, fieldDecl.GetIdentifier())) {
         printSemanticError(std::format("duplicate member '{}'", fieldName),
                             fieldDecl.GetLocation());
     } else {
-        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, fieldName, &fieldDecl);
+        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, fieldDecl.GetIdentifier(), &fieldDecl);
     }
 }
 
 void SemanticAstVisitor::Visit(FunctionDeclaration& funcDecl) {
     QualType funcDeclQualType = AcceptQualType(funcDecl.GetType());
     funcDecl.SetType(funcDeclQualType);
-    Type* funcDeclType = funcDeclQualType.GetSubType();
 
     std::string funcName = funcDecl.GetName();
 
     Scope* globalScope = m_SymbolTable.GetGlobalScope();
-    if (globalScope->HasSymbol(Scope::NamespaceType::Ident, funcName)) {
-        Declaration* decl = globalScope->GetSymbol(Scope::NamespaceType::Ident, funcName);
+    if (globalScope->HasSymbol(Scope::NamespaceType::Ident, funcDecl.GetIdentifier())) {
+        Declaration* decl = globalScope->GetSymbol(Scope::NamespaceType::Ident, funcDecl.GetIdentifier());
         auto* scopeFuncDecl = dynamic_cast<FunctionDeclaration*>(decl);
         if (!scopeFuncDecl) {
             printSemanticError(std::format("redefinition of '{}' as different kind of symbol",
@@ -195,20 +196,40 @@ void SemanticAstVisitor::Visit(FunctionDeclaration& funcDecl) {
             }
         }
     } else {
-        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, funcName);
+        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, funcDecl.GetIdentifier());
         if (decl) {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, funcName, *decl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, funcDecl.GetIdentifier(), *decl);
         } else {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, funcName, &funcDecl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, funcDecl.GetIdentifier(), &funcDecl);
         }
     }
 
-    m_CurrentScope = m_SymbolTable.CreateScope(std::format("{} [function]", funcName),
+    if (m_DeferredDefinitions && funcDecl.HasBody()) {
+        // Parameter types are resolved before the global scope is frozen,
+        // other bodies read them through calls
+        for (ParameterDeclaration* paramDecl : funcDecl.GetParams()) {
+            paramDecl->SetType(AcceptQualType(paramDecl->GetType()));
+        }
+        m_DeferredDefinitions->push_back(&funcDecl);
+        return;
+    }
+
+    checkFunctionBody(funcDecl, /*areParamTypesResolved=*/false);
+}
+
+void SemanticAstVisitor::checkFunctionBody(FunctionDeclaration& funcDecl, bool areParamTypesResolved) {
+    auto* funcType = static_cast<FunctionType*>(funcDecl.GetType().GetSubType());
+
+    m_CurrentScope = m_SymbolTable.CreateScope(std::format("{} [function]", funcDecl.GetName()),
                                                 m_CurrentScope);
     m_FunctionScope = m_CurrentScope;  
 
     for (ParameterDeclaration* paramDecl : funcDecl.GetParams()) {
-        paramDecl->Accept(*this);
+        if (areParamTypesResolved) {
+            declareParameter(*paramDecl);
+        } else {
+            paramDecl->Accept(*this);
+        }
     }
 
     Statement* body = funcDecl.GetBody();
@@ -220,9 +241,11 @@ void SemanticAstVisitor::Visit(FunctionDeclaration& funcDecl) {
         m_IgnoreCompoundScope = true;
         m_CurrentFunctionDecl = &funcDecl;
 
+        // Implicit casts belong to the body
+        m_Program.BeginFunctionBody();
         body->Accept(*this);
+        m_Program.EndFunctionBody();
     
-        auto* funcType = static_cast<FunctionType*>(funcDeclType);
         if (!isVoidType(funcType->GetSubType()) && !m_HasReturn) {
             printSemanticError("non-void function does not return a value", funcDecl.GetLocation());
         }
@@ -234,17 +257,17 @@ void SemanticAstVisitor::Visit(FunctionDeclaration& funcDecl) {
     }
 
     m_FunctionScope = nullptr;
-    m_CurrentScope = m_CurrentScope->GetParentScope(); 
+    m_CurrentScope = m_SymbolTable.ExitScope(m_CurrentScope);
 }
 
 void SemanticAstVisitor::Visit(LabelDeclaration& labelDecl) {
     std::string labelName = labelDecl.GetName();
     assert(m_FunctionScope);
-    if (m_FunctionScope->HasSymbol(Scope::NamespaceType::Label, labelName)) {
+    if (m_FunctionScope->HasSymbol(Scope::NamespaceType::Label, labelDecl.GetIdentifier())) {
         printSemanticError(std::format("redefinition of label '{}'", labelName),
                             labelDecl.GetLocation());
     } else {
-        m_FunctionScope->AddSymbol(Scope::NamespaceType::Label, labelName, &labelDecl);
+        m_FunctionScope->AddSymbol(Scope::NamespaceType::Label, labelDecl.GetIdentifier(), &labelDecl);
     }
 
     if (m_CurrentLabelDecl) {
@@ -263,21 +286,25 @@ void SemanticAstVisitor::Visit(ParameterDeclaration& paramDecl) {
     paramDecl.SetType(paramDeclQualType);
     Type* paramDeclType = paramDeclQualType.GetSubType();
 
+    declareParameter(paramDecl);
+}
+
+void SemanticAstVisitor::declareParameter(ParameterDeclaration& paramDecl) {
     std::string paramName = paramDecl.GetName();
     assert(m_FunctionScope);
-    if (m_FunctionScope->HasSymbol(Scope::NamespaceType::Ident, paramName)) {
+    if (m_FunctionScope->HasSymbol(Scope::NamespaceType::Ident, paramDecl.GetIdentifier())) {
         printSemanticError(std::format("redefinition of parameter '{}'", paramName),
                             paramDecl.GetLocation());
     } else {
-        m_FunctionScope->AddSymbol(Scope::NamespaceType::Ident, paramName, &paramDecl);
+        m_FunctionScope->AddSymbol(Scope::NamespaceType::Ident, paramDecl.GetIdentifier(), &paramDecl);
     }
 }
 
 void SemanticAstVisitor::Visit(RecordDeclaration& recordDecl) {
     std::string recordName = recordDecl.GetName();
 
-    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Tag, recordName)) {
-        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Tag, recordName);
+    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Tag, recordDecl.GetIdentifier())) {
+        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Tag, recordDecl.GetIdentifier());
         auto* scopeRecordDecl = dynamic_cast<RecordDeclaration*>(decl);
         if (!scopeRecordDecl || recordDecl.IsStruct() != scopeRecordDecl->IsStruct()) {
             printSemanticError(std::format("use of '{}' with tag type that does not "
@@ -287,16 +314,17 @@ void SemanticAstVisitor::Visit(RecordDeclaration& recordDecl) {
             handleTagDeclaration(&recordDecl, recordName, scopeRecordDecl);
         }
     } else {
-        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, recordName);
+        auto decl = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, recordDecl.GetIdentifier());
         if (decl) {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, recordName, *decl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, recordDecl.GetIdentifier(), *decl);
         } else {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, recordName, &recordDecl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Tag, recordDecl.GetIdentifier(), &recordDecl);
         }
     }
 
     Scope* recordScope = m_SymbolTable.CreateScope(std::format("{} [record]", recordName),
                                                     m_CurrentScope);
+    recordScope->SetRecordScope();
     for (Declaration* decl : recordDecl.GetInternalDecls()) {
         if (auto* fieldDecl = dynamic_cast<FieldDeclaration*>(decl)) {
             m_CurrentScope = recordScope;
@@ -307,6 +335,7 @@ void SemanticAstVisitor::Visit(RecordDeclaration& recordDecl) {
             decl->Accept(*this);
         }
     }
+    m_SymbolTable.ExitScope(recordScope);
 }
 
 void SemanticAstVisitor::Visit(TranslationUnit& unit) {
@@ -321,8 +350,8 @@ void SemanticAstVisitor::Visit(TypedefDeclaration& typedefDecl) {
     Type* typedefType = typedefQualType.GetSubType();
 
     std::string typedefName = typedefDecl.GetName();
-    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, typedefName)) {
-        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Ident, typedefName);
+    if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, typedefDecl.GetIdentifier())) {
+        Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Ident, typedefDecl.GetIdentifier());
         auto* scopeTypedefDecl = dynamic_cast<TypedefDeclaration*>(decl);
         if (!scopeTypedefDecl) {
             printSemanticError(std::format("redefinition of '{}' as different kind of symbol",
@@ -333,7 +362,7 @@ void SemanticAstVisitor::Visit(TypedefDeclaration& typedefDecl) {
                                 typedefDecl.GetLocation());
         }
     } else {
-        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, typedefName, &typedefDecl);
+        m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, typedefDecl.GetIdentifier(), &typedefDecl);
     }
 }
 
@@ -356,8 +385,8 @@ void SemanticAstVisitor::Visit(VariableDeclaration& varDecl) {
                                 varDecl.GetLocation());
         }
 
-        if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, varName)) {
-            Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Ident, varName);
+        if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, varDecl.GetIdentifier())) {
+            Declaration* decl = m_CurrentScope->GetSymbol(Scope::NamespaceType::Ident, varDecl.GetIdentifier());
             auto* scopeVarDecl = dynamic_cast<VariableDeclaration*>(decl);
             if (!scopeVarDecl) {
                 printSemanticError(std::format("redefinition of '{}' as different kind of symbol",
@@ -387,14 +416,14 @@ void SemanticAstVisitor::Visit(VariableDeclaration& varDecl) {
                 }
             }
         } else {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, varName, &varDecl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, varDecl.GetIdentifier(), &varDecl);
         }
     } else {  // Local variable
-        if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, varName)) {
+        if (m_CurrentScope->HasSymbol(Scope::NamespaceType::Ident, varDecl.GetIdentifier())) {
             printSemanticError(std::format("redefinition of local variable '{}'", varName),
                                 varDecl.GetLocation());
         } else {
-            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, varName, &varDecl);
+            m_CurrentScope->AddSymbol(Scope::NamespaceType::Ident, varDecl.GetIdentifier(), &varDecl);
         }
     }
 
@@ -403,68 +432,15 @@ void SemanticAstVisitor::Visit(VariableDeclaration& varDecl) {
     }
 
     Expression* initExpr = varDecl.GetInit();
-    initExpr->Accept(*this);
 
     // TODO: Evaluate global variable constant initializer
-    // TODO: Handle initializer lists
-
-    varDeclQualType = varDecl.GetType();
-    QualType exprQualType = initExpr->GetType();
-
-    if (checkArrayInitialization(varDeclQualType, initExpr)) {
-        return;
+    bool isLocal = !varDecl.IsGlobal() && varDecl.GetStorageClass() != StorageClass::kStatic;
+    if (!isLocal && dynamic_cast<InitializerList*>(initExpr)) {
+        ANCL_CRITICAL("Initializer lists of static variables are not supported yet :(");
+        throw std::runtime_error("Not implemented error");
     }
 
-    bool isInitNullPtr = isNullPointerConstant(initExpr);
-
-    if (initExpr->IsLValue()) {
-        auto* cast = m_Program.CreateAstNode<CastExpression>(varDecl.GetInit(),
-                                                             CastExpression::Kind::kLValueToRValue);
-        varDecl.SetInit(cast);
-        exprQualType = cast->GetType();
-    }
-
-    QualType resultUnqualType = varDeclQualType; 
-    resultUnqualType.RemoveQualifiers();
-
-    bool ptrNull = isPointerType(varDeclQualType) && isInitNullPtr;
-
-    bool bothReal = isRealType(varDeclQualType) && isRealType(exprQualType);
-    bool bothRecord = isRecordType(varDeclQualType) && isRecordType(exprQualType);
-    bool bothPtr = isPointerType(varDeclQualType) && isPointerType(exprQualType);
-    if (!bothReal && !bothRecord && !bothPtr && !ptrNull) {
-        printSemanticError("initializing with an expression of incompatible type",
-                            initExpr->GetLocation());
-    }
-
-    if (bothRecord) {
-        if (!areCompatibleTypes(varDeclQualType, exprQualType, /*isPointer=*/false)) {
-            printSemanticError("initializing with an expression of incompatible type",
-                                initExpr->GetLocation());     
-        }
-    } else if (bothPtr && !isPointerToVoidType(varDeclQualType) && !isPointerToVoidType(exprQualType)) {
-        auto* varDeclPtrType = dynamic_cast<PointerType*>(varDeclQualType.GetSubType());
-        QualType varDeclSubType = varDeclPtrType->GetSubType();
-        auto* exprPtrType = dynamic_cast<PointerType*>(exprQualType.GetSubType());
-        QualType exprSubType = exprPtrType->GetSubType();
-
-        if (!areEqualTypes(varDeclSubType.GetSubType(), exprSubType.GetSubType())) {
-            printSemanticError("pointers to compatible types are required",
-                                initExpr->GetLocation());  
-        }
-
-        if (!varDeclSubType.IsConst() && exprSubType.IsConst()) {
-            printSemanticError("initializing discards qualifiers",
-                                initExpr->GetLocation());  
-        }
-    }
-
-    // TODO: Handle null pointer
-    if (!areEqualQualTypes(resultUnqualType, exprQualType) && !ptrNull) {
-        auto* cast = m_Program.CreateAstNode<CastExpression>(varDecl.GetInit(),
-                                                                resultUnqualType);
-        varDecl.SetInit(cast);
-    }
+    varDecl.SetInit(checkInitializer(varDecl.GetType(), initExpr));
 }
 
 
@@ -499,6 +475,9 @@ void SemanticAstVisitor::Visit(CompoundStatement& compoundStmt) {
         stmt->Accept(*this);
     }
 
+    if (m_CurrentScope != oldScope) {
+        m_SymbolTable.ExitScope(m_CurrentScope);
+    }
     m_CurrentScope = oldScope; 
 }
 
@@ -553,19 +532,19 @@ void SemanticAstVisitor::Visit(ForStatement& forStmt) {
     body->Accept(*this);
     m_InsideLoop = wasInsideLoop;
 
-    m_CurrentScope = m_CurrentScope->GetParentScope(); 
+    m_CurrentScope = m_SymbolTable.ExitScope(m_CurrentScope);
 }
 
 void SemanticAstVisitor::Visit(GotoStatement& gotoStmt) {
     LabelDeclaration* labelOldDecl = gotoStmt.GetLabel();
     std::string declName = labelOldDecl->GetName();
 
-    if (!m_FunctionScope->HasSymbol(Scope::NamespaceType::Label, declName)) {
+    if (!m_FunctionScope->HasSymbol(Scope::NamespaceType::Label, labelOldDecl->GetIdentifier())) {
         m_UnlabeledGotos[declName] = &gotoStmt;
         return;
     }
 
-    Declaration* decl = m_FunctionScope->GetSymbol(Scope::NamespaceType::Label, declName);
+    Declaration* decl = m_FunctionScope->GetSymbol(Scope::NamespaceType::Label, labelOldDecl->GetIdentifier());
     auto* labelDecl = dynamic_cast<LabelDeclaration*>(decl);
     assert(labelDecl);
 
@@ -1372,7 +1351,7 @@ void SemanticAstVisitor::Visit(ConstExpression& constExpr) {
     Expression* expr = constExpr.GetExpression();
     expr->Accept(*this);
 
-    IntConstExprAstVisitor constExprVisitor;
+    IntConstExprAstVisitor constExprVisitor{m_Program.GetSourceManager()};
     IntConstExprAstVisitor::Status status = constExprVisitor.Evaluate(constExpr);
     if (status == IntConstExprAstVisitor::Status::kError) {
         printSemanticError("expression is not an integer constant expression",
@@ -1388,7 +1367,7 @@ void SemanticAstVisitor::Visit(DeclRefExpression& declrefExpr) {
         return;
     }
 
-    if (auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, declName)) {
+    if (auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, oldDecl->GetIdentifier())) {
         Declaration* decl = *declOpt;
         auto* valDecl = dynamic_cast<ValueDeclaration*>(decl);
         assert(valDecl);
@@ -1516,10 +1495,15 @@ void SemanticAstVisitor::Visit(UnaryExpression& unaryExpr) {
                 if (varDecl->GetStorageClass() == StorageClass::kRegister) {
                     isRegister = true;
                 }
+                // Globals are shared between the function body workers
+                if (!varDecl->IsGlobal()) {
+                    varDecl->SetAddressTaken();
+                }
             } else if (auto* paramDecl = dynamic_cast<ParameterDeclaration*>(valueDecl)) {
                 if (paramDecl->GetStorageClass() == StorageClass::kRegister) {
                     isRegister = true;
                 }
+                paramDecl->SetAddressTaken();
             }
             if (isRegister) {
                 printSemanticError("address of register variable requested",
@@ -1627,7 +1611,7 @@ void SemanticAstVisitor::Visit(EnumType& enumType) {
 
     std::string enumName = oldDecl->GetName();
 
-    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, enumName);
+    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, oldDecl->GetIdentifier());
     if (!declOpt) {
         return;
     }
@@ -1670,7 +1654,7 @@ void SemanticAstVisitor::Visit(RecordType& recordType) {
 
     std::string recordName = oldDecl->GetName();
 
-    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, recordName);
+    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Tag, oldDecl->GetIdentifier());
     if (!declOpt) {
         return;
     }
@@ -1692,7 +1676,7 @@ void SemanticAstVisitor::Visit(TypedefType& typedefType) {
     TypedefDeclaration* oldDecl = typedefType.GetDeclaration();
     std::string typedefName = oldDecl->GetName();
 
-    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, typedefName);
+    auto declOpt = m_CurrentScope->FindSymbol(Scope::NamespaceType::Ident, oldDecl->GetIdentifier());
     if (!declOpt) {
         printSemanticError(std::format("use of undeclared identifier '{}'", typedefName),
                             oldDecl->GetLocation());
@@ -1732,17 +1716,125 @@ bool SemanticAstVisitor::checkArrayInitialization(QualType arrayQualType, Expres
         return true;
     }
 
-    // TODO: ...
-    ANCL_CRITICAL("Initializer lists are not supported yet :(");
-    throw std::runtime_error("Not implemented error");
-    // exit(EXIT_FAILURE);
-
-    // printSemanticError("array initializer must be an initializer list or string literal",
-    //                    initExpr->GetLocation());
+    printSemanticError("array initializer must be an initializer list or string literal",
+                       initExpr->GetLocation());
 
     return true;
 }
 
+Expression* SemanticAstVisitor::checkInitializer(QualType varDeclQualType, Expression* initExpr) {
+    if (auto* initList = dynamic_cast<InitializerList*>(initExpr)) {
+        checkInitializerList(varDeclQualType, *initList);
+        return initList;
+    }
+
+    initExpr->Accept(*this);
+    QualType exprQualType = initExpr->GetType();
+
+    if (checkArrayInitialization(varDeclQualType, initExpr)) {
+        return initExpr;
+    }
+
+    bool isInitNullPtr = isNullPointerConstant(initExpr);
+
+    Expression* resultExpr = initExpr;
+    if (initExpr->IsLValue()) {
+        resultExpr = m_Program.CreateAstNode<CastExpression>(initExpr,
+                                                             CastExpression::Kind::kLValueToRValue);
+        exprQualType = resultExpr->GetType();
+    }
+
+    QualType resultUnqualType = varDeclQualType; 
+    resultUnqualType.RemoveQualifiers();
+
+    bool ptrNull = isPointerType(varDeclQualType) && isInitNullPtr;
+
+    bool bothReal = isRealType(varDeclQualType) && isRealType(exprQualType);
+    bool bothRecord = isRecordType(varDeclQualType) && isRecordType(exprQualType);
+    bool bothPtr = isPointerType(varDeclQualType) && isPointerType(exprQualType);
+    if (!bothReal && !bothRecord && !bothPtr && !ptrNull) {
+        printSemanticError("initializing with an expression of incompatible type",
+                            initExpr->GetLocation());
+    }
+
+    if (bothRecord) {
+        if (!areCompatibleTypes(varDeclQualType, exprQualType, /*isPointer=*/false)) {
+            printSemanticError("initializing with an expression of incompatible type",
+                                initExpr->GetLocation());     
+        }
+    } else if (bothPtr && !isPointerToVoidType(varDeclQualType) && !isPointerToVoidType(exprQualType)) {
+        auto* varDeclPtrType = dynamic_cast<PointerType*>(varDeclQualType.GetSubType());
+        QualType varDeclSubType = varDeclPtrType->GetSubType();
+        auto* exprPtrType = dynamic_cast<PointerType*>(exprQualType.GetSubType());
+        QualType exprSubType = exprPtrType->GetSubType();
+
+        if (!areEqualTypes(varDeclSubType.GetSubType(), exprSubType.GetSubType())) {
+            printSemanticError("pointers to compatible types are required",
+                                initExpr->GetLocation());  
+        }
+
+        if (!varDeclSubType.IsConst() && exprSubType.IsConst()) {
+            printSemanticError("initializing discards qualifiers",
+                                initExpr->GetLocation());  
+        }
+    }
+
+    // TODO: Handle null pointer
+    if (!areEqualQualTypes(resultUnqualType, exprQualType) && !ptrNull) {
+        resultExpr = m_Program.CreateAstNode<CastExpression>(resultExpr, resultUnqualType);
+    }
+
+    return resultExpr;
+}
+
+void SemanticAstVisitor::checkInitializerList(QualType qualType, InitializerList& initList) {
+    initList.SetType(qualType);
+    initList.SetRValue();
+
+    // Braces are not elided: a nested aggregate takes its own list
+    std::vector<Expression*> inits = initList.GetInits();
+    std::vector<QualType> initQualTypes;
+    initQualTypes.reserve(inits.size());
+
+    Type* type = qualType.GetSubType();
+    if (auto* arrayType = dynamic_cast<ArrayType*>(type)) {
+        uint64_t arraySize = arrayType->GetSize().GetUnsignedValue();
+        if (inits.size() > arraySize) {
+            printSemanticError("excess elements in array initializer",
+                               inits[arraySize]->GetLocation());
+        }
+        initQualTypes.assign(inits.size(), arrayType->GetSubType());
+    } else if (auto* recordType = dynamic_cast<RecordType*>(type)) {
+        RecordDeclaration* recordDecl = recordType->GetDeclaration();
+        std::vector<FieldDeclaration*> fields = recordDecl->GetFields();
+
+        // Only the first member of a union is initialized
+        size_t fieldsNumber = recordDecl->IsUnion() ? std::min<size_t>(fields.size(), 1) : fields.size();
+        if (inits.size() > fieldsNumber) {
+            printSemanticError(std::format("excess elements in {} initializer",
+                                           recordDecl->IsUnion() ? "union" : "struct"),
+                               inits[fieldsNumber]->GetLocation());
+        }
+        for (size_t i = 0; i < inits.size(); ++i) {
+            initQualTypes.push_back(fields[i]->GetType());
+        }
+    } else {
+        if (inits.empty()) {
+            printSemanticError("scalar initializer cannot be empty",
+                               initList.GetLocation());
+        }
+        if (inits.size() > 1) {
+            printSemanticError("excess elements in scalar initializer",
+                               inits[1]->GetLocation());
+        }
+        initQualTypes.push_back(qualType);
+    }
+
+    for (size_t i = 0; i < inits.size(); ++i) {
+        initList.SetInit(i, checkInitializer(initQualTypes[i], inits[i]));
+    }
+}
+
 std::optional<QualType> SemanticAstVisitor::decayType(QualType qualType) {
     Type* type = qualType.GetSubType();
     if (auto* arrayType = dynamic_cast<ArrayType*>(type)) {
@@ -2028,7 +2120,7 @@ void SemanticAstVisitor::handleTagDeclaration(TagDeclaration* decl, const std::s
 
                 currentDecl = prevDecl;
             }
-            m_CurrentScope->UpdateSymbol(Scope::NamespaceType::Tag, name, decl);
+            m_CurrentScope->UpdateSymbol(Scope::NamespaceType::Tag, decl->GetIdentifier(), decl);
         }
     } else {
         if (scopeDecl->IsDefinition()) {
@@ -2044,7 +2136,7 @@ void SemanticAstVisitor::handleTagDeclaration(TagDeclaration* decl, const std::s
             }
         } else {
             decl->SetPreviousDeclaration(scopeDecl);
-            m_CurrentScope->UpdateSymbol(Scope::NamespaceType::Tag, name, decl);
+            m_CurrentScope->UpdateSymbol(Scope::NamespaceType::Tag, decl->GetIdentifier(), decl);
         }
     }
 }
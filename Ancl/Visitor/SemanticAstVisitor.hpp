@@ -28,6 +28,11 @@ public:
     SemanticAstVisitor(ASTProgram& program)
         : m_Program(program) {}
 
+    // Parallel analysis: checks one function body against
+    // the global scope frozen by `globalVisitor.RunDeclarations()`
+    SemanticAstVisitor(ASTProgram& program, const SemanticAstVisitor& globalVisitor)
+        : m_Program(program), m_SymbolTable(&globalVisitor.m_SymbolTable) {}
+
     Status Run() {
         m_Status = Status::kOk;
         Visit(*m_Program.GetTranslationUnit());
@@ -35,6 +40,40 @@ public:
         return m_Status;
     }
 
+    // Streaming compilation: checks one external declaration
+    // against the global scope built so far
+    Status Run(Declaration& decl) {
+        m_Status = Status::kOk;
+        m_ScopesMark = m_SymbolTable.GetMark();
+        decl.Accept(*this);
+
+        return m_Status;
+    }
+
+    // Parallel analysis: checks file-scope declarations only,
+    // function definitions are collected in source order for RunFunctionBody()
+    Status RunDeclarations(std::vector<FunctionDeclaration*>& definitions) {
+        m_Status = Status::kOk;
+        m_DeferredDefinitions = &definitions;
+        Visit(*m_Program.GetTranslationUnit());
+        m_DeferredDefinitions = nullptr;
+
+        return m_Status;
+    }
+
+    Status RunFunctionBody(FunctionDeclaration& funcDecl) {
+        m_Status = Status::kOk;
+        checkFunctionBody(funcDecl, /*areParamTypesResolved=*/true);
+
+        return m_Status;
+    }
+
+    // Releases the scopes created by the last Run(decl),
+    // function declarations do not need them after the check
+    void ReleaseFunctionScopes() {
+        m_SymbolTable.ReleaseScopes(m_ScopesMark);
+    }
+
     void PrintScopeInfoDot(const std::string& filename) {
         SymbolTreeDotConverter dotConverter(m_SymbolTable, filename);
         dotConverter.Convert();
@@ -190,6 +229,8 @@ private:
 
 private:
     bool checkArrayInitialization(QualType arrayQualType, Expression* initExpr);
+    Expression* checkInitializer(QualType varDeclQualType, Expression* initExpr);
+    void checkInitializerList(QualType qualType, InitializerList& initList);
 
     std::optional<QualType> decayType(QualType qualType);
 
@@ -221,13 +262,17 @@ private:
     void handleTagDeclaration(TagDeclaration* decl, const std::string& name,
                               TagDeclaration* scopeDecl);
 
+private:
+    void checkFunctionBody(FunctionDeclaration& funcDecl, bool areParamTypesResolved);
+    void declareParameter(ParameterDeclaration& paramDecl);
+
 private:
     void printSemanticWarning(const std::string& text, const Location& location) {
-        ANCL_WARN("{} {}", location.ToString(), text);
+        ANCL_WARN("{} {}", m_Program.GetSourceManager().ToString(location), text);
     }
 
     void printSemanticError(const std::string& text, const Location& location) {
-        ANCL_ERROR("{} {}", location.ToString(), text);
+        ANCL_ERROR("{} {}", m_Program.GetSourceManager().ToString(location), text);
 
         // TODO: Handle error
         m_Status = Status::kError;
@@ -241,6 +286,7 @@ private:
 
     SymbolTable m_SymbolTable;
     Scope* m_CurrentScope = m_SymbolTable.GetGlobalScope();
+    SymbolTable::Mark m_ScopesMark;
 
     FunctionDeclaration* m_CurrentFunctionDecl = nullptr;
     Scope* m_FunctionScope = nullptr;
@@ -255,6 +301,8 @@ private:
     LabelDeclaration* m_CurrentLabelDecl = nullptr;
 
     bool m_HasReturn = false;
+
+    std::vector<FunctionDeclaration*>* m_DeferredDefinitions = nullptr;
 };
 
 }  // namespace ast
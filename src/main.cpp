@@ -1,3 +1,5 @@
+#include <fstream>
+#include <memory>
 #include <string>
 #include <sstream>
 
@@ -27,19 +29,35 @@ int main(int argc, char** argv) {
     std::string machineIRPath;
     app.add_option("-m,--mir", machineIRPath, "Machine IR output directory")->check(CLI::ExistingDirectory);
 
-    auto* asmGroup = app.add_option_group("asm");
+    auto* outputGroup = app.add_option_group("output");
 
     std::string intelPath;
-    asmGroup->add_option("-n,--intel-asm", intelPath, "Intel assembler output filename");
+    outputGroup->add_option("-n,--intel-asm", intelPath, "Intel assembler output filename");
 
     std::string gasPath;
-    asmGroup->add_option("-g,--gas-asm", gasPath, "GAS assembler output filename");
+    outputGroup->add_option("-g,--gas-asm", gasPath, "GAS assembler output filename");
 
-    asmGroup->require_option(1);
+    std::string tokensFilename;
+    outputGroup->add_option("-t,--tokens", tokensFilename, "Filename to output the tokens of the input file (not preprocessed)");
+
+    outputGroup->require_option(1);
 
     bool useOptimizations = false;
     app.add_flag("-O,--optim", useOptimizations, "Use optimizations");
 
+    bool useFastLexer = false;
+    app.add_flag("--fast-lexer", useFastLexer, "Use hand-written lexer instead of the generated ANTLR lexer");
+
+    bool useStreaming = false;
+    app.add_flag("--stream", useStreaming, "Compile declarations one by one releasing function bodies (no intermediate dumps, inlines only earlier callees)");
+
+    size_t threadsNumber = 1;
+    app.add_option("-j,--jobs", threadsNumber, "Threads to check and lower function bodies with (ignored in streaming mode)")
+        ->check(CLI::PositiveNumber);
+
+    bool verifyDominators = false;
+    app.add_flag("--verify-dom", verifyDominators, "Check the dominator trees updated by the passes against rebuilt ones");
+
     bool isLinearScan = false;
     app.add_flag("--linscan", isLinearScan, "Use Linear Scan Allocator (works unstable with spilling)");
 
@@ -55,22 +73,43 @@ int main(int argc, char** argv) {
     anclDriver.SetMIREmitterPath(machineIRPath);
 
     anclDriver.SetUseOptimizations(useOptimizations);
+    anclDriver.SetUseFastLexer(useFastLexer);
+    anclDriver.SetThreadsNumber(threadsNumber);
+    anclDriver.SetVerifyDominators(verifyDominators);
     anclDriver.SetUseGraphColorAllocatorFlag(!isLinearScan);
 
     anclDriver.SetIntelEmitterPath(intelPath);
     anclDriver.SetGASEmitterPath(gasPath);
 
-    Driver::ParseResult result = Driver::ParseResult::kOK;
+    if (!tokensFilename.empty()) {
+        std::ifstream sourceStream{sourceFile};
+        if (anclDriver.DumpTokens(sourceStream, tokensFilename) != Driver::ParseResult::kOK) {
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::unique_ptr<std::istream> stream;
     if (preprocFilename.empty()) {
-        std::string preprocessed = anclDriver.Preprocess(sourceFile);
-        std::istringstream stream{preprocessed};
-        result = anclDriver.Parse(stream);
+        stream = std::make_unique<std::istringstream>(anclDriver.Preprocess(sourceFile));
     } else {
         anclDriver.PreprocessToFile(sourceFile, preprocFilename);
-        std::ifstream stream{preprocFilename};
-        result = anclDriver.Parse(stream);
+        stream = std::make_unique<std::ifstream>(preprocFilename);
     }
-    if (result != Driver::ParseResult::kOK) {
+
+    if (useStreaming) {
+        try {
+            if (anclDriver.CompileStreaming(*stream) != Driver::ParseResult::kOK) {
+                return EXIT_FAILURE;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << '\n';
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if (anclDriver.Parse(*stream) != Driver::ParseResult::kOK) {
         return EXIT_FAILURE;
     }
 
@@ -0,0 +1,81 @@
+#include "include/std.h"
+
+struct triple {
+    int a;
+    short b;
+    char c;
+};
+
+long sumEvery(int* values, int n, int step) {
+    long sum = 0;
+    for (int i = 0; i < n; i = i + step) {
+        sum = sum + values[i];
+    }
+    return sum;
+}
+
+int sumTriples(struct triple* triples, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum = sum + triples[i].a * triples[i].b + triples[i].c;
+    }
+    return sum;
+}
+
+void fillSquares(long* squares, int n) {
+    for (int i = 0; i < n; ++i) {
+        squares[i] = i * 12 + (i << 2);
+    }
+}
+
+int backwards(short* values, int n) {
+    int result = 0;
+    for (int i = n - 1; i >= 0; i = i - 3) {
+        result = result * 3 + values[i];
+    }
+    return result;
+}
+
+int columns(int* matrix, int rows, int cols) {
+    int sum = 0;
+    for (int j = 0; j < cols; ++j) {
+        for (int i = 0; i < rows; ++i) {
+            sum = sum + matrix[i * cols + j] * (j + 1);
+        }
+    }
+    return sum;
+}
+
+int main() {
+    int values[60];
+    for (int i = 0; i < 60; ++i) {
+        values[i] = i * 7 - 100;
+    }
+    printf("%ld %ld %ld\n", sumEvery(values, 60, 1), sumEvery(values, 60, 2), sumEvery(values, 59, 5));
+
+    struct triple triples[10];
+    for (int i = 0; i < 10; ++i) {
+        triples[i].a = i + 1;
+        triples[i].b = 10 - i;
+        triples[i].c = i * 3;
+    }
+    printf("%d\n", sumTriples(triples, 10));
+
+    long squares[20];
+    fillSquares(squares, 20);
+    printf("%ld %ld %ld\n", squares[0], squares[7], squares[19]);
+
+    short shorts[25];
+    for (int i = 0; i < 25; ++i) {
+        shorts[i] = 50 - i * 4;
+    }
+    printf("%d %d\n", backwards(shorts, 25), backwards(shorts, 2));
+
+    int matrix[24];
+    for (int i = 0; i < 24; ++i) {
+        matrix[i] = i % 5 - 2;
+    }
+    printf("%d\n", columns(matrix, 4, 6));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,47 @@
+#include "include/std.h"
+
+volatile int status;
+int plain;
+
+int readStatus() {
+    return status;
+}
+
+void writeStatus(int value) {
+    status = value;
+    status = value + 1;
+}
+
+int readTwice(volatile int* value) {
+    int first = *value;
+    int second = *value;
+    return first + second;
+}
+
+void bump(volatile int* value, int n) {
+    for (int i = 0; i < n; ++i) {
+        *value = *value + 1;
+    }
+}
+
+int localVolatile(int n) {
+    volatile int local = n;
+    bump(&local, 5);
+    return readTwice(&local);
+}
+
+int main() {
+    writeStatus(10);
+    int before = readStatus();
+
+    for (int i = 0; i < 4; ++i) {
+        writeStatus(i);
+        plain = plain + readStatus();
+    }
+    printf("%d %d %d\n", before, status, plain);
+
+    bump(&status, 7);
+    printf("%d %d\n", readTwice(&status), localVolatile(3));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include "include/std.h"
+
+// Streaming compilation inlines the small callees defined earlier,
+// their bodies are kept after their own code is emitted
+
+int later(int x);
+
+int square(int x) {
+    return x * x;
+}
+
+int clamp(int x, int low, int high) {
+    if (x < low) {
+        return low;
+    }
+    if (x > high) {
+        return high;
+    }
+    return x;
+}
+
+// Has square inlined already when it is inlined itself
+int sumOfSquares(int a, int b) {
+    return square(a) + square(b);
+}
+
+static int classify(int x) {
+    switch (x % 4) {
+        case 0:
+            return 10;
+        case 1:
+            return 20;
+        case 2:
+            return 30;
+        default:
+            return 40;
+    }
+}
+
+void accumulate(int* total, int value) {
+    if (value < 0) {
+        return;
+    }
+    *total = *total + value;
+}
+
+static inline int triangle(int n) {
+    int sum = 0;
+    for (int i = 1; i <= n; ++i) {
+        sum = sum + i;
+    }
+    return sum;
+}
+
+int factorial(int n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * factorial(n - 1);
+}
+
+int useAll(int n) {
+    int total = 0;
+    for (int i = -2; i < n; ++i) {
+        accumulate(&total, clamp(i, 0, 5));
+        accumulate(&total, classify(i + 2));
+    }
+    return total + sumOfSquares(n, n + 1) + triangle(n) + later(n);
+}
+
+int later(int x) {
+    return x * 3 + 1;
+}
+
+int main() {
+    int total = 0;
+    for (int i = 0; i < 6; ++i) {
+        total = total + useAll(i) + factorial(i) + square(i);
+    }
+    printf("%d %d %d\n", total, clamp(42, 0, 10), later(7));
+    printf("%d %d\n", sumOfSquares(3, 4), classify(7));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+#include "include/std.h"
+
+int calls;
+
+int next() {
+    calls = calls + 1;
+    return calls % 3 == 0;
+}
+
+int loopBackEdge(int n) {
+    while (1) {
+        if (next()) {
+            continue;
+        }
+        if (!n) {
+            return 0;
+        }
+        return loopBackEdge(n - 1);
+    }
+}
+
+long factorial(long n, long accumulator) {
+    if (n <= 1) {
+        return accumulator;
+    }
+    return factorial(n - 1, accumulator * n);
+}
+
+int gcd(int a, int b) {
+    if (b == 0) {
+        return a;
+    }
+    return gcd(b, a % b);
+}
+
+int sumTo(int n, int accumulator) {
+    if (n == 0) {
+        return accumulator;
+    }
+    int step = n % 2 == 0 ? n : -n;
+    return sumTo(n - 1, accumulator + step);
+}
+
+int swapped(int a, int b, int depth) {
+    if (depth == 0) {
+        return a * 100 + b;
+    }
+    return swapped(b, a + depth, depth - 1);
+}
+
+double halve(double value, int times) {
+    if (times == 0) {
+        return value;
+    }
+    return halve(value / 2, times - 1);
+}
+
+int loopThenRecurse(int n, int total) {
+    for (int i = 0; i < n; ++i) {
+        total = total + i;
+    }
+    if (n > 0) {
+        return loopThenRecurse(n - 1, total);
+    }
+    return total;
+}
+
+int isOdd(int n);
+
+int isEven(int n) {
+    if (n == 0) {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
+
+int isOdd(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+int square(int x) {
+    return x * x;
+}
+
+int negate(int x) {
+    return -x;
+}
+
+int choose(int x) {
+    if (x > 10) {
+        return square(x);
+    }
+    if (x < -10) {
+        return negate(x);
+    }
+    return x + 1;
+}
+
+void report(int value) {
+    printf("report %d\n", value);
+}
+
+void reportTwice(int value) {
+    report(value);
+    report(value * 2);
+}
+
+int mix(int a, int b, int c, int d, int e, int f) {
+    return a + b * 2 + c * 3 + d * 4 + e * 5 + f * 6;
+}
+
+int forward(int a, int b) {
+    return mix(b, a, b, a, a + b, a - b);
+}
+
+int manyExits(int x, int y) {
+    int a = square(x);
+    int b = square(y);
+    int c = a - b;
+    if (c > 100) {
+        return a + b + c + negate(c);
+    }
+    int d = square(a % 7 + b % 5);
+    if (d % 2 == 0) {
+        return a * 3 + b + c + d;
+    }
+    if (d > 10) {
+        return choose(a + b + c + d);
+    }
+    return a + b * 5 + c * 7 + d * 11;
+}
+
+int main() {
+    calls = 0;
+    int result = loopBackEdge(10);
+    printf("%d %d\n", result, calls);
+
+    printf("%ld %ld\n", factorial(20, 1), factorial(1, 5));
+    printf("%d %d %d\n", gcd(1071, 462), gcd(17, 5), gcd(0, 9));
+    printf("%d %d\n", sumTo(10000, 0), sumTo(7, 3));
+    printf("%d %d\n", swapped(1, 2, 5), swapped(4, 3, 0));
+    printf("%f\n", halve(1000.0, 6));
+    printf("%d\n", loopThenRecurse(20, 1));
+    printf("%d %d\n", isEven(1000), isOdd(777));
+    printf("%d %d %d\n", choose(12), choose(-20), choose(3));
+    reportTwice(21);
+    printf("%d\n", forward(3, 8));
+
+    for (int x = -3; x < 20; x = x + 4) {
+        printf("%d ", manyExits(x, x / 2 - 3));
+        printf("%d ", manyExits(x / 3, x));
+    }
+    printf("\n");
+
+    return EXIT_SUCCESS;
+}
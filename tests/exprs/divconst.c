@@ -0,0 +1,149 @@
+#include "include/std.h"
+
+void signed32(int x) {
+    int q2 = x / 2;
+    int r2 = x % 2;
+    int q3 = x / 3;
+    int r3 = x % 3;
+    int q7 = x / 7;
+    int r7 = x % 7;
+    int qm3 = x / -3;
+    int rm3 = x % -3;
+    int qm4 = x / -4;
+    int rm4 = x % -4;
+    int q16 = x / 16;
+    int r16 = x % 16;
+    int qbig = x / 1073741824;
+    int rbig = x % 1073741824;
+    int qmin = x / (-2147483647 - 1);
+    int rmin = x % (-2147483647 - 1);
+    int qmax = x / 2147483647;
+    int rmax = x % 2147483647;
+    int q641 = x / 641;
+    int r641 = x % 641;
+    printf("%d %d %d %d %d %d %d %d %d %d ", q2, r2, q3, r3, q7, r7, qm3, rm3, qm4, rm4);
+    printf("%d %d %d %d %d %d %d %d %d %d\n", q16, r16, qbig, rbig, qmin, rmin, qmax, rmax, q641, r641);
+}
+
+void unsigned32(unsigned int x) {
+    unsigned int q2 = x / 2;
+    unsigned int r2 = x % 2;
+    unsigned int q3 = x / 3;
+    unsigned int r3 = x % 3;
+    unsigned int q7 = x / 7;
+    unsigned int r7 = x % 7;
+    unsigned int q10 = x / 10;
+    unsigned int r10 = x % 10;
+    unsigned int q64 = x / 64;
+    unsigned int r64 = x % 64;
+    unsigned int qhigh = x / (unsigned int)(-2147483647 - 1);
+    unsigned int rhigh = x % (unsigned int)(-2147483647 - 1);
+    unsigned int qmax = x / (unsigned int)-1;
+    unsigned int rmax = x % (unsigned int)-1;
+    unsigned int qm3 = x / (unsigned int)-3;
+    unsigned int rm3 = x % (unsigned int)-3;
+    unsigned int q641 = x / 641;
+    unsigned int r641 = x % 641;
+    printf("%u %u %u %u %u %u %u %u %u %u ", q2, r2, q3, r3, q7, r7, q10, r10, q64, r64);
+    printf("%u %u %u %u %u %u %u %u\n", qhigh, rhigh, qmax, rmax, qm3, rm3, q641, r641);
+}
+
+void signed64(long x) {
+    long q2 = x / 2;
+    long r2 = x % 2;
+    long q3 = x / 3;
+    long r3 = x % 3;
+    long q7 = x / 7;
+    long r7 = x % 7;
+    long qm3 = x / -3;
+    long rm3 = x % -3;
+    long qm4 = x / -4;
+    long rm4 = x % -4;
+    long q1024 = x / 1024;
+    long r1024 = x % 1024;
+    long qint = x / (-2147483647 - 1);
+    long rint = x % (-2147483647 - 1);
+    long qbig = x / ((long)2147483647 * 4 + 3);
+    long rbig = x % ((long)2147483647 * 4 + 3);
+    long qpow = x / ((long)1 << 40);
+    long rpow = x % ((long)1 << 40);
+    printf("%ld %ld %ld %ld %ld %ld %ld %ld %ld %ld ", q2, r2, q3, r3, q7, r7, qm3, rm3, qm4, rm4);
+    printf("%ld %ld %ld %ld %ld %ld %ld %ld\n", q1024, r1024, qint, rint, qbig, rbig, qpow, rpow);
+}
+
+void unsigned64(unsigned long x) {
+    unsigned long q2 = x / 2;
+    unsigned long r2 = x % 2;
+    unsigned long q3 = x / 3;
+    unsigned long r3 = x % 3;
+    unsigned long q7 = x / 7;
+    unsigned long r7 = x % 7;
+    unsigned long q10 = x / 10;
+    unsigned long r10 = x % 10;
+    unsigned long q4096 = x / 4096;
+    unsigned long r4096 = x % 4096;
+    unsigned long qmax = x / (unsigned long)-1;
+    unsigned long rmax = x % (unsigned long)-1;
+    unsigned long qm3 = x / (unsigned long)-3;
+    unsigned long rm3 = x % (unsigned long)-3;
+    unsigned long qhigh = x / ((unsigned long)1 << 63);
+    unsigned long rhigh = x % ((unsigned long)1 << 63);
+    unsigned long quint = x / (unsigned int)-1;
+    unsigned long ruint = x % (unsigned int)-1;
+    printf("%lu %lu %lu %lu %lu %lu %lu %lu %lu %lu ", q2, r2, q3, r3, q7, r7, q10, r10, q4096, r4096);
+    printf("%lu %lu %lu %lu %lu %lu %lu %lu\n", qmax, rmax, qm3, rm3, qhigh, rhigh, quint, ruint);
+}
+
+int main() {
+    int intMin = -2147483647 - 1;
+    int intMax = 2147483647;
+    int ints[12];
+    ints[0] = 0;
+    ints[1] = -1;
+    ints[2] = 1;
+    ints[3] = intMin;
+    ints[4] = intMax;
+    ints[5] = 100;
+    ints[6] = -100;
+    ints[7] = 20;
+    ints[8] = -21;
+    ints[9] = intMin + 1;
+    ints[10] = intMax - 1;
+    ints[11] = 1234567;
+    for (int i = 0; i < 12; ++i) {
+        signed32(ints[i]);
+    }
+
+    for (int i = 0; i < 12; ++i) {
+        unsigned32(ints[i]);
+    }
+    unsigned32((unsigned int)-1);
+    unsigned32((unsigned int)-2);
+
+    long longMax = ((long)1 << 62) - 1 + ((long)1 << 62);
+    long longMin = -longMax - 1;
+    long longs[12];
+    longs[0] = 0;
+    longs[1] = -1;
+    longs[2] = intMin;
+    longs[3] = intMax;
+    longs[4] = longMin;
+    longs[5] = longMax;
+    longs[6] = longMin + 1;
+    longs[7] = (long)intMax * 4 + 3;
+    longs[8] = -((long)intMax * 4 + 3);
+    longs[9] = (long)1 << 40;
+    longs[10] = (long)99999 * 1000000 + 999999;
+    longs[11] = -7;
+    for (int i = 0; i < 12; ++i) {
+        signed64(longs[i]);
+    }
+
+    for (int i = 0; i < 12; ++i) {
+        unsigned64(longs[i]);
+    }
+    unsigned64((unsigned long)-1);
+    unsigned64((unsigned long)-3);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#include "include/std.h"
+
+int identities(int x, int y) {
+    int a = x + 0;
+    int b = (y * 1) | 0;
+    int c = (x ^ 0) - 0;
+    int d = (x & -1) + (y * 0);
+    int e = (x - x) + (y ^ y);
+    int f = (x & x) + (y | y);
+    return a + b * 3 + c * 5 + d * 7 + e + f * 11;
+}
+
+int negations(int x, int y) {
+    int a = x + (0 - y);
+    int b = (0 - x) + y;
+    int c = x - (0 - y);
+    int d = 0 - (0 - x);
+    int e = x * -1;
+    return a * 10000 + b * 1000 + c * 100 + d * 10 + e;
+}
+
+int constantChains(int x) {
+    int a = ((x + 3) + 4) - 10;
+    int b = ((x * 3) * 5) * -2;
+    int c = ((x & 252) & 63) | 1;
+    int d = ((x | 16) | 3) ^ 5;
+    int e = ((x ^ 12) ^ 10) - 1;
+    return a + b + c + d + e;
+}
+
+long shiftChains(long x, int y) {
+    unsigned long ux = x;
+    unsigned long a = (ux << 3) << 5;
+    long b = (x >> 2) >> 62;
+    unsigned int u = y;
+    unsigned int c = (u << 20) << 11;
+    unsigned int d = (u >> 16) >> 16;
+    unsigned int e = (u >> 3) >> 4;
+    int f = (y >> 20) >> 20;
+    return a + b + c + d + e + f;
+}
+
+int powerMultiplies(int x, long y) {
+    int a = x * 8;
+    long b = y * 1024;
+    int c = x * 2 + x * 64;
+    return a + (int)(b % 1000003) + c;
+}
+
+int boolCompares(int x, int y) {
+    int less = x < y;
+    int a = (less != 0) + (less == 0) * 2;
+    int b = ((x == y) == 1) * 4;
+    int c = ((x >= y) != 1) * 8;
+    int d = (x < x) + (y <= y) * 16 + (x != x) * 32;
+    return a + b + c + d;
+}
+
+long casts(char c, short s, int i) {
+    long a = (long)(int)(short)c;
+    unsigned long b = (unsigned long)(unsigned int)(unsigned short)s;
+    char d = (char)(long)i;
+    short e = (short)(int)c;
+    int f = (int)(long)s;
+    return a * 100000 + b + d * 1000 + e * 10 + f;
+}
+
+int main() {
+    printf("%d %d\n", identities(5, 7), identities(-3, 12));
+    printf("%d %d\n", negations(9, 4), negations(-2, 6));
+    printf("%d %d\n", constantChains(77), constantChains(-45));
+    printf("%ld %ld\n", shiftChains(3, 1), shiftChains(-5, -1234567));
+    printf("%d %d\n", powerMultiplies(13, 100000), powerMultiplies(-7, -3));
+    printf("%d %d %d\n", boolCompares(1, 2), boolCompares(3, 3), boolCompares(5, -1));
+    printf("%ld %ld\n", casts(65, 300, 1000), casts(-7, -2, -300));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+#include "include/std.h"
+
+void signed32(int x) {
+    int m3 = x * 3;
+    int m5 = x * 5;
+    int m9 = x * 9;
+    int m12 = x * 12;
+    int m45 = x * 45;
+    int m7 = x * 7;
+    int m15 = x * 15;
+    int m17 = x * 17;
+    int m31 = x * 31;
+    int m33 = x * 33;
+    int m63 = x * 63;
+    int m65 = x * 65;
+    int mneg = x * -9;
+    printf("%d %d %d %d %d %d %d ", m3, m5, m9, m12, m45, m7, m15);
+    printf("%d %d %d %d %d %d\n", m17, m31, m33, m63, m65, mneg);
+}
+
+void unsigned32(unsigned int x) {
+    unsigned int m3 = x * 3;
+    unsigned int m5 = x * 5;
+    unsigned int m9 = x * 9;
+    unsigned int m12 = x * 12;
+    unsigned int m45 = x * 45;
+    unsigned int m255 = x * 255;
+    unsigned int m257 = x * 257;
+    unsigned int m1023 = x * 1023;
+    unsigned int m1025 = x * 1025;
+    printf("%u %u %u %u %u %u %u %u %u\n", m3, m5, m9, m12, m45, m255, m257, m1023, m1025);
+}
+
+void unsigned64(unsigned long x) {
+    unsigned long m3 = x * 3;
+    unsigned long m5 = x * 5;
+    unsigned long m9 = x * 9;
+    unsigned long m12 = x * 12;
+    unsigned long m45 = x * 45;
+    unsigned long m7 = x * 7;
+    unsigned long m17 = x * 17;
+    unsigned long m4095 = x * 4095;
+    unsigned long m4097 = x * 4097;
+    unsigned long mhuge = x * (((unsigned long)1 << 32) + 1);
+    printf("%lu %lu %lu %lu %lu %lu %lu %lu %lu %lu\n", m3, m5, m9, m12, m45, m7, m17, m4095, m4097, mhuge);
+}
+
+long signed64(long x) {
+    long sum = x * 3 + x * 5 * 2 + x * 9 - x * 12 + x * 45;
+    return sum + x * 31 - x * 129;
+}
+
+void powerOfTwoUnsigned(unsigned int x, unsigned long y) {
+    unsigned int d8 = x / 8;
+    unsigned int r16 = x % 16;
+    unsigned int d1 = x / 1;
+    unsigned int r1 = x % 1;
+    unsigned int dhigh = x / (unsigned int)(-2147483647 - 1);
+    unsigned long d1024 = y / 1024;
+    unsigned long r4096 = y % 4096;
+    unsigned long dhuge = y / ((unsigned long)1 << 40);
+    unsigned long rhuge = y % ((unsigned long)1 << 40);
+    printf("%u %u %u %u %u ", d8, r16, d1, r1, dhigh);
+    printf("%lu %lu %lu %lu\n", d1024, r4096, dhuge, rhuge);
+}
+
+void floatDivisions(double x, float y) {
+    double a = x / 2.0;
+    double b = x / 0.25;
+    double c = x / 1024.0;
+    double d = x / 3.0;
+    double e = x / -8.0;
+    double f = x / 0.1;
+    float g = y / 4.0;
+    float h = y / 10.0;
+    double gd = g;
+    double hd = h;
+    printf("%.17g %.17g %.17g %.17g %.17g %.17g %.9g %.9g\n", a, b, c, d, e, f, gd, hd);
+}
+
+int main() {
+    int values[8];
+    values[0] = 0;
+    values[1] = 1;
+    values[2] = -1;
+    values[3] = 7;
+    values[4] = -123;
+    values[5] = 1000;
+    values[6] = -46000;
+    values[7] = 33333;
+    for (int i = 0; i < 8; ++i) {
+        signed32(values[i]);
+    }
+
+    unsigned int big = 2147483647;
+    big = big + 12345;
+    unsigned32(0);
+    unsigned32(1);
+    unsigned32(big);
+    unsigned32((unsigned int)-1);
+    unsigned32(98765);
+
+    unsigned64(0);
+    unsigned64((unsigned long)-1);
+    unsigned64(((unsigned long)1 << 63) + 5);
+    unsigned64(123456789);
+
+    printf("%ld %ld %ld\n", signed64(0), signed64(-77), signed64(1000003));
+
+    powerOfTwoUnsigned(0, 0);
+    powerOfTwoUnsigned(big, (unsigned long)-1);
+    powerOfTwoUnsigned(12345, ((unsigned long)1 << 40) + 4097);
+
+    floatDivisions(1.0, 1.0);
+    floatDivisions(-7.5, 3.5);
+    floatDivisions(10000000000.0, -12345.678);
+    floatDivisions(0.3, 0.7);
+
+    return EXIT_SUCCESS;
+}
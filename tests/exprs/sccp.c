@@ -0,0 +1,83 @@
+#include "include/std.h"
+
+int constantBranch(int x) {
+    int mode = 3;
+    int limit = mode * 4 - 2;
+    if (limit > 10) {
+        return x * 1000;
+    }
+    if (limit == 10) {
+        return x + limit;
+    }
+    return -x;
+}
+
+int loopConstant(int n) {
+    int flag = 1;
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        if (flag != 1) {
+            flag = 2;
+            sum = sum - 100;
+        }
+        sum = sum + flag * i;
+    }
+    return sum;
+}
+
+int constantSwitch(int x) {
+    int kind = 2;
+    int offset = 0;
+    if (kind < 5) {
+        offset = 7;
+    } else {
+        offset = -7;
+    }
+
+    switch (kind + offset) {
+        case 1:
+            return x;
+        case 9:
+            return x * 9 + offset;
+        case 10:
+            return 10;
+        default:
+            return -1;
+    }
+}
+
+int switchDefault(int x) {
+    int key = 40 / 8;
+    switch (key) {
+        case 1:
+            x = x + 1;
+            break;
+        case 2:
+            x = x + 2;
+            break;
+        default:
+            x = x * 3;
+            break;
+    }
+    return x;
+}
+
+long narrowFolds() {
+    char c = 100;
+    char d = c + c;
+    unsigned int big = 2000000000;
+    big = big * 2 - 1000;
+    unsigned short s = 65535;
+    s = s + 2;
+    long result = d * 1000000;
+    return result + (big / 3) % 1000 + (big >> 28) + s;
+}
+
+int main() {
+    printf("%d %d\n", constantBranch(5), constantBranch(-8));
+    printf("%d\n", loopConstant(10));
+    printf("%d %d\n", constantSwitch(4), switchDefault(11));
+    printf("%ld\n", narrowFolds());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,227 @@
+#include "include/std.h"
+
+int flags;
+
+int maxSigned(int a, int b) {
+    int result;
+    if (a > b) {
+        result = a;
+    } else {
+        result = b;
+    }
+    return result;
+}
+
+unsigned int minUnsigned(unsigned int a, unsigned int b) {
+    unsigned int result = b;
+    if (a < b) {
+        result = a;
+    }
+    return result;
+}
+
+long clampLong(long value, long low, long high) {
+    if (value < low) {
+        value = low;
+    }
+    if (value > high) {
+        value = high;
+    }
+    return value;
+}
+
+unsigned long pickUnsigned(unsigned long a, unsigned long b) {
+    unsigned long result;
+    if (a >= b) {
+        result = a - b;
+    } else {
+        result = b * 3 + 1;
+    }
+    return result;
+}
+
+short pickShort(short a, short b) {
+    short result = a;
+    if (a <= b) {
+        result = b + 2;
+    }
+    return result;
+}
+
+int diamondArithmetic(int x, int y) {
+    int a;
+    int b;
+    if (x != y) {
+        a = x * 2 + y;
+        b = x - y;
+    } else {
+        a = y - 7;
+        b = x * y;
+    }
+    return a * 1000 + b;
+}
+
+int* pickPointer(int* first, int* second, int useFirst) {
+    int* result = second;
+    if (useFirst) {
+        result = first;
+    }
+    return result;
+}
+
+int truthValue(int value) {
+    int result = 10;
+    if (value) {
+        result = 20;
+    }
+    return result;
+}
+
+int conditionReused(int a, int b) {
+    int less = a < b;
+    int result = a;
+    if (less) {
+        result = b;
+    }
+    return result + less * 100;
+}
+
+int floatCompare(double a, double b) {
+    int result = 1;
+    if (a < b) {
+        result = 2;
+    }
+    return result;
+}
+
+int nestedSelects(int x) {
+    int result = 0;
+    if (x > 0) {
+        if (x > 100) {
+            result = 3;
+        } else {
+            result = 2;
+        }
+    } else {
+        result = 1;
+    }
+    return result;
+}
+
+char pickChar(char a, char b, int which) {
+    char result = a;
+    if (which > 0) {
+        result = b;
+    }
+    return result;
+}
+
+double pickDouble(double a, double b, int which) {
+    double result = a;
+    if (which > 0) {
+        result = b;
+    }
+    return result;
+}
+
+float pickFloat(float a, float b) {
+    float result;
+    if (a < b) {
+        result = a * 2;
+    } else {
+        result = b * 3;
+    }
+    return result;
+}
+
+int safeDivide(int a, int b) {
+    int result = 0;
+    if (b != 0) {
+        result = a / b;
+    }
+    return result;
+}
+
+unsigned int safeRemainder(unsigned int a, unsigned int b) {
+    unsigned int result;
+    if (b > 0) {
+        result = a % b;
+    } else {
+        result = a;
+    }
+    return result;
+}
+
+double safeFloatDivide(double a, double b) {
+    double result = 0.0;
+    if (b != 0.0) {
+        result = a / b;
+    }
+    return result;
+}
+
+int safeLoad(int* pointer) {
+    int result = -1;
+    if (pointer) {
+        result = *pointer;
+    }
+    return result;
+}
+
+int sideEffect(int x) {
+    int result = x;
+    if (x > 5) {
+        flags = flags + 1;
+        result = x - 5;
+    }
+    return result;
+}
+
+int main() {
+    printf("%d %d %d\n", maxSigned(3, 9), maxSigned(-4, -8), maxSigned(5, 5));
+
+    unsigned int big = 1500000000;
+    big = big * 2;
+    unsigned int m1 = minUnsigned(big, 7);
+    unsigned int m2 = minUnsigned(4, big);
+    printf("%u %u\n", m1, m2);
+
+    printf("%ld %ld %ld\n", clampLong(-50, -10, 10), clampLong(25, -10, 10), clampLong(3, -10, 10));
+
+    unsigned long huge = big;
+    huge = huge * 4;
+    printf("%lu %lu\n", pickUnsigned(huge, 5), pickUnsigned(5, huge));
+    int short1 = pickShort(-3, 4);
+    int short2 = pickShort(300, 200);
+    printf("%d %d\n", short1, short2);
+    printf("%d %d\n", diamondArithmetic(6, 2), diamondArithmetic(4, 4));
+
+    int first = 11;
+    int second = 22;
+    printf("%d %d\n", *pickPointer(&first, &second, 1), *pickPointer(&first, &second, 0));
+    printf("%d %d %d\n", truthValue(0), truthValue(-9), truthValue(1));
+    printf("%d %d\n", conditionReused(1, 2), conditionReused(8, 2));
+    printf("%d %d\n", floatCompare(1.5, 2.5), floatCompare(2.5, 1.5));
+    printf("%d %d %d\n", nestedSelects(-5), nestedSelects(50), nestedSelects(500));
+
+    int c1 = pickChar('a', 'b', 1);
+    int c2 = pickChar('a', 'b', -1);
+    printf("%d %d\n", c1, c2);
+    printf("%f %f\n", pickDouble(1.25, 2.5, 1), pickDouble(1.25, 2.5, 0));
+    double f1 = pickFloat(1.5, 4.0);
+    double f2 = pickFloat(4.0, 1.5);
+    printf("%f %f\n", f1, f2);
+
+    printf("%d %d\n", safeDivide(17, 5), safeDivide(17, 0));
+    printf("%u %u\n", safeRemainder(big, 7), safeRemainder(big, 0));
+    printf("%f %f\n", safeFloatDivide(9.0, 4.0), safeFloatDivide(9.0, 0.0));
+    int* none = 0;
+    printf("%d %d\n", safeLoad(&first), safeLoad(none));
+
+    flags = 0;
+    int s1 = sideEffect(3);
+    int s2 = sideEffect(9);
+    printf("%d %d %d\n", s1, s2, flags);
+
+    return EXIT_SUCCESS;
+}
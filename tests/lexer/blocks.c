@@ -0,0 +1,9 @@
+/* Tokens and skipped text that straddle the 16-byte blocks of the lexer */
+int abcdefghijklmnopqrstuvwxyz_0123456789_abcdefghijklmnopqrstuvwxyz;
+int x=1                                                   ;
+char* s = "0123456789abcdef\"0123456789abcdef\\0123456789\x41\101é";
+/* comment with a star * right before the block end     ****/ long y = 0x123456789abcdefULL;
+// line comment that runs until the newline at the very end of a block........
+double d = 1234567.890123e+10f + .5 + 0x1.8p3;     int z=x>>=y<<=2...;
+int	tabs	and	  spaces	;
+int last_identifier_at_the_end_of_the_file_______
\ No newline at end of file
@@ -0,0 +1,15 @@
+#line 1 "line.c"
+int first = 1;
+#line 40 "other.h"
+static const char* name = "héllo wörld"; int after = 2;
+  char c = 'ü';	int x; /* ë → ∞ */ int y = "𝄞"[0];
+#line 0 "ignored.h"
+#line 12 "other.h" trailing text keeps it a plain directive
+#include <stdio.h>
+#define TWICE(x) \
+    ((x) + \
+     (x))
+#line 7 "line.c"
+int last(void) { return first + after; }
+#line 100 ""
+int unnamed;
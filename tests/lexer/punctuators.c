@@ -0,0 +1,12 @@
+( ) [ ] { } < <= > >= << >> + ++ - -- * / % & | && || ^ ! ~ ? : ; , = *= /= %= += -=
+<<= >>= &= ^= |= == != -> . ...
+<<<= >>>= +++ --- ->* &&& ||| === !== .... a.b a->b a...b
+<: :> <% %> %: %:%: ?? =
+auto break case char const continue default do double else enum extern float for goto if
+inline int long register restrict return short signed sizeof static struct switch typedef
+union unsigned void volatile while autos _Bool int8 x1 _x __x
+0 00 07 08 0x 0x1F 0X1fULL 0b101 0b2 1u 1U 1l 1L 1ll 1LL 1ul 1lu 1llu 1ull 1Lu 1lL
+1. .1 1.5 1e5 1e 1e+ 1.e-3 1.5f 1.5L 0x1p1 0x.8p-1 0x1.p+2 0x1p 123abc 1.2.3
+'a' '\n' '\'' '\x4f' '\101' L'a' u'b' U'c' "" "a\"b" u8"s" u"s" U"s" L"s" "a\
+continued"
+t\u00e9t\U0001F600 L u8 u U
@@ -0,0 +1,8 @@
+int before = 1;
+char* s = "unterminated string
+int middle = 'x;
+char empty = '';
+char* bad = "bad \q escape" + 1;
+char* hex = "\xg" "\u12g" '\8' L"prefixed
+int after = @ 2 $ é;
+/* the comment is never closed * / int hidden;
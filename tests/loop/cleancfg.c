@@ -0,0 +1,88 @@
+#include "include/std.h"
+
+// Empty blocks, blocks to combine and branches to hoist for the CFG cleanup,
+// the dominator tree is updated on each of them with --verify-dom
+
+int sign(int x) {
+    int result = 0;
+    if (x > 0) {
+        result = 1;
+    } else if (x < 0) {
+        result = -1;
+    }
+    return result;
+}
+
+int countDigits(int x) {
+    int count = 0;
+    do {
+        x = x / 10;
+        ++count;
+    } while (x != 0);
+    return count;
+}
+
+int firstMultiple(int* values, int size, int divisor) {
+    for (int i = 0; i < size; ++i) {
+        if (values[i] == 0) {
+            continue;
+        }
+        if (values[i] % divisor == 0) {
+            return values[i];
+        }
+    }
+    return -1;
+}
+
+int nested(int a, int b, int c) {
+    int result = 0;
+    if (a) {
+        if (b) {
+            if (c) {
+                result = 7;
+            }
+        }
+    }
+    if (a || b) {
+        if (b && c) {
+            result = result + 1;
+        }
+    }
+    return result;
+}
+
+int chain(int n) {
+    int total = 0;
+    if (n < 0) {
+        goto done;
+    }
+    total = n;
+    goto second;
+second:
+    total = total * 2;
+    goto third;
+third:
+    if (n > 5) {
+        total = total + 1;
+    }
+done:
+    return total;
+}
+
+int main() {
+    int values[6] = {0, 7, 12, 0, 9, 30};
+
+    int total = 0;
+    for (int i = -3; i <= 3; ++i) {
+        total = total * 3 + sign(i) + 1;
+    }
+    for (int i = 0; i < 8; ++i) {
+        total = total + nested(i & 1, i & 2, i & 4) + chain(i * 2 - 3);
+    }
+
+    printf("%d %d %d\n", total, countDigits(0), countDigits(123456));
+    printf("%d %d %d\n", firstMultiple(values, 6, 3), firstMultiple(values, 6, 5),
+           firstMultiple(values, 6, 11));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+#include "include/std.h"
+
+int skipMultiples(int n, int k) {
+    int sum = 0;
+    int i = 0;
+    while (i < n) {
+        i++;
+        if (i % k == 0) {
+            continue;
+        }
+        if (i % (k + 1) == 0) {
+            sum = sum - i;
+            continue;
+        }
+        sum = sum + i * k;
+    }
+    return sum;
+}
+
+int sharedExit(int n, int limit) {
+    int found = -1;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i * j == limit) {
+                found = i * 100 + j;
+                goto done;
+            }
+            if (j > i) {
+                break;
+            }
+        }
+    }
+done:
+    return found;
+}
+
+int twoEntries(int start, int n) {
+    int steps = 0;
+    int x = start;
+    if (x < 0) {
+        x = -x;
+        goto body;
+    }
+    while (x < n) {
+        x = x + 3;
+body:
+        steps = steps + x % 7;
+        if (steps > 1000) {
+            break;
+        }
+    }
+    return steps * 10 + x;
+}
+
+int main() {
+    printf("%d %d\n", skipMultiples(50, 3), skipMultiples(77, 5));
+    printf("%d %d %d\n", sharedExit(20, 42), sharedExit(20, 361), sharedExit(5, 7));
+    printf("%d %d\n", twoEntries(-4, 40), twoEntries(2, 100));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+#include "include/std.h"
+
+int total;
+long checksum;
+int table[16];
+volatile int ticks;
+
+int invariantProduct(int a, int b, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        int scale = a * b + 7;
+        sum = sum + scale * i + (a * 8) / 4;
+    }
+    return sum;
+}
+
+void accumulate(int n) {
+    for (int i = 0; i < n; ++i) {
+        total = total + i;
+        if (i % 3 == 0) {
+            checksum = checksum * 31 + total;
+        }
+    }
+}
+
+int promoteWithExits(int n, int stop) {
+    for (int i = 0; i < n; ++i) {
+        total = total + table[i % 16];
+        if (total > stop) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void countTicks(int n) {
+    for (int i = 0; i < n; ++i) {
+        ticks = ticks + 1;
+    }
+}
+
+void report() {
+    printf("report %d %ld\n", total, checksum);
+}
+
+void withCall(int n) {
+    for (int i = 0; i < n; ++i) {
+        total = total + 2;
+        if (i == n / 2) {
+            report();
+        }
+    }
+}
+
+int invariantLoad(int* values, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum = sum + values[i] * table[3];
+    }
+    return sum;
+}
+
+int main() {
+    printf("%d %d\n", invariantProduct(3, 4, 10), invariantProduct(-5, 2, 7));
+
+    accumulate(20);
+    printf("%d %ld\n", total, checksum);
+
+    for (int i = 0; i < 16; ++i) {
+        table[i] = i * i - 20;
+    }
+    total = 0;
+    int stopped = promoteWithExits(100, 500);
+    printf("%d %d\n", stopped, total);
+    stopped = promoteWithExits(10, 100000);
+    printf("%d %d\n", stopped, total);
+
+    countTicks(25);
+    printf("%d\n", ticks);
+
+    withCall(6);
+    printf("%d\n", total);
+
+    int values[8];
+    for (int i = 0; i < 8; ++i) {
+        values[i] = i + 1;
+    }
+    printf("%d\n", invariantLoad(values, 8));
+
+    return EXIT_SUCCESS;
+}
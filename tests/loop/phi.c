@@ -0,0 +1,63 @@
+#include "include/std.h"
+
+int collatzSteps(int n) {
+    int steps = 0;
+    while (n != 1) {
+        if (n % 2 == 0) {
+            n = n / 2;
+        } else {
+            n = 3 * n + 1;
+        }
+        steps++;
+    }
+    return steps;
+}
+
+int firstDivisor(int n) {
+    for (int d = 2; d < n; ++d) {
+        if (n % d == 0) {
+            return d;
+        }
+    }
+    return n;
+}
+
+void increment(int* value) {
+    *value = *value + 1;
+}
+
+int main() {
+    int a = 1;
+    int b = 2;
+    int i = 0;
+    do {
+        int t = a;
+        a = b;
+        b = t;
+        if (i == 3) {
+            ++i;
+            continue;
+        }
+        i++;
+    } while (i < 7);
+    printf("%d %d %d", a, b, i);
+
+    int sum = 0;
+    int j = 0;
+    while (j < 100) {
+        if (j > 10) {
+            break;
+        }
+        sum = sum + (j % 3 == 0 ? j : -j);
+        j++;
+    }
+    printf("%d", sum);
+
+    int counter = 5;
+    increment(&counter);
+    printf("%d", counter);
+
+    printf("%d %d %d", collatzSteps(27), firstDivisor(91), firstDivisor(13));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+#include "include/std.h"
+
+struct point {
+    int x;
+    int y;
+};
+
+struct range {
+    long low;
+    long high;
+    int count;
+};
+
+int walk(int steps) {
+    struct point p;
+    p.x = 0;
+    p.y = 0;
+    for (int i = 0; i < steps; ++i) {
+        if (i % 4 == 0) {
+            p.x = p.x + i;
+        } else if (i % 4 == 1) {
+            p.y = p.y - i;
+        } else {
+            int t = p.x;
+            p.x = p.y;
+            p.y = t;
+        }
+    }
+    return p.x * 1000 + p.y;
+}
+
+long spread(int n) {
+    struct range r;
+    r.low = 1000;
+    r.high = -1000;
+    r.count = 0;
+    for (int i = 0; i < n; ++i) {
+        long value = (i * 37) % 101 - 50;
+        if (value == 13) {
+            continue;
+        }
+        if (value < r.low) {
+            r.low = value;
+        }
+        if (value > r.high) {
+            r.high = value;
+        }
+        r.count++;
+        if (r.count == 40) {
+            break;
+        }
+    }
+    return (r.high - r.low) * 100 + r.count;
+}
+
+int nested(int n) {
+    struct point p;
+    p.x = 1;
+    p.y = 0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if ((i + j) % 3 == 0) {
+                p.x = p.x * 2 % 1009;
+            }
+        }
+        p.y = p.y + p.x;
+    }
+    return p.y;
+}
+
+int jumps(int n) {
+    struct point p;
+    p.x = n;
+    p.y = 0;
+again:
+    if (p.x % 2 == 0) {
+        p.x = p.x / 2;
+        goto count;
+    }
+    if (p.x == 1) {
+        goto done;
+    }
+    p.x = 3 * p.x + 1;
+count:
+    p.y++;
+    goto again;
+done:
+    return p.y;
+}
+
+int main() {
+    printf("%d %d\n", walk(10), walk(31));
+    printf("%ld %ld\n", spread(20), spread(100));
+    printf("%d %d\n", nested(5), nested(12));
+    printf("%d %d\n", jumps(27), jumps(1));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,178 @@
+#include "include/std.h"
+
+struct s1 {
+    char bytes[1];
+};
+
+struct s3 {
+    char bytes[3];
+};
+
+struct s7 {
+    char bytes[7];
+};
+
+struct s13 {
+    char bytes[13];
+};
+
+struct s64 {
+    long values[8];
+};
+
+struct s128 {
+    int values[32];
+};
+
+struct s129 {
+    char bytes[129];
+};
+
+struct s4096 {
+    char bytes[4096];
+};
+
+struct guarded {
+    char before[5];
+    struct s13 middle;
+    char after[6];
+};
+
+int fill(char* bytes, int size, int seed) {
+    for (int i = 0; i < size; ++i) {
+        bytes[i] = seed + i * 7;
+    }
+    return size;
+}
+
+int compare(char* left, char* right, int size) {
+    int mismatches = 0;
+    for (int i = 0; i < size; ++i) {
+        if (left[i] != right[i]) {
+            mismatches = mismatches + 1;
+        }
+    }
+    return mismatches;
+}
+
+int checksum(char* bytes, int size) {
+    int sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum = sum * 31 + bytes[i];
+        sum = sum % 1000003;
+    }
+    return sum;
+}
+
+int assignments(int seed) {
+    struct s1 a1;
+    struct s1 b1;
+    struct s3 a3;
+    struct s3 b3;
+    struct s7 a7;
+    struct s7 b7;
+    struct s13 a13;
+    struct s13 b13;
+    fill((char*)&a1, sizeof(a1), seed);
+    fill((char*)&a3, sizeof(a3), seed + 1);
+    fill((char*)&a7, sizeof(a7), seed + 2);
+    fill((char*)&a13, sizeof(a13), seed + 3);
+    fill((char*)&b1, sizeof(b1), 0);
+    fill((char*)&b3, sizeof(b3), 0);
+    fill((char*)&b7, sizeof(b7), 0);
+    fill((char*)&b13, sizeof(b13), 0);
+
+    b1 = a1;
+    b3 = a3;
+    b7 = a7;
+    b13 = a13;
+    return compare((char*)&a1, (char*)&b1, sizeof(a1)) + compare((char*)&a3, (char*)&b3, sizeof(a3)) +
+           compare((char*)&a7, (char*)&b7, sizeof(a7)) + compare((char*)&a13, (char*)&b13, sizeof(a13)) +
+           checksum((char*)&b13, sizeof(b13));
+}
+
+int largeAssignments(int seed) {
+    struct s64 a64;
+    struct s64 b64;
+    struct s128 a128;
+    struct s128 b128;
+    struct s129 a129;
+    struct s129 b129;
+    fill((char*)&a64, sizeof(a64), seed);
+    fill((char*)&a128, sizeof(a128), seed + 1);
+    fill((char*)&a129, sizeof(a129), seed + 2);
+    fill((char*)&b64, sizeof(b64), 0);
+    fill((char*)&b128, sizeof(b128), 0);
+    fill((char*)&b129, sizeof(b129), 0);
+
+    b64 = a64;
+    b128 = a128;
+    b129 = a129;
+    return compare((char*)&a64, (char*)&b64, sizeof(a64)) +
+           compare((char*)&a128, (char*)&b128, sizeof(a128)) +
+           compare((char*)&a129, (char*)&b129, sizeof(a129)) +
+           checksum((char*)&b129, sizeof(b129));
+}
+
+int initializations(int seed) {
+    struct s13 source;
+    fill((char*)&source, sizeof(source), seed);
+    struct s13 copy = source;
+
+    struct s129 bigSource;
+    fill((char*)&bigSource, sizeof(bigSource), seed * 3);
+    struct s129 bigCopy = bigSource;
+
+    return compare((char*)&source, (char*)&copy, sizeof(copy)) +
+           compare((char*)&bigSource, (char*)&bigCopy, sizeof(bigCopy)) +
+           checksum((char*)&copy, sizeof(copy)) + checksum((char*)&bigCopy, sizeof(bigCopy));
+}
+
+void copyThrough(struct s7* destination, struct s7* source) {
+    *destination = *source;
+}
+
+void copyPage(struct s4096* destination, struct s4096* source) {
+    *destination = *source;
+}
+
+int pointers(int seed) {
+    struct s7 values[4];
+    fill((char*)values, sizeof(values), seed);
+    copyThrough(&values[0], &values[3]);
+    values[1] = values[2];
+    int result = compare((char*)&values[0], (char*)&values[3], sizeof(values[0])) +
+                 compare((char*)&values[1], (char*)&values[2], sizeof(values[1]));
+
+    struct s4096* pages = malloc(sizeof(struct s4096) * 2);
+    fill((char*)pages, sizeof(struct s4096) * 2, seed + 5);
+    copyPage(&pages[0], &pages[1]);
+    result = result + compare((char*)&pages[0], (char*)&pages[1], sizeof(pages[0]));
+    result = result + checksum((char*)pages, sizeof(struct s4096));
+    free(pages);
+    return result + checksum((char*)values, sizeof(values));
+}
+
+int neighbours(int seed) {
+    struct guarded g;
+    fill((char*)&g, sizeof(g), seed);
+    struct s13 replacement;
+    fill((char*)&replacement, sizeof(replacement), seed + 100);
+
+    int before = checksum(g.before, 5);
+    int after = checksum(g.after, 6);
+    g.middle = replacement;
+    return (checksum(g.before, 5) - before) + (checksum(g.after, 6) - after) +
+           compare((char*)&g.middle, (char*)&replacement, sizeof(replacement)) +
+           checksum((char*)&g, sizeof(g));
+}
+
+int main() {
+    printf("%d %d\n", assignments(3), assignments(-50));
+    printf("%d %d\n", largeAssignments(11), largeAssignments(90));
+    printf("%d %d\n", initializations(7), initializations(-1));
+    printf("%d\n", pointers(13));
+    printf("%d\n", neighbours(21));
+
+    return EXIT_SUCCESS;
+}
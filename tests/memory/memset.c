@@ -0,0 +1,176 @@
+#include "include/std.h"
+
+struct small {
+    char bytes[3];
+};
+
+struct odd {
+    char tag;
+    short count;
+    char rest[4];
+};
+
+struct medium {
+    long first;
+    int second;
+    char third;
+    double fourth;
+};
+
+struct large {
+    long values[25];
+};
+
+struct page {
+    int header;
+    char data[4088];
+    int footer;
+};
+
+struct nested {
+    struct small head;
+    int numbers[3];
+    struct odd tail;
+};
+
+union word {
+    long whole;
+    char bytes[8];
+};
+
+int checkBytes(unsigned char* bytes, int size) {
+    int dirty = 0;
+    for (int i = 0; i < size; ++i) {
+        if (bytes[i] != 0) {
+            dirty = dirty + 1;
+        }
+    }
+    return dirty;
+}
+
+int sumBytes(unsigned char* bytes, int size) {
+    int sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum = sum + bytes[i] * (i % 7 + 1);
+    }
+    return sum;
+}
+
+int dirtyStack() {
+    unsigned char garbage[8192];
+    for (int i = 0; i < 8192; ++i) {
+        garbage[i] = i * 37 + 11;
+    }
+    return sumBytes(garbage, 8192);
+}
+
+int zeroArrays() {
+    unsigned char a3[3] = {0};
+    unsigned char a7[7] = {0};
+    unsigned char a24[24] = {0};
+    unsigned char a200[200] = {0};
+    unsigned char a203[203] = {0};
+    unsigned char a4096[4096] = {0};
+    long longs[25] = {0};
+    return checkBytes(a3, 3) + checkBytes(a7, 7) + checkBytes(a24, 24) +
+           checkBytes(a200, 200) + checkBytes(a203, 203) + checkBytes(a4096, 4096) +
+           checkBytes((unsigned char*)longs, 200);
+}
+
+int zeroStructs() {
+    struct small s = {{0}};
+    struct odd o = {0};
+    struct medium m = {0};
+    struct large l = {{0}};
+    struct page p = {0};
+    union word w = {0};
+    return checkBytes((unsigned char*)&s, sizeof(s)) + checkBytes((unsigned char*)&o, sizeof(o)) +
+           checkBytes((unsigned char*)&m, sizeof(m)) + checkBytes((unsigned char*)&l, sizeof(l)) +
+           checkBytes((unsigned char*)&p, sizeof(p)) + checkBytes((unsigned char*)&w, sizeof(w));
+}
+
+int partialArrays(int x) {
+    int numbers[50] = {x, x + 1, 0, x * 3};
+    unsigned char text[10] = {'a', 'b'};
+    unsigned char word[12] = "hello";
+    int grid[3][4] = {{1, 2}, {0}, {x, x, x, x}};
+    int sum = 0;
+    for (int i = 0; i < 50; ++i) {
+        sum = sum + numbers[i] * (i + 1);
+    }
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            sum = sum + grid[i][j] * (i * 4 + j + 1);
+        }
+    }
+    return sum + sumBytes(text, 10) + sumBytes(word, 12);
+}
+
+long partialStructs(int x) {
+    struct medium m = {x, 2};
+    struct odd o = {'z', 300};
+    struct nested n = {{{'p', 'q'}}, {x, 0, x}, {'t', 0, "ab"}};
+    union word w = {x};
+    double scale = m.fourth + 1.5;
+    long result = m.first * 1000 + m.second * 100 + m.third + (long)(scale * 2);
+    result = result + o.tag + o.count + o.rest[0] + o.rest[3];
+    result = result * 3 + sumBytes((unsigned char*)&n.head, sizeof(n.head));
+    result = result + n.numbers[0] + n.numbers[1] * 7 + n.numbers[2] * 11;
+    result = result + n.tail.tag + n.tail.count + sumBytes((unsigned char*)n.tail.rest, 4);
+    return result + w.whole;
+}
+
+long copiedElements(int x) {
+    struct small s;
+    s.bytes[0] = x;
+    s.bytes[1] = x + 1;
+    s.bytes[2] = x + 2;
+    struct small pair[3] = {s, {{0}}, s};
+    struct nested n = {s, {x}};
+    return sumBytes((unsigned char*)pair, sizeof(pair)) * 10 + sumBytes((unsigned char*)&n, 3) +
+           n.numbers[0] + checkBytes((unsigned char*)&n.tail, sizeof(n.tail));
+}
+
+int scalars(int x) {
+    int a = {x};
+    double d = {x * 2};
+    int* p = {0};
+    int result = a + (int)d;
+    if (p == 0) {
+        result = result + 1000;
+    }
+    return result;
+}
+
+int volatileArray(int x) {
+    volatile int values[6] = {x, 0, x};
+    int sum = 0;
+    for (int i = 0; i < 6; ++i) {
+        sum = sum * 3 + values[i];
+    }
+    return sum;
+}
+
+int main() {
+    int garbage = dirtyStack();
+    int arrays = zeroArrays();
+    garbage = garbage + dirtyStack();
+    int structs = zeroStructs();
+    printf("%d %d %d\n", garbage, arrays, structs);
+
+    dirtyStack();
+    int partial = partialArrays(9);
+    dirtyStack();
+    long partialStruct = partialStructs(-4);
+    printf("%d %ld\n", partial, partialStruct);
+
+    dirtyStack();
+    long copied = copiedElements(5);
+    dirtyStack();
+    int scalar = scalars(21);
+    dirtyStack();
+    int volatiles = volatileArray(7);
+    printf("%ld %d %d\n", copied, scalar, volatiles);
+
+    return EXIT_SUCCESS;
+}
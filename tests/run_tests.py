@@ -1,4 +1,6 @@
 import argparse
+import difflib
+import os
 import subprocess
 
 RED_COLOR = '\033[31m'
@@ -12,6 +14,9 @@ ANCL_ASMFILE = "ancl.s"
 ANCL_EXEFILE = "./ancl.out"
 SYSTEM_EXEFILE = "./clang.out"
 
+ANTLR_TOKENS_FILE = "antlr.tokens"
+FAST_TOKENS_FILE = "fast.tokens"
+
 
 def print_ok(test_file):
     print(f"{GREEN_COLOR}[ OK ]{END_COLOR} {test_file}")
@@ -28,31 +33,92 @@ def print_output_failed(test_file, ancl_output, system_output):
     print(system_output)
     print("===========================")
 
+def print_tokens_failed(test_file, antlr_tokens, fast_tokens):
+    print(f"{RED_COLOR}[ FAILED ]{END_COLOR} {test_file} (lexers)")
+    print("===========================")
+    print("".join(difflib.unified_diff(antlr_tokens, fast_tokens, "ANTLR LEXER", "FAST LEXER")))
+    print("===========================")
+
+
+def read_tokens(test_file, lexer_flags, tokens_file):
+    open(tokens_file, "w").close()
+    subprocess.call([ANCL_COMPILER, f"-f{test_file}", f"-t{tokens_file}", *lexer_flags],
+                    stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    with open(tokens_file) as tokens:
+        return tokens.readlines()
+
+
+# Both lexers must produce the same tokens with the same positions,
+# the files are lexed as they are, without the preprocessor
+def compare_lexers(test_files):
+    for test_file in test_files:
+        antlr_tokens = read_tokens(test_file, [], ANTLR_TOKENS_FILE)
+        fast_tokens = read_tokens(test_file, ["--fast-lexer"], FAST_TOKENS_FILE)
+
+        if not antlr_tokens or antlr_tokens != fast_tokens:
+            print_tokens_failed(test_file, antlr_tokens, fast_tokens)
+        else:
+            print_ok(test_file)
+
 
 def main():
     parser = argparse.ArgumentParser(description='Testing')
     parser.add_argument('--opt', dest='opt', default=False, action='store_true',
                         help='Test with optimizations')
+    parser.add_argument('--fast-lexer', dest='fast_lexer', default=False, action='store_true',
+                        help='Test with hand-written lexer')
+    parser.add_argument('--stream', dest='stream', default=False, action='store_true',
+                        help='Test streaming compilation')
+    parser.add_argument('--verify-dom', dest='verify_dom', default=False, action='store_true',
+                        help='Check the incrementally updated dominator trees')
+    parser.add_argument('--jobs', dest='jobs', type=int, default=1,
+                        help='Threads to compile function bodies with')
 
     args = parser.parse_args()
 
     test_files = [
         "basic/answer.c", "basic/conv.c",
-        "call/variadic_hello.c", "call/long_answer.c",
-        "exprs/conditional.c", "exprs/allexprs.c",
-        "loop/count.c", "loop/fib.c", "loop/nested.c", "loop/goto.c",
-        "array/reverse.c",
-        "struct/readwrite.c", "struct/union.c",
+        "call/variadic_hello.c", "call/long_answer.c", "call/inline_volatile.c",
+        "call/tailcall.c", "call/stream_inline.c",
+        "exprs/conditional.c", "exprs/allexprs.c", "exprs/sccp.c",
+        "exprs/instcombine.c", "exprs/select.c", "exprs/divconst.c",
+        "exprs/mulconst.c",
+        "loop/count.c", "loop/fib.c", "loop/nested.c", "loop/goto.c", "loop/phi.c",
+        "loop/struct_phi.c", "loop/latches.c", "loop/licm.c", "loop/cleancfg.c",
+        "array/reverse.c", "array/stride.c",
+        "struct/readwrite.c", "struct/union.c", "struct/sroa.c", "struct/rle.c",
+        "struct/dse.c",
         "alignment/basic.c",
+        "switch/basic.c", "switch/lowering.c",
+        "memory/memset.c", "memory/memcpy.c",
         "hard/bintree.c", "hard/avl.c",
     ]
 
+    lexer_test_files = [
+        "lexer/line.c", "lexer/punctuators.c", "lexer/blocks.c", "lexer/unterminated.c",
+    ]
+
+    compare_lexers(lexer_test_files)
+
     for test_file in test_files:
         subprocess.call([SYSTEM_COMPILER, test_file, f"-o{SYSTEM_EXEFILE}", "-I."])
 
         ancl_flags = [f"-f{test_file}", f"-n{ANCL_ASMFILE}"]
         if args.opt:
             ancl_flags.append("-O")
+        if args.fast_lexer:
+            ancl_flags.append("--fast-lexer")
+        if args.stream:
+            ancl_flags.append("--stream")
+        if args.jobs > 1:
+            ancl_flags.append(f"-j{args.jobs}")
+        if args.verify_dom:
+            ancl_flags.append("--verify-dom")
+
+        # A failed compilation must not leave the results of the previous test
+        for output_file in (ANCL_ASMFILE, ANCL_EXEFILE):
+            if os.path.exists(output_file):
+                os.remove(output_file)
 
         subprocess.call([ANCL_COMPILER, *ancl_flags], stdout=subprocess.DEVNULL)
         subprocess.call([SYSTEM_COMPILER, ANCL_ASMFILE, f"-o{ANCL_EXEFILE}"])
@@ -0,0 +1,97 @@
+#include "include/std.h"
+
+struct counters {
+    int hits;
+    int misses;
+    long bytes;
+};
+
+int last;
+
+void overwrite(struct counters* c, int value) {
+    c->hits = 0;
+    c->misses = 0;
+    c->hits = value;
+    c->misses = value + 1;
+    c->bytes = 1;
+    c->bytes = c->bytes + value;
+}
+
+int readOnOnePath(int* slot, int flag) {
+    *slot = 5;
+    if (flag) {
+        int seen = *slot;
+        *slot = 6;
+        return seen;
+    }
+    *slot = 7;
+    return 0;
+}
+
+int overwrittenOnBothPaths(int* slot, int flag) {
+    *slot = 1;
+    if (flag) {
+        *slot = 2;
+    } else {
+        *slot = 3;
+    }
+    return *slot;
+}
+
+int deadLocal(int n) {
+    int scratch[8];
+    struct counters unused;
+    for (int i = 0; i < 8; ++i) {
+        scratch[i] = i * n;
+    }
+    unused.hits = n;
+    unused.bytes = n * 2;
+    return n + 1;
+}
+
+void report() {
+    printf("last=%d\n", last);
+}
+
+void storeBeforeCall(int value) {
+    last = value;
+    report();
+    last = value * 2;
+}
+
+void printSlot(int* slot) {
+    printf("slot=%d\n", *slot);
+}
+
+void escapedStore(int value) {
+    int slot = value;
+    printSlot(&slot);
+    slot = value + 1;
+    printSlot(&slot);
+    slot = value + 2;
+}
+
+int main() {
+    struct counters c;
+    overwrite(&c, 9);
+    printf("%d %d %ld\n", c.hits, c.misses, c.bytes);
+
+    int slot = 0;
+    int seen = readOnOnePath(&slot, 1);
+    printf("%d %d\n", seen, slot);
+    seen = readOnOnePath(&slot, 0);
+    printf("%d %d\n", seen, slot);
+
+    int first = overwrittenOnBothPaths(&slot, 1);
+    int second = overwrittenOnBothPaths(&slot, 0);
+    printf("%d %d\n", first, second);
+
+    printf("%d\n", deadLocal(4));
+
+    storeBeforeCall(11);
+    printf("%d\n", last);
+
+    escapedStore(30);
+
+    return EXIT_SUCCESS;
+}
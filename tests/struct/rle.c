@@ -0,0 +1,95 @@
+#include "include/std.h"
+
+struct pair {
+    int first;
+    int second;
+};
+
+union pun {
+    int bits;
+    float real;
+    char bytes[4];
+};
+
+int* saved;
+int shared;
+
+int forwardStore(struct pair* p, int value) {
+    p->first = value;
+    p->second = value * 2;
+    return p->first + p->second;
+}
+
+int repeatedLoads(int* values) {
+    int a = values[1] + values[2];
+    int b = values[1] * values[2];
+    return a + b;
+}
+
+int overlapping(struct pair* p, int* q) {
+    p->first = 10;
+    *q = 20;
+    return p->first;
+}
+
+void keep(int* pointer) {
+    saved = pointer;
+}
+
+void change() {
+    *saved = *saved + 100;
+}
+
+int escapedLocal() {
+    int local = 5;
+    keep(&local);
+    local = 7;
+    change();
+    return local;
+}
+
+int clobberedGlobal() {
+    shared = 1;
+    saved = &shared;
+    change();
+    return shared;
+}
+
+int punning(float value) {
+    union pun u;
+    u.real = value;
+    int bits = u.bits;
+    u.bits = bits + 1;
+    return (u.bits - bits) * 1000 + u.bytes[3];
+}
+
+int volatileLoads(volatile int* counter) {
+    *counter = 3;
+    int a = *counter;
+    *counter = a + 1;
+    int b = *counter;
+    return a * 10 + b;
+}
+
+int main() {
+    struct pair p;
+    int sum = forwardStore(&p, 21);
+    printf("%d %d\n", sum, p.second);
+
+    int values[4];
+    values[0] = 1;
+    values[1] = 4;
+    values[2] = 6;
+    values[3] = 8;
+    printf("%d\n", repeatedLoads(values));
+
+    printf("%d %d\n", overlapping(&p, &p.first), overlapping(&p, &p.second));
+    printf("%d %d\n", escapedLocal(), clobberedGlobal());
+    printf("%d %d\n", punning(1.5), punning(-2.0));
+
+    volatile int counter = 0;
+    int loaded = volatileLoads(&counter);
+    printf("%d %d\n", loaded, counter);
+
+    return EXIT_SUCCESS;
+}
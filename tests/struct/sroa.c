@@ -0,0 +1,85 @@
+#include "include/std.h"
+
+struct vec {
+    double x;
+    double y;
+};
+
+struct mixed {
+    char tag;
+    int count;
+    long total;
+    float ratio;
+};
+
+struct box {
+    struct vec low;
+    struct vec high;
+};
+
+double lengthSquared(double x, double y) {
+    struct vec v;
+    v.x = x;
+    v.y = y;
+    return v.x * v.x + v.y * v.y;
+}
+
+long summarize(int n) {
+    struct mixed m;
+    m.tag = 'a';
+    m.count = 0;
+    m.total = 0;
+    m.ratio = 0.5;
+    for (int i = 1; i <= n; ++i) {
+        m.count++;
+        m.total = m.total + i * i;
+        if (i % 4 == 0) {
+            m.tag = m.tag + 1;
+            m.ratio = m.ratio * 2;
+        }
+    }
+    return m.tag * 100000 + m.count * 1000 + m.total + (long)m.ratio;
+}
+
+double area(double x0, double y0, double x1, double y1) {
+    struct box b;
+    b.low.x = x0;
+    b.low.y = y0;
+    b.high.x = x1;
+    b.high.y = y1;
+
+    struct box copy;
+    copy = b;
+    copy.high.x = copy.high.x + 1;
+    return (copy.high.x - copy.low.x) * (copy.high.y - copy.low.y) + b.high.x;
+}
+
+int smallArray(int a, int b) {
+    int values[4];
+    values[0] = a;
+    values[1] = b;
+    values[2] = a + b;
+    values[3] = values[2] * values[1];
+    return values[0] - values[1] + values[2] * values[3];
+}
+
+void printVec(struct vec* v) {
+    printf("%f %f\n", v->x, v->y);
+}
+
+void escaped(double x) {
+    struct vec v;
+    v.x = x;
+    v.y = x * 3;
+    printVec(&v);
+}
+
+int main() {
+    printf("%f %f\n", lengthSquared(3.0, 4.0), lengthSquared(-1.5, 2.5));
+    printf("%ld %ld\n", summarize(10), summarize(3));
+    printf("%f\n", area(1.0, 2.0, 4.0, 7.0));
+    printf("%d %d\n", smallArray(3, 5), smallArray(-2, 9));
+    escaped(1.25);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include "include/std.h"
+
+int fallthrough(int x) {
+    int result = 0;
+    switch (x) {
+        case 0:
+            result = result + 1;
+        case 1:
+            result = result + 10;
+        case 2:
+            result = result + 100;
+            break;
+        case 3:
+            result = -1;
+    }
+    return result;
+}
+
+int defaultInMiddle(int x) {
+    int result = 1;
+    switch (x) {
+        case 5:
+            result = 50;
+            break;
+        default:
+            result = result * 7;
+        case 6:
+            result = result + 60;
+            break;
+        case 7:
+            result = 70;
+    }
+    return result;
+}
+
+int emptySwitch(int x) {
+    int result = x;
+    switch (x) {
+    }
+    switch (x + 1) {
+        default:
+            result = result * 2;
+    }
+    return result;
+}
+
+int nested(int x, int y) {
+    switch (x) {
+        case 0:
+            switch (y) {
+                case 0:
+                    return 100;
+                case 1:
+                    break;
+                default:
+                    return 102;
+            }
+            return 101;
+        case 1:
+            switch (y) {
+                case 1:
+                    x = x + 10;
+                default:
+                    x = x + 100;
+            }
+            break;
+        default:
+            return -1;
+    }
+    return x;
+}
+
+int inLoop(int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        switch (i % 4) {
+            case 0:
+                continue;
+            case 1:
+                sum = sum + i;
+                break;
+            case 2:
+                if (sum > 20) {
+                    return sum;
+                }
+            default:
+                sum = sum - 1;
+        }
+        sum = sum * 2;
+    }
+    return sum;
+}
+
+int main() {
+    for (int i = -1; i < 5; ++i) {
+        printf("%d ", fallthrough(i));
+    }
+    printf("\n");
+
+    for (int i = 4; i < 9; ++i) {
+        printf("%d ", defaultInMiddle(i));
+    }
+    printf("\n");
+
+    printf("%d %d\n", emptySwitch(3), emptySwitch(-4));
+
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            printf("%d ", nested(x, y));
+        }
+    }
+    printf("\n");
+
+    printf("%d %d\n", inLoop(5), inLoop(20));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,287 @@
+#include "include/std.h"
+
+int dense(int x) {
+    switch (x) {
+        case 0:
+            return 11;
+        case 1:
+            return 22;
+        case 2:
+            return 33;
+        case 3:
+            return 44;
+        case 5:
+            return 66;
+        case 6:
+            return 77;
+        case 8:
+            return 99;
+        case 9:
+            return 111;
+        default:
+            return -1;
+    }
+}
+
+int holes(int x) {
+    int result = 0;
+    switch (x) {
+        case 10:
+        case 11:
+        case 12:
+            result = 1;
+            break;
+        case 14:
+            result = 2;
+            break;
+        case 17:
+            result = 3;
+            break;
+        case 19:
+            result = 4;
+            break;
+        case 21:
+            result = 5;
+            break;
+    }
+    return result;
+}
+
+int sparse(int x) {
+    switch (x) {
+        case 1:
+            return 1;
+        case 100:
+            return 2;
+        case 1000:
+            return 3;
+        case 5000:
+            return 4;
+        case 70000:
+            return 5;
+        case 1000000:
+            return 6;
+        case -3:
+            return 7;
+        case -500:
+            return 8;
+        case 2147483647:
+            return 9;
+        default:
+            return 0;
+    }
+}
+
+int negative(int x) {
+    switch (x) {
+        case -8:
+            return 1;
+        case -7:
+            return 2;
+        case -6:
+            return 3;
+        case -5:
+            return 4;
+        case -3:
+            return 5;
+        case -1:
+            return 6;
+        case 0:
+            return 7;
+        case 1:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+int unsignedCases(unsigned int x) {
+    switch (x) {
+        case 0:
+            return 1;
+        case 1:
+            return 2;
+        case 2:
+            return 3;
+        case -1:
+            return 4;
+        case -2:
+            return 5;
+        case -3:
+            return 6;
+        case 2147483647:
+            return 7;
+        case -2147483647 - 1:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+int charCases(char c) {
+    switch (c) {
+        case 'a':
+            return 1;
+        case 'b':
+            return 2;
+        case 'c':
+            return 3;
+        case 'd':
+            return 4;
+        case -128:
+            return 5;
+        case -1:
+            return 6;
+        case 127:
+            return 7;
+        default:
+            return 0;
+    }
+}
+
+long longCases(long x) {
+    long big = 1000000;
+    switch (x) {
+        case 0:
+            return 1;
+        case 3:
+            return 2;
+        case 2147483647:
+            return 3;
+        case -2147483647 - 1:
+            return 4;
+        case -1:
+            return 5;
+        default:
+            return x / big;
+    }
+}
+
+int defaultWithPhis(int x, int y) {
+    int a = y;
+    int b = 1;
+    switch (x) {
+        case 0:
+            a = a + 5;
+            b = 2;
+            break;
+        case 1:
+            a = a * 3;
+        case 2:
+            b = b + 10;
+            break;
+        case 3:
+            a = -a;
+        default:
+            a = a + 1000;
+            b = b * 4;
+            break;
+        case 4:
+            a = 7;
+        case 5:
+            b = b - 9;
+    }
+    return a * 100 + b;
+}
+
+int defaultWithPhisDense(int x, int y) {
+    int a = y;
+    switch (x) {
+        case 10:
+            a = a + 1;
+            break;
+        case 11:
+            a = a + 2;
+            break;
+        case 12:
+            a = a * 2;
+        case 14:
+            a = a + 3;
+            break;
+        case 15:
+            a = a - 1;
+        default:
+            a = a * 10;
+    }
+    return a;
+}
+
+int main() {
+    for (int i = -2; i < 12; ++i) {
+        printf("%d ", dense(i));
+    }
+    printf("\n");
+
+    for (int i = 8; i < 24; ++i) {
+        printf("%d ", holes(i));
+    }
+    printf("\n");
+
+    int sparseKeys[12];
+    sparseKeys[0] = 1;
+    sparseKeys[1] = 100;
+    sparseKeys[2] = 1000;
+    sparseKeys[3] = 5000;
+    sparseKeys[4] = 70000;
+    sparseKeys[5] = 1000000;
+    sparseKeys[6] = -3;
+    sparseKeys[7] = -500;
+    sparseKeys[8] = 2147483647;
+    sparseKeys[9] = 0;
+    sparseKeys[10] = 999;
+    sparseKeys[11] = -2147483647 - 1;
+    for (int i = 0; i < 12; ++i) {
+        printf("%d ", sparse(sparseKeys[i]));
+    }
+    printf("\n");
+
+    for (int i = -10; i < 4; ++i) {
+        printf("%d ", negative(i));
+    }
+    printf("\n");
+
+    unsigned int unsignedKeys[10];
+    unsignedKeys[0] = 0;
+    unsignedKeys[1] = 1;
+    unsignedKeys[2] = 2;
+    unsignedKeys[3] = 3;
+    unsignedKeys[4] = -1;
+    unsignedKeys[5] = -2;
+    unsignedKeys[6] = -3;
+    unsignedKeys[7] = -4;
+    unsignedKeys[8] = 2147483647;
+    unsignedKeys[9] = unsignedKeys[8] + 1;
+    for (int i = 0; i < 10; ++i) {
+        printf("%d ", unsignedCases(unsignedKeys[i]));
+    }
+    printf("\n");
+
+    printf("%d %d %d %d %d %d %d %d %d\n", charCases('a'), charCases('b'),
+           charCases('c'), charCases('d'), charCases('e'), charCases(-128),
+           charCases(-1), charCases(127), charCases(0));
+
+    long longKeys[7];
+    longKeys[0] = 0;
+    longKeys[1] = 3;
+    longKeys[2] = 2147483647;
+    longKeys[3] = -2147483647 - 1;
+    longKeys[4] = -1;
+    longKeys[5] = longKeys[2] * 4;
+    longKeys[6] = longKeys[3] - 1;
+    for (int i = 0; i < 7; ++i) {
+        printf("%ld ", longCases(longKeys[i]));
+    }
+    printf("\n");
+
+    for (int i = -1; i < 7; ++i) {
+        printf("%d ", defaultWithPhis(i, 6));
+    }
+    printf("\n");
+
+    for (int i = 9; i < 17; ++i) {
+        printf("%d ", defaultWithPhisDense(i, 4));
+    }
+    printf("\n");
+
+    return EXIT_SUCCESS;
+}